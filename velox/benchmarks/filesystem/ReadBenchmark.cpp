@@ -17,6 +17,7 @@
 #include "velox/benchmarks/filesystem/ReadBenchmark.h"
 
 #include "velox/common/config/Config.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/connectors/hive/storage_adapters/abfs/RegisterAbfsFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/gcs/RegisterGCSFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/RegisterHdfsFileSystem.h"
@@ -31,6 +32,11 @@ DEFINE_int64(
 DEFINE_int32(num_threads, 16, "Test paralelism");
 DEFINE_int32(seed, 0, "Random seed, 0 means no seed");
 DEFINE_bool(odirect, false, "Use O_DIRECT");
+DEFINE_bool(
+    io_uring,
+    false,
+    "Read local files through io_uring. Requires building with "
+    "VELOX_ENABLE_IO_URING. Combines with --odirect");
 
 DEFINE_int32(
     bytes,
@@ -86,7 +92,7 @@ std::shared_ptr<config::ConfigBase> readConfig(const std::string& filePath) {
 // Initialize a LocalReadFile instance for the specified 'path'.
 void ReadBenchmark::initialize() {
   executor_ = std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_threads);
-  if (FLAGS_odirect) {
+  if (FLAGS_odirect && !FLAGS_io_uring) {
     int32_t o_direct =
 #ifdef linux
         O_DIRECT;
@@ -103,7 +109,14 @@ void ReadBenchmark::initialize() {
     }
     readFile_ = std::make_unique<LocalReadFile>(fd_);
   } else {
-    filesystems::registerLocalFileSystem();
+    filesystems::LocalFileSystemOptions localOptions;
+    localOptions.useIoUring = FLAGS_io_uring;
+    localOptions.directIo = FLAGS_odirect;
+    if (localOptions.directIo) {
+      // Direct IO reads into staging buffers from the memory manager.
+      memory::MemoryManager::initialize({});
+    }
+    filesystems::registerLocalFileSystem(localOptions);
     filesystems::registerS3FileSystem();
     filesystems::registerGCSFileSystem();
     filesystems::registerHdfsFileSystem();
@@ -38,6 +38,7 @@ DECLARE_int64(file_size_gb);
 DECLARE_int32(num_threads);
 DECLARE_int32(seed);
 DECLARE_bool(odirect);
+DECLARE_bool(io_uring);
 DECLARE_int32(bytes);
 DECLARE_int32(gap);
 DECLARE_int32(num_in_run);
@@ -47,7 +48,7 @@ DECLARE_string(config);
 
 namespace facebook::velox {
 
-enum class Mode { Pread = 0, Preadv = 1, Multiple = 2 };
+enum class Mode { Pread = 0, Preadv = 1, Multiple = 2, PreadvAsync = 3 };
 
 // Struct to read data into. If we read contiguous and then copy to
 // non-contiguous buffers, we read to 'buffer' and copy to
@@ -106,6 +107,9 @@ class ReadBenchmark {
     clearCache();
     std::vector<folly::Promise<bool>> promises;
     std::vector<folly::SemiFuture<bool>> futures;
+    // Destination of the reads in flight with PreadvAsync.
+    std::vector<std::string> asyncBuffers;
+    asyncBuffers.reserve(parallel ? repeats : 0);
     uint64_t usec = 0;
     std::string label;
     {
@@ -116,7 +120,7 @@ class ReadBenchmark {
       globalScratch.bufferCopy.resize(rangeSize);
       for (auto repeat = 0; repeat < repeats; ++repeat) {
         std::unique_ptr<folly::Promise<bool>> promise;
-        if (parallel) {
+        if (parallel && mode != Mode::PreadvAsync) {
           auto [tempPromise, future] = folly::makePromiseContract<bool>();
           promise = std::make_unique<folly::Promise<bool>>();
           *promise = std::move(tempPromise);
@@ -220,6 +224,31 @@ class ReadBenchmark {
             }
             break;
           }
+          case Mode::PreadvAsync: {
+            // Reads are issued from this thread. With 'parallel' they are all
+            // in flight at the same time instead of using the executor.
+            label = "1 preadvAsync";
+            char* buffer = globalScratch.buffer.data();
+            if (parallel) {
+              asyncBuffers.emplace_back(rangeSize, 0);
+              buffer = asyncBuffers.back().data();
+            }
+            std::vector<folly::Range<char*>> ranges;
+            for (auto start = 0; start < rangeSize; start += size + gap) {
+              ranges.push_back(folly::Range<char*>(buffer + start, size));
+              if (gap && start + gap < rangeSize) {
+                ranges.push_back(folly::Range<char*>(nullptr, gap));
+              }
+            }
+            auto future = readFile_->preadvAsync(offset, ranges);
+            if (parallel) {
+              futures.push_back(
+                  std::move(future).deferValue([](uint64_t) { return true; }));
+            } else {
+              std::move(future).get();
+            }
+            break;
+          }
         }
       }
       if (parallel) {
@@ -253,6 +282,10 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    if (readFile_->hasPreadvAsync()) {
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, false);
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, true);
+    }
   }
 
   void run();
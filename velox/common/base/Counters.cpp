@@ -265,6 +265,34 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricSsdCacheRecoveredEntries, facebook::velox::StatType::SUM);
 
+  // Total number of cache entries not saved to SSD because their predicted
+  // reuse is below the admission threshold.
+  DEFINE_METRIC(
+      kMetricSsdCacheAdmissionRejectedEntries, facebook::velox::StatType::SUM);
+
+  // Total number of cache entries not saved to SSD because the SSD write
+  // budget is exhausted.
+  DEFINE_METRIC(
+      kMetricSsdCacheWriteThrottledEntries, facebook::velox::StatType::SUM);
+
+  /// ================== File Metadata Cache Counters =================
+
+  // Number of decoded file footers currently cached.
+  DEFINE_METRIC(
+      kMetricFileMetadataCacheNumEntries, facebook::velox::StatType::AVG);
+
+  // Estimated heap memory of the decoded file footers currently cached. This
+  // memory is not counted by any memory pool.
+  DEFINE_METRIC(kMetricFileMetadataCacheBytes, facebook::velox::StatType::AVG);
+
+  // Number of file footers found in the cache.
+  DEFINE_METRIC(
+      kMetricFileMetadataCacheNumHits, facebook::velox::StatType::SUM);
+
+  // Number of file footers not found in the cache.
+  DEFINE_METRIC(
+      kMetricFileMetadataCacheNumMisses, facebook::velox::StatType::SUM);
+
   /// ================== Memory Arbitration Counters =================
 
   // The number of arbitration requests.
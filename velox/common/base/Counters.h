@@ -299,6 +299,24 @@ constexpr folly::StringPiece kMetricSsdCacheRegionsEvicted{
 constexpr folly::StringPiece kMetricSsdCacheRecoveredEntries{
     "velox.ssd_cache_recovered_entries"};
 
+constexpr folly::StringPiece kMetricSsdCacheAdmissionRejectedEntries{
+    "velox.ssd_cache_admission_rejected_entries"};
+
+constexpr folly::StringPiece kMetricSsdCacheWriteThrottledEntries{
+    "velox.ssd_cache_write_throttled_entries"};
+
+constexpr folly::StringPiece kMetricFileMetadataCacheNumEntries{
+    "velox.file_metadata_cache_num_entries"};
+
+constexpr folly::StringPiece kMetricFileMetadataCacheBytes{
+    "velox.file_metadata_cache_bytes"};
+
+constexpr folly::StringPiece kMetricFileMetadataCacheNumHits{
+    "velox.file_metadata_cache_num_hits"};
+
+constexpr folly::StringPiece kMetricFileMetadataCacheNumMisses{
+    "velox.file_metadata_cache_num_misses"};
+
 constexpr folly::StringPiece kMetricExchangeDataTimeMs{
     "velox.exchange_data_time_ms"};
 
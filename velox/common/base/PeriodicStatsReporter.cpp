@@ -231,6 +231,12 @@ void PeriodicStatsReporter::reportCacheStats() {
         deltaSsdStats.readWithoutChecksumChecks);
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheRecoveredEntries, deltaSsdStats.entriesRecovered);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheAdmissionRejectedEntries,
+        deltaSsdStats.entriesAdmissionRejected);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheWriteThrottledEntries,
+        deltaSsdStats.entriesWriteThrottled);
   }
 
   // TTL controler snapshot stats.
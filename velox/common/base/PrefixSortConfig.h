@@ -24,8 +24,15 @@ namespace facebook::velox::common {
 struct PrefixSortConfig {
   explicit PrefixSortConfig(
       int64_t maxNormalizedKeySize,
-      int32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
+      int32_t threshold = 130,
+      int32_t maxStringPrefixLength = 12,
+      int32_t maxSortThreads = 1,
+      int32_t minRowsPerSortThread = 100'000)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        maxStringPrefixLength(maxStringPrefixLength),
+        maxSortThreads(maxSortThreads),
+        minRowsPerSortThread(minRowsPerSortThread) {}
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry.
@@ -33,5 +40,19 @@ struct PrefixSortConfig {
 
   /// PrefixSort will have performance regression when the dateset is too small.
   const int32_t threshold;
+
+  /// Max number of leading bytes of a VARCHAR or VARBINARY sort key to store in
+  /// the prefix-sort buffer. Rows with equal prefixes are compared using the
+  /// full values. The default covers strings that are inlined in StringView.
+  /// Use 0 to not normalize string keys.
+  const int32_t maxStringPrefixLength;
+
+  /// Max number of threads to sort the rows of a single sort buffer. If more
+  /// than 1 and an executor is provided, the rows are split into ranges that
+  /// are sorted in parallel and then merged.
+  const int32_t maxSortThreads;
+
+  /// Min number of rows per range when sorting in parallel.
+  const int32_t minRowsPerSortThread;
 };
 } // namespace facebook::velox::common
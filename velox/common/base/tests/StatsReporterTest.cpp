@@ -500,6 +500,9 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheAdmissionRejectedEntries.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheWriteThrottledEntries.str()), 0);
     ASSERT_EQ(counterMap.size(), 22);
   }
 
@@ -528,6 +531,8 @@ TEST_F(PeriodicStatsReporterTest, basic) {
   newSsdStats->readCheckpointErrors = 10;
   newSsdStats->readWithoutChecksumChecks = 10;
   newSsdStats->entriesRecovered = 10;
+  newSsdStats->entriesAdmissionRejected = 10;
+  newSsdStats->entriesWriteThrottled = 10;
   cache.updateStats(
       {.numHit = 10,
        .hitBytes = 10,
@@ -583,7 +588,10 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 1);
-    ASSERT_EQ(counterMap.size(), 54);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheAdmissionRejectedEntries.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheWriteThrottledEntries.str()), 1);
+    ASSERT_EQ(counterMap.size(), 56);
   }
 }
 
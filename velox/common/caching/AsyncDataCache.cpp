@@ -76,7 +76,8 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
 
   auto* ssdCache = shard_->cache()->ssdCache();
   if ((ssdCache != nullptr) && (ssdFile_ == nullptr)) {
-    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
+    if (ssdCache->shouldSaveToSsd(
+            groupId_, trackingId_, key_.fileNum.id(), key_.offset)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
     }
@@ -151,6 +152,22 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+int32_t TinyLfuEvictionPolicy::score(
+    const AsyncDataCacheEntry& entry,
+    AccessTime now) const {
+  const auto& stats = entry.accessStats();
+  if (!stats.lastUse) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  const auto frequency = sketch_.frequency(std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{entry.key().fileNum.id(), entry.key().offset}));
+  const int32_t age = std::max<int32_t>(0, now - stats.lastUse);
+  if (frequency < admitFrequency_) {
+    return kProbationScore + std::min(age, kProbationScore - 1);
+  }
+  return age / (1 + frequency);
+}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -183,6 +200,7 @@ CachePin CacheShard::findOrCreate(
 
       if (foundEntry->size() >= size) {
         foundEntry->touch();
+        evictionPolicy_->recordAccess(key);
         // The entry is in a readable state. Add a pin.
         if (foundEntry->isPrefetch()) {
           foundEntry->isFirstUse_ = true;
@@ -416,7 +434,8 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (score = evictionPolicy_->score(*candidate, now)) >=
+               evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -498,7 +517,7 @@ void CacheShard::calibrateThreshold() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? evictionPolicy_->score(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -664,7 +683,11 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this,
+        opts_.maxWriteRatio,
+        opts_.evictionPolicyFactory ? opts_.evictionPolicyFactory()
+                                    : nullptr));
   }
 }
 
@@ -893,7 +916,8 @@ void AsyncDataCache::incrementNew(uint64_t size) {
     nextSsdScoreSize_ = newBytes_ +
         std::max<int64_t>(memory::AllocationTraits::pageBytes(cachedPages_),
                           1UL << 28);
-    ssdCache_->groupStats().updateSsdFilter(ssdCache_->maxBytes() * 0.9);
+    ssdCache_->groupStats().updateSsdFilter(
+        ssdCache_->maxBytes() * 0.9, kSsdFilterDecayPct);
   }
 }
 
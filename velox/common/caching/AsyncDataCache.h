@@ -28,6 +28,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -194,6 +195,10 @@ class AsyncDataCacheEntry {
     return accessStats_.score(now, size_);
   }
 
+  const AccessStats& accessStats() const {
+    return accessStats_;
+  }
+
   bool isShared() const {
     return numPins_ > 0;
   }
@@ -245,6 +250,12 @@ class AsyncDataCacheEntry {
     return ssdSaveable_;
   }
 
+  /// Unmarks an entry that SsdCache declines to save, so that it is evicted
+  /// like entries that are not saveable.
+  void clearSsdSaveable() {
+    ssdSaveable_ = false;
+  }
+
   void setTrackingId(TrackingId id) {
     trackingId_ = id;
   }
@@ -550,14 +561,102 @@ struct CacheStats {
   std::string toString() const;
 };
 
+/// Ranks the entries of a CacheShard for eviction. The shard samples the
+/// scores of its entries to set an eviction threshold and evicts the unpinned
+/// entries scoring at or above it. Each shard has its own policy. The methods
+/// are called under the shard mutex.
+class CacheEvictionPolicy {
+ public:
+  virtual ~CacheEvictionPolicy() = default;
+
+  virtual std::string_view name() const = 0;
+
+  /// Records a hit on 'key' in findOrCreate(). Misses and exists() are not
+  /// recorded.
+  virtual void recordAccess(RawFileCacheKey /*key*/) {}
+
+  /// Returns the retention score of 'entry'. A higher number means less worth
+  /// retaining. 'now' is the current accessTime().
+  virtual int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const = 0;
+};
+
+/// The default policy. Ranks entries by time since last use over the number
+/// of uses since the entry was loaded, see AccessStats::score().
+class RecencyFrequencyEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  std::string_view name() const override {
+    return "RecencyFrequency";
+  }
+
+  int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const override {
+    return entry.score(now);
+  }
+};
+
+/// A scan resistant policy based on TinyLFU. Every hit is counted in a
+/// FrequencySketch, which remembers the recent frequency of keys also after
+/// their entries are evicted. Entries of keys seen fewer than
+/// 'admitFrequency' times are on probation: they rank behind all the admitted
+/// entries and are evicted first, oldest first. This keeps one-time data, e.g.
+/// of a large scan, from flushing entries that are hit repeatedly. The
+/// admitted entries are ranked by time since last use over their frequency.
+///
+/// The cache creates entries on a miss before the data is read, so unlike in
+/// TinyLFU, admission does not reject new entries but decides the order of
+/// eviction.
+class TinyLfuEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  static constexpr uint64_t kDefaultCapacity = 1 << 16;
+
+  /// 'capacity' is the expected number of entries in the shard.
+  explicit TinyLfuEvictionPolicy(
+      uint64_t capacity = kDefaultCapacity,
+      int32_t admitFrequency = 2)
+      : sketch_(capacity), admitFrequency_(admitFrequency) {}
+
+  std::string_view name() const override {
+    return "TinyLfu";
+  }
+
+  void recordAccess(RawFileCacheKey key) override {
+    sketch_.increment(std::hash<RawFileCacheKey>()(key));
+  }
+
+  int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const override;
+
+  const FrequencySketch& sketch() const {
+    return sketch_;
+  }
+
+ private:
+  // Score of a just used entry on probation. Larger than the score of any
+  // admitted entry.
+  static constexpr int32_t kProbationScore = 1 << 30;
+
+  FrequencySketch sketch_;
+  const int32_t admitFrequency_;
+};
+
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  /// Uses RecencyFrequencyEvictionPolicy if 'evictionPolicy' is nullptr.
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      std::unique_ptr<CacheEvictionPolicy> evictionPolicy = nullptr)
+      : cache_(cache),
+        maxWriteRatio_(maxWriteRatio),
+        evictionPolicy_(
+            evictionPolicy != nullptr
+                ? std::move(evictionPolicy)
+                : std::make_unique<RecencyFrequencyEvictionPolicy>()) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -626,6 +725,10 @@ class CacheShard {
     return allocClocks_;
   }
 
+  const CacheEvictionPolicy& evictionPolicy() const {
+    return *evictionPolicy_;
+  }
+
   std::vector<AsyncDataCacheEntry*> testingCacheEntries() const;
 
  private:
@@ -650,6 +753,7 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  const std::unique_ptr<CacheEvictionPolicy> evictionPolicy_;
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -722,6 +826,11 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// Creates the eviction policy of each cache shard. If not set, the shards
+    /// use RecencyFrequencyEvictionPolicy.
+    std::function<std::unique_ptr<CacheEvictionPolicy>()>
+        evictionPolicyFactory;
   };
 
   AsyncDataCache(
@@ -882,6 +991,9 @@ class AsyncDataCache : public memory::Cache {
  private:
   static constexpr int32_t kNumShards = 4; // Must be power of 2.
   static constexpr int32_t kShardMask = kNumShards - 1;
+  // Percentage by which the SSD admission stats are discounted each time half
+  // the cache is replaced.
+  static constexpr int32_t kSsdFilterDecayPct = 20;
 
   // True if 'acquired' has more pages than 'numPages' or allocator has space
   // for numPages - acquired pages of more allocation.
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::cache {
+
+FileGroupStats::FileGroupStats(double minReuse, uint64_t numRegions)
+    : minReuse_(minReuse),
+      // The sketch is not used if admission control is off.
+      regionLoads_(minReuse > 0 ? numRegions : 1) {
+  VELOX_CHECK_GE(minReuse_, 0);
+}
+
+void FileGroupStats::recordReference(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  columns_[{groupId, trackingId.id()}].tracking.incrementReference(bytes, 0);
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  columns_[{groupId, trackingId.id()}].tracking.incrementRead(bytes);
+}
+
+void FileGroupStats::recordFile(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    int32_t numStripes) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& group = groups_[groupId];
+  ++group.numFiles;
+  group.numStripes += numStripes;
+}
+
+bool FileGroupStats::shouldSaveToSsd(
+    uint64_t groupId,
+    TrackingId trackingId,
+    uint64_t fileId,
+    uint64_t offset) {
+  if (minReuse_ == 0) {
+    return true;
+  }
+  const auto regionHash = bits::hashMix(fileId, offset);
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto numPriorLoads = regionLoads_.frequency(regionHash);
+  regionLoads_.increment(regionHash);
+  const bool admit =
+      predictedReuseLocked(groupId, trackingId, numPriorLoads) >= minReuse_;
+  auto& column = columns_[{groupId, trackingId.id()}];
+  ++column.numLoads;
+  if (numPriorLoads > 0) {
+    ++column.numReloads;
+  }
+  if (admit) {
+    ++numAdmitted_;
+  } else {
+    ++numRejected_;
+  }
+  return admit;
+}
+
+double FileGroupStats::predictedReuse(
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t numPriorLoads) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return predictedReuseLocked(groupId, trackingId, numPriorLoads);
+}
+
+double FileGroupStats::predictedReuseLocked(
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t numPriorLoads) const {
+  if (numPriorLoads > 0) {
+    return numPriorLoads;
+  }
+  auto it = columns_.find(GroupColumn{groupId, trackingId.id()});
+  if (it == columns_.end()) {
+    return 0;
+  }
+  const auto& column = it->second;
+  // The fraction of the referenced bytes that were read weighs as
+  // 'kPriorLoads' loads, so that it dominates while there are few loads and
+  // fades as the loads accumulate.
+  double priorReloads = 0;
+  double priorLoads = 0;
+  if (column.tracking.referencedBytes > 0) {
+    const auto readFraction = std::min<double>(
+        1,
+        static_cast<double>(column.tracking.readBytes) /
+            column.tracking.referencedBytes);
+    priorLoads = kPriorLoads;
+    priorReloads = kPriorLoads * readFraction;
+  }
+  if (column.numLoads + priorLoads == 0) {
+    return 0;
+  }
+  return (column.numReloads + priorReloads) / (column.numLoads + priorLoads);
+}
+
+void FileGroupStats::updateSsdFilter(uint64_t /*ssdSize*/, int32_t decayPct) {
+  VELOX_CHECK_GE(decayPct, 0);
+  VELOX_CHECK_LE(decayPct, 100);
+  if (minReuse_ == 0 || decayPct == 0) {
+    return;
+  }
+  const double keep = (100 - decayPct) / 100.0;
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto it = columns_.begin(); it != columns_.end();) {
+    auto& column = it->second;
+    column.numLoads *= keep;
+    column.numReloads *= keep;
+    column.tracking.referencedBytes *= keep;
+    column.tracking.readBytes *= keep;
+    column.tracking.numReferences *= keep;
+    column.tracking.numReads *= keep;
+    if (column.numLoads < 1 && column.tracking.numReferences == 0 &&
+        column.tracking.numReads == 0) {
+      it = columns_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::string FileGroupStats::toString(uint64_t cacheBytes) {
+  if (minReuse_ == 0) {
+    return "<admission disabled>";
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  int64_t readBytes = 0;
+  double numLoads = 0;
+  double numReloads = 0;
+  for (const auto& [key, column] : columns_) {
+    readBytes += column.tracking.readBytes;
+    numLoads += column.numLoads;
+    numReloads += column.numReloads;
+  }
+  return fmt::format(
+      "min reuse {} admitted {} rejected {} columns {} groups {} "
+      "read {} ({:.1f}% of capacity) reloads {:.1f}%",
+      minReuse_,
+      numAdmitted_,
+      numRejected_,
+      columns_.size(),
+      groups_.size(),
+      succinctBytes(readBytes),
+      cacheBytes == 0 ? 0.0 : 100.0 * readBytes / cacheBytes,
+      numLoads == 0 ? 0.0 : 100.0 * numReloads / numLoads);
+}
+
+} // namespace facebook::velox::cache
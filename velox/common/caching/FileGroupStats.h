@@ -16,48 +16,125 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+/// Admission control of SsdCache. Decides which data loaded from storage into
+/// AsyncDataCache is worth saving to SSD. The loads of each region, i.e. cache
+/// entry, are counted in a FrequencySketch. The loads and the ScanTracker
+/// references and reads are also counted for each column, i.e. TrackingId, of
+/// each file group. The predicted reuse of a region is the number of times it
+/// was loaded before. For a region loaded for the first time, this is the
+/// fraction of loads of the same group and column that reloaded a region, i.e.
+/// the chance that the region will be loaded again. The fraction of the
+/// referenced bytes of the column that were read stands in for this while the
+/// column has few loads: a column that is read whenever it is referenced is
+/// likely to be read again, one whose references are mostly skipped is not. A
+/// region qualifies for SSD if its predicted reuse is at least 'minReuse'. All
+/// data qualifies if 'minReuse' is 0, in which case nothing is tracked. Thread
+/// safe.
 class FileGroupStats {
  public:
-  // Records ScanTracker::recordReference at group level
+  /// Default number of distinct regions whose loads are counted.
+  static constexpr uint64_t kDefaultNumRegions = 1 << 20;
+
+  /// 'numRegions' is the expected number of distinct regions loaded over the
+  /// lifetime of SSD cache contents, e.g. the SSD capacity divided by the
+  /// average entry size.
+  explicit FileGroupStats(
+      double minReuse = 0,
+      uint64_t numRegions = kDefaultNumRegions);
+
+  /// Records ScanTracker::recordReference at group level.
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
-  // Records ScanTracker::recordRead at group level
+  /// Records ScanTracker::recordRead at group level.
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
-
-  // Records the existence of a distinct file inside 'groupId'
-  void recordFile(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      int32_t /*numStripes*/) {}
-
-  // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
-  }
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
+
+  /// Records the existence of a distinct file inside 'groupId'.
+  void recordFile(uint64_t fileId, uint64_t groupId, int32_t numStripes);
 
-  // Updates the SSD selection criteria. 'ssdsize' is the capacity,
-  // 'decayPct' gives by how much old accesses are discounted.
-  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
+  /// Records a load from storage of the region at 'offset' in 'fileId' and
+  /// returns true if the region qualifies to be saved to SSD. 'groupId' and
+  /// 'trackingId' identify the group and column of the region.
+  bool shouldSaveToSsd(
+      uint64_t groupId,
+      TrackingId trackingId,
+      uint64_t fileId,
+      uint64_t offset);
 
-  // Recalculates the best groups and makes a human readable
-  // summary. 'cacheBytes' is used to compute what fraction of the tracked
-  // working set can be cached in 'cacheBytes'.
-  std::string toString(uint64_t /*cacheBytes*/) {
-    return "<dummy FileGroupStats>";
+  /// Returns the predicted reuse of a region of 'trackingId' in 'groupId' that
+  /// was loaded 'numPriorLoads' times before.
+  double predictedReuse(
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t numPriorLoads) const;
+
+  /// Updates the SSD selection criteria. 'ssdSize' is the capacity, 'decayPct'
+  /// gives by how much old accesses are discounted. Columns whose counts decay
+  /// to nothing are forgotten.
+  void updateSsdFilter(uint64_t ssdSize, int32_t decayPct = 0);
+
+  double minReuse() const {
+    return minReuse_;
   }
+
+  /// Makes a human readable summary. 'cacheBytes' is the SSD capacity, used to
+  /// relate the bytes read in the tracked groups to the capacity.
+  std::string toString(uint64_t cacheBytes);
+
+ private:
+  // Key of a column of a file group.
+  using GroupColumn = std::pair<uint64_t, int32_t>;
+
+  struct ColumnStats {
+    // References and reads reported by ScanTrackers.
+    TrackingData tracking;
+    // Number of loads from storage.
+    double numLoads{0};
+    // Number of loads from storage of regions that were loaded before.
+    double numReloads{0};
+  };
+
+  struct GroupStats {
+    int32_t numFiles{0};
+    int64_t numStripes{0};
+  };
+
+  // Number of loads the read to reference ratio of a column counts for in its
+  // predicted reuse.
+  static constexpr double kPriorLoads = 10;
+
+  double predictedReuseLocked(
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t numPriorLoads) const;
+
+  const double minReuse_;
+
+  mutable std::mutex mutex_;
+
+  FrequencySketch regionLoads_;
+
+  folly::F14FastMap<GroupColumn, ColumnStats> columns_;
+
+  folly::F14FastMap<uint64_t, GroupStats> groups_;
+
+  // Number of loads that were admitted and rejected.
+  uint64_t numAdmitted_{0};
+  uint64_t numRejected_{0};
 };
 
 } // namespace facebook::velox::cache
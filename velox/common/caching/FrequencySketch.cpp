@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+namespace {
+constexpr int32_t kCountersPerWord = 16;
+constexpr uint64_t kSeeds[] = {
+    0x97cb3127c4b9b8e1ULL,
+    0xc2b2ae3d27d4eb4fULL,
+    0x165667b19e3779f9ULL,
+    0x9e3779b97f4a7c15ULL};
+// Clears the high bit of each 4 bit counter after a right shift by 1.
+constexpr uint64_t kResetMask = 0x7777777777777777ULL;
+} // namespace
+
+FrequencySketch::FrequencySketch(uint64_t capacity)
+    : table_(
+          std::max<uint64_t>(
+              bits::nextPowerOfTwo(std::max<uint64_t>(capacity, 1)) * kNumRows,
+              kCountersPerWord) /
+          kCountersPerWord),
+      counterMask_(table_.size() * kCountersPerWord - 1),
+      sampleSize_(10 * std::max<uint64_t>(capacity, 1)) {}
+
+uint64_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  return bits::hashMix(hash, kSeeds[row]) & counterMask_;
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool added = false;
+  for (auto row = 0; row < kNumRows; ++row) {
+    const auto index = counterIndex(hash, row);
+    auto& word = table_[index / kCountersPerWord];
+    const auto shift = (index % kCountersPerWord) * 4;
+    if (((word >> shift) & 0xf) < kMaxFrequency) {
+      word += 1ULL << shift;
+      added = true;
+    }
+  }
+  if (added && ++size_ >= sampleSize_) {
+    reset();
+  }
+}
+
+int32_t FrequencySketch::frequency(uint64_t hash) const {
+  int32_t frequency = kMaxFrequency;
+  for (auto row = 0; row < kNumRows; ++row) {
+    const auto index = counterIndex(hash, row);
+    const auto word = table_[index / kCountersPerWord];
+    frequency = std::min<int32_t>(
+        frequency, (word >> ((index % kCountersPerWord) * 4)) & 0xf);
+  }
+  return frequency;
+}
+
+void FrequencySketch::reset() {
+  for (auto& word : table_) {
+    word = (word >> 1) & kResetMask;
+  }
+  size_ /= 2;
+  ++numResets_;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate count of recent accesses to keys given by their hash. This is a
+/// count-min sketch with 4 rows of 4 bit counters packed 16 to a word. An
+/// access increments the counter of the key in each row and the estimate is
+/// the minimum of the 4 counters. After 10x 'capacity' increments, all the
+/// counters are halved, so that the estimates reflect recent history and keys
+/// that stop being accessed lose their frequency. Used as the admission filter
+/// of TinyLfuEvictionPolicy. Not thread safe.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxFrequency = 15;
+
+  /// 'capacity' is the expected number of distinct keys to track.
+  explicit FrequencySketch(uint64_t capacity);
+
+  /// Records an access to the key with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with 'hash',
+  /// at most kMaxFrequency.
+  int32_t frequency(uint64_t hash) const;
+
+  /// Returns the number of times the counters have been halved.
+  uint64_t numResets() const {
+    return numResets_;
+  }
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+
+  // Returns the index of the counter of 'hash' in 'row'. The counter is the
+  // 4 bits of word 'index / 16' at bit 4 * (index % 16).
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  // Halves all counters.
+  void reset();
+
+  std::vector<uint64_t> table_;
+
+  // Number of counters in 'table_' - 1. The number of counters is a power of
+  // 2.
+  const uint64_t counterMask_;
+
+  // Number of increments after which the counters are halved.
+  const uint64_t sampleSize_;
+
+  // Number of increments since the last reset.
+  uint64_t size_{0};
+
+  uint64_t numResets_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -32,8 +32,12 @@ namespace facebook::velox::cache {
 SsdCache::SsdCache(const Config& config)
     : filePrefix_(config.filePrefix),
       numShards_(config.numShards),
-      groupStats_(std::make_unique<FileGroupStats>()),
-      executor_(config.executor) {
+      groupStats_(std::make_unique<FileGroupStats>(
+          config.minSsdReuse,
+          std::max<uint64_t>(
+              FileGroupStats::kDefaultNumRegions, config.maxBytes >> 16))),
+      executor_(config.executor),
+      maxWriteBytesPerSec_(config.maxWriteBytesPerSec) {
   // Make sure the given path of Ssd files has the prefix for local file system.
   // Local file system would be derived based on the prefix.
   VELOX_CHECK(
@@ -90,11 +94,55 @@ bool SsdCache::startWrite() {
   return false;
 }
 
+bool SsdCache::shouldSaveToSsd(
+    uint64_t groupId,
+    TrackingId trackingId,
+    uint64_t fileId,
+    uint64_t offset) {
+  if (groupStats_->shouldSaveToSsd(groupId, trackingId, fileId, offset)) {
+    return true;
+  }
+  ++numAdmissionRejected_;
+  return false;
+}
+
+void SsdCache::applyWriteBudget(std::vector<CachePin>& pins) {
+  const auto nowUs = getCurrentTimeMicro();
+  // Allows a burst of at most one second worth of writes. The budget may go
+  // into debt by the size of the last admitted entry, so that entries larger
+  // than one second worth of writes are admitted and only slow down the
+  // writes that follow.
+  writeBudget_ = std::min<double>(
+      maxWriteBytesPerSec_,
+      writeBudget_ +
+          static_cast<double>(nowUs - writeBudgetUpdateUs_) *
+              maxWriteBytesPerSec_ / 1'000'000);
+  writeBudgetUpdateUs_ = nowUs;
+
+  std::vector<CachePin> kept;
+  kept.reserve(pins.size());
+  for (auto& pin : pins) {
+    auto* entry = pin.checkedEntry();
+    if (writeBudget_ > 0) {
+      writeBudget_ -= entry->size();
+      kept.push_back(std::move(pin));
+      continue;
+    }
+    entry->clearSsdSaveable();
+    ++numWriteThrottled_;
+  }
+  pins = std::move(kept);
+}
+
 void SsdCache::write(std::vector<CachePin> pins) {
   VELOX_CHECK_EQ(numShards_, writesInProgress_);
 
   TestValue::adjust("facebook::velox::cache::SsdCache::write", this);
 
+  if (maxWriteBytesPerSec_ > 0) {
+    applyWriteBudget(pins);
+  }
+
   const auto startTimeUs = getCurrentTimeMicro();
 
   uint64_t bytes = 0;
@@ -182,6 +230,8 @@ SsdCacheStats SsdCache::stats() const {
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.entriesAdmissionRejected = numAdmissionRejected_;
+  stats.entriesWriteThrottled = numWriteThrottled_;
   return stats;
 }
 
@@ -193,6 +243,10 @@ std::string SsdCache::toString() const {
       << succinctBytes(data.bytesRead) << " Size " << succinctBytes(capacity)
       << " Occupied " << succinctBytes(data.bytesCached);
   out << " " << (data.entriesCached >> 10) << "K entries.";
+  if (data.entriesAdmissionRejected > 0 || data.entriesWriteThrottled > 0) {
+    out << " Rejected " << data.entriesAdmissionRejected << " throttled "
+        << data.entriesWriteThrottled << " entries.";
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
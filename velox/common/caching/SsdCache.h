@@ -37,7 +37,9 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        double _minSsdReuse = 0,
+        uint64_t _maxWriteBytesPerSec = 0)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -45,6 +47,8 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
+          minSsdReuse(_minSsdReuse),
+          maxWriteBytesPerSec(_maxWriteBytesPerSec),
           executor(_executor){};
 
     std::string filePrefix;
@@ -64,18 +68,29 @@ class SsdCache {
     /// If true, checksum read verification from SSD is enabled.
     bool checksumReadVerificationEnabled;
 
+    /// Minimum predicted reuse of data loaded from storage for the data to be
+    /// saved to SSD. See FileGroupStats. 0 means all data is saved.
+    double minSsdReuse{0};
+
+    /// Maximum number of bytes written to SSD per second. Data over the budget
+    /// is not saved. 0 means no limit.
+    uint64_t maxWriteBytesPerSec{0};
+
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, min reuse {}, write budget {}/s",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          minSsdReuse,
+          (maxWriteBytesPerSec == 0 ? "UNLIMITED"
+                                    : succinctBytes(maxWriteBytesPerSec)));
     }
   };
 
@@ -92,6 +107,9 @@ class SsdCache {
   /// write) feature if the underlying filesystem (such as brtfs) supports it.
   /// This prevents the actual cache space usage on disk from exceeding the
   /// 'maxBytes' limit and stop working.
+  /// If 'minSsdReuse' is non-zero, only data with at least this predicted reuse
+  /// is saved. If 'maxWriteBytesPerSec' is non-zero, at most this many bytes
+  /// per second are written on average.
   SsdCache(const Config& config);
 
   /// Returns the shard corresponding to 'fileId'. 'fileId' is a file id from
@@ -143,6 +161,15 @@ class SsdCache {
     return *groupStats_;
   }
 
+  /// Returns true if an entry of 'groupId' and 'trackingId' at 'offset' in
+  /// 'fileId' that was just loaded from storage should be saved to SSD.
+  /// Counts the rejected entries in stats().
+  bool shouldSaveToSsd(
+      uint64_t groupId,
+      TrackingId trackingId,
+      uint64_t fileId,
+      uint64_t offset);
+
   /// Stops writing to the cache files and waits for pending writes to finish.
   /// If checkpointing is on, makes a checkpoint.
   void shutdown();
@@ -179,13 +206,28 @@ class SsdCache {
         !shutdown_, "Unexpected write after SSD cache has been shutdown");
   }
 
+  // Removes the entries of 'pins' that do not fit in the write budget. The
+  // removed entries are no longer marked as SSD saveable.
+  void applyWriteBudget(std::vector<CachePin>& pins);
+
   const std::string filePrefix_;
   const int32_t numShards_;
   // Stats for selecting entries to save from AsyncDataCache.
   const std::unique_ptr<FileGroupStats> groupStats_;
   folly::Executor* const executor_;
+  const uint64_t maxWriteBytesPerSec_;
   mutable std::mutex mutex_;
 
+  // Bytes that can be written without exceeding 'maxWriteBytesPerSec_' and
+  // the time in microseconds they were last topped up. Negative after an
+  // entry larger than the remaining budget is admitted. Accessed by write()
+  // only, of which there is one at a time.
+  double writeBudget_{0};
+  uint64_t writeBudgetUpdateUs_{0};
+
+  std::atomic_uint64_t numAdmissionRejected_{0};
+  std::atomic_uint64_t numWriteThrottled_{0};
+
   std::vector<std::unique_ptr<SsdFile>> files_;
 
   // Count of shards with unfinished writes.
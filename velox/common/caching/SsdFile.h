@@ -166,6 +166,8 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    entriesAdmissionRejected = tsanAtomicValue(other.entriesAdmissionRejected);
+    entriesWriteThrottled = tsanAtomicValue(other.entriesWriteThrottled);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -197,6 +199,10 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.entriesAdmissionRejected =
+        entriesAdmissionRejected - other.entriesAdmissionRejected;
+    result.entriesWriteThrottled =
+        entriesWriteThrottled - other.entriesWriteThrottled;
     return result;
   }
 
@@ -233,6 +239,13 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+
+  /// Entries not saved to SSD because their predicted reuse is below the
+  /// admission threshold of SsdCache.
+  tsan_atomic<uint64_t> entriesAdmissionRejected{0};
+  /// Entries not saved to SSD because the write budget of SsdCache is
+  /// exhausted.
+  tsan_atomic<uint64_t> entriesWriteThrottled{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Replays an access trace against AsyncDataCache with each eviction policy
+// and prints the hit rates. The trace mixes repeated accesses to a hot set of
+// entries, e.g. footers and dimension tables read by dashboards, with ad hoc
+// scans that read each of their entries once.
+
+#include <iostream>
+#include <random>
+
+#include <fmt/format.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_int64(cache_bytes, 256 << 20, "Memory cache size in bytes.");
+
+DEFINE_int32(entry_bytes, 64 << 10, "Size of each cache entry in bytes.");
+
+DEFINE_int32(num_hot_entries, 1'000, "Number of entries accessed repeatedly.");
+
+DEFINE_int32(
+    hot_accesses_per_round,
+    20'000,
+    "Number of accesses to random hot entries per round.");
+
+DEFINE_int32(
+    scan_entries_per_round,
+    8'000,
+    "Number of entries read once per round by a scan.");
+
+DEFINE_int32(num_rounds, 10, "Number of rounds in the trace.");
+
+DEFINE_int32(seed, 1, "Seed of the random trace.");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+struct Access {
+  uint64_t offset;
+  bool hot;
+};
+
+struct ReplayResult {
+  int64_t hotAccesses{0};
+  int64_t hotHits{0};
+  int64_t scanAccesses{0};
+  int64_t scanHits{0};
+};
+
+// Interleaves the hot accesses and the scan of each round at random.
+std::vector<Access> makeTrace() {
+  std::mt19937 rng(FLAGS_seed);
+  std::vector<Access> trace;
+  uint64_t nextScanEntry = FLAGS_num_hot_entries;
+  for (auto round = 0; round < FLAGS_num_rounds; ++round) {
+    int32_t numHot = FLAGS_hot_accesses_per_round;
+    int32_t numScan = FLAGS_scan_entries_per_round;
+    while (numHot + numScan > 0) {
+      if (std::uniform_int_distribution<int32_t>(1, numHot + numScan)(rng) <=
+          numHot) {
+        const auto entry = std::uniform_int_distribution<int32_t>(
+            0, FLAGS_num_hot_entries - 1)(rng);
+        trace.push_back({uint64_t(entry) * FLAGS_entry_bytes, true});
+        --numHot;
+      } else {
+        trace.push_back({nextScanEntry++ * FLAGS_entry_bytes, false});
+        --numScan;
+      }
+    }
+  }
+  return trace;
+}
+
+ReplayResult replay(
+    const std::vector<Access>& trace,
+    uint64_t fileNum,
+    const AsyncDataCache::Options& cacheOptions) {
+  memory::MemoryManagerOptions options;
+  options.useMmapAllocator = true;
+  options.allocatorCapacity = FLAGS_cache_bytes;
+  options.arbitratorCapacity = FLAGS_cache_bytes;
+  options.arbitratorReservedCapacity = 0;
+  memory::MemoryManager manager(options);
+  auto cache =
+      AsyncDataCache::create(manager.allocator(), nullptr, cacheOptions);
+
+  ReplayResult result;
+  for (const auto& access : trace) {
+    folly::SemiFuture<bool> wait(false);
+    auto pin = cache->findOrCreate(
+        RawFileCacheKey{fileNum, access.offset}, FLAGS_entry_bytes, &wait);
+    VELOX_CHECK(!pin.empty());
+    const bool hit = !pin.checkedEntry()->isExclusive();
+    if (!hit) {
+      pin.checkedEntry()->setExclusiveToShared(false);
+    }
+    if (access.hot) {
+      ++result.hotAccesses;
+      result.hotHits += hit;
+    } else {
+      ++result.scanAccesses;
+      result.scanHits += hit;
+    }
+  }
+  cache->shutdown();
+  return result;
+}
+
+double percent(int64_t count, int64_t total) {
+  return total == 0 ? 0 : 100.0 * count / total;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+
+  const auto trace = makeTrace();
+  StringIdLease file(fileIds(), "replay_file");
+
+  std::vector<std::pair<std::string, AsyncDataCache::Options>> policies(2);
+  policies[0].first = "RecencyFrequency";
+  policies[1].first = "TinyLfu";
+  policies[1].second.evictionPolicyFactory = []() {
+    return std::make_unique<TinyLfuEvictionPolicy>();
+  };
+
+  std::cout << fmt::format(
+                   "{:<20}{:>12}{:>12}{:>12}",
+                   "Policy",
+                   "Hot hit %",
+                   "Scan hit %",
+                   "Total hit %")
+            << std::endl;
+  for (const auto& [name, options] : policies) {
+    const auto result = replay(trace, file.id(), options);
+    std::cout << fmt::format(
+                     "{:<20}{:>12.2f}{:>12.2f}{:>12.2f}",
+                     name,
+                     percent(result.hotHits, result.hotAccesses),
+                     percent(result.scanHits, result.scanAccesses),
+                     percent(
+                         result.hotHits + result.scanHits,
+                         result.hotAccesses + result.scanAccesses))
+              << std::endl;
+  }
+  return 0;
+}
@@ -115,7 +115,9 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
       int64_t ssdBytes = 0,
       uint64_t checkpointIntervalBytes = 0,
       bool eraseCheckpoint = false,
-      AsyncDataCache::Options cacheOptions = {}) {
+      AsyncDataCache::Options cacheOptions = {},
+      double minSsdReuse = 0,
+      uint64_t maxSsdWriteBytesPerSec = 0) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -139,7 +141,9 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
           checkpointIntervalBytes > 0 ? checkpointIntervalBytes : ssdBytes / 20,
           false,
           GetParam().checksumEnabled,
-          GetParam().checksumVerificationEnabled);
+          GetParam().checksumVerificationEnabled,
+          minSsdReuse,
+          maxSsdWriteBytesPerSec);
       ssdCache = std::make_unique<SsdCache>(config);
     }
 
@@ -163,6 +167,22 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
     ASSERT_EQ(MemoryAllocator::kindString(cache_->allocator()->kind()), "MMAP");
   }
 
+  // Loads 'numEntries' entries of 'entryBytes' each from the start of the
+  // first file.
+  void loadEntries(int32_t numEntries, int32_t entryBytes) {
+    for (auto i = 0; i < numEntries; ++i) {
+      Request request(static_cast<uint64_t>(i) * entryBytes, entryBytes);
+      loadOne(filenames_[0].id(), request, false);
+    }
+  }
+
+  // Writes all SSD saveable entries to SSD and waits for the write to finish.
+  void saveAllToSsd() {
+    ASSERT_TRUE(cache_->ssdCache()->startWrite());
+    cache_->saveToSsd(/*saveAll=*/true);
+    cache_->ssdCache()->waitForWriteToFinish();
+  }
+
   // Finds one entry from RAM, SSD or storage. Throws if the data
   // cannot be read or 'injectError' is true. Checks the data with
   // verifyHook and discards the pin.
@@ -976,7 +996,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "[size 256: 0(0MB) allocated 0 mapped]\n"
       "]\n"
       "SSD: Ssd cache IO: Write 0B read 0B Size 512.00MB Occupied 0B 0K entries.\n"
-      "GroupStats: <dummy FileGroupStats>";
+      "GroupStats: <admission disabled>";
   ASSERT_EQ(cache_->toString(), expectedDetailedCacheOutput);
   ASSERT_EQ(cache_->toString(true), expectedDetailedCacheOutput);
   const std::string expectedShortCacheOutput =
@@ -1414,6 +1434,57 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, tinyLfuEviction) {
+  constexpr uint64_t kRamBytes = 32UL << 20;
+  constexpr int32_t kDataSize = 64 << 10;
+  constexpr int32_t kNumHotEntries = 32;
+  AsyncDataCache::Options options;
+  options.evictionPolicyFactory = []() {
+    return std::make_unique<TinyLfuEvictionPolicy>();
+  };
+  initializeCache(kRamBytes, 0, 0, false, options);
+
+  // The hot entries are hit repeatedly. The probed entries are only checked
+  // with exists(), which does not count as an access.
+  auto hotKey = [&](int32_t i) {
+    return RawFileCacheKey{filenames_[0].id(), uint64_t(i) * kDataSize};
+  };
+  auto probedKey = [&](int32_t i) {
+    return RawFileCacheKey{
+        filenames_[0].id(), uint64_t(kNumHotEntries + i) * kDataSize};
+  };
+  for (auto i = 0; i < kNumHotEntries; ++i) {
+    for (const auto& key : {hotKey(i), probedKey(i)}) {
+      auto pin = newEntry(key.offset, kDataSize);
+      ASSERT_FALSE(pin.empty());
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  }
+  for (auto round = 0; round < 4; ++round) {
+    for (auto i = 0; i < kNumHotEntries; ++i) {
+      auto pin = cache_->findOrCreate(hotKey(i), kDataSize);
+      ASSERT_FALSE(pin.empty());
+      ASSERT_TRUE(pin.checkedEntry()->isShared());
+      ASSERT_TRUE(cache_->exists(probedKey(i)));
+    }
+  }
+
+  // Scans 4x the cache capacity once. The new entries are on probation and are
+  // evicted before the hot entries. So are the probed entries.
+  for (uint64_t offset = 2 * kNumHotEntries * kDataSize;
+       offset < 2 * kNumHotEntries * kDataSize + 4 * kRamBytes;
+       offset += kDataSize) {
+    auto pin = newEntry(offset, kDataSize);
+    ASSERT_FALSE(pin.empty());
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  ASSERT_GT(cache_->refreshStats().numEvict, 0);
+  for (auto i = 0; i < kNumHotEntries; ++i) {
+    ASSERT_TRUE(cache_->exists(hotKey(i))) << i;
+    ASSERT_FALSE(cache_->exists(probedKey(i))) << i;
+  }
+}
+
 TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
@@ -1540,6 +1611,99 @@ TEST_P(AsyncDataCacheTest, checkpoint) {
   ASSERT_EQ(stats.ssdStats->checkpointsWritten, kNumSsdShards);
 }
 
+TEST_P(AsyncDataCacheTest, ssdAdmission) {
+  constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
+  constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
+  constexpr int32_t kNumEntries = 16;
+  constexpr int32_t kEntryBytes = 64 << 10;
+
+  // Entries are written to SSD only by saveAllToSsd(). Only entries that were
+  // loaded at least once before qualify.
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      /*checkpointIntervalBytes=*/1ULL << 30,
+      /*eraseCheckpoint=*/true,
+      {0.0, 10000.0, 1 << 30},
+      /*minSsdReuse=*/1);
+  loadEntries(kNumEntries, kEntryBytes);
+  saveAllToSsd();
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, 0);
+  ASSERT_EQ(stats.ssdStats->entriesAdmissionRejected, kNumEntries);
+
+  // The entries are loaded again after being evicted from memory.
+  cache_->clear();
+  loadEntries(kNumEntries, kEntryBytes);
+  saveAllToSsd();
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, kNumEntries);
+  ASSERT_EQ(stats.ssdStats->entriesAdmissionRejected, kNumEntries);
+  ASSERT_EQ(stats.ssdStats->entriesWriteThrottled, 0);
+}
+
+TEST_P(AsyncDataCacheTest, ssdWriteBudget) {
+  constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
+  constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
+  constexpr int32_t kNumEntries = 16;
+  constexpr int32_t kEntryBytes = 64 << 10;
+  constexpr int32_t kBudgetEntries = 4;
+
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      /*checkpointIntervalBytes=*/1ULL << 30,
+      /*eraseCheckpoint=*/true,
+      {0.0, 10000.0, 1 << 30},
+      /*minSsdReuse=*/0,
+      /*maxSsdWriteBytesPerSec=*/kBudgetEntries * kEntryBytes);
+  loadEntries(kNumEntries, kEntryBytes);
+  saveAllToSsd();
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, kBudgetEntries);
+  ASSERT_EQ(
+      stats.ssdStats->entriesWriteThrottled, kNumEntries - kBudgetEntries);
+  ASSERT_EQ(stats.ssdStats->entriesAdmissionRejected, 0);
+
+  // The throttled entries are no longer saveable.
+  saveAllToSsd();
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, kBudgetEntries);
+  ASSERT_EQ(
+      stats.ssdStats->entriesWriteThrottled, kNumEntries - kBudgetEntries);
+}
+
+TEST_P(AsyncDataCacheTest, ssdWriteBudgetLargeEntry) {
+  constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
+  constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
+  constexpr int32_t kNumEntries = 4;
+  constexpr int32_t kEntryBytes = 64 << 10;
+
+  // Each entry is larger than one second worth of writes. The first one is
+  // admitted and puts the budget into debt, which throttles the others.
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      /*checkpointIntervalBytes=*/1ULL << 30,
+      /*eraseCheckpoint=*/true,
+      {0.0, 10000.0, 1 << 30},
+      /*minSsdReuse=*/0,
+      /*maxSsdWriteBytesPerSec=*/kEntryBytes / 2);
+  loadEntries(kNumEntries, kEntryBytes);
+  saveAllToSsd();
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, 1);
+  ASSERT_EQ(stats.ssdStats->entriesWriteThrottled, kNumEntries - 1);
+
+  // Large entries are admitted again once the debt is paid off.
+  std::this_thread::sleep_for(std::chrono::seconds(2)); // NOLINT
+  cache_->clear();
+  loadEntries(kNumEntries, kEntryBytes);
+  saveAllToSsd();
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, 2);
+}
+
 // TODO: add concurrent fuzzer test.
 
 INSTANTIATE_TEST_SUITE_P(
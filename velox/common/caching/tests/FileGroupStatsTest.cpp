@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+namespace {
+constexpr uint64_t kFileId = 11;
+constexpr uint64_t kGroupId = 22;
+constexpr int32_t kEntryBytes = 64 << 10;
+} // namespace
+
+TEST(FileGroupStatsTest, disabled) {
+  FileGroupStats stats;
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_TRUE(
+        stats.shouldSaveToSsd(kGroupId, TrackingId(1), kFileId, kEntryBytes));
+  }
+  EXPECT_EQ("<admission disabled>", stats.toString(1 << 30));
+}
+
+TEST(FileGroupStatsTest, reloadedRegion) {
+  FileGroupStats stats(/*minReuse=*/1, /*numRegions=*/1024);
+  const TrackingId column(1);
+  // A region qualifies when loaded for the second time.
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_FALSE(
+        stats.shouldSaveToSsd(kGroupId, column, kFileId, i * kEntryBytes));
+  }
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_TRUE(
+        stats.shouldSaveToSsd(kGroupId, column, kFileId, i * kEntryBytes));
+  }
+  EXPECT_EQ(1, stats.predictedReuse(kGroupId, column, 1));
+  EXPECT_DOUBLE_EQ(0.5, stats.predictedReuse(kGroupId, column, 0));
+}
+
+TEST(FileGroupStatsTest, columnReuse) {
+  FileGroupStats stats(/*minReuse=*/0.5, /*numRegions=*/1024);
+  const TrackingId hotColumn(1);
+  const TrackingId scanColumn(2);
+  // The regions of 'hotColumn' are loaded 4 times, those of 'scanColumn' once.
+  for (auto round = 0; round < 4; ++round) {
+    for (auto i = 0; i < 10; ++i) {
+      stats.shouldSaveToSsd(kGroupId, hotColumn, kFileId, i * kEntryBytes);
+      stats.shouldSaveToSsd(
+          kGroupId, scanColumn, kFileId, (round * 10 + i + 100) * kEntryBytes);
+    }
+  }
+  EXPECT_DOUBLE_EQ(0.75, stats.predictedReuse(kGroupId, hotColumn, 0));
+  EXPECT_EQ(0, stats.predictedReuse(kGroupId, scanColumn, 0));
+
+  // A new region of 'hotColumn' qualifies on its first load, one of
+  // 'scanColumn' does not.
+  EXPECT_TRUE(
+      stats.shouldSaveToSsd(kGroupId, hotColumn, kFileId, 1'000 * kEntryBytes));
+  EXPECT_FALSE(stats.shouldSaveToSsd(
+      kGroupId, scanColumn, kFileId, 1'001 * kEntryBytes));
+  // A column of another group has no history.
+  EXPECT_FALSE(stats.shouldSaveToSsd(
+      kGroupId + 1, hotColumn, kFileId, 1'002 * kEntryBytes));
+}
+
+TEST(FileGroupStatsTest, readFraction) {
+  FileGroupStats stats(/*minReuse=*/0.5, /*numRegions=*/1024);
+  const TrackingId denseColumn(1);
+  const TrackingId sparseColumn(2);
+  // All the referenced bytes of 'denseColumn' are read, a quarter of those of
+  // 'sparseColumn'.
+  stats.recordReference(kFileId, kGroupId, denseColumn, 4 * kEntryBytes);
+  stats.recordRead(kFileId, kGroupId, denseColumn, 4 * kEntryBytes);
+  stats.recordReference(kFileId, kGroupId, sparseColumn, 4 * kEntryBytes);
+  stats.recordRead(kFileId, kGroupId, sparseColumn, kEntryBytes);
+  EXPECT_EQ(1, stats.predictedReuse(kGroupId, denseColumn, 0));
+  EXPECT_DOUBLE_EQ(0.25, stats.predictedReuse(kGroupId, sparseColumn, 0));
+  EXPECT_FALSE(stats.shouldSaveToSsd(
+      kGroupId, sparseColumn, kFileId, 100 * kEntryBytes));
+
+  // The read fraction weighs as 10 loads. The regions of 'denseColumn' qualify
+  // until the loads that are not reloads outweigh it.
+  for (auto i = 0; i < 11; ++i) {
+    EXPECT_TRUE(
+        stats.shouldSaveToSsd(kGroupId, denseColumn, kFileId, i * kEntryBytes));
+  }
+  EXPECT_DOUBLE_EQ(10.0 / 21, stats.predictedReuse(kGroupId, denseColumn, 0));
+  EXPECT_FALSE(
+      stats.shouldSaveToSsd(kGroupId, denseColumn, kFileId, 11 * kEntryBytes));
+}
+
+TEST(FileGroupStatsTest, decay) {
+  FileGroupStats stats(/*minReuse=*/0.5, /*numRegions=*/1024);
+  const TrackingId column(1);
+  stats.recordReference(kFileId, kGroupId, column, kEntryBytes);
+  stats.recordRead(kFileId, kGroupId, column, kEntryBytes);
+  for (auto round = 0; round < 2; ++round) {
+    for (auto i = 0; i < 10; ++i) {
+      stats.shouldSaveToSsd(kGroupId, column, kFileId, i * kEntryBytes);
+    }
+  }
+  // 10 reloads of 20 loads and the fully read reference, which counts as 10
+  // loads.
+  EXPECT_DOUBLE_EQ(20.0 / 30, stats.predictedReuse(kGroupId, column, 0));
+  EXPECT_NE(
+      std::string::npos,
+      stats.toString(1 << 30).find("admitted 20 rejected 0"));
+
+  // Decaying keeps the ratio of reloads to loads and of reads to references,
+  // which then weighs more.
+  stats.updateSsdFilter(1 << 30, 50);
+  EXPECT_DOUBLE_EQ(15.0 / 20, stats.predictedReuse(kGroupId, column, 0));
+
+  // A column is forgotten after its counts decay to nothing.
+  stats.updateSsdFilter(1 << 30, 100);
+  EXPECT_EQ(0, stats.predictedReuse(kGroupId, column, 0));
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1024);
+  constexpr uint64_t kKey = 1234;
+  EXPECT_EQ(0, sketch.frequency(kKey));
+  for (auto i = 1; i <= 5; ++i) {
+    sketch.increment(kKey);
+    EXPECT_EQ(i, sketch.frequency(kKey));
+  }
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(kKey);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxFrequency, sketch.frequency(kKey));
+}
+
+TEST(FrequencySketchTest, oneHitKeys) {
+  FrequencySketch sketch(1024);
+  for (uint64_t key = 0; key < 100; ++key) {
+    sketch.increment(key);
+  }
+  for (uint64_t key = 0; key < 100; ++key) {
+    EXPECT_EQ(1, sketch.frequency(key));
+  }
+  // Keys not seen have no frequency but for rare collisions in all rows.
+  int32_t numFalsePositives = 0;
+  for (uint64_t key = 100; key < 1'100; ++key) {
+    if (sketch.frequency(key) > 0) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LE(numFalsePositives, 5);
+}
+
+TEST(FrequencySketchTest, reset) {
+  constexpr uint64_t kCapacity = 1024;
+  constexpr uint64_t kHotKey = ~0ULL;
+  FrequencySketch sketch(kCapacity);
+  for (auto i = 0; i < FrequencySketch::kMaxFrequency; ++i) {
+    sketch.increment(kHotKey);
+  }
+  // Counters are halved after 10x capacity increments. The increments of keys
+  // whose counters are all saturated do not count.
+  uint64_t key = 0;
+  while (sketch.numResets() == 0) {
+    ASSERT_LT(key, 20 * kCapacity);
+    sketch.increment(key++);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxFrequency / 2, sketch.frequency(kHotKey));
+
+  // The hot key recovers its frequency when accessed again.
+  for (auto i = 0; i < FrequencySketch::kMaxFrequency; ++i) {
+    sketch.increment(kHotKey);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxFrequency, sketch.frequency(kHotKey));
+}
@@ -18,6 +18,9 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringReadFile.h"
+#endif
 
 #include <cstdio>
 #include <filesystem>
@@ -79,8 +82,18 @@ folly::once_flag localFSInstantiationFlag;
 // Implement Local FileSystem.
 class LocalFileSystem : public FileSystem {
  public:
-  explicit LocalFileSystem(std::shared_ptr<const config::ConfigBase> config)
-      : FileSystem(config) {}
+  LocalFileSystem(
+      std::shared_ptr<const config::ConfigBase> config,
+      const LocalFileSystemOptions& options)
+      : FileSystem(config), options_(options) {
+#ifndef VELOX_ENABLE_IO_URING
+    VELOX_CHECK(
+        !options_.useIoUring, "Velox is built without VELOX_ENABLE_IO_URING");
+#endif
+    VELOX_CHECK(
+        !options_.directIo || options_.useIoUring,
+        "Direct IO on the local file system requires io_uring");
+  }
 
   ~LocalFileSystem() override {}
 
@@ -98,6 +111,13 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
       const FileOptions& /*unused*/) override {
+#ifdef VELOX_ENABLE_IO_URING
+    if (options_.useIoUring) {
+      IoUringReadFileOptions readOptions;
+      readOptions.directIo = options_.directIo;
+      return std::make_unique<IoUringReadFile>(extractPath(path), readOptions);
+    }
+#endif
     return std::make_unique<LocalReadFile>(extractPath(path));
   }
 
@@ -195,23 +215,28 @@ class LocalFileSystem : public FileSystem {
 
   static std::function<std::shared_ptr<
       FileSystem>(std::shared_ptr<const config::ConfigBase>, std::string_view)>
-  fileSystemGenerator() {
-    return [](std::shared_ptr<const config::ConfigBase> properties,
-              std::string_view filePath) {
+  fileSystemGenerator(const LocalFileSystemOptions& options) {
+    return [options](
+               std::shared_ptr<const config::ConfigBase> properties,
+               std::string_view filePath) {
       // One instance of Local FileSystem is sufficient.
       // Initialize on first access and reuse after that.
       static std::shared_ptr<FileSystem> lfs;
-      folly::call_once(localFSInstantiationFlag, [&properties]() {
-        lfs = std::make_shared<LocalFileSystem>(properties);
+      folly::call_once(localFSInstantiationFlag, [&properties, &options]() {
+        lfs = std::make_shared<LocalFileSystem>(properties, options);
       });
       return lfs;
     };
   }
+
+ private:
+  const LocalFileSystemOptions options_;
 };
 } // namespace
 
-void registerLocalFileSystem() {
+void registerLocalFileSystem(const LocalFileSystemOptions& options) {
   registerFileSystem(
-      LocalFileSystem::schemeMatcher(), LocalFileSystem::fileSystemGenerator());
+      LocalFileSystem::schemeMatcher(),
+      LocalFileSystem::fileSystemGenerator(options));
 }
 } // namespace facebook::velox::filesystems
@@ -125,7 +125,17 @@ void registerFileSystem(
         std::shared_ptr<const config::ConfigBase>,
         std::string_view)> fileSystemGenerator);
 
-/// Register the local filesystem.
-void registerLocalFileSystem();
+struct LocalFileSystemOptions {
+  /// Opens files for read as IoUringReadFile, which has a native
+  /// preadvAsync(). Requires building with VELOX_ENABLE_IO_URING.
+  bool useIoUring{false};
+
+  /// Reads with O_DIRECT. Only supported together with 'useIoUring'.
+  bool directIo{false};
+};
+
+/// Register the local filesystem. The options of the first registration are
+/// used for the process.
+void registerLocalFileSystem(const LocalFileSystemOptions& options = {});
 
 } // namespace facebook::velox::filesystems
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringReadFile.h"
+
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include <mutex>
+#include <thread>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox {
+namespace {
+
+// Submission queue size of the process wide ring.
+constexpr uint32_t kQueueDepth = 256;
+
+// Alignment of file offsets, sizes and memory for O_DIRECT.
+constexpr uint64_t kDirectIoAlignment = memory::AllocationTraits::kPageSize;
+
+struct ReadRequest;
+
+// File bytes read with one SQE.
+struct ReadRun {
+  ReadRequest* request;
+  // Range of the file requested by the caller.
+  uint64_t offset;
+  uint64_t length;
+  // The caller's buffers for the range.
+  std::vector<iovec> iovecs;
+  // With direct IO, the aligned range that is read into 'staging'.
+  uint64_t alignedOffset{0};
+  uint64_t alignedLength{0};
+  char* staging{nullptr};
+};
+
+// A preadvAsync() in flight. Owned by the completion thread once submitted and
+// freed after the completion of its last run.
+struct ReadRequest {
+  explicit ReadRequest(memory::MemoryAllocator* _allocator)
+      : allocator(_allocator) {}
+
+  ~ReadRequest() {
+    if (!staging.empty()) {
+      allocator->freeContiguous(staging);
+    }
+  }
+
+  // Records the 'result' of the read of 'run'. Fulfills 'promise' and returns
+  // true if this was the last run.
+  bool complete(const ReadRun& run, int32_t result) {
+    if (error.empty()) {
+      const uint64_t needed = run.staging == nullptr
+          ? run.length
+          : run.offset + run.length - run.alignedOffset;
+      if (result < 0) {
+        error = fmt::format(
+            "io_uring read of {} bytes at {} failed: {}",
+            run.length,
+            run.offset,
+            folly::errnoStr(-result));
+      } else if (static_cast<uint64_t>(result) < needed) {
+        error = fmt::format(
+            "Short io_uring read at {}: {} vs {}", run.offset, result, needed);
+      } else if (run.staging != nullptr) {
+        const char* source = run.staging + (run.offset - run.alignedOffset);
+        for (const auto& iov : run.iovecs) {
+          ::memcpy(iov.iov_base, source, iov.iov_len);
+          source += iov.iov_len;
+        }
+      }
+    }
+    if (--pending > 0) {
+      return false;
+    }
+    if (error.empty()) {
+      promise.setValue(numBytes);
+    } else {
+      try {
+        VELOX_FAIL("{}", error);
+      } catch (const std::exception&) {
+        promise.setException(
+            folly::exception_wrapper(std::current_exception()));
+      }
+    }
+    return true;
+  }
+
+  memory::MemoryAllocator* const allocator;
+  memory::ContiguousAllocation staging;
+  std::vector<ReadRun> runs;
+  // Bytes covered by the request, including skipped ranges.
+  uint64_t numBytes{0};
+  // Number of runs that have not completed. Only accessed by the completion
+  // thread after submission.
+  int32_t pending{0};
+  std::string error;
+  folly::Promise<uint64_t> promise;
+};
+
+// An io_uring instance shared by all IoUringReadFiles. Submissions are
+// serialized by a mutex and all the SQEs of one request go to the kernel with
+// a single io_uring_submit. Completions are reaped by a dedicated thread.
+class IoUring {
+ public:
+  static IoUring& instance() {
+    // Leaked on purpose, files may be read during static destruction.
+    static IoUring* ring = new IoUring(kQueueDepth);
+    return *ring;
+  }
+
+  explicit IoUring(uint32_t entries) {
+    const auto rc = io_uring_queue_init(entries, &ring_, 0);
+    VELOX_CHECK_EQ(
+        rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+    completionThread_ = std::thread([this]() { reapCompletions(); });
+  }
+
+  ~IoUring() {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      // A completion without a run stops the completion thread.
+      auto* sqe = nextSqe();
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      submit();
+    }
+    completionThread_.join();
+    io_uring_queue_exit(&ring_);
+  }
+
+  // Submits the reads of all runs of 'request'. The completion thread takes
+  // ownership of 'request'.
+  void submit(int32_t fd, ReadRequest* request) {
+    request->pending = request->runs.size();
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto& run : request->runs) {
+      auto* sqe = nextSqe();
+      if (run.staging != nullptr) {
+        io_uring_prep_read(
+            sqe, fd, run.staging, run.alignedLength, run.alignedOffset);
+      } else {
+        io_uring_prep_readv(
+            sqe, fd, run.iovecs.data(), run.iovecs.size(), run.offset);
+      }
+      io_uring_sqe_set_data(sqe, &run);
+    }
+    submit();
+  }
+
+ private:
+  // Returns a free SQE, submitting the prepared ones if the queue is full.
+  io_uring_sqe* nextSqe() {
+    auto* sqe = io_uring_get_sqe(&ring_);
+    while (sqe == nullptr) {
+      submit();
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    return sqe;
+  }
+
+  void submit() {
+    for (;;) {
+      const auto rc = io_uring_submit(&ring_);
+      if (rc >= 0) {
+        return;
+      }
+      // The completion queue is full or the kernel is out of resources. Wait
+      // for the completion thread to make room.
+      VELOX_CHECK(
+          rc == -EBUSY || rc == -EAGAIN || rc == -EINTR,
+          "io_uring_submit failed: {}",
+          folly::errnoStr(-rc));
+      std::this_thread::yield();
+    }
+  }
+
+  void reapCompletions() {
+    folly::setThreadName("IoUringReaper");
+    for (;;) {
+      io_uring_cqe* cqe;
+      const auto rc = io_uring_wait_cqe(&ring_, &cqe);
+      if (rc == -EINTR) {
+        continue;
+      }
+      VELOX_CHECK_EQ(
+          rc, 0, "io_uring_wait_cqe failed: {}", folly::errnoStr(-rc));
+      auto* run = static_cast<ReadRun*>(io_uring_cqe_get_data(cqe));
+      const auto result = cqe->res;
+      io_uring_cqe_seen(&ring_, cqe);
+      if (run == nullptr) {
+        return;
+      }
+      auto* request = run->request;
+      if (request->complete(*run, result)) {
+        delete request;
+      }
+    }
+  }
+
+  io_uring ring_;
+  std::mutex mutex_;
+  std::thread completionThread_;
+};
+
+} // namespace
+
+IoUringReadFile::IoUringReadFile(
+    std::string_view path,
+    IoUringReadFileOptions options)
+    : path_(path),
+      directIo_(options.directIo),
+      allocator_(
+          options.allocator != nullptr || !options.directIo
+              ? options.allocator
+              : memory::memoryManager()->allocator()) {
+  fd_ = ::open(path_.c_str(), O_RDONLY | (directIo_ ? O_DIRECT : 0));
+  if (fd_ < 0) {
+    if (errno == ENOENT) {
+      VELOX_FILE_NOT_FOUND_ERROR("No such file or directory: {}", path);
+    }
+    VELOX_FAIL(
+        "open failure in IoUringReadFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+  }
+  const off_t rc = ::lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      rc,
+      0,
+      "lseek failure in IoUringReadFile constructor, {} {}.",
+      path,
+      folly::errnoStr(errno));
+  size_ = rc;
+}
+
+IoUringReadFile::~IoUringReadFile() {
+  if (::close(fd_) < 0) {
+    LOG(WARNING) << "close failure in IoUringReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
+}
+
+std::string_view
+IoUringReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  if (directIo_) {
+    // The caller's buffer is not aligned, go through a staging buffer.
+    preadv(offset, {folly::Range<char*>(static_cast<char*>(buf), length)});
+  } else {
+    bytesRead_ += length;
+    const auto bytesRead = ::pread(fd_, buf, length, offset);
+    VELOX_CHECK_EQ(
+        bytesRead,
+        length,
+        "pread failure in IoUringReadFile::pread, {} {}.",
+        path_,
+        folly::errnoStr(errno));
+  }
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t IoUringReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  return preadvAsync(offset, buffers).get();
+}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto request = std::make_unique<ReadRequest>(allocator_);
+  auto& runs = request->runs;
+  // Ranges with a null data are gaps in a coalesced load and are not read.
+  // Adjacent buffers are read into with one readv.
+  bool inRun = false;
+  for (const auto& range : buffers) {
+    if (offset >= size_) {
+      break;
+    }
+    const auto length = std::min<uint64_t>(range.size(), size_ - offset);
+    if (range.data() == nullptr) {
+      inRun = false;
+    } else if (length > 0) {
+      if (!inRun || runs.back().iovecs.size() >= IOV_MAX) {
+        runs.push_back({request.get(), offset, 0});
+        inRun = true;
+      }
+      runs.back().iovecs.push_back({range.data(), length});
+      runs.back().length += length;
+      bytesRead_ += length;
+    }
+    offset += length;
+    request->numBytes += length;
+  }
+  if (runs.empty()) {
+    return folly::makeSemiFuture<uint64_t>(request->numBytes);
+  }
+
+  if (directIo_) {
+    uint64_t stagingSize = 0;
+    for (auto& run : runs) {
+      run.alignedOffset = run.offset - run.offset % kDirectIoAlignment;
+      run.alignedLength =
+          bits::roundUp(run.offset + run.length, kDirectIoAlignment) -
+          run.alignedOffset;
+      stagingSize += run.alignedLength;
+    }
+    VELOX_CHECK(
+        allocator_->allocateContiguous(
+            memory::AllocationTraits::numPages(stagingSize),
+            nullptr,
+            request->staging),
+        "Failed to allocate {} bytes for direct IO on {}",
+        stagingSize,
+        path_);
+    auto* staging = request->staging.data<char>();
+    for (auto& run : runs) {
+      run.staging = staging;
+      staging += run.alignedLength;
+    }
+  }
+
+  auto future = request->promise.getSemiFuture();
+  IoUring::instance().submit(fd_, request.release());
+  return future;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+namespace memory {
+class MemoryAllocator;
+} // namespace memory
+
+struct IoUringReadFileOptions {
+  /// Opens the file with O_DIRECT. Reads then bypass the page cache and are
+  /// made into page aligned staging buffers from 'allocator', from which the
+  /// requested bytes are copied to the caller's buffers.
+  bool directIo{false};
+
+  /// Allocator for the staging buffers of direct IO. Defaults to the allocator
+  /// of the process wide memory manager.
+  memory::MemoryAllocator* allocator{nullptr};
+};
+
+/// Local file read through io_uring. preadvAsync() submits the reads of all
+/// the contiguous runs of the requested ranges with a single io_uring_submit
+/// and returns without blocking. The completions are reaped by one thread per
+/// process that fulfills the returned future. This lets DirectBufferedInput
+/// and CachedBufferedInput keep many coalesced loads in flight without
+/// occupying an IO thread for each.
+///
+/// Only available when built with VELOX_ENABLE_IO_URING.
+class IoUringReadFile final : public ReadFile {
+ public:
+  explicit IoUringReadFile(
+      std::string_view path,
+      IoUringReadFileOptions options = {});
+
+  ~IoUringReadFile() override;
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+  uint64_t memoryUsage() const final {
+    return sizeof(*this);
+  }
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  std::string getName() const override {
+    return path_;
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 10 << 20;
+  }
+
+ private:
+  const std::string path_;
+  const bool directIo_;
+  memory::MemoryAllocator* const allocator_;
+  int32_t fd_;
+  uint64_t size_;
+};
+
+} // namespace facebook::velox
@@ -20,6 +20,10 @@
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringReadFile.h"
+#include "velox/common/memory/Memory.h"
+#endif
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -352,6 +356,54 @@ INSTANTIATE_TEST_SUITE_P(
     LocalFileTest,
     ::testing::Values(false, true));
 
+#ifdef VELOX_ENABLE_IO_URING
+TEST(IoUringReadFile, writeAndRead) {
+  memory::MemoryManager::testingSetInstance({});
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeData(&writeFile);
+    writeFile.close();
+  }
+  for (bool directIo : {false, true}) {
+    SCOPED_TRACE(fmt::format("directIo: {}", directIo));
+    if (directIo) {
+      // Some file systems, e.g. tmpfs, do not support O_DIRECT.
+      const auto fd = ::open(filename.c_str(), O_RDONLY | O_DIRECT);
+      if (fd < 0) {
+        continue;
+      }
+      ::close(fd);
+    }
+    IoUringReadFileOptions options;
+    options.directIo = directIo;
+    IoUringReadFile readFile(filename, options);
+    ASSERT_TRUE(readFile.hasPreadvAsync());
+    readData(&readFile);
+
+    // Several reads in flight at the same time. Each skips from a different
+    // offset to the last 7 bytes.
+    const std::string begin = "aaaaabbbbbcccccccccccc";
+    std::vector<std::string> heads(10, std::string(12, 0));
+    std::vector<std::string> tails(10, std::string(7, 0));
+    std::vector<folly::SemiFuture<uint64_t>> futures;
+    for (auto i = 0; i < heads.size(); ++i) {
+      futures.push_back(readFile.preadvAsync(
+          i,
+          {folly::Range<char*>(heads[i].data(), heads[i].size()),
+           folly::Range<char*>(nullptr, kOneMB + 8 - heads[i].size() - i),
+           folly::Range<char*>(tails[i].data(), tails[i].size())}));
+    }
+    for (auto i = 0; i < heads.size(); ++i) {
+      ASSERT_EQ(std::move(futures[i]).get(), 15 + kOneMB - i);
+      ASSERT_EQ(heads[i], begin.substr(i, heads[i].size()));
+      ASSERT_EQ(tails[i], "ccddddd");
+    }
+  }
+}
+#endif
+
 class FaultyFsTest : public ::testing::Test {
  protected:
   FaultyFsTest() {}
@@ -335,4 +335,22 @@ bool HiveConfig::cacheNoRetention(const config::ConfigBase* session) const {
       config_->get<bool>(kCacheNoRetention, /*defaultValue=*/false));
 }
 
+uint32_t HiveConfig::parallelDecodingThreads() const {
+  return config_->get<uint32_t>(kParallelDecodingThreads, 0);
+}
+
+uint32_t HiveConfig::parallelDecodingFactor(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kParallelDecodingFactorSession,
+      config_->get<uint32_t>(
+          kParallelDecodingFactor, parallelDecodingThreads()));
+}
+
+uint64_t HiveConfig::fileMetadataCacheBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kFileMetadataCacheBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
 } // namespace facebook::velox::connector::hive
@@ -245,6 +245,24 @@ class HiveConfig {
   static constexpr const char* kCacheNoRetention = "cache.no_retention";
   static constexpr const char* kCacheNoRetentionSession = "cache.no_retention";
 
+  /// Number of threads of the executor the connector decodes the columns of
+  /// the DWRF and ORC splits on in parallel. 0 turns parallel decoding off.
+  static constexpr const char* kParallelDecodingThreads =
+      "parallel-decoding-threads";
+
+  /// Maximum number of threads that decode the columns of one split in
+  /// parallel. Parallel decoding is off if this is less than 2. Defaults to
+  /// the number of parallel decoding threads.
+  static constexpr const char* kParallelDecodingFactor =
+      "parallel-decoding-factor";
+  static constexpr const char* kParallelDecodingFactorSession =
+      "parallel_decoding_factor";
+
+  /// Capacity of the process-wide cache of decoded Parquet and DWRF footers
+  /// that the splits of the same file share. 0 disables the cache.
+  static constexpr const char* kFileMetadataCacheBytes =
+      "file-metadata-cache-bytes";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const config::ConfigBase* session) const;
 
@@ -362,6 +380,12 @@ class HiveConfig {
   /// locality.
   bool cacheNoRetention(const config::ConfigBase* session) const;
 
+  uint32_t parallelDecodingThreads() const;
+
+  uint32_t parallelDecodingFactor(const config::ConfigBase* session) const;
+
+  uint64_t fileMetadataCacheBytes() const;
+
   HiveConfig(std::shared_ptr<const config::ConfigBase> config) {
     VELOX_CHECK_NOT_NULL(
         config, "Config is null for HiveConfig initialization");
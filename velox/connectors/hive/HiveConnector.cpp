@@ -17,6 +17,7 @@
 #include "velox/connectors/hive/HiveConnector.h"
 
 #include "velox/common/base/Fs.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
@@ -31,11 +32,14 @@
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 #include "velox/dwio/orc/reader/OrcReader.h"
+#include "velox/dwio/orc/writer/OrcWriter.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h" // @manual
 #include "velox/dwio/parquet/RegisterParquetWriter.h" // @manual
 #include "velox/expression/FieldReference.h"
 
 #include <boost/lexical_cast.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <memory>
 
 using namespace facebook::velox::exec;
@@ -56,6 +60,21 @@ HiveConnector::HiveConnector(
               : nullptr,
           std::make_unique<FileHandleGenerator>(config)),
       executor_(executor) {
+  if (const auto threads = hiveConfig_->parallelDecodingThreads();
+      threads > 0) {
+    decodingExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+        threads,
+        std::make_shared<folly::NamedThreadFactory>(
+            fmt::format("{}.decoding", connectorId())));
+  }
+  if (const auto bytes = hiveConfig_->fileMetadataCacheBytes();
+      bytes > 0 && dwio::common::FileMetadataCache::getInstance() == nullptr) {
+    fileMetadataCache_ =
+        std::make_unique<dwio::common::FileMetadataCache>(bytes);
+    dwio::common::FileMetadataCache::setInstance(fileMetadataCache_.get());
+    LOG(INFO) << "Hive connector " << connectorId()
+              << " created file metadata cache of " << succinctBytes(bytes);
+  }
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with maximum of "
@@ -66,6 +85,14 @@ HiveConnector::HiveConnector(
   }
 }
 
+HiveConnector::~HiveConnector() {
+  if (fileMetadataCache_ != nullptr &&
+      dwio::common::FileMetadataCache::getInstance() ==
+          fileMetadataCache_.get()) {
+    dwio::common::FileMetadataCache::setInstance(nullptr);
+  }
+}
+
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<ConnectorTableHandle>& tableHandle,
@@ -80,7 +107,8 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       executor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      decodingExecutor_);
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -126,6 +154,7 @@ void HiveConnectorFactory::initialize() {
     dwrf::registerDwrfReaderFactory();
     dwrf::registerDwrfWriterFactory();
     orc::registerOrcReaderFactory();
+    orc::registerOrcWriterFactory();
 
     parquet::registerParquetReaderFactory();
     parquet::registerParquetWriterFactory();
@@ -19,6 +19,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/PlanNode.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 
 namespace facebook::velox::dwio::common {
 class DataSink;
@@ -34,6 +35,8 @@ class HiveConnector : public Connector {
       std::shared_ptr<const config::ConfigBase> config,
       folly::Executor* executor);
 
+  ~HiveConnector() override;
+
   const std::shared_ptr<const config::ConfigBase>& connectorConfig()
       const override {
     return hiveConfig_->config();
@@ -79,6 +82,11 @@ class HiveConnector : public Connector {
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* executor_;
+  // Set if HiveConfig::kParallelDecodingThreads is positive.
+  std::shared_ptr<folly::Executor> decodingExecutor_;
+  // Set if HiveConfig::kFileMetadataCacheBytes is positive and no other
+  // connector has installed the process-wide FileMetadataCache.
+  std::unique_ptr<dwio::common::FileMetadataCache> fileMetadataCache_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
@@ -926,6 +926,16 @@ void updateParquetWriterOptions(
               *hiveConfig->config(), core::QueryConfig::kSessionTimezone);
   }
 
+  if (!parquetWriterOptions->useNativeWriter) {
+    if (const auto useNativeWriter = sessionProperties->get<bool>(
+            parquet::WriterOptions::kParquetSessionUseNativeWriter)) {
+      parquetWriterOptions->useNativeWriter = useNativeWriter;
+    } else {
+      parquetWriterOptions->useNativeWriter = hiveConfig->config()->get<bool>(
+          parquet::WriterOptions::kParquetHiveConnectorUseNativeWriter);
+    }
+  }
+
   writerOptions = std::move(parquetWriterOptions);
 }
 #endif
@@ -997,6 +1007,7 @@ void updateWriterOptionsFromHiveConfig(
     std::shared_ptr<dwio::common::WriterOptions>& writerOptions) {
   switch (fileFormat) {
     case dwio::common::FileFormat::DWRF:
+    case dwio::common::FileFormat::ORC:
       updateDWRFWriterOptions(hiveConfig, sessionProperties, writerOptions);
       break;
     case dwio::common::FileFormat::PARQUET:
@@ -45,7 +45,8 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      std::shared_ptr<folly::Executor> decodingExecutor = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -104,6 +105,7 @@ class HiveDataSource : public DataSource {
 
   FileHandleFactory* const fileHandleFactory_;
   folly::Executor* const executor_;
+  const std::shared_ptr<folly::Executor> decodingExecutor_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
   memory::MemoryPool* const pool_;
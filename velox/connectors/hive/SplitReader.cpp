@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -74,7 +75,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
     const std::shared_ptr<io::IoStatistics>& ioStats,
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec) {
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    const std::shared_ptr<folly::Executor>& decodingExecutor) {
   //  Create the SplitReader based on hiveSplit->customSplitInfo["table_format"]
   if (hiveSplit->customSplitInfo.count("table_format") > 0 &&
       hiveSplit->customSplitInfo["table_format"] == "hive-iceberg") {
@@ -88,7 +90,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
         ioStats,
         fileHandleFactory,
         executor,
-        scanSpec);
+        scanSpec,
+        decodingExecutor);
   } else {
     return std::unique_ptr<SplitReader>(new SplitReader(
         hiveSplit,
@@ -100,7 +103,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
         ioStats,
         fileHandleFactory,
         executor,
-        scanSpec));
+        scanSpec,
+        decodingExecutor));
   }
 }
 
@@ -115,7 +119,8 @@ SplitReader::SplitReader(
     const std::shared_ptr<io::IoStatistics>& ioStats,
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec)
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    const std::shared_ptr<folly::Executor>& decodingExecutor)
     : hiveSplit_(hiveSplit),
       hiveTableHandle_(hiveTableHandle),
       partitionKeys_(partitionKeys),
@@ -125,6 +130,7 @@ SplitReader::SplitReader(
       ioStats_(ioStats),
       fileHandleFactory_(fileHandleFactory),
       executor_(executor),
+      decodingExecutor_(decodingExecutor),
       pool_(connectorQueryCtx->memoryPool()),
       scanSpec_(scanSpec),
       baseReaderOpts_(connectorQueryCtx->memoryPool()),
@@ -250,6 +256,17 @@ void SplitReader::createReader(
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  // Splits of the same file version share the decoded footer. The cache is
+  // skipped if the version of the file is unknown, as a file rewritten at the
+  // same path would otherwise be read with the footer of its old version.
+  const auto& properties = hiveSplit_->properties;
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache != nullptr && properties.has_value() &&
+      properties->modificationTime.has_value()) {
+    baseReaderOpts_.setFileMetadataCache(
+        metadataCache,
+        {fileHandleCachePtr->uuid, properties->modificationTime.value()});
+  }
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
@@ -275,6 +292,12 @@ void SplitReader::createReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       baseRowReaderOpts_);
+  if (decodingExecutor_ != nullptr) {
+    baseRowReaderOpts_.setDecodingExecutor(decodingExecutor_);
+    baseRowReaderOpts_.setDecodingParallelismFactor(
+        hiveConfig_->parallelDecodingFactor(
+            connectorQueryCtx_->sessionProperties()));
+  }
 }
 
 bool SplitReader::checkIfSplitIsEmpty(
@@ -65,7 +65,8 @@ class SplitReader {
       const std::shared_ptr<io::IoStatistics>& ioStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      const std::shared_ptr<folly::Executor>& decodingExecutor = nullptr);
 
   virtual ~SplitReader() = default;
 
@@ -111,7 +112,8 @@ class SplitReader {
       const std::shared_ptr<io::IoStatistics>& ioStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      const std::shared_ptr<folly::Executor>& decodingExecutor = nullptr);
 
   /// Create the dwio::common::Reader object baseReader_, which will be used to
   /// read the data file's metadata and schema
@@ -157,6 +159,9 @@ class SplitReader {
   const std::shared_ptr<io::IoStatistics> ioStats_;
   FileHandleFactory* const fileHandleFactory_;
   folly::Executor* const executor_;
+  // Decodes the columns of the split in parallel if set, see
+  // HiveConfig::kParallelDecodingThreads.
+  const std::shared_ptr<folly::Executor> decodingExecutor_;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<common::ScanSpec> scanSpec_;
@@ -35,7 +35,8 @@ IcebergSplitReader::IcebergSplitReader(
     const std::shared_ptr<io::IoStatistics>& ioStats,
     FileHandleFactory* const fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec)
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    const std::shared_ptr<folly::Executor>& decodingExecutor)
     : SplitReader(
           hiveSplit,
           hiveTableHandle,
@@ -46,7 +47,8 @@ IcebergSplitReader::IcebergSplitReader(
           ioStats,
           fileHandleFactory,
           executor,
-          scanSpec),
+          scanSpec,
+          decodingExecutor),
       baseReadOffset_(0),
       splitOffset_(0),
       deleteBitmap_(nullptr),
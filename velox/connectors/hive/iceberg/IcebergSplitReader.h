@@ -37,7 +37,8 @@ class IcebergSplitReader : public SplitReader {
       const std::shared_ptr<io::IoStatistics>& ioStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      const std::shared_ptr<folly::Executor>& decodingExecutor = nullptr);
 
   ~IcebergSplitReader() override = default;
 
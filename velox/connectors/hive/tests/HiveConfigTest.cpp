@@ -77,6 +77,9 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(
       hiveConfig.orcWriterLinearStripeSizeHeuristics(emptySession.get()), true);
   ASSERT_FALSE(hiveConfig.cacheNoRetention(emptySession.get()));
+  ASSERT_EQ(hiveConfig.parallelDecodingThreads(), 0);
+  ASSERT_EQ(hiveConfig.parallelDecodingFactor(emptySession.get()), 0);
+  ASSERT_EQ(hiveConfig.fileMetadataCacheBytes(), 0);
 }
 
 TEST(HiveConfigTest, overrideConfig) {
@@ -112,7 +115,9 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristics, "false"},
       {HiveConfig::kOrcWriterMinCompressionSize, "512"},
       {HiveConfig::kOrcWriterCompressionLevel, "1"},
-      {HiveConfig::kCacheNoRetention, "true"}};
+      {HiveConfig::kCacheNoRetention, "true"},
+      {HiveConfig::kParallelDecodingThreads, "8"},
+      {HiveConfig::kFileMetadataCacheBytes, "64MB"}};
   HiveConfig hiveConfig(
       std::make_shared<config::ConfigBase>(std::move(configFromFile)));
   auto emptySession = std::make_shared<config::ConfigBase>(
@@ -165,6 +170,9 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig.orcWriterLinearStripeSizeHeuristics(emptySession.get()),
       false);
   ASSERT_TRUE(hiveConfig.cacheNoRetention(emptySession.get()));
+  ASSERT_EQ(hiveConfig.parallelDecodingThreads(), 8);
+  ASSERT_EQ(hiveConfig.parallelDecodingFactor(emptySession.get()), 8);
+  ASSERT_EQ(hiveConfig.fileMetadataCacheBytes(), 64UL << 20);
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -186,7 +194,8 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kOrcWriterMinCompressionSizeSession, "512"},
       {HiveConfig::kOrcWriterCompressionLevelSession, "1"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristicsSession, "false"},
-      {HiveConfig::kCacheNoRetentionSession, "true"}};
+      {HiveConfig::kCacheNoRetentionSession, "true"},
+      {HiveConfig::kParallelDecodingFactorSession, "4"}};
   const auto session =
       std::make_unique<config::ConfigBase>(std::move(sessionOverride));
   ASSERT_EQ(
@@ -235,4 +244,5 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_EQ(hiveConfig.orcWriterMinCompressionSize(session.get()), 512);
   ASSERT_EQ(hiveConfig.orcWriterCompressionLevel(session.get()), 1);
   ASSERT_TRUE(hiveConfig.cacheNoRetention(session.get()));
+  ASSERT_EQ(hiveConfig.parallelDecodingFactor(session.get()), 4);
 }
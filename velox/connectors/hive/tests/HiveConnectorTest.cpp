@@ -19,6 +19,7 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HiveDataSource.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -83,6 +84,26 @@ TEST_F(HiveConnectorTest, hiveConfig) {
       "UNKNOWN BEHAVIOR 100");
 }
 
+TEST_F(HiveConnectorTest, fileMetadataCache) {
+  using dwio::common::FileMetadataCache;
+  ASSERT_EQ(FileMetadataCache::getInstance(), nullptr);
+  auto config = std::make_shared<config::ConfigBase>(
+      std::unordered_map<std::string, std::string>{
+          {HiveConfig::kFileMetadataCacheBytes, "1MB"}});
+  {
+    HiveConnector connector("metadataCache", config, nullptr);
+    auto* cache = FileMetadataCache::getInstance();
+    ASSERT_NE(cache, nullptr);
+    ASSERT_EQ(cache->maxBytes(), 1 << 20);
+
+    // Other connectors use the installed cache.
+    HiveConnector other("otherMetadataCache", config, nullptr);
+    ASSERT_EQ(FileMetadataCache::getInstance(), cache);
+  }
+  // The cache is uninstalled with the connector that created it.
+  ASSERT_EQ(FileMetadataCache::getInstance(), nullptr);
+}
+
 TEST_F(HiveConnectorTest, makeScanSpec_requiredSubfields_multilevel) {
   auto columnType = ROW(
       {{"c0c0", BIGINT()},
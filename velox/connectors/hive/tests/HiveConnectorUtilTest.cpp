@@ -414,6 +414,32 @@ TEST_F(HiveConnectorUtilTest, updateWriterOptionsFromHiveConfigParquet) {
   ASSERT_EQ(
       parquetOptions->parquetWriteTimestampUnit.value(), TimestampUnit::kMilli);
   ASSERT_EQ(parquetOptions->parquetWriteTimestampTimeZone.value(), "UTC");
+  ASSERT_FALSE(parquetOptions->useNativeWriter.has_value());
+}
+
+TEST_F(HiveConnectorUtilTest, updateWriterOptionsParquetNativeWriter) {
+  auto fileFormat = dwio::common::FileFormat::PARQUET;
+  auto hiveConfig =
+      std::make_shared<hive::HiveConfig>(std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>{
+              {parquet::WriterOptions::kParquetHiveConnectorUseNativeWriter,
+               "true"}}));
+  auto useNativeWriter =
+      [&](const std::unordered_map<std::string, std::string>& session) {
+        config::ConfigBase sessionProperties(
+            std::unordered_map<std::string, std::string>(session));
+        std::shared_ptr<dwio::common::WriterOptions> options =
+            std::make_shared<parquet::WriterOptions>();
+        updateWriterOptionsFromHiveConfig(
+            fileFormat, hiveConfig, &sessionProperties, options);
+        return std::dynamic_pointer_cast<parquet::WriterOptions>(options)
+            ->useNativeWriter.value();
+      };
+
+  ASSERT_TRUE(useNativeWriter({}));
+  // The session property overrides the connector config.
+  ASSERT_FALSE(useNativeWriter(
+      {{parquet::WriterOptions::kParquetSessionUseNativeWriter, "false"}}));
 }
 #endif
 
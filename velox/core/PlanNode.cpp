@@ -1057,11 +1057,17 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (!hashTableCacheKey_.empty()) {
+    stream << ", hash table cache key: " << hashTableCacheKey_;
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  if (!hashTableCacheKey_.empty()) {
+    obj["hashTableCacheKey"] = hashTableCacheKey_;
+  }
   return obj;
 }
 
@@ -1081,6 +1087,11 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  std::string hashTableCacheKey;
+  if (obj.count("hashTableCacheKey")) {
+    hashTableCacheKey = obj["hashTableCacheKey"].asString();
+  }
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1090,7 +1101,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      std::move(hashTableCacheKey));
 }
 
 MergeJoinNode::MergeJoinNode(
@@ -1264,6 +1276,312 @@ PlanNodePtr NestedLoopJoinNode::create(
       outputType);
 }
 
+namespace {
+std::unordered_map<IEJoinNode::Op, std::string> ieJoinOpNames() {
+  return {
+      {IEJoinNode::Op::kLessThan, "<"},
+      {IEJoinNode::Op::kLessThanOrEqual, "<="},
+      {IEJoinNode::Op::kGreaterThan, ">"},
+      {IEJoinNode::Op::kGreaterThanOrEqual, ">="},
+  };
+}
+} // namespace
+
+// static
+const char* IEJoinNode::opName(Op op) {
+  static const auto kOps = ieJoinOpNames();
+  return kOps.at(op).c_str();
+}
+
+// static
+IEJoinNode::Op IEJoinNode::opFromName(std::string_view name) {
+  static const auto kOps = invertMap(ieJoinOpNames());
+  auto it = kOps.find(std::string(name));
+  VELOX_USER_CHECK(it != kOps.end(), "Invalid IEJoin operator: {}", name);
+  return it->second;
+}
+
+std::string IEJoinNode::Condition::toString() const {
+  return fmt::format("{} {} {}", left->name(), opName(op), right->name());
+}
+
+folly::dynamic IEJoinNode::Condition::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["left"] = left->serialize();
+  obj["op"] = opName(op);
+  obj["right"] = right->serialize();
+  return obj;
+}
+
+// static
+IEJoinNode::Condition IEJoinNode::Condition::create(
+    const folly::dynamic& obj,
+    void* context) {
+  return {
+      ISerializable::deserialize<FieldAccessTypedExpr>(obj["left"], context),
+      opFromName(obj["op"].asString()),
+      ISerializable::deserialize<FieldAccessTypedExpr>(obj["right"], context)};
+}
+
+IEJoinNode::IEJoinNode(
+    const PlanNodeId& id,
+    JoinType joinType,
+    const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+    const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+    std::vector<Condition> conditions,
+    PlanNodePtr left,
+    PlanNodePtr right,
+    RowTypePtr outputType)
+    : PlanNode(id),
+      joinType_(joinType),
+      leftKeys_(leftKeys),
+      rightKeys_(rightKeys),
+      conditions_(std::move(conditions)),
+      sources_({std::move(left), std::move(right)}),
+      outputType_(std::move(outputType)) {
+  VELOX_USER_CHECK(
+      isSupported(joinType_),
+      "The join type is not supported by IEJoin: {}",
+      joinTypeName(joinType_));
+  VELOX_USER_CHECK_EQ(
+      leftKeys_.size(),
+      rightKeys_.size(),
+      "IEJoin must have the same number of left and right keys");
+  VELOX_USER_CHECK(
+      !conditions_.empty() && conditions_.size() <= 2,
+      "IEJoin must have one or two inequality conditions: {}",
+      conditions_.size());
+
+  const auto& leftType = sources_[0]->outputType();
+  const auto& rightType = sources_[1]->outputType();
+  auto checkField = [](const RowTypePtr& type,
+                       const FieldAccessTypedExprPtr& field,
+                       const char* side) {
+    VELOX_USER_CHECK(
+        type->containsChild(field->name()),
+        "IEJoin {} side column not found: {}",
+        side,
+        field->name());
+  };
+  for (auto i = 0; i < leftKeys_.size(); ++i) {
+    checkField(leftType, leftKeys_[i], "left");
+    checkField(rightType, rightKeys_[i], "right");
+    VELOX_USER_CHECK(
+        leftKeys_[i]->type()->equivalent(*rightKeys_[i]->type()),
+        "IEJoin key types on the left and right sides must match: {} vs. {}",
+        leftKeys_[i]->type()->toString(),
+        rightKeys_[i]->type()->toString());
+  }
+  for (const auto& condition : conditions_) {
+    checkField(leftType, condition.left, "left");
+    checkField(rightType, condition.right, "right");
+    VELOX_USER_CHECK(
+        condition.left->type()->equivalent(*condition.right->type()),
+        "IEJoin condition types on the left and right sides must match: {}",
+        condition.toString());
+    VELOX_USER_CHECK(
+        condition.left->type()->isOrderable(),
+        "IEJoin condition type is not orderable: {}",
+        condition.left->type()->toString());
+  }
+
+  for (const auto& name : outputType_->names()) {
+    const bool leftContains = leftType->containsChild(name);
+    const bool rightContains = rightType->containsChild(name);
+    VELOX_USER_CHECK(
+        !(leftContains && rightContains),
+        "Duplicate column name found on join's left and right sides: {}",
+        name);
+    VELOX_USER_CHECK(
+        leftContains || rightContains,
+        "Join's output column not found in either left or right sides: {}",
+        name);
+  }
+}
+
+// static
+bool IEJoinNode::isSupported(core::JoinType joinType) {
+  switch (joinType) {
+    case core::JoinType::kInner:
+    case core::JoinType::kLeft:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void IEJoinNode::addDetails(std::stringstream& stream) const {
+  stream << joinTypeName(joinType_) << " ";
+  for (auto i = 0; i < leftKeys_.size(); ++i) {
+    stream << leftKeys_[i]->name() << "=" << rightKeys_[i]->name() << " AND ";
+  }
+  for (auto i = 0; i < conditions_.size(); ++i) {
+    if (i > 0) {
+      stream << " AND ";
+    }
+    stream << conditions_[i].toString();
+  }
+}
+
+folly::dynamic IEJoinNode::serialize() const {
+  auto obj = PlanNode::serialize();
+  obj["joinType"] = joinTypeName(joinType_);
+  obj["leftKeys"] = ISerializable::serialize(leftKeys_);
+  obj["rightKeys"] = ISerializable::serialize(rightKeys_);
+  auto conditions = folly::dynamic::array();
+  for (const auto& condition : conditions_) {
+    conditions.push_back(condition.serialize());
+  }
+  obj["conditions"] = std::move(conditions);
+  obj["outputType"] = outputType_->serialize();
+  return obj;
+}
+
+// static
+PlanNodePtr IEJoinNode::create(const folly::dynamic& obj, void* context) {
+  auto sources = deserializeSources(obj, context);
+  VELOX_CHECK_EQ(2, sources.size());
+
+  auto leftKeys = deserializeFields(obj["leftKeys"], context);
+  auto rightKeys = deserializeFields(obj["rightKeys"], context);
+
+  std::vector<Condition> conditions;
+  for (const auto& condition : obj["conditions"]) {
+    conditions.push_back(Condition::create(condition, context));
+  }
+
+  auto outputType = deserializeRowType(obj["outputType"]);
+
+  return std::make_shared<IEJoinNode>(
+      deserializePlanNodeId(obj),
+      joinTypeFromName(obj["joinType"].asString()),
+      leftKeys,
+      rightKeys,
+      std::move(conditions),
+      sources[0],
+      sources[1],
+      outputType);
+}
+
+AsOfJoinNode::AsOfJoinNode(
+    const PlanNodeId& id,
+    JoinType joinType,
+    const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+    const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+    IEJoinNode::Condition matchCondition,
+    PlanNodePtr left,
+    PlanNodePtr right,
+    RowTypePtr outputType)
+    : PlanNode(id),
+      joinType_(joinType),
+      leftKeys_(leftKeys),
+      rightKeys_(rightKeys),
+      matchCondition_(std::move(matchCondition)),
+      sources_({std::move(left), std::move(right)}),
+      outputType_(std::move(outputType)) {
+  VELOX_USER_CHECK(
+      isSupported(joinType_),
+      "The join type is not supported by AS OF join: {}",
+      joinTypeName(joinType_));
+  VELOX_USER_CHECK_EQ(
+      leftKeys_.size(),
+      rightKeys_.size(),
+      "AS OF join must have the same number of left and right keys");
+
+  const auto& leftType = sources_[0]->outputType();
+  const auto& rightType = sources_[1]->outputType();
+  auto checkFields = [&](const FieldAccessTypedExprPtr& left,
+                         const FieldAccessTypedExprPtr& right) {
+    VELOX_USER_CHECK(
+        leftType->containsChild(left->name()),
+        "AS OF join left side column not found: {}",
+        left->name());
+    VELOX_USER_CHECK(
+        rightType->containsChild(right->name()),
+        "AS OF join right side column not found: {}",
+        right->name());
+    VELOX_USER_CHECK(
+        left->type()->equivalent(*right->type()),
+        "AS OF join column types on both sides must match: {} vs. {}",
+        left->type()->toString(),
+        right->type()->toString());
+  };
+  for (auto i = 0; i < leftKeys_.size(); ++i) {
+    checkFields(leftKeys_[i], rightKeys_[i]);
+  }
+  checkFields(matchCondition_.left, matchCondition_.right);
+  VELOX_USER_CHECK(
+      matchCondition_.left->type()->isOrderable(),
+      "AS OF join match condition type is not orderable: {}",
+      matchCondition_.left->type()->toString());
+
+  for (const auto& name : outputType_->names()) {
+    const bool leftContains = leftType->containsChild(name);
+    const bool rightContains = rightType->containsChild(name);
+    VELOX_USER_CHECK(
+        !(leftContains && rightContains),
+        "Duplicate column name found on join's left and right sides: {}",
+        name);
+    VELOX_USER_CHECK(
+        leftContains || rightContains,
+        "Join's output column not found in either left or right sides: {}",
+        name);
+  }
+}
+
+// static
+bool AsOfJoinNode::isSupported(core::JoinType joinType) {
+  switch (joinType) {
+    case core::JoinType::kInner:
+    case core::JoinType::kLeft:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void AsOfJoinNode::addDetails(std::stringstream& stream) const {
+  stream << joinTypeName(joinType_) << " ";
+  for (auto i = 0; i < leftKeys_.size(); ++i) {
+    stream << leftKeys_[i]->name() << "=" << rightKeys_[i]->name() << " AND ";
+  }
+  stream << matchCondition_.toString();
+}
+
+folly::dynamic AsOfJoinNode::serialize() const {
+  auto obj = PlanNode::serialize();
+  obj["joinType"] = joinTypeName(joinType_);
+  obj["leftKeys"] = ISerializable::serialize(leftKeys_);
+  obj["rightKeys"] = ISerializable::serialize(rightKeys_);
+  obj["matchCondition"] = matchCondition_.serialize();
+  obj["outputType"] = outputType_->serialize();
+  return obj;
+}
+
+// static
+PlanNodePtr AsOfJoinNode::create(const folly::dynamic& obj, void* context) {
+  auto sources = deserializeSources(obj, context);
+  VELOX_CHECK_EQ(2, sources.size());
+
+  auto leftKeys = deserializeFields(obj["leftKeys"], context);
+  auto rightKeys = deserializeFields(obj["rightKeys"], context);
+  auto matchCondition =
+      IEJoinNode::Condition::create(obj["matchCondition"], context);
+  auto outputType = deserializeRowType(obj["outputType"]);
+
+  return std::make_shared<AsOfJoinNode>(
+      deserializePlanNodeId(obj),
+      joinTypeFromName(obj["joinType"].asString()),
+      leftKeys,
+      rightKeys,
+      std::move(matchCondition),
+      sources[0],
+      sources[1],
+      outputType);
+}
+
 AssignUniqueIdNode::AssignUniqueIdNode(
     const PlanNodeId& id,
     const std::string& idName,
@@ -2290,6 +2608,8 @@ void PlanNode::registerSerDe() {
   registry.Register("MergeExchangeNode", MergeExchangeNode::create);
   registry.Register("MergeJoinNode", MergeJoinNode::create);
   registry.Register("NestedLoopJoinNode", NestedLoopJoinNode::create);
+  registry.Register("IEJoinNode", IEJoinNode::create);
+  registry.Register("AsOfJoinNode", AsOfJoinNode::create);
   registry.Register("LimitNode", LimitNode::create);
   registry.Register("LocalMergeNode", LocalMergeNode::create);
   registry.Register("LocalPartitionNode", LocalPartitionNode::create);
@@ -1577,7 +1577,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      std::string hashTableCacheKey = "")
       : AbstractJoinNode(
             id,
             joinType,
@@ -1587,7 +1588,15 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        hashTableCacheKey_{std::move(hashTableCacheKey)} {
+    if (!hashTableCacheKey_.empty()) {
+      VELOX_USER_CHECK(
+          !nullAware && (isInnerJoin() || isLeftJoin() ||
+                         isLeftSemiFilterJoin() || isAntiJoin()),
+          "Hash table cache is supported only for inner, left, left semi "
+          "filter and non null-aware anti joins");
+    }
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1612,14 +1621,25 @@ class HashJoinNode : public AbstractJoinNode {
     // filter set. It requires to cross join the null-key probe rows with all
     // the build-side rows for filter evaluation which is not supported under
     // spilling.
+    // NOTE: a cached hash table is shared with other tasks and can't be
+    // spilled.
     return !(isAntiJoin() && nullAware_ && filter() != nullptr) &&
-        queryConfig.joinSpillEnabled();
+        hashTableCacheKey_.empty() && queryConfig.joinSpillEnabled();
   }
 
   bool isNullAware() const {
     return nullAware_;
   }
 
+  /// If not empty, the built hash table is shared through the node level
+  /// exec::HashTableCache with the concurrent tasks that have the same key.
+  /// The key must identify the build side plan fragment and its input splits
+  /// such that all the tasks with the same key build the same table. Only
+  /// join types that don't update the table while probing can use the cache.
+  const std::string& hashTableCacheKey() const {
+    return hashTableCacheKey_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1628,6 +1648,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const std::string hashTableCacheKey_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -1706,6 +1727,13 @@ class NestedLoopJoinNode : public PlanNode {
     return joinType_;
   }
 
+  /// NOTE: only inner and cross joins can spill. The build side is spilled in
+  /// chunks that are joined one at a time with the spilled probe input, which
+  /// can't track the probe and build rows without a match across chunks.
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return isInnerJoin(joinType_) && queryConfig.joinSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   /// If nested loop join supports this join type.
@@ -1722,6 +1750,186 @@ class NestedLoopJoinNode : public PlanNode {
   const RowTypePtr outputType_;
 };
 
+/// Represents inner/left joins on one or two inequality conditions between a
+/// column of the left side and a column of the right side, plus optional
+/// equality keys, e.g. 'l.ts BETWEEN r.start AND r.end' or 'l.a < r.a AND
+/// l.b > r.b'. Translates to an exec::IEJoinProbe and a
+/// exec::NestedLoopJoinBuild. A separate pipeline is produced for the build
+/// side when generating exec::Operators.
+///
+/// Unlike NestedLoopJoinNode, the conditions are not evaluated on the cross
+/// product of the inputs. The right side rows are sorted on the conditions
+/// and the matches of each left side row are looked up in the sorted rows
+/// (IEJoin algorithm), so the cost is proportional to the input size and
+/// number of matches.
+class IEJoinNode : public PlanNode {
+ public:
+  /// Comparison between a left side and a right side column.
+  enum class Op {
+    kLessThan,
+    kLessThanOrEqual,
+    kGreaterThan,
+    kGreaterThanOrEqual,
+  };
+
+  static const char* opName(Op op);
+
+  static Op opFromName(std::string_view name);
+
+  /// An inequality join condition: 'left' 'op' 'right'.
+  struct Condition {
+    FieldAccessTypedExprPtr left;
+    Op op;
+    FieldAccessTypedExprPtr right;
+
+    std::string toString() const;
+
+    folly::dynamic serialize() const;
+
+    static Condition create(const folly::dynamic& obj, void* context);
+  };
+
+  IEJoinNode(
+      const PlanNodeId& id,
+      JoinType joinType,
+      const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+      const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+      std::vector<Condition> conditions,
+      PlanNodePtr left,
+      PlanNodePtr right,
+      RowTypePtr outputType);
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  const RowTypePtr& outputType() const override {
+    return outputType_;
+  }
+
+  std::string_view name() const override {
+    return "IEJoin";
+  }
+
+  JoinType joinType() const {
+    return joinType_;
+  }
+
+  /// Equality keys of the left side. May be empty.
+  const std::vector<FieldAccessTypedExprPtr>& leftKeys() const {
+    return leftKeys_;
+  }
+
+  /// Equality keys of the right side. Same number and types as 'leftKeys'.
+  const std::vector<FieldAccessTypedExprPtr>& rightKeys() const {
+    return rightKeys_;
+  }
+
+  /// One or two inequality conditions.
+  const std::vector<Condition>& conditions() const {
+    return conditions_;
+  }
+
+  /// NOTE: only inner joins can spill, see NestedLoopJoinNode::canSpill().
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return isInnerJoin(joinType_) && queryConfig.joinSpillEnabled();
+  }
+
+  folly::dynamic serialize() const override;
+
+  /// If IEJoin supports this join type.
+  static bool isSupported(core::JoinType joinType);
+
+  static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const JoinType joinType_;
+  const std::vector<FieldAccessTypedExprPtr> leftKeys_;
+  const std::vector<FieldAccessTypedExprPtr> rightKeys_;
+  const std::vector<Condition> conditions_;
+  const std::vector<PlanNodePtr> sources_;
+  const RowTypePtr outputType_;
+};
+
+/// Represents an AS OF join: joins each left row with the single right row
+/// with the same equality keys that is nearest to it on a time-like column,
+/// e.g. the latest quote at or before the time of each trade for
+/// 'matchCondition' 'trade_time >= quote_time'. The nearest row is the one
+/// with the largest right value satisfying a '>' or '>=' condition and the
+/// one with the smallest right value satisfying a '<' or '<=' condition.
+/// Supports inner and left joins. Left joins produce nulls for the right side
+/// columns of the rows without a match.
+///
+/// Translates to an exec::AsOfJoin operator. Like for MergeJoinNode, both
+/// inputs must be sorted in ascending order on the equality keys followed by
+/// the columns of 'matchCondition'. The operator merges the two inputs and
+/// keeps at most the nearest right row of the current keys, so the memory
+/// doesn't depend on the number of rows with the same keys. The right side
+/// runs in a separate pipeline.
+class AsOfJoinNode : public PlanNode {
+ public:
+  AsOfJoinNode(
+      const PlanNodeId& id,
+      JoinType joinType,
+      const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+      const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+      IEJoinNode::Condition matchCondition,
+      PlanNodePtr left,
+      PlanNodePtr right,
+      RowTypePtr outputType);
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  const RowTypePtr& outputType() const override {
+    return outputType_;
+  }
+
+  std::string_view name() const override {
+    return "AsOfJoin";
+  }
+
+  JoinType joinType() const {
+    return joinType_;
+  }
+
+  /// Equality keys of the left side. May be empty.
+  const std::vector<FieldAccessTypedExprPtr>& leftKeys() const {
+    return leftKeys_;
+  }
+
+  /// Equality keys of the right side. Same number and types as 'leftKeys'.
+  const std::vector<FieldAccessTypedExprPtr>& rightKeys() const {
+    return rightKeys_;
+  }
+
+  /// Inequality between a left and a right column selecting the candidate
+  /// matches of a left row, of which the nearest one is returned.
+  const IEJoinNode::Condition& matchCondition() const {
+    return matchCondition_;
+  }
+
+  folly::dynamic serialize() const override;
+
+  /// If AS OF join supports this join type.
+  static bool isSupported(core::JoinType joinType);
+
+  static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const JoinType joinType_;
+  const std::vector<FieldAccessTypedExprPtr> leftKeys_;
+  const std::vector<FieldAccessTypedExprPtr> rightKeys_;
+  const IEJoinNode::Condition matchCondition_;
+  const std::vector<PlanNodePtr> sources_;
+  const RowTypePtr outputType_;
+};
+
 // Represents the 'SortBy' node in the plan.
 class OrderByNode : public PlanNode {
  public:
@@ -2295,6 +2503,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -125,6 +125,14 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of input rows whose distinct grouping keys are estimated with
+  /// HyperLogLog before partial aggregation builds its hash table. If the
+  /// estimated number of groups is at least
+  /// 'abandon_partial_aggregation_min_pct' % of the rows, partial aggregation
+  /// is abandoned without building the table. 0 disables the estimate.
+  static constexpr const char* kAbandonPartialAggregationSampleRows =
+      "abandon_partial_aggregation_sample_rows";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -199,6 +207,10 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -305,6 +317,23 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The maximum size in bytes of a Bloom filter built over a hash join build
+  /// key to push down as a dynamic filter when the key's distinct values are
+  /// too many for an exact IN filter. No Bloom filter is built if it would
+  /// exceed this size. 0 disables Bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// The target size in bytes of the radix partitions of a hash join table.
+  /// A join table whose bucket array is larger than this is split into
+  /// 2^n ranges of at most this size, indexed by the high bits of the bucket
+  /// offset. The build inserts the rows one range at a time and the probe
+  /// reorders each batch by range so that the accessed range stays in cache.
+  /// Should be set to a fraction of the last level cache size. 0 disables
+  /// radix partitioning.
+  static constexpr const char* kHashJoinRadixPartitionBytes =
+      "hash_join_radix_partition_bytes";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -347,6 +376,24 @@ class QueryConfig {
   /// derived using micro-benchmarking.
   static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
 
+  /// Maximum number of leading bytes of a VARCHAR or VARBINARY sort key to
+  /// store in the normalized key in prefix-sort. Rows with equal prefixes are
+  /// compared using the full values. Use 0 to not normalize string keys.
+  static constexpr const char* kPrefixSortMaxStringPrefixLength =
+      "prefixsort_max_string_prefix_length";
+
+  /// Maximum number of threads used to sort the buffered rows of an OrderBy
+  /// operator. If more than 1, the rows are split into ranges that are sorted
+  /// in parallel on the query executor and then merged. Sorted spill runs
+  /// are produced the same way on the spill executor.
+  static constexpr const char* kOrderBySortMaxThreads =
+      "order_by_sort_max_threads";
+
+  /// Minimum number of rows sorted by each thread when
+  /// 'order_by_sort_max_threads' is more than 1.
+  static constexpr const char* kOrderBySortMinRowsPerThread =
+      "order_by_sort_min_rows_per_thread";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -428,6 +475,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationSampleRows() const {
+    return get<int32_t>(kAbandonPartialAggregationSampleRows, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -589,6 +640,12 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MarkDistinct operator. Must also
+  /// check the spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -749,6 +806,14 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  uint64_t hashJoinRadixPartitionBytes() const {
+    return get<uint64_t>(kHashJoinRadixPartitionBytes, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -789,6 +854,18 @@ class QueryConfig {
     return get<int32_t>(kPrefixSortMinRows, 130);
   }
 
+  int32_t prefixSortMaxStringPrefixLength() const {
+    return get<int32_t>(kPrefixSortMaxStringPrefixLength, 12);
+  }
+
+  int32_t orderBySortMaxThreads() const {
+    return get<int32_t>(kOrderBySortMaxThreads, 1);
+  }
+
+  int32_t orderBySortMinRowsPerThread() const {
+    return get<int32_t>(kOrderBySortMinRowsPerThread, 100'000);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -396,10 +396,13 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          // Identifies the column for SSD admission.
+          pin.checkedEntry()->setGroupId(groupId_);
+          pin.checkedEntry()->setTrackingId(requests_[index].trackingId);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
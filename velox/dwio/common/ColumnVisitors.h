@@ -1613,6 +1613,10 @@ class StringColumnReadWithVisitorHelper {
         readHelper<velox::common::NegatedBytesValues, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
         break;
+      case velox::common::FilterKind::kBloomFilterValues:
+        readHelper<velox::common::BloomFilterValues, kIsDense>(
+            filter, extractValues, std::forward<F>(readWithVisitor));
+        break;
       default:
         readHelper<velox::common::Filter, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
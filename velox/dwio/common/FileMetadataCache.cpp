@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::dwio::common {
+
+std::string FileMetadataCache::Stats::toString() const {
+  return fmt::format(
+      "entries {} bytes {} hits {} misses {} evictions {}",
+      numEntries,
+      succinctBytes(bytes),
+      numHits,
+      numMisses,
+      numEvictions);
+}
+
+FileMetadataCache::FileMetadataCache(uint64_t maxBytes) : maxBytes_(maxBytes) {
+  VELOX_CHECK_GT(maxBytes_, 0);
+}
+
+std::shared_ptr<const CachedFileMetadata> FileMetadataCache::findInternal(
+    const Key& key) {
+  std::shared_ptr<const CachedFileMetadata> metadata;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(CacheKey{key.fileId.id(), key.modificationTime});
+    if (it == entries_.end()) {
+      ++numMisses_;
+    } else {
+      ++numHits_;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      metadata = it->second->metadata;
+    }
+  }
+  if (metadata == nullptr) {
+    RECORD_METRIC_VALUE(kMetricFileMetadataCacheNumMisses);
+  } else {
+    RECORD_METRIC_VALUE(kMetricFileMetadataCacheNumHits);
+  }
+  return metadata;
+}
+
+void FileMetadataCache::insert(
+    const Key& key,
+    std::shared_ptr<const CachedFileMetadata> metadata) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  VELOX_CHECK(key.fileId.hasValue());
+  const auto bytes = metadata->memoryBytes();
+  if (bytes > maxBytes_) {
+    return;
+  }
+  const CacheKey cacheKey{key.fileId.id(), key.modificationTime};
+  uint64_t numEntries;
+  uint64_t totalBytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(cacheKey);
+    if (it != entries_.end()) {
+      removeLocked(it->second);
+    }
+    while (bytes_ + bytes > maxBytes_) {
+      VELOX_CHECK(!lru_.empty());
+      removeLocked(std::prev(lru_.end()));
+      ++numEvictions_;
+    }
+    lru_.push_front(Entry{cacheKey, key.fileId, std::move(metadata), bytes});
+    entries_[cacheKey] = lru_.begin();
+    bytes_ += bytes;
+    numEntries = lru_.size();
+    totalBytes = bytes_;
+  }
+  // The entries are not allocated from a memory pool. The metrics show their
+  // memory instead.
+  RECORD_METRIC_VALUE(kMetricFileMetadataCacheNumEntries, numEntries);
+  RECORD_METRIC_VALUE(kMetricFileMetadataCacheBytes, totalBytes);
+}
+
+void FileMetadataCache::clear() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+  }
+  RECORD_METRIC_VALUE(kMetricFileMetadataCacheNumEntries, 0);
+  RECORD_METRIC_VALUE(kMetricFileMetadataCacheBytes, 0);
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  stats.numEntries = lru_.size();
+  stats.bytes = bytes_;
+  return stats;
+}
+
+void FileMetadataCache::removeLocked(std::list<Entry>::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+FileMetadataCache** FileMetadataCache::getInstancePtr() {
+  static FileMetadataCache* cache_{nullptr};
+  return &cache_;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/StringIdMap.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Deserialized file metadata, e.g. a Parquet FileMetaData or a DWRF footer,
+/// that is shared by the readers of the same file. Immutable once cached.
+class CachedFileMetadata {
+ public:
+  virtual ~CachedFileMetadata() = default;
+
+  /// Returns the approximate memory footprint in bytes, including the heap
+  /// memory of the decoded objects.
+  virtual uint64_t memoryBytes() const = 0;
+};
+
+/// Node-level LRU cache of deserialized file metadata. Saves decoding the
+/// footer again for each split of the same file. The entries are keyed on the
+/// id of the file path in fileIds() and the modification time of the file.
+/// Files without a known modification time must not be cached. The total
+/// memoryBytes() of the entries is kept under 'maxBytes'. Thread safe.
+///
+/// The Hive connector creates and installs the process-wide instance if
+/// HiveConfig::kFileMetadataCacheBytes is set.
+///
+/// NOTE: unlike AsyncDataCache, the entries are not allocated from a
+/// MemoryPool. They are objects decoded by thrift or protobuf from the heap,
+/// and the DWRF footer arena can't allocate from a pool either. The cache is
+/// then a fixed-size node-level budget outside query memory, like the file
+/// handle cache. 'maxBytes' is to be subtracted from the memory given to the
+/// memory manager. The memory in use is reported through the
+/// kMetricFileMetadataCacheBytes metric. The bound relies on memoryBytes()
+/// estimating the decoded size, not the serialized one.
+class FileMetadataCache {
+ public:
+  /// Identifies a version of a file.
+  struct Key {
+    /// Lease on the id of the file path. Keeps the id from being reused for a
+    /// different path while the entry is cached.
+    StringIdLease fileId;
+    int64_t modificationTime{0};
+  };
+
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+
+    std::string toString() const;
+  };
+
+  explicit FileMetadataCache(uint64_t maxBytes);
+
+  /// Returns the metadata for 'key' or nullptr if it is not cached or is not
+  /// of type T.
+  template <typename T>
+  std::shared_ptr<const T> find(const Key& key) {
+    return std::dynamic_pointer_cast<const T>(findInternal(key));
+  }
+
+  /// Adds 'metadata' for 'key', replacing any previous entry. Evicts least
+  /// recently used entries to stay within 'maxBytes'. 'metadata' is not
+  /// cached if larger than 'maxBytes'.
+  void insert(
+      const Key& key,
+      std::shared_ptr<const CachedFileMetadata> metadata);
+
+  /// Removes all entries. Metadata in use by readers stays alive until the
+  /// readers are done with it.
+  void clear();
+
+  Stats stats() const;
+
+  uint64_t maxBytes() const {
+    return maxBytes_;
+  }
+
+  /// Returns the process-wide cache or nullptr if there is none.
+  static FileMetadataCache* getInstance();
+
+  static void setInstance(FileMetadataCache* cache);
+
+ private:
+  using CacheKey = std::pair<uint64_t, int64_t>;
+
+  struct Entry {
+    CacheKey key;
+    StringIdLease fileId;
+    std::shared_ptr<const CachedFileMetadata> metadata;
+    uint64_t bytes;
+  };
+
+  std::shared_ptr<const CachedFileMetadata> findInternal(const Key& key);
+
+  void removeLocked(std::list<Entry>::iterator it);
+
+  static FileMetadataCache** getInstancePtr();
+
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+
+  // Entries in order of last use, most recent first.
+  std::list<Entry> lru_;
+
+  folly::F14FastMap<CacheKey, std::list<Entry>::iterator> entries_;
+
+  uint64_t bytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
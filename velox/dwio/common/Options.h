@@ -28,6 +28,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/ErrorTolerance.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/common/FlushPolicy.h"
 #include "velox/dwio/common/InputStream.h"
@@ -585,6 +586,24 @@ class ReaderOptions : public io::ReaderOptions {
     selectiveNimbleReaderEnabled_ = value;
   }
 
+  /// Sets the cache of deserialized file metadata and the key of the file to
+  /// read. The reader looks up its footer in 'cache' before decoding it and
+  /// adds the decoded footer on a miss. No caching if 'cache' is nullptr.
+  void setFileMetadataCache(
+      FileMetadataCache* cache,
+      FileMetadataCache::Key key) {
+    fileMetadataCache_ = cache;
+    fileMetadataCacheKey_ = std::move(key);
+  }
+
+  FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_;
+  }
+
+  const FileMetadataCache::Key& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
  private:
   uint64_t tailLocation_;
   FileFormat fileFormat_;
@@ -600,6 +619,8 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
   const tz::TimeZone* sessionTimezone_{nullptr};
   bool selectiveNimbleReaderEnabled_{false};
+  FileMetadataCache* fileMetadataCache_{nullptr};
+  FileMetadataCache::Key fileMetadataCacheKey_;
 };
 
 struct WriterOptions {
@@ -382,7 +382,15 @@ std::string ScanSpec::toString() const {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
-  filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  if (!filter_) {
+    filter_ = filter.clone();
+  } else if (filter.kind() == common::FilterKind::kBloomFilterValues) {
+    // Exact filters do not merge with Bloom filters. The Bloom filter keeps
+    // the existing filter as a conjunct instead.
+    filter_ = filter.mergeWith(filter_.get());
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
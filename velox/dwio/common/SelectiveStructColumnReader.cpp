@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -188,6 +189,10 @@ void SelectiveStructColumnReaderBase::read(
     activeRows = outputRows_;
   }
 
+  // The children without filters are read after the filters when reading in
+  // parallel, so that they are only read for the rows that pass.
+  decodedInParallel_ = decodeInParallel();
+  parallelChildSpecs_.clear();
   const auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
   for (size_t i = 0; i < childSpecs.size(); ++i) {
@@ -203,6 +208,11 @@ void SelectiveStructColumnReaderBase::read(
 
     const auto fieldIndex = childSpec->subscript();
     auto* reader = children_.at(fieldIndex);
+    if (decodedInParallel_ && !childSpec->hasFilter()) {
+      advanceFieldReader(reader, offset);
+      parallelChildSpecs_.push_back(childSpec.get());
+      continue;
+    }
     if (reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter() && !childSpec->extractValues()) {
       // Will make a LazyVector.
@@ -231,6 +241,10 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!activeRows.empty() && !parallelChildSpecs_.empty()) {
+    readChildrenInParallel(offset, activeRows, structNulls);
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -242,6 +256,27 @@ void SelectiveStructColumnReaderBase::read(
   readOffset_ = offset + rows.back() + 1;
 }
 
+void SelectiveStructColumnReaderBase::readChildrenInParallel(
+    vector_size_t offset,
+    const RowSet& rows,
+    const uint64_t* structNulls) {
+  parallelCpuNanos_.assign(parallelChildSpecs_.size(), 0);
+  ParallelFor(
+      decodingExecutor_,
+      0,
+      parallelChildSpecs_.size(),
+      decodingParallelismFactor_)
+      .execute([&](size_t i) {
+        const auto startCpuNanos = process::threadCpuNanos();
+        auto* reader = children_[parallelChildSpecs_[i]->subscript()];
+        reader->read(offset, rows, structNulls);
+        parallelCpuNanos_[i] = process::threadCpuNanos() - startCpuNanos;
+      });
+  for (auto nanos : parallelCpuNanos_) {
+    columnReaderStatistics_.parallelDecodingCpuNanos += nanos;
+  }
+}
+
 void SelectiveStructColumnReaderBase::recordParentNullsInChildren(
     vector_size_t offset,
     const RowSet& rows) {
@@ -418,7 +453,7 @@ void SelectiveStructColumnReaderBase::getValues(
     }
 
     if (childSpec->extractValues() || childSpec->hasFilter() ||
-        !children_[index]->isTopLevel()) {
+        !children_[index]->isTopLevel() || decodedInParallel_) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -104,6 +106,19 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     fillMutatedOutputRows_ = value;
   }
 
+  /// Makes read() decode the children without filters in parallel on
+  /// 'executor' once the filters have produced the rows to read, using up to
+  /// 'parallelismFactor' threads. These children are then read eagerly instead
+  /// of being returned as LazyVectors. Their CPU time is added to
+  /// ColumnReaderStatistics::parallelDecodingCpuNanos. Parallel decoding is
+  /// off if 'executor' is nullptr or 'parallelismFactor' is less than 2.
+  void setDecodingExecutor(
+      folly::Executor* executor,
+      size_t parallelismFactor) {
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -121,7 +136,8 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
       : SelectiveColumnReader(requestedType, fileType, params, scanSpec),
         debugString_(
             getExceptionContext().message(VeloxException::Type::kSystem)),
-        isRoot_(isRoot) {}
+        isRoot_(isRoot),
+        columnReaderStatistics_(params.runtimeStatistics()) {}
 
   /// Records the number of nulls added by 'this' between the end position of
   /// each child reader and the end of the range of 'read(). This must be done
@@ -139,6 +155,17 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  bool decodeInParallel() const {
+    return decodingExecutor_ != nullptr && decodingParallelismFactor_ > 1;
+  }
+
+  // Reads the children in 'parallelChildSpecs_' for 'rows' on
+  // 'decodingExecutor_'.
+  void readChildrenInParallel(
+      vector_size_t offset,
+      const RowSet& rows,
+      const uint64_t* structNulls);
+
   // Context information obtained from ExceptionContext. Stored here
   // so that LazyVector readers under this can add this to their
   // ExceptionContext. Allows contextualizing reader errors to split
@@ -168,6 +195,23 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   bool hasDeletion_ = false;
 
   bool fillMutatedOutputRows_ = false;
+
+  ColumnReaderStatistics& columnReaderStatistics_;
+
+  // Executor for reading the children without filters in parallel. Not owned.
+  folly::Executor* decodingExecutor_{nullptr};
+
+  size_t decodingParallelismFactor_{0};
+
+  // True if the last read() read all the children, so that getValues() makes
+  // no LazyVectors.
+  bool decodedInParallel_{false};
+
+  // Specs of the children read by readChildrenInParallel() in the last read().
+  std::vector<velox::common::ScanSpec*> parallelChildSpecs_;
+
+  // CPU time of reading each of 'parallelChildSpecs_'.
+  std::vector<uint64_t> parallelCpuNanos_;
 };
 
 class SelectiveStructColumnReader : public SelectiveStructColumnReaderBase {
@@ -523,6 +523,11 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // CPU time in nanoseconds spent reading the top level columns that are read
+  // in parallel on the decoding executor. Summed over the columns so that the
+  // number of runtime stats does not grow with the width of the table.
+  int64_t parallelDecodingCpuNanos{0};
 };
 
 struct RuntimeStatistics {
@@ -535,16 +540,33 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows inside of read strides skipped based on page level
+  // statistics.
+  int64_t skippedPageRows{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
-    return {
+    std::unordered_map<std::string, RuntimeCounter> result = {
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
         {"flattenStringDictionaryValues",
          RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+    // Only formats with page indexes report this.
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
+    // Only readers with a decoding executor report this.
+    if (columnReaderStatistics.parallelDecodingCpuNanos > 0) {
+      result.emplace(
+          "parallelDecodingCpuNanos",
+          RuntimeCounter(
+              columnReaderStatistics.parallelDecodingCpuNanos,
+              RuntimeCounter::Unit::kNanos));
+    }
+    return result;
   }
 };
 
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/FileIds.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+class TestMetadata : public CachedFileMetadata {
+ public:
+  TestMetadata(int32_t value, uint64_t bytes) : value_(value), bytes_(bytes) {}
+
+  uint64_t memoryBytes() const override {
+    return bytes_;
+  }
+
+  int32_t value() const {
+    return value_;
+  }
+
+ private:
+  const int32_t value_;
+  const uint64_t bytes_;
+};
+
+class OtherMetadata : public CachedFileMetadata {
+ public:
+  uint64_t memoryBytes() const override {
+    return 1;
+  }
+};
+
+FileMetadataCache::Key makeKey(
+    const std::string& path,
+    int64_t modificationTime = 0) {
+  return {StringIdLease(fileIds(), path), modificationTime};
+}
+
+} // namespace
+
+TEST(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(1'000);
+  const auto key = makeKey("/tmp/file1", 10);
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>(key));
+
+  cache.insert(key, std::make_shared<TestMetadata>(1, 100));
+  auto metadata = cache.find<TestMetadata>(key);
+  ASSERT_NE(nullptr, metadata);
+  EXPECT_EQ(1, metadata->value());
+
+  // A new version of the file is a different entry.
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>(makeKey("/tmp/file1", 11)));
+  // Metadata of another type is not returned.
+  EXPECT_EQ(nullptr, cache.find<OtherMetadata>(key));
+
+  // Inserting again replaces the entry.
+  cache.insert(key, std::make_shared<TestMetadata>(2, 200));
+  EXPECT_EQ(2, cache.find<TestMetadata>(key)->value());
+  // The replaced metadata stays alive while in use.
+  EXPECT_EQ(1, metadata->value());
+
+  auto stats = cache.stats();
+  EXPECT_EQ(3, stats.numHits);
+  EXPECT_EQ(2, stats.numMisses);
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(200, stats.bytes);
+  EXPECT_EQ(0, stats.numEvictions);
+
+  cache.clear();
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>(key));
+  EXPECT_EQ(0, cache.stats().bytes);
+}
+
+TEST(FileMetadataCacheTest, eviction) {
+  FileMetadataCache cache(1'000);
+  std::vector<FileMetadataCache::Key> keys;
+  for (auto i = 0; i < 4; ++i) {
+    keys.push_back(makeKey(fmt::format("/tmp/evict{}", i)));
+    cache.insert(keys.back(), std::make_shared<TestMetadata>(i, 300));
+  }
+  // The first file is evicted to make space for the fourth.
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>(keys[0]));
+  EXPECT_EQ(1, cache.stats().numEvictions);
+  EXPECT_EQ(900, cache.stats().bytes);
+
+  // Using the second file makes the third the least recently used.
+  ASSERT_NE(nullptr, cache.find<TestMetadata>(keys[1]));
+  cache.insert(keys[0], std::make_shared<TestMetadata>(0, 300));
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>(keys[2]));
+  EXPECT_NE(nullptr, cache.find<TestMetadata>(keys[1]));
+  EXPECT_NE(nullptr, cache.find<TestMetadata>(keys[3]));
+
+  // Metadata larger than the cache is not cached.
+  cache.insert(keys[2], std::make_shared<TestMetadata>(2, 2'000));
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>(keys[2]));
+  EXPECT_EQ(3, cache.stats().numEntries);
+}
+
+TEST(FileMetadataCacheTest, keepsFileId) {
+  FileMetadataCache cache(1'000);
+  const std::string path = "/tmp/keepsFileId";
+  uint64_t id;
+  {
+    auto key = makeKey(path);
+    id = key.fileId.id();
+    cache.insert(key, std::make_shared<TestMetadata>(1, 10));
+  }
+  // The cache holds a lease on the id of the path, so that the id still
+  // refers to the same path.
+  EXPECT_EQ(path, fileIds().string(id));
+  EXPECT_NE(nullptr, cache.find<TestMetadata>(makeKey(path)));
+}
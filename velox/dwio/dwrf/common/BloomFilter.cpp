@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+// Seed of the Murmur3 hash of ORC Bloom filters.
+constexpr uint64_t kMurmurSeed = 104729;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// The 64 bit Murmur3 variant of org.apache.orc.util.Murmur3.hash64().
+uint64_t murmur3Hash64(const uint8_t* data, size_t length) {
+  constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+  constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+  constexpr int32_t kR1 = 31;
+  constexpr int32_t kR2 = 27;
+  constexpr uint64_t kM = 5;
+  constexpr uint64_t kN1 = 0x52dce729;
+
+  uint64_t hash = kMurmurSeed;
+  const size_t numBlocks = length / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t k;
+    std::memcpy(&k, data + i * 8, sizeof(k));
+    k *= kC1;
+    k = rotateLeft(k, kR1);
+    k *= kC2;
+    hash ^= k;
+    hash = rotateLeft(hash, kR2) * kM + kN1;
+  }
+
+  const uint8_t* tail = data + numBlocks * 8;
+  const size_t tailLength = length - numBlocks * 8;
+  if (tailLength > 0) {
+    uint64_t k = 0;
+    for (size_t i = 0; i < tailLength; ++i) {
+      k ^= static_cast<uint64_t>(tail[i]) << (i * 8);
+    }
+    k *= kC1;
+    k = rotateLeft(k, kR1);
+    k *= kC2;
+    hash ^= k;
+  }
+  hash ^= length;
+  return fmix64(hash);
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(uint64_t expectedEntries, double fpp) {
+  VELOX_CHECK_GT(expectedEntries, 0);
+  VELOX_CHECK(fpp > 0 && fpp < 1, "Bloom filter fpp must be in (0, 1)");
+  const auto log2 = std::log(2.0);
+  const auto optimalBits = static_cast<uint64_t>(
+      -static_cast<double>(expectedEntries) * std::log(fpp) / (log2 * log2));
+  // ORC always adds a word, also when 'optimalBits' is a multiple of 64.
+  bits_.resize(optimalBits / 64 + 1);
+  numHashFunctions_ = std::max<uint32_t>(
+      1,
+      static_cast<uint32_t>(
+          std::round(static_cast<double>(numBits()) / expectedEntries * log2)));
+}
+
+BloomFilter::BloomFilter(const proto::BloomFilter& bloomFilter)
+    : numHashFunctions_{bloomFilter.numhashfunctions()} {
+  VELOX_CHECK_GT(numHashFunctions_, 0);
+  if (bloomFilter.has_utf8bitset()) {
+    const auto& bytes = bloomFilter.utf8bitset();
+    VELOX_CHECK_EQ(bytes.size() % sizeof(uint64_t), 0);
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    std::memcpy(bits_.data(), bytes.data(), bytes.size());
+  } else {
+    bits_.assign(bloomFilter.bitset().begin(), bloomFilter.bitset().end());
+  }
+  VELOX_CHECK(!bits_.empty(), "Empty Bloom filter");
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = static_cast<int32_t>(this->numBits());
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto bit = combined % numBits;
+    bits_[bit / 64] |= 1ULL << (bit % 64);
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = static_cast<int32_t>(this->numBits());
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto bit = combined % numBits;
+    if ((bits_[bit / 64] & (1ULL << (bit % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::reset() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+}
+
+void BloomFilter::toProto(proto::BloomFilter& bloomFilter) const {
+  bloomFilter.set_numhashfunctions(numHashFunctions_);
+  bloomFilter.set_utf8bitset(bits_.data(), bits_.size() * sizeof(uint64_t));
+}
+
+// static
+uint64_t BloomFilter::hashLong(int64_t value) {
+  // Thomas Wang's integer hash as in ORC. The right shifts are arithmetic.
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key ^= static_cast<uint64_t>(static_cast<int64_t>(key) >> 24);
+  key = key + (key << 3) + (key << 8);
+  key ^= static_cast<uint64_t>(static_cast<int64_t>(key) >> 14);
+  key = key + (key << 2) + (key << 4);
+  key ^= static_cast<uint64_t>(static_cast<int64_t>(key) >> 28);
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hashDouble(double value) {
+  // Like Java's Double.doubleToLongBits(), all NaNs have the same bits.
+  if (std::isnan(value)) {
+    value = std::numeric_limits<double>::quiet_NaN();
+  }
+  int64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return hashLong(bits);
+}
+
+// static
+uint64_t BloomFilter::hashBytes(std::string_view value) {
+  return murmur3Hash64(
+      reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// Bloom filter of the values of a column in a row group, stored in the
+/// BLOOM_FILTER_UTF8 stream. The layout and hash functions are those of the
+/// Apache ORC BloomFilter: integers and the bits of doubles are hashed with
+/// the Thomas Wang 64 bit integer hash, strings with 64 bit Murmur3.
+class BloomFilter {
+ public:
+  /// Sizes the filter for 'expectedEntries' distinct values with a false
+  /// positive probability of 'fpp'.
+  BloomFilter(uint64_t expectedEntries, double fpp);
+
+  /// Reads a filter written by toProto() or by an ORC writer.
+  explicit BloomFilter(const proto::BloomFilter& bloomFilter);
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addDouble(double value) {
+    addHash(hashDouble(value));
+  }
+
+  void addBytes(std::string_view value) {
+    addHash(hashBytes(value));
+  }
+
+  /// Returns false if no value with 'hash' was added. 'hash' comes from
+  /// hashLong(), hashDouble() or hashBytes().
+  bool testHash(uint64_t hash) const;
+
+  /// Removes all values.
+  void reset();
+
+  void toProto(proto::BloomFilter& bloomFilter) const;
+
+  uint64_t numBits() const {
+    return bits_.size() * 64;
+  }
+
+  uint32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashDouble(double value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+ private:
+  void addHash(uint64_t hash);
+
+  uint32_t numHashFunctions_;
+  std::vector<uint64_t> bits_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -21,6 +21,59 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+std::string columnsToString(const std::vector<uint32_t>& val) {
+  return folly::join(",", val);
+}
+
+std::vector<uint32_t> columnsFromString(
+    const std::string& /* key */,
+    const std::string& val) {
+  std::vector<uint32_t> result;
+  if (!val.empty()) {
+    std::vector<folly::StringPiece> pieces;
+    folly::split(',', val, pieces, true);
+    for (const auto& p : pieces) {
+      const auto& trimmedCol = folly::trimWhitespace(p);
+      if (!trimmedCol.empty()) {
+        result.push_back(folly::to<uint32_t>(trimmedCol));
+      }
+    }
+  }
+  return result;
+}
+
+// The RLE version is configured by its number, "1" or "2", as in the Apache
+// ORC writer, not by its enum ordinal.
+std::string rleVersionToString(const RleVersion& version) {
+  switch (version) {
+    case RleVersion_1:
+      return "1";
+    case RleVersion_2:
+      return "2";
+  }
+  VELOX_UNREACHABLE();
+}
+
+RleVersion rleVersionFromString(
+    const std::string& key,
+    const std::string& val) {
+  const auto trimmed = folly::trimWhitespace(val);
+  if (trimmed == "1") {
+    return RleVersion_1;
+  }
+  if (trimmed == "2") {
+    return RleVersion_2;
+  }
+  VELOX_USER_FAIL(
+      "Invalid configuration for key '{}'. RLE version must be 1 or 2, got '{}'.",
+      key,
+      val);
+}
+
+} // namespace
+
 Config::Entry<WriterVersion> Config::WRITER_VERSION(
     "orc.writer.version",
     WriterVersion_CURRENT);
@@ -59,6 +112,14 @@ Config::Entry<uint32_t> Config::ROW_INDEX_STRIDE{
     "hive.exec.orc.row.index.stride",
     10'000};
 
+Config::Entry<const std::vector<uint32_t>> Config::BLOOM_FILTER_COLUMNS(
+    "orc.bloom.filter.columns",
+    {},
+    columnsToString,
+    columnsFromString);
+
+Config::Entry<float> Config::BLOOM_FILTER_FPP{"orc.bloom.filter.fpp", 0.05f};
+
 Config::Entry<proto::ChecksumAlgorithm> Config::CHECKSUM_ALGORITHM{
     "orc.checksum.algorithm",
     proto::ChecksumAlgorithm::XXHASH};
@@ -77,6 +138,12 @@ Config::Entry<uint32_t> Config::DICTIONARY_ENCODING_INTERVAL{
 
 Config::Entry<bool> Config::USE_VINTS{"hive.exec.orc.use.vints", true};
 
+Config::Entry<RleVersion> Config::RLE_VERSION{
+    "orc.rle.version",
+    RleVersion_1,
+    rleVersionToString,
+    rleVersionFromString};
+
 Config::Entry<float> Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD{
     "hive.exec.orc.dictionary.key.numeric.size.threshold",
     0.7f};
@@ -126,21 +193,8 @@ Config::Entry<bool> Config::MAP_FLAT_DICT_SHARE(
 Config::Entry<const std::vector<uint32_t>> Config::MAP_FLAT_COLS(
     "orc.map.flat.cols",
     {},
-    [](const std::vector<uint32_t>& val) { return folly::join(",", val); },
-    [](const std::string& /* key */, const std::string& val) {
-      std::vector<uint32_t> result;
-      if (!val.empty()) {
-        std::vector<folly::StringPiece> pieces;
-        folly::split(',', val, pieces, true);
-        for (const auto& p : pieces) {
-          const auto& trimmedCol = folly::trimWhitespace(p);
-          if (!trimmedCol.empty()) {
-            result.push_back(folly::to<uint32_t>(trimmedCol));
-          }
-        }
-      }
-      return result;
-    });
+    columnsToString,
+    columnsFromString);
 
 Config::Entry<const std::vector<std::vector<std::string>>>
     Config::MAP_FLAT_COLS_STRUCT_KEYS(
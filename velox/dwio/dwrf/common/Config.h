@@ -39,11 +39,21 @@ class Config : public config::ConfigBase {
   static Entry<uint32_t> COMPRESSION_THRESHOLD;
   static Entry<bool> CREATE_INDEX;
   static Entry<uint32_t> ROW_INDEX_STRIDE;
+  /// Top level columns that get a Bloom filter per row index stride. Only
+  /// integer, floating point and varchar columns are supported. Requires
+  /// CREATE_INDEX.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLUMNS;
+  /// False positive probability of the Bloom filters.
+  static Entry<float> BLOOM_FILTER_FPP;
   static Entry<proto::ChecksumAlgorithm> CHECKSUM_ALGORITHM;
   static Entry<StripeCacheMode> STRIPE_CACHE_MODE;
   static Entry<uint32_t> STRIPE_CACHE_SIZE;
   static Entry<uint32_t> DICTIONARY_ENCODING_INTERVAL;
   static Entry<bool> USE_VINTS;
+  /// RLE version of the run length encoded integer streams, "1" or "2" in a
+  /// config map. RleVersion_2 marks the encodings of the columns that use
+  /// these streams as DIRECT_V2 or DICTIONARY_V2.
+  static Entry<RleVersion> RLE_VERSION;
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
   static Entry<bool> DICTIONARY_SORT_KEYS;
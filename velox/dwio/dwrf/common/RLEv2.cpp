@@ -107,6 +107,373 @@ inline uint32_t getClosestFixedBits(uint32_t n) {
   }
 }
 
+inline uint32_t encodeBitWidth(uint32_t n) {
+  n = getClosestFixedBits(n);
+  if (n <= 24) {
+    return n - 1;
+  } else if (n == 26) {
+    return FixedBitSizes::TWENTYSIX;
+  } else if (n == 28) {
+    return FixedBitSizes::TWENTYEIGHT;
+  } else if (n == 30) {
+    return FixedBitSizes::THIRTY;
+  } else if (n == 32) {
+    return FixedBitSizes::THIRTYTWO;
+  } else if (n == 40) {
+    return FixedBitSizes::FORTY;
+  } else if (n == 48) {
+    return FixedBitSizes::FORTYEIGHT;
+  } else if (n == 56) {
+    return FixedBitSizes::FIFTYSIX;
+  } else {
+    return FixedBitSizes::SIXTYFOUR;
+  }
+}
+
+// Returns the number of bits of the smallest width in the RLEv2 bit widths
+// that fits 'value'.
+inline uint32_t findClosestNumBits(uint64_t value) {
+  return getClosestFixedBits(value == 0 ? 0 : 64 - __builtin_clzll(value));
+}
+
+// Returns the smallest RLEv2 bit width that fits 'percentile' of the first
+// 'numValues' of 'data'.
+inline uint32_t
+percentileBits(const int64_t* data, int32_t numValues, double percentile) {
+  int32_t histogram[32] = {};
+  for (int32_t i = 0; i < numValues; ++i) {
+    ++histogram[encodeBitWidth(
+        findClosestNumBits(static_cast<uint64_t>(data[i])))];
+  }
+  auto numAbove = static_cast<int32_t>(numValues * (1.0 - percentile));
+  for (int32_t i = 31; i >= 0; --i) {
+    numAbove -= histogram[i];
+    if (numAbove < 0) {
+      return decodeBitWidth(i);
+    }
+  }
+  return 0;
+}
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeValues() {
+  if (numLiterals_ == 0) {
+    return;
+  }
+  if (variableRunLength_ == 0 && fixedRunLength_ >= RLE_MINIMUM_REPEAT) {
+    writeFixedRun();
+  } else {
+    writeVariableRun();
+  }
+}
+
+template void RleEncoderV2<true>::writeValues();
+template void RleEncoderV2<false>::writeValues();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeFixedRun() {
+  if (numLiterals_ <= kMaxShortRepeatLength) {
+    writeShortRepeat();
+  } else {
+    writeDelta(0, 0);
+  }
+}
+
+template void RleEncoderV2<true>::writeFixedRun();
+template void RleEncoderV2<false>::writeFixedRun();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeVariableRun() {
+  if (numLiterals_ == 0) {
+    return;
+  }
+  // Not worth looking for a better encoding for a few values.
+  if (numLiterals_ <= RLE_MINIMUM_REPEAT) {
+    writeDirect(0);
+    return;
+  }
+
+  int64_t min = literals_[0];
+  int64_t max = literals_[0];
+  bool increasing = true;
+  bool decreasing = true;
+  for (int32_t i = 1; i < numLiterals_; ++i) {
+    const auto value = literals_[i];
+    min = std::min(min, value);
+    max = std::max(max, value);
+    increasing &= literals_[i - 1] <= value;
+    decreasing &= literals_[i - 1] >= value;
+  }
+  int64_t range;
+  if (__builtin_sub_overflow(max, min, &range)) {
+    // Deltas may overflow. DIRECT is also faster than PATCHED_BASE here.
+    writeDirect(0);
+    return;
+  }
+
+  // No difference of 2 values overflows from here on.
+  const int64_t firstDelta = literals_[1] - literals_[0];
+  bool fixedDelta = true;
+  int64_t maxDelta = 0;
+  for (int32_t i = 2; i < numLiterals_; ++i) {
+    const int64_t delta = literals_[i] - literals_[i - 1];
+    fixedDelta &= delta == firstDelta;
+    scratch_[i - 1] = std::abs(delta);
+    maxDelta = std::max(maxDelta, scratch_[i - 1]);
+  }
+  if (fixedDelta) {
+    writeDelta(firstDelta, 0);
+    return;
+  }
+  if (firstDelta != 0 && (increasing || decreasing)) {
+    // The sign of the first delta gives the direction of the others. The
+    // encoded width of 1 bit is reserved for fixed deltas.
+    writeDelta(firstDelta, std::max(findClosestNumBits(maxDelta), 2U));
+    return;
+  }
+
+  // Patch the values if the widest 10% need more than 1 bit more than the
+  // others.
+  const auto zigzagBits = computeZigZagLiterals();
+  const auto zigzagBits90p =
+      percentileBits(scratch_.data(), numLiterals_, 0.9);
+  if (zigzagBits <= zigzagBits90p + 1 || min < -kMaxPatchedBase ||
+      min > kMaxPatchedBase) {
+    writeDirect(zigzagBits);
+    return;
+  }
+  for (int32_t i = 0; i < numLiterals_; ++i) {
+    scratch_[i] = literals_[i] - min;
+  }
+  const auto bits95p = percentileBits(scratch_.data(), numLiterals_, 0.95);
+  const auto bits100p = percentileBits(scratch_.data(), numLiterals_, 1.0);
+  // Patching does not pay if the widest 5% of the values need no more bits
+  // than the others after subtracting the base.
+  if (bits100p == bits95p) {
+    writeDirect(0);
+    return;
+  }
+  writePatchedBase(min, bits95p, bits100p);
+}
+
+template void RleEncoderV2<true>::writeVariableRun();
+template void RleEncoderV2<false>::writeVariableRun();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeRunHeader(
+    EncodingType type,
+    uint32_t encodedBitWidth) {
+  // The run length is stored minus 1 in 9 bits.
+  const uint32_t length = numLiterals_ - 1;
+  IntEncoder<isSigned>::writeByte(
+      static_cast<char>((type << 6) | (encodedBitWidth << 1) | (length >> 8)));
+  IntEncoder<isSigned>::writeByte(static_cast<char>(length & 0xff));
+}
+
+template void RleEncoderV2<true>::writeRunHeader(
+    EncodingType type,
+    uint32_t encodedBitWidth);
+template void RleEncoderV2<false>::writeRunHeader(
+    EncodingType type,
+    uint32_t encodedBitWidth);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeShortRepeat() {
+  const uint64_t value = isSigned ? ZigZag::encode(literals_[0])
+                                  : static_cast<uint64_t>(literals_[0]);
+  const int32_t numBytes = (findClosestNumBits(value) + 7) / 8;
+  IntEncoder<isSigned>::writeByte(static_cast<char>(
+      (SHORT_REPEAT << 6) | ((numBytes - 1) << 3) |
+      (numLiterals_ - RLE_MINIMUM_REPEAT)));
+  for (int32_t i = numBytes - 1; i >= 0; --i) {
+    IntEncoder<isSigned>::writeByte(static_cast<char>(value >> (i * 8)));
+  }
+  clearRun();
+}
+
+template void RleEncoderV2<true>::writeShortRepeat();
+template void RleEncoderV2<false>::writeShortRepeat();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeDirect(uint32_t zigzagBits) {
+  if (zigzagBits == 0) {
+    zigzagBits = computeZigZagLiterals();
+  }
+  writeRunHeader(DIRECT, encodeBitWidth(zigzagBits));
+  writeBitPacked(scratch_.data(), numLiterals_, zigzagBits);
+  clearRun();
+}
+
+template void RleEncoderV2<true>::writeDirect(uint32_t zigzagBits);
+template void RleEncoderV2<false>::writeDirect(uint32_t zigzagBits);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writePatchedBase(
+    int64_t base,
+    uint32_t bits95p,
+    uint32_t bits100p) {
+  uint32_t valueBits = bits95p;
+  uint32_t patchBits = getClosestFixedBits(bits100p - bits95p);
+  // A gap and a patch must fit in 64 bits together.
+  if (patchBits == 64) {
+    patchBits = 56;
+    valueBits = 8;
+  }
+
+  // Values wider than 'valueBits' keep their low bits in the packed values
+  // and their high bits in the patch list. Each patch comes with the distance
+  // from the previous patched value.
+  const int64_t mask = (1LL << valueBits) - 1;
+  std::array<int32_t, kMaxPatchListLength> gaps;
+  std::array<int64_t, kMaxPatchListLength> patches;
+  int32_t numPatches = 0;
+  int32_t previous = 0;
+  int32_t maxGap = 0;
+  for (int32_t i = 0; i < numLiterals_; ++i) {
+    if (scratch_[i] > mask) {
+      VELOX_DCHECK_LT(numPatches, kMaxPatchListLength);
+      gaps[numPatches] = i - previous;
+      patches[numPatches] = static_cast<uint64_t>(scratch_[i]) >> valueBits;
+      maxGap = std::max(maxGap, gaps[numPatches]);
+      previous = i;
+      ++numPatches;
+      scratch_[i] &= mask;
+    }
+  }
+
+  // The gap width has 3 bits in the header. Longer gaps are split into gaps
+  // of 255 with a 0 patch.
+  const uint32_t gapBits = std::min(findClosestNumBits(maxGap), 8U);
+  std::array<int64_t, kMaxPatchListLength> patchList;
+  int32_t patchListLength = 0;
+  for (int32_t i = 0; i < numPatches; ++i) {
+    uint64_t gap = gaps[i];
+    while (gap > 255) {
+      patchList[patchListLength++] = static_cast<int64_t>(255ULL << patchBits);
+      gap -= 255;
+    }
+    VELOX_DCHECK_LT(patchListLength, kMaxPatchListLength);
+    patchList[patchListLength++] = static_cast<int64_t>(
+        (gap << patchBits) | static_cast<uint64_t>(patches[i]));
+  }
+
+  // The base is stored in sign and magnitude form, big endian.
+  const bool negative = base < 0;
+  uint64_t baseValue = negative ? -base : base;
+  const int32_t baseBytes = (findClosestNumBits(baseValue) + 8) / 8;
+  if (negative) {
+    baseValue |= 1ULL << (baseBytes * 8 - 1);
+  }
+
+  writeRunHeader(PATCHED_BASE, encodeBitWidth(valueBits));
+  IntEncoder<isSigned>::writeByte(
+      static_cast<char>(((baseBytes - 1) << 5) | encodeBitWidth(patchBits)));
+  IntEncoder<isSigned>::writeByte(
+      static_cast<char>(((gapBits - 1) << 5) | patchListLength));
+  for (int32_t i = baseBytes - 1; i >= 0; --i) {
+    IntEncoder<isSigned>::writeByte(static_cast<char>(baseValue >> (i * 8)));
+  }
+  writeBitPacked(scratch_.data(), numLiterals_, valueBits);
+  writeBitPacked(
+      patchList.data(),
+      patchListLength,
+      getClosestFixedBits(gapBits + patchBits));
+  clearRun();
+}
+
+template void RleEncoderV2<true>::writePatchedBase(
+    int64_t base,
+    uint32_t bits95p,
+    uint32_t bits100p);
+template void RleEncoderV2<false>::writePatchedBase(
+    int64_t base,
+    uint32_t bits95p,
+    uint32_t bits100p);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeDelta(int64_t delta, uint32_t bitWidth) {
+  writeRunHeader(DELTA, bitWidth == 0 ? 0 : encodeBitWidth(bitWidth));
+  writeVarint(literals_[0]);
+  // The deltas are signed also for unsigned values.
+  IntEncoder<isSigned>::writeVslong(delta);
+  if (bitWidth != 0) {
+    writeBitPacked(scratch_.data() + 1, numLiterals_ - 2, bitWidth);
+  }
+  clearRun();
+}
+
+template void RleEncoderV2<true>::writeDelta(int64_t delta, uint32_t bitWidth);
+template void RleEncoderV2<false>::writeDelta(
+    int64_t delta,
+    uint32_t bitWidth);
+
+template <bool isSigned>
+uint32_t RleEncoderV2<isSigned>::computeZigZagLiterals() {
+  // The widest value has the highest bit set in the OR of all values.
+  uint64_t allBits = 0;
+  for (int32_t i = 0; i < numLiterals_; ++i) {
+    const uint64_t value = isSigned ? ZigZag::encode(literals_[i])
+                                    : static_cast<uint64_t>(literals_[i]);
+    scratch_[i] = static_cast<int64_t>(value);
+    allBits |= value;
+  }
+  return findClosestNumBits(allBits);
+}
+
+template uint32_t RleEncoderV2<true>::computeZigZagLiterals();
+template uint32_t RleEncoderV2<false>::computeZigZagLiterals();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeBitPacked(
+    const int64_t* values,
+    int32_t numValues,
+    uint32_t bitWidth) {
+  if (bitWidth % 8 == 0) {
+    // Whole bytes, big endian.
+    const int32_t numBytes = bitWidth / 8;
+    for (int32_t i = 0; i < numValues; ++i) {
+      const auto value = static_cast<uint64_t>(values[i]);
+      for (int32_t byte = numBytes - 1; byte >= 0; --byte) {
+        IntEncoder<isSigned>::writeByte(static_cast<char>(value >> (byte * 8)));
+      }
+    }
+    return;
+  }
+
+  uint32_t current = 0;
+  int32_t bitsLeft = 8;
+  for (int32_t i = 0; i < numValues; ++i) {
+    const auto value = static_cast<uint64_t>(values[i]);
+    int32_t bitsToWrite = bitWidth;
+    while (bitsToWrite > bitsLeft) {
+      current |= (value >> (bitsToWrite - bitsLeft)) & ((1U << bitsLeft) - 1);
+      IntEncoder<isSigned>::writeByte(static_cast<char>(current));
+      current = 0;
+      bitsToWrite -= bitsLeft;
+      bitsLeft = 8;
+    }
+    bitsLeft -= bitsToWrite;
+    current |= (value & ((1ULL << bitsToWrite) - 1)) << bitsLeft;
+    if (bitsLeft == 0) {
+      IntEncoder<isSigned>::writeByte(static_cast<char>(current));
+      current = 0;
+      bitsLeft = 8;
+    }
+  }
+  if (bitsLeft != 8) {
+    IntEncoder<isSigned>::writeByte(static_cast<char>(current));
+  }
+}
+
+template void RleEncoderV2<true>::writeBitPacked(
+    const int64_t* values,
+    int32_t numValues,
+    uint32_t bitWidth);
+template void RleEncoderV2<false>::writeBitPacked(
+    const int64_t* values,
+    int32_t numValues,
+    uint32_t bitWidth);
+
 template <bool isSigned>
 int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   int64_t ret = 0, val;
@@ -21,11 +21,254 @@
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/IntEncoder.h"
 
+#include <array>
 #include <vector>
 
 namespace facebook::velox::dwrf {
 
+/// Writes integers in the ORC RLEv2 format read by RleDecoderV2. Pending
+/// values are kept until a run ends. Each run is then written with the
+/// smallest of the SHORT_REPEAT, DIRECT, PATCHED_BASE and DELTA
+/// sub-encodings, using the same choice rules as the Apache ORC writer.
+template <bool isSigned>
+class RleEncoderV2 : public IntEncoder<isSigned> {
+ public:
+  /// 'useVInts' and 'numBytes' are ignored since RLEv2 has its own layout.
+  /// They are accepted for symmetry with RleEncoderV1.
+  RleEncoderV2(
+      std::unique_ptr<BufferedOutputStream> outStream,
+      bool useVInts,
+      uint32_t numBytes)
+      : IntEncoder<isSigned>{std::move(outStream), useVInts, numBytes} {}
+
+  uint64_t add(
+      const int64_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const int32_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const uint32_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const int16_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const uint16_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  void writeValue(int64_t value) override {
+    write(value);
+  }
+
+  uint64_t flush() override {
+    writeValues();
+    return IntEncoder<isSigned>::flush();
+  }
+
+  void recordPosition(PositionRecorder& recorder, int32_t strideIndex = -1)
+      const override {
+    IntEncoder<isSigned>::recordPosition(recorder, strideIndex);
+    recorder.add(static_cast<uint64_t>(numLiterals_), strideIndex);
+  }
+
+ private:
+  enum EncodingType {
+    SHORT_REPEAT = 0,
+    DIRECT = 1,
+    PATCHED_BASE = 2,
+    DELTA = 3
+  };
+
+  // Maximum number of values in a run.
+  static constexpr int32_t kMaxLiterals = 512;
+  // Maximum length of a SHORT_REPEAT run. Longer repeats are fixed DELTA.
+  static constexpr int32_t kMaxShortRepeatLength = 10;
+  // PATCHED_BASE stores the base in at most 8 bytes with a sign bit.
+  static constexpr int64_t kMaxPatchedBase = (1LL << 56) - 1;
+  // The patch list length has 5 bits in the PATCHED_BASE header.
+  static constexpr int32_t kMaxPatchListLength = 31;
+
+  void write(int64_t value) {
+    if (numLiterals_ == 0) {
+      startRun(value);
+      return;
+    }
+    if (numLiterals_ == 1) {
+      prevDeltaIsZero_ = value == literals_[0];
+      literals_[numLiterals_++] = value;
+      if (prevDeltaIsZero_) {
+        fixedRunLength_ = 2;
+        variableRunLength_ = 0;
+      } else {
+        fixedRunLength_ = 0;
+        variableRunLength_ = 2;
+      }
+      return;
+    }
+
+    const bool deltaIsZero = value == literals_[numLiterals_ - 1];
+    if (prevDeltaIsZero_ && deltaIsZero) {
+      // The last 3 values are equal.
+      literals_[numLiterals_++] = value;
+      if (variableRunLength_ > 0) {
+        fixedRunLength_ = 2;
+      }
+      ++fixedRunLength_;
+      if (fixedRunLength_ >= RLE_MINIMUM_REPEAT && variableRunLength_ > 0) {
+        // Write the values before the repeats as a run of their own.
+        numLiterals_ -= RLE_MINIMUM_REPEAT;
+        writeVariableRun();
+        for (int32_t i = 0; i < RLE_MINIMUM_REPEAT; ++i) {
+          literals_[numLiterals_++] = value;
+        }
+        fixedRunLength_ = RLE_MINIMUM_REPEAT;
+      }
+      if (fixedRunLength_ == kMaxLiterals) {
+        writeFixedRun();
+      }
+      return;
+    }
+
+    if (fixedRunLength_ >= RLE_MINIMUM_REPEAT) {
+      writeFixedRun();
+    } else if (fixedRunLength_ > 0) {
+      // Fewer than RLE_MINIMUM_REPEAT equal values start a variable run.
+      variableRunLength_ = fixedRunLength_;
+      fixedRunLength_ = 0;
+    }
+    if (numLiterals_ == 0) {
+      startRun(value);
+      return;
+    }
+    prevDeltaIsZero_ = deltaIsZero;
+    literals_[numLiterals_++] = value;
+    ++variableRunLength_;
+    if (variableRunLength_ == kMaxLiterals) {
+      writeVariableRun();
+    }
+  }
+
+  void startRun(int64_t value) {
+    literals_[numLiterals_++] = value;
+    fixedRunLength_ = 1;
+    variableRunLength_ = 1;
+  }
+
+  // Drops the pending values once written.
+  void clearRun() {
+    numLiterals_ = 0;
+    fixedRunLength_ = 0;
+    variableRunLength_ = 0;
+  }
+
+  // Writes all pending values.
+  void writeValues();
+
+  // Writes the pending values, which are all equal, as SHORT_REPEAT or as
+  // DELTA with a 0 delta.
+  void writeFixedRun();
+
+  // Writes the pending values with the sub-encoding that takes the least
+  // space.
+  void writeVariableRun();
+
+  void writeShortRepeat();
+
+  // Writes the pending values as DIRECT. 'zigzagBits' is the bit width of the
+  // zigzag encoded values in 'scratch_' or 0 if these are not computed yet.
+  void writeDirect(uint32_t zigzagBits);
+
+  // Writes the pending values as PATCHED_BASE. 'scratch_' has the values
+  // minus 'base'.
+  void writePatchedBase(int64_t base, uint32_t bits95p, uint32_t bits100p);
+
+  // Writes the pending values as DELTA. If 'bitWidth' is 0, all deltas are
+  // 'delta'. Otherwise 'scratch_' has the absolute values of the deltas after
+  // the first, which is 'delta', packed in 'bitWidth' bits.
+  void writeDelta(int64_t delta, uint32_t bitWidth);
+
+  // Writes the zigzag encoding of the pending values to 'scratch_'. Returns
+  // the bit width of the largest.
+  uint32_t computeZigZagLiterals();
+
+  // Writes 'numValues' values of 'bitWidth' bits each, most significant bit
+  // first. The last byte is padded with 0 bits.
+  void writeBitPacked(
+      const int64_t* values,
+      int32_t numValues,
+      uint32_t bitWidth);
+
+  void writeRunHeader(EncodingType type, uint32_t encodedBitWidth);
+
+  void writeVarint(int64_t value) {
+    if constexpr (isSigned) {
+      IntEncoder<isSigned>::writeVslong(value);
+    } else {
+      IntEncoder<isSigned>::writeVulong(value);
+    }
+  }
+
+  template <typename T>
+  uint64_t
+  addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
+
+  std::array<int64_t, kMaxLiterals> literals_;
+  int32_t numLiterals_{0};
+  // Number of equal values at the end of 'literals_'.
+  int32_t fixedRunLength_{0};
+  // Number of values in 'literals_' that are not part of a fixed run.
+  int32_t variableRunLength_{0};
+  // True if the last 2 values in 'literals_' are equal.
+  bool prevDeltaIsZero_{false};
+  // Zigzag encoded, base reduced or delta values of the run being written.
+  std::array<int64_t, kMaxLiterals> scratch_;
+};
+
+template <bool isSigned>
+template <typename T>
+uint64_t RleEncoderV2<isSigned>::addImpl(
+    const T* data,
+    const common::Ranges& ranges,
+    const uint64_t* nulls) {
+  uint64_t count = 0;
+  if (nulls) {
+    for (auto& pos : ranges) {
+      if (!bits::isBitNull(nulls, pos)) {
+        write(data[pos]);
+        ++count;
+      }
+    }
+  } else {
+    for (auto& pos : ranges) {
+      write(data[pos]);
+      ++count;
+    }
+  }
+  return count;
+}
+
 template <bool isSigned>
 class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
  public:
@@ -17,9 +17,89 @@
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+// Filters with more values than this are not tested against Bloom filters.
+constexpr size_t kMaxBloomFilterValues = 1'000;
+
+// Returns the Bloom filter hashes of the values that pass 'filter' on a column
+// of 'type', std::nullopt if 'filter' is not a point lookup on an integer or
+// string column. Bloom filters have no nulls, so that filters passing nulls
+// are not considered either.
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter& filter,
+    const Type& type) {
+  if (filter.testNull() || type.isDecimal()) {
+    return std::nullopt;
+  }
+  std::vector<uint64_t> hashes;
+  auto hashIntegers = [&](const auto& values) -> bool {
+    if (values.size() > kMaxBloomFilterValues ||
+        (type.kind() != TypeKind::BIGINT && type.kind() != TypeKind::INTEGER &&
+         type.kind() != TypeKind::SMALLINT &&
+         type.kind() != TypeKind::TINYINT)) {
+      return false;
+    }
+    // The writer widens all integers to 64 bits.
+    for (int64_t value : values) {
+      hashes.push_back(BloomFilter::hashLong(value));
+    }
+    return true;
+  };
+  auto hashStrings = [&](const auto& values) -> bool {
+    if (values.size() > kMaxBloomFilterValues ||
+        type.kind() != TypeKind::VARCHAR) {
+      return false;
+    }
+    for (const std::string& value : values) {
+      hashes.push_back(BloomFilter::hashBytes(value));
+    }
+    return true;
+  };
+
+  bool supported = false;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(&filter);
+      supported = range->isSingleValue() &&
+          hashIntegers(std::vector<int64_t>{range->lower()});
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      supported = hashIntegers(
+          static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+              ->values());
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      supported = hashIntegers(
+          static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+              ->values());
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(&filter);
+      supported = range->isSingleValue() &&
+          hashStrings(std::vector<std::string>{range->lower()});
+      break;
+    }
+    case common::FilterKind::kBytesValues:
+      supported = hashStrings(
+          static_cast<const common::BytesValues*>(&filter)->values());
+      break;
+    default:
+      break;
+  }
+  if (!supported) {
+    return std::nullopt;
+  }
+  return hashes;
+}
+
+} // namespace
+
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
@@ -28,6 +108,7 @@ DwrfData::DwrfData(
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
+      stripe_(stripe),
       stripeRows_{stripe.stripeRows()},
       rowsPerRowGroup_{stripe.rowsPerRowGroup()} {
   EncodingKey encodingKey{fileType_->id(), flatMapContext_.sequence};
@@ -91,6 +172,22 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+bool DwrfData::ensureBloomFilterIndex() {
+  // Bloom filters are only present for the columns the writer was configured
+  // for. The stream is read on first use so that columns without a filter that
+  // can be tested against them do not fetch it with the stripe.
+  if (!bloomFilterRead_) {
+    bloomFilterRead_ = true;
+    EncodingKey encodingKey{fileType_->id(), flatMapContext_.sequence};
+    if (auto stream = stripe_.readStream(
+            encodingKey.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8))) {
+      bloomFilterIndex_ =
+          ProtoUtils::readProto<proto::BloomFilterIndex>(std::move(stream));
+    }
+  }
+  return bloomFilterIndex_ != nullptr;
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(uint32_t index) {
   ensureRowGroupIndex();
 
@@ -165,6 +262,14 @@ void DwrfData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
 
+  std::optional<std::vector<uint64_t>> hashes;
+  if (filter) {
+    hashes = bloomFilterHashes(*filter, *fileType_->type());
+    if (hashes.has_value() && !ensureBloomFilterIndex()) {
+      hashes.reset();
+    }
+  }
+
   for (auto i = 0; i < index_->entry_size(); ++i) {
     const auto& entry = index_->entry(i);
     const auto columnStats = buildColumnStatisticsFromProto(
@@ -176,6 +281,17 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (hashes.has_value() && i < bloomFilterIndex_->bloomfilter_size()) {
+      const BloomFilter bloomFilter(bloomFilterIndex_->bloomfilter(i));
+      if (std::none_of(hashes->begin(), hashes->end(), [&](uint64_t hash) {
+            return bloomFilter.testHash(hash);
+          })) {
+        VLOG(1) << "Drop stride " << i << " on Bloom filter for "
+                << scanSpec.toString();
+        bits::setBit(result.filterResult.data(), i);
+        continue;
+      }
+    }
 
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
@@ -92,6 +92,10 @@ class DwrfData : public dwio::common::FormatData {
     return *index_;
   }
 
+  // Reads and decodes the Bloom filters of the row groups if not already
+  // done. Returns false if the column has no Bloom filters.
+  bool ensureBloomFilterIndex();
+
  private:
   static std::vector<uint64_t> toPositionsInner(
       const proto::RowIndexEntry& entry) {
@@ -102,9 +106,14 @@ class DwrfData : public dwio::common::FormatData {
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
+  // Used for reading the Bloom filters on demand. Outlives 'this'.
+  const StripeStreams& stripe_;
   std::unique_ptr<BooleanRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // True once the Bloom filter stream has been looked up.
+  bool bloomFilterRead_{false};
+  std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
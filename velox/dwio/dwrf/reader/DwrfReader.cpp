@@ -19,6 +19,7 @@
 #include <chrono>
 
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -171,6 +172,15 @@ void DwrfUnit::ensureDecoders() {
     selectiveColumnReader_->setIsTopLevel();
     selectiveColumnReader_->setFillMutatedOutputRows(
         options_.rowNumberColumnInfo().has_value());
+    if (options_.decodingExecutor()) {
+      auto* structReader =
+          dynamic_cast<dwio::common::SelectiveStructColumnReaderBase*>(
+              selectiveColumnReader_.get());
+      VELOX_CHECK_NOT_NULL(structReader);
+      structReader->setDecodingExecutor(
+          options_.decodingExecutor().get(),
+          options_.decodingParallelismFactor());
+    }
   } else {
     auto requestedType = columnSelector_->getSchemaWithId();
     auto factory = &ColumnReaderFactory::defaultFactory();
@@ -793,7 +803,9 @@ DwrfReader::DwrfReader(
                                                   : FileFormat::DWRF,
           options.fileColumnNamesReadAsLowerCase(),
           options.randomSkip(),
-          options.scanSpec())),
+          options.scanSpec(),
+          options.fileMetadataCache(),
+          options.fileMetadataCacheKey())),
       options_(options) {
   // If we are not using column names to map table columns to file columns,
   // then we use indices. In that case we need to ensure the names completely
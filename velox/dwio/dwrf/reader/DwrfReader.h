@@ -112,6 +112,8 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.skippedStrides += skippedStrides_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    stats.columnReaderStatistics.parallelDecodingCpuNanos +=
+        columnReaderStatistics_.parallelDecodingCpuNanos;
   }
 
   void resetFilterCaches() override;
@@ -32,6 +32,38 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+std::unique_ptr<PostScript> copyPostScript(const PostScript& postScript) {
+  if (postScript.format() == DwrfFormat::kDwrf) {
+    return std::make_unique<PostScript>(
+        proto::PostScript(*postScript.getDwrfPtr()));
+  }
+  return std::make_unique<PostScript>(
+      proto::orc::PostScript(*postScript.getOrcPtr()));
+}
+
+// Decoded post script and footer of a DWRF or ORC file. Shared by the readers
+// of the file through a FileMetadataCache.
+struct DwrfFileTail : public dwio::common::CachedFileMetadata {
+  uint64_t fileLength{0};
+  uint64_t psLength{0};
+  std::unique_ptr<PostScript> postScript;
+  // Owns the footer.
+  google::protobuf::Arena arena;
+  const proto::Footer* dwrfFooter{nullptr};
+  const proto::orc::Footer* orcFooter{nullptr};
+
+  uint64_t memoryBytes() const override {
+    return sizeof(*this) + psLength + arena.SpaceAllocated();
+  }
+
+  std::unique_ptr<FooterWrapper> makeFooter() const {
+    return dwrfFooter != nullptr ? std::make_unique<FooterWrapper>(dwrfFooter)
+                                 : std::make_unique<FooterWrapper>(orcFooter);
+  }
+};
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -97,7 +129,9 @@ ReaderBase::ReaderBase(
     FileFormat fileFormat,
     bool fileColumnNamesReadAsLowerCase,
     std::shared_ptr<random::RandomSkipTracker> randomSkip,
-    std::shared_ptr<velox::common::ScanSpec> scanSpec)
+    std::shared_ptr<velox::common::ScanSpec> scanSpec,
+    dwio::common::FileMetadataCache* metadataCache,
+    const dwio::common::FileMetadataCache::Key& metadataCacheKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -112,37 +146,52 @@ ReaderBase::ReaderBase(
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
   VELOX_CHECK_GE(fileLength_, 4, "File size too small");
 
+  std::shared_ptr<const DwrfFileTail> cachedTail;
+  if (metadataCache != nullptr) {
+    cachedTail = metadataCache->find<DwrfFileTail>(metadataCacheKey);
+    if (cachedTail != nullptr && cachedTail->fileLength != fileLength_) {
+      cachedTail.reset();
+    }
+  }
+
   const auto preloadFile = fileLength_ <= filePreloadThreshold_;
   const uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
-  if (input_->supportSyncLoad()) {
+  // With a cached tail, only a file to preload needs to be read here.
+  if (input_->supportSyncLoad() && (cachedTail == nullptr || preloadFile)) {
     input_->enqueue({fileLength_ - readSize, readSize, "footer"});
     input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
   }
 
-  // TODO: read footer from spectrum
-  {
-    const void* buf;
-    int32_t ignored;
-    auto lastByteStream = input_->read(fileLength_ - 1, 1, LogType::FOOTER);
-    const bool ret = lastByteStream->Next(&buf, &ignored);
-    VELOX_CHECK(ret, "Failed to read");
-    // Make sure 'lastByteStream' is live while dereferencing 'buf'.
-    psLength_ = *static_cast<const char*>(buf) & 0xff;
-  }
-  VELOX_CHECK_LE(
-      psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
-      fileLength_,
-      "Corrupted file, Post script size is invalid");
-
-  if (fileFormat == FileFormat::DWRF) {
-    auto postScript = ProtoUtils::readProto<proto::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+  if (cachedTail != nullptr) {
+    psLength_ = cachedTail->psLength;
+    postScript_ = copyPostScript(*cachedTail->postScript);
   } else {
-    auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    // TODO: read footer from spectrum
+    {
+      const void* buf;
+      int32_t ignored;
+      auto lastByteStream = input_->read(fileLength_ - 1, 1, LogType::FOOTER);
+      const bool ret = lastByteStream->Next(&buf, &ignored);
+      VELOX_CHECK(ret, "Failed to read");
+      // Make sure 'lastByteStream' is live while dereferencing 'buf'.
+      psLength_ = *static_cast<const char*>(buf) & 0xff;
+    }
+    VELOX_CHECK_LE(
+        psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
+        fileLength_,
+        "Corrupted file, Post script size is invalid");
+
+    if (fileFormat == FileFormat::DWRF) {
+      auto postScript = ProtoUtils::readProto<proto::PostScript>(input_->read(
+          fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
+      postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    } else {
+      auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
+          input_->read(
+              fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
+      postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    }
   }
 
   const uint64_t footerSize = postScript_->footerLength();
@@ -166,27 +215,43 @@ ReaderBase::ReaderBase(
       "Corrupted File, invalid compression kind ",
       postScript_->compression());
 
-  if (input_->supportSyncLoad() && (tailSize > readSize)) {
-    input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
-    input_->load(LogType::FOOTER);
-  }
-
-  auto footerStream = input_->read(
-      fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
-  if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
-    ProtoUtils::readProtoInto<proto::Footer>(
-        createDecompressedStream(std::move(footerStream), "File Footer"),
-        footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+  if (cachedTail != nullptr) {
+    footer_ = cachedTail->makeFooter();
+    tail_ = std::move(cachedTail);
   } else {
-    auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
-    ProtoUtils::readProtoInto<proto::orc::Footer>(
-        createDecompressedStream(std::move(footerStream), "File Footer"),
-        footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    if (input_->supportSyncLoad() && (tailSize > readSize)) {
+      input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
+      input_->load(LogType::FOOTER);
+    }
+
+    // The footer is decoded into the arena of 'tail' so that it can be shared
+    // with other readers of the file.
+    auto tail = std::make_shared<DwrfFileTail>();
+    auto footerStream = input_->read(
+        fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
+    if (fileFormat == FileFormat::DWRF) {
+      auto footer =
+          google::protobuf::Arena::CreateMessage<proto::Footer>(&tail->arena);
+      ProtoUtils::readProtoInto<proto::Footer>(
+          createDecompressedStream(std::move(footerStream), "File Footer"),
+          footer);
+      tail->dwrfFooter = footer;
+    } else {
+      auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
+          &tail->arena);
+      ProtoUtils::readProtoInto<proto::orc::Footer>(
+          createDecompressedStream(std::move(footerStream), "File Footer"),
+          footer);
+      tail->orcFooter = footer;
+    }
+    footer_ = tail->makeFooter();
+    if (metadataCache != nullptr) {
+      tail->fileLength = fileLength_;
+      tail->psLength = psLength_;
+      tail->postScript = copyPostScript(*postScript_);
+      metadataCache->insert(metadataCacheKey, tail);
+    }
+    tail_ = std::move(tail);
   }
 
   schema_ = std::dynamic_pointer_cast<const RowType>(
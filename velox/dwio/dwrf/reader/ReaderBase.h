@@ -73,7 +73,9 @@ class ReaderBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
       std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
-      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr);
+      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr,
+      dwio::common::FileMetadataCache* metadataCache = nullptr,
+      const dwio::common::FileMetadataCache::Key& metadataCacheKey = {});
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -250,6 +252,9 @@ class ReaderBase {
   std::unique_ptr<google::protobuf::Arena> arena_;
   std::unique_ptr<PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  // Owns the decoded footer that 'footer_' points to. May be shared with other
+  // readers through a FileMetadataCache.
+  std::shared_ptr<const dwio::common::CachedFileMetadata> tail_;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
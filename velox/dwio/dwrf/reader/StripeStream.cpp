@@ -178,6 +178,21 @@ void StripeStreamsImpl::loadStreams() {
 
   uint64_t streamOffset{0};
   for (auto& stream : stripeFooter.streams()) {
+    if (format() == DwrfFormat::kOrc &&
+        stream.kind() > proto::Stream_Kind_ROW_INDEX) {
+      // The ORC stripe footer is parsed as a DWRF one and the stream kinds
+      // after ROW_INDEX differ.
+      proto::Stream orcStream{stream};
+      if (static_cast<int>(stream.kind()) ==
+          proto::orc::Stream_Kind_BLOOM_FILTER_UTF8) {
+        orcStream.set_kind(proto::Stream_Kind_BLOOM_FILTER_UTF8);
+        addStream(orcStream, streamOffset);
+      } else {
+        // Not read, e.g. the Bloom filters of writers before ORC-101.
+        streamOffset += stream.length();
+      }
+      continue;
+    }
     addStream(stream, streamOffset);
   }
 
@@ -315,6 +330,35 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
       getDecrypter(si.encodingKey().node()));
 }
 
+std::unique_ptr<dwio::common::SeekableInputStream>
+StripeStreamsImpl::readStream(const DwrfStreamIdentifier& si) const {
+  const auto& info = getStreamInfo(si, /*throwIfNotFound=*/false);
+  if (!info.valid()) {
+    return {};
+  }
+
+  std::unique_ptr<dwio::common::SeekableInputStream> streamInput;
+  if (isIndexStream(si.kind())) {
+    streamInput = getIndexStreamFromCache(info);
+  }
+
+  if (!streamInput) {
+    // The read plan of the stripe may already be loaded, so that the stream
+    // cannot be enqueued anymore.
+    streamInput = readState_->stripeMetadata->stripeInput->read(
+        info.getOffset() + stripeStart_,
+        info.getLength(),
+        dwio::common::LogType::STREAM);
+  }
+
+  const auto streamDebugInfo =
+      fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
+  return readState_->readerBase->createDecompressedStream(
+      std::move(streamInput),
+      streamDebugInfo,
+      getDecrypter(si.encodingKey().node()));
+}
+
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
     uint32_t node,
     std::function<void(const StreamInformation&)> visitor) const {
@@ -123,6 +123,16 @@ class StripeStreams {
       std::string_view label,
       bool throwIfNotFound) const = 0;
 
+  /// Reads the stream for the given column/kind synchronously. Used for
+  /// streams that are only needed after the stripe's read plan has been
+  /// loaded, so that they are not fetched when unused. Returns nullptr if the
+  /// stream is not present. Defaults to getStream() for implementations whose
+  /// streams need no load.
+  virtual std::unique_ptr<dwio::common::SeekableInputStream> readStream(
+      const DwrfStreamIdentifier& si) const {
+    return getStream(si, {}, false);
+  }
+
   /// Gets the integer dictionary data for the given node and sequence.
   ///
   /// 'elementWidth' is the width of the data type of the column.
@@ -293,6 +303,9 @@ class StripeStreamsImpl : public StripeStreamsBase {
       std::string_view label,
       bool throwIfNotFound) const override;
 
+  std::unique_ptr<dwio::common::SeekableInputStream> readStream(
+      const DwrfStreamIdentifier& si) const override;
+
   uint32_t visitStreamsOfNode(
       uint32_t node,
       std::function<void(const StreamInformation&)> visitor) const override;
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+
+using namespace facebook::velox::dwrf;
+
+TEST(BloomFilterTest, sizing) {
+  BloomFilter bloomFilter(10'000, 0.05);
+  // -n * ln(p) / ln(2)^2 bits rounded up to the next word.
+  EXPECT_EQ(62'400, bloomFilter.numBits());
+  EXPECT_EQ(4, bloomFilter.numHashFunctions());
+
+  BloomFilter small(1, 0.5);
+  EXPECT_EQ(64, small.numBits());
+  EXPECT_LE(1, small.numHashFunctions());
+}
+
+TEST(BloomFilterTest, addAndTest) {
+  BloomFilter bloomFilter(10'000, 0.01);
+  for (int64_t i = 0; i < 10'000; ++i) {
+    bloomFilter.addLong(i * 7'919);
+    bloomFilter.addBytes(std::to_string(i));
+  }
+  bloomFilter.addDouble(1.5);
+  for (int64_t i = 0; i < 10'000; ++i) {
+    ASSERT_TRUE(bloomFilter.testHash(BloomFilter::hashLong(i * 7'919)));
+    ASSERT_TRUE(
+        bloomFilter.testHash(BloomFilter::hashBytes(std::to_string(i))));
+  }
+  EXPECT_TRUE(bloomFilter.testHash(BloomFilter::hashDouble(1.5)));
+
+  bloomFilter.reset();
+  EXPECT_FALSE(bloomFilter.testHash(BloomFilter::hashLong(7'919)));
+  EXPECT_FALSE(bloomFilter.testHash(BloomFilter::hashBytes("1")));
+}
+
+TEST(BloomFilterTest, falsePositives) {
+  BloomFilter bloomFilter(10'000, 0.05);
+  for (int64_t i = 0; i < 10'000; ++i) {
+    bloomFilter.addLong(i);
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 100'000; ++i) {
+    numFalsePositives +=
+        bloomFilter.testHash(BloomFilter::hashLong(1'000'000 + i));
+  }
+  EXPECT_LT(numFalsePositives, 6'000);
+}
+
+TEST(BloomFilterTest, nan) {
+  BloomFilter bloomFilter(100, 0.05);
+  bloomFilter.addDouble(std::nan("1"));
+  EXPECT_TRUE(bloomFilter.testHash(BloomFilter::hashDouble(-std::nan("2"))));
+}
+
+TEST(BloomFilterTest, toProto) {
+  BloomFilter bloomFilter(1'000, 0.05);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bloomFilter.addLong(i);
+  }
+  proto::BloomFilter proto;
+  bloomFilter.toProto(proto);
+  EXPECT_EQ(bloomFilter.numHashFunctions(), proto.numhashfunctions());
+  EXPECT_EQ(bloomFilter.numBits() / 8, proto.utf8bitset().size());
+
+  BloomFilter copy(proto);
+  EXPECT_EQ(bloomFilter.numBits(), copy.numBits());
+  for (int64_t i = 0; i < 1'000; ++i) {
+    ASSERT_TRUE(copy.testHash(BloomFilter::hashLong(i)));
+  }
+
+  // The bits of ORC files may also be in the bitset field.
+  proto::BloomFilter orcProto;
+  orcProto.set_numhashfunctions(proto.numhashfunctions());
+  for (auto i = 0; i < proto.utf8bitset().size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, proto.utf8bitset().data() + i, sizeof(word));
+    orcProto.add_bitset(word);
+  }
+  BloomFilter orcCopy(orcProto);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    ASSERT_TRUE(orcCopy.testHash(BloomFilter::hashLong(i)));
+  }
+}
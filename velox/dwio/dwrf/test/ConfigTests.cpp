@@ -89,3 +89,20 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
         ConfigTestParams{"12, 13, 14", {12, 13, 14}},
         ConfigTestParams{"", {}},
         ConfigTestParams{" ", {}}));
+
+TEST(ConfigTests, RleVersion) {
+  auto config = Config::fromMap({{"orc.rle.version", "2"}});
+  EXPECT_EQ(config->get(Config::RLE_VERSION), RleVersion_2);
+  config = Config::fromMap({{"orc.rle.version", "1"}});
+  EXPECT_EQ(config->get(Config::RLE_VERSION), RleVersion_1);
+  config = Config::fromMap({});
+  EXPECT_EQ(config->get(Config::RLE_VERSION), RleVersion_1);
+
+  config->set(Config::RLE_VERSION, RleVersion_2);
+  EXPECT_EQ(config->toSerdeParams().at("orc.rle.version"), "2");
+  EXPECT_EQ(config->get(Config::RLE_VERSION), RleVersion_2);
+
+  config = Config::fromMap({{"orc.rle.version", "0"}});
+  VELOX_ASSERT_USER_THROW(
+      config->get(Config::RLE_VERSION), "RLE version must be 1 or 2");
+}
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/Portability.h"
+#include "velox/common/file/File.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/E2EFilterTestBase.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
@@ -104,13 +105,31 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<DwrfReader>(opts, std::move(input));
   }
 
+  // Returns the column encodings of the first stripe of the last file
+  // written.
+  std::vector<proto::ColumnEncoding> firstStripeEncodings() {
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    auto reader = std::make_unique<DwrfReader>(
+        readerOpts,
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(sinkData_),
+            readerOpts.memoryPool()));
+    auto rowReader = reader->createDwrfRowReader(RowReaderOptions());
+    bool preload = true;
+    auto stripe = rowReader->fetchStripe(0, preload);
+    const auto& encodings = stripe->footer->encoding();
+    return {encodings.begin(), encodings.end()};
+  }
+
   std::unordered_set<std::string> flatMapColumns_;
+  RleVersion rleVersion_{RleVersion_1};
 
  private:
   dwrf::WriterOptions createWriterOptions(const TypePtr& type) {
     auto config = std::make_shared<dwrf::Config>();
     config->set(dwrf::Config::COMPRESSION, CompressionKind_NONE);
     config->set(dwrf::Config::USE_VINTS, useVInts_);
+    config->set(dwrf::Config::RLE_VERSION, rleVersion_);
     auto writerSchema = type;
     if (!flatMapColumns_.empty()) {
       auto& rowType = type->asRow();
@@ -316,6 +335,48 @@ TEST_F(E2EFilterTest, listAndMap) {
       numCombinations);
 }
 
+TEST_F(E2EFilterTest, rleV2) {
+  rleVersion_ = RleVersion_2;
+  testWithTypes(
+      "long_val:bigint,"
+      "timestamp_val:timestamp,"
+      "string_val:string,"
+      "string_dict:string,"
+      "binary_val:varbinary,"
+      "array_val:array<int>,"
+      "map_val:map<bigint,string>",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_dict", 100, true, false);
+        makeStringUnique("binary_val");
+      },
+      false,
+      {"long_val",
+       "timestamp_val",
+       "string_val",
+       "string_dict",
+       "binary_val",
+       "array_val",
+       "map_val"},
+      20,
+      true,
+      true);
+
+  // The run length encoded streams of the timestamp, string, binary, list
+  // and map columns are RLEv2, and no column is left with an RLEv1 encoding.
+  const auto encodings = firstStripeEncodings();
+  ASSERT_EQ(encodings.size(), 11);
+  for (auto node : {2, 5, 6, 8}) {
+    EXPECT_EQ(encodings[node].kind(), proto::ColumnEncoding_Kind_DIRECT_V2)
+        << node;
+  }
+  EXPECT_EQ(encodings[3].kind(), proto::ColumnEncoding_Kind_DIRECT_V2);
+  EXPECT_EQ(encodings[4].kind(), proto::ColumnEncoding_Kind_DICTIONARY_V2);
+  for (const auto& encoding : encodings) {
+    EXPECT_NE(encoding.kind(), proto::ColumnEncoding_Kind_DICTIONARY);
+  }
+}
+
 TEST_F(E2EFilterTest, nullCompactRanges) {
   // Makes a dataset with nulls at the beginning. Tries different
   // filter combinations on progressively larger batches. tests for a
@@ -64,6 +64,30 @@ static size_t generateAutoId2(int64_t startId, int64_t count) {
   return encoder->flush();
 }
 
+// Writes 'count' values like the lengths of short strings, with some
+// repeats, in RLE 'version'. Returns the encoded size.
+static size_t encodeLengths(RleVersion version, int64_t count) {
+  size_t capacity = count * folly::kMaxVarintLength64;
+  auto pool = memory::memoryManager()->addLeafPool();
+  DataBufferHolder holder{*pool, capacity};
+  auto output = std::make_unique<BufferedOutputStream>(holder);
+  auto encoder = createRleEncoder<false>(
+      version, std::move(output), true, sizeof(int32_t));
+
+  int64_t buffer[1024];
+  int64_t countRemaining = count;
+  int64_t row = 0;
+  while (countRemaining > 0) {
+    int64_t bufCount = std::min(countRemaining, (int64_t)1024);
+    for (int64_t i = 0; i < bufCount; ++i, ++row) {
+      buffer[i] = row % 100 < 20 ? 10 : (row * 7919) % 61;
+    }
+    encoder->add(buffer, common::Ranges::of(0, bufCount), nullptr);
+    countRemaining -= bufCount;
+  }
+  return encoder->flush();
+}
+
 FOLLY_ALWAYS_INLINE static int32_t findSetBitsOld(uint64_t value) {
   if (value < (1ul << 14)) {
     if (value < (1ul << 7)) {
@@ -203,6 +227,20 @@ BENCHMARK_RELATIVE(GenerateAutoIdNew_64) {
   }
 }
 
+BENCHMARK(EncodeLengthsRleV1) {
+  for (int64_t i = 0; i < iters / 10; i++) {
+    auto result = encodeLengths(RleVersion_1, 100'000);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK_RELATIVE(EncodeLengthsRleV2) {
+  for (int64_t i = 0; i < iters / 10; i++) {
+    auto result = encodeLengths(RleVersion_2, 100'000);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
 int32_t main(int32_t argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   memory::MemoryManager::initialize({});
@@ -2486,6 +2486,51 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
 
+TEST_F(TestReader, parallelDecoding) {
+  constexpr int kSize = 1'000;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row * 3; }),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return std::string(row % 30, 'x'); }),
+      makeFlatVector<double>(kSize, [](auto row) { return row / 2.0; }),
+  });
+  auto [writer, reader] = createWriterReader({batch}, pool());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*reader->rowType());
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(100, 599, false));
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(3);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  rowReaderOpts.setDecodingExecutor(executor);
+  rowReaderOpts.setDecodingParallelismFactor(3);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(reader->rowType(), 0, pool());
+  ASSERT_EQ(rowReader->next(kSize, actual), kSize);
+  auto* actualRow = actual->as<RowVector>();
+  for (const auto& child : actualRow->children()) {
+    // The children without filters are read eagerly.
+    ASSERT_FALSE(child->isLazy());
+  }
+  assertEqualVectors(
+      makeRowVector({
+          makeFlatVector<int64_t>(500, [](auto row) { return row + 100; }),
+          makeFlatVector<int64_t>(
+              500, [](auto row) { return (row + 100) * 3; }),
+          makeFlatVector<std::string>(
+              500, [](auto row) { return std::string((row + 100) % 30, 'x'); }),
+          makeFlatVector<double>(
+              500, [](auto row) { return (row + 100) / 2.0; }),
+      }),
+      actual);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_GT(stats.columnReaderStatistics.parallelDecodingCpuNanos, 0);
+  ASSERT_EQ(stats.toMap().count("parallelDecodingCpuNanos"), 1);
+}
+
 // A primitive subfield is missing in file, and result is not reused.
 TEST_F(TestReader, missingSubfieldsNoResultReusing) {
   constexpr int kSize = 10;
@@ -2566,6 +2611,75 @@ TEST_F(TestReader, selectiveStringDirect) {
   assertEqualVectors(expected, actual);
 }
 
+TEST_F(TestReader, bloomFilter) {
+  constexpr int kStride = 1'000;
+  constexpr int kNumStrides = 10;
+  // Stride 's' has the values s, 10 + s, 20 + s and so on, so that the min
+  // and max of all strides overlap and only Bloom filters can skip them.
+  auto value = [](auto row) { return (row % kStride) * 10 + row / kStride; };
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kStride * kNumStrides, value),
+      makeFlatVector<std::string>(
+          kStride * kNumStrides,
+          [&](auto row) { return std::to_string(value(row)); }),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(kStride));
+  config->set<const std::vector<uint32_t>>(
+      dwrf::Config::BLOOM_FILTER_COLUMNS, {0, 1});
+  auto [writer, reader] = createWriterReader({batch}, pool(), config);
+  auto schema = asRowType(batch->type());
+
+  // Returns the values of c0 that pass 'filter' on 'name'.
+  auto read = [&, &reader = reader](
+                  const std::string& name,
+                  std::unique_ptr<common::Filter> filter,
+                  int64_t expectedSkippedStrides) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    spec->childByName(name)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(schema, 0, pool());
+    std::vector<int64_t> values;
+    while (rowReader->next(kStride, result) > 0) {
+      auto* column =
+          result->as<RowVector>()->childAt(0)->as<SimpleVector<int64_t>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        values.push_back(column->valueAt(i));
+      }
+    }
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStrides, expectedSkippedStrides);
+    return values;
+  };
+
+  EXPECT_THAT(
+      read("c0", std::make_unique<common::BigintRange>(53, 53, false), 9),
+      ElementsAre(53));
+  EXPECT_THAT(
+      read("c0", common::createBigintValues({76, 5'000'000}, false), 9),
+      ElementsAre(76));
+  EXPECT_THAT(
+      read(
+          "c1",
+          std::make_unique<common::BytesValues>(
+              std::vector<std::string>{"53", "9"}, false),
+          8),
+      ElementsAre(53, 9));
+  // Ranges are not tested against Bloom filters.
+  EXPECT_THAT(
+      read("c0", std::make_unique<common::BigintRange>(53, 54, false), 0),
+      ElementsAre(53, 54));
+  // Neither are filters that pass nulls.
+  EXPECT_EQ(
+      read("c0", std::make_unique<common::BigintRange>(53, 53, true), 0)
+          .size(),
+      1);
+}
+
 TEST_F(TestReader, selectiveFlatMapFastPathAllInlinedStringKeys) {
   auto maps = makeMapVector<std::string, int64_t>(
       {{{"a", 0}, {"b", 0}}, {{"a", 1}, {"b", 1}}});
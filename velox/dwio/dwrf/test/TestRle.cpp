@@ -16,10 +16,14 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/IntDecoder.h"
+#include "velox/dwio/common/PositionProvider.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/common/RLEv2.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 using namespace facebook::velox;
@@ -673,6 +677,250 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+class RleEncoderV2Test : public testing::Test {
+ protected:
+  static constexpr int32_t kMemStreamSize = 1024 * 1024;
+
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Writes the non-null values of 'data' with RleEncoderV2 and checks that
+  // RleDecoderV2 reads them back. Returns the encoded size.
+  template <bool isSigned>
+  uint64_t roundTrip(
+      const std::vector<int64_t>& data,
+      const uint64_t* nulls = nullptr) {
+    dwio::common::MemorySink memSink(kMemStreamSize, {.pool = pool_.get()});
+    dwio::common::DataBufferHolder holder{
+        *pool_, 1024, 0, dwio::common::DEFAULT_PAGE_GROW_RATIO, &memSink};
+    RleEncoderV2<isSigned> encoder(
+        std::make_unique<dwio::common::BufferedOutputStream>(holder), true, 8);
+    encoder.add(data.data(), common::Ranges::of(0, data.size()), nulls);
+    encoder.flush();
+
+    RleDecoderV2<isSigned> decoder(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            memSink.data(), memSink.size()),
+        *pool_);
+    std::vector<int64_t> decoded(data.size());
+    decoder.next(decoded.data(), data.size(), nulls);
+    for (auto i = 0; i < data.size(); ++i) {
+      if (!nulls || !bits::isBitNull(nulls, i)) {
+        EXPECT_EQ(data[i], decoded[i]) << "at " << i;
+      }
+    }
+    return memSink.size();
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  std::mt19937_64 rng_{1};
+};
+
+TEST_F(RleEncoderV2Test, shortRepeat) {
+  // 1 header byte and 1 byte for the value.
+  EXPECT_EQ(2, roundTrip<true>(std::vector<int64_t>(5, 7)));
+  EXPECT_EQ(2, roundTrip<false>(std::vector<int64_t>(10, 200)));
+  // 3 bytes for the zigzag encoded value.
+  EXPECT_EQ(4, roundTrip<true>(std::vector<int64_t>(3, -100'000)));
+}
+
+TEST_F(RleEncoderV2Test, longRepeat) {
+  // Fixed delta runs of at most 512 values.
+  const auto size = roundTrip<true>(std::vector<int64_t>(10'000, -5));
+  EXPECT_LT(size, 100);
+  roundTrip<false>(std::vector<int64_t>(513, 1LL << 40));
+}
+
+TEST_F(RleEncoderV2Test, fixedDelta) {
+  std::vector<int64_t> data(2'000);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 1'000 - 3 * i;
+  }
+  EXPECT_LT(roundTrip<true>(data), 50);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 10 + 7 * i;
+  }
+  EXPECT_LT(roundTrip<false>(data), 50);
+}
+
+TEST_F(RleEncoderV2Test, monotonic) {
+  std::vector<int64_t> data(2'000);
+  int64_t value = 1LL << 50;
+  for (auto i = 0; i < data.size(); ++i) {
+    value += 1 + rng_() % 99;
+    data[i] = value;
+  }
+  // The deltas take 7 bits each.
+  EXPECT_LT(roundTrip<false>(data), data.size());
+  for (auto i = 0; i < data.size(); ++i) {
+    value -= 1 + rng_() % 99;
+    data[i] = value;
+  }
+  EXPECT_LT(roundTrip<true>(data), data.size());
+}
+
+TEST_F(RleEncoderV2Test, direct) {
+  for (auto bits : {1, 3, 8, 13, 25, 33, 63}) {
+    std::vector<int64_t> data(1'000);
+    for (auto& value : data) {
+      value = rng_() & ((1LL << bits) - 1);
+    }
+    roundTrip<false>(data);
+    for (auto& value : data) {
+      value -= 1LL << (bits - 1);
+    }
+    roundTrip<true>(data);
+  }
+}
+
+TEST_F(RleEncoderV2Test, patchedBase) {
+  // A few large values among small ones are patched.
+  std::vector<int64_t> data(1'000);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 5'000 + (i * 7) % 16;
+    if (i % 50 == 7) {
+      data[i] = 1LL << (30 + i % 20);
+    }
+  }
+  const auto patchedSize = roundTrip<true>(data);
+  // Much less than storing all values in 50 bits.
+  EXPECT_LT(patchedSize, data.size() * 2);
+  roundTrip<false>(data);
+
+  // Negative base and gaps above 255.
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = -100 - i % 4;
+  }
+  data[0] = 1LL << 48;
+  data[400] = 1LL << 52;
+  data[511] = 1LL << 55;
+  roundTrip<true>(data);
+
+  // Values that need the full 64 bits after zigzag encoding.
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i % 4;
+  }
+  data[300] = std::numeric_limits<int64_t>::max();
+  data[600] = std::numeric_limits<int64_t>::max() - 1;
+  roundTrip<true>(data);
+  roundTrip<false>(data);
+}
+
+TEST_F(RleEncoderV2Test, minAndMax) {
+  std::vector<int64_t> data{
+      std::numeric_limits<int64_t>::min(),
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min(),
+      0,
+      -1,
+      1,
+      std::numeric_limits<int64_t>::max()};
+  roundTrip<true>(data);
+  roundTrip<false>(data);
+  for (auto i = 0; i < 100; ++i) {
+    data.push_back(i % 2 ? std::numeric_limits<int64_t>::min() : i);
+  }
+  roundTrip<true>(data);
+  roundTrip<false>(data);
+}
+
+TEST_F(RleEncoderV2Test, mixedRuns) {
+  // Repeats in the middle of variable runs are split off into runs of their
+  // own.
+  std::vector<int64_t> data;
+  for (auto run = 0; run < 200; ++run) {
+    const auto length = rng_() % 40;
+    const auto kind = rng_() % 4;
+    const int64_t start = static_cast<int64_t>(rng_() % 1'000) - 500;
+    for (auto i = 0; i < length; ++i) {
+      switch (kind) {
+        case 0:
+          data.push_back(start);
+          break;
+        case 1:
+          data.push_back(start + i * 11);
+          break;
+        case 2:
+          data.push_back(start - i * (rng_() % 3));
+          break;
+        default:
+          data.push_back(static_cast<int64_t>(rng_() % 100'000) - 50'000);
+          break;
+      }
+    }
+  }
+  roundTrip<true>(data);
+  for (auto& value : data) {
+    value += 50'000;
+  }
+  roundTrip<false>(data);
+}
+
+TEST_F(RleEncoderV2Test, nulls) {
+  std::vector<int64_t> data(1'000);
+  std::vector<uint64_t> nulls(bits::nwords(data.size()), bits::kNotNull64);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i % 10 < 5 ? 42 : i;
+    if (rng_() % 3 == 0) {
+      bits::setNull(nulls.data(), i);
+    }
+  }
+  roundTrip<true>(data, nulls.data());
+  roundTrip<false>(data, nulls.data());
+
+  std::fill(nulls.begin(), nulls.end(), bits::kNull64);
+  roundTrip<true>(data, nulls.data());
+}
+
+TEST_F(RleEncoderV2Test, seek) {
+  dwio::common::MemorySink memSink(kMemStreamSize, {.pool = pool_.get()});
+  dwio::common::DataBufferHolder holder{
+      *pool_, 1024, 0, dwio::common::DEFAULT_PAGE_GROW_RATIO, &memSink};
+  RleEncoderV2<true> encoder(
+      std::make_unique<dwio::common::BufferedOutputStream>(holder), true, 8);
+
+  constexpr int32_t kStride = 1'000;
+  std::vector<int64_t> data(10 * kStride);
+  for (auto i = 0; i < data.size(); ++i) {
+    switch ((i / 300) % 3) {
+      case 0:
+        data[i] = i / 7;
+        break;
+      case 1:
+        data[i] = static_cast<int64_t>(rng_() % 1'000);
+        break;
+      default:
+        data[i] = 3 * i;
+        break;
+    }
+  }
+  TestPositionRecorder recorder;
+  for (auto i = 0; i < data.size(); i += kStride) {
+    if (i > 0) {
+      recorder.addEntry();
+    }
+    encoder.recordPosition(recorder);
+    encoder.add(data.data(), common::Ranges::of(i, i + kStride), nullptr);
+  }
+  encoder.flush();
+
+  RleDecoderV2<true> decoder(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          memSink.data(), memSink.size()),
+      *pool_);
+  std::vector<int64_t> decoded(kStride);
+  for (auto stride : {7, 2, 9, 0, 5}) {
+    dwio::common::PositionProvider positions(recorder.getPositions(stride));
+    decoder.seekToRowGroup(positions);
+    decoder.next(decoded.data(), kStride, nullptr);
+    for (auto i = 0; i < kStride; ++i) {
+      ASSERT_EQ(data[stride * kStride + i], decoded[i]);
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
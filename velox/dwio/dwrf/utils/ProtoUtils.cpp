@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/utils/ProtoUtils.h"
+#include "velox/common/base/Exceptions.h"
 #include "velox/dwio/common/exception/Exception.h"
 
 namespace facebook::velox::dwrf {
@@ -47,6 +48,63 @@ CREATE_TYPE_TRAIT(ROW, STRUCT)
 
 #undef CREATE_TYPE_TRAIT
 
+// Integer, double and string statistics have the same fields in both formats.
+template <typename From, typename To>
+void copyMinMaxSum(const From& from, To& to) {
+  if (from.has_minimum()) {
+    to.set_minimum(from.minimum());
+  }
+  if (from.has_maximum()) {
+    to.set_maximum(from.maximum());
+  }
+  if (from.has_sum()) {
+    to.set_sum(from.sum());
+  }
+}
+
+proto::orc::Stream_Kind toOrcStreamKind(proto::Stream_Kind kind) {
+  switch (kind) {
+    case proto::Stream_Kind_PRESENT:
+      return proto::orc::Stream_Kind_PRESENT;
+    case proto::Stream_Kind_DATA:
+      return proto::orc::Stream_Kind_DATA;
+    case proto::Stream_Kind_LENGTH:
+      return proto::orc::Stream_Kind_LENGTH;
+    case proto::Stream_Kind_DICTIONARY_DATA:
+      return proto::orc::Stream_Kind_DICTIONARY_DATA;
+    case proto::Stream_Kind_DICTIONARY_COUNT:
+      return proto::orc::Stream_Kind_DICTIONARY_COUNT;
+    case proto::Stream_Kind_NANO_DATA:
+      return proto::orc::Stream_Kind_SECONDARY;
+    case proto::Stream_Kind_ROW_INDEX:
+      return proto::orc::Stream_Kind_ROW_INDEX;
+    case proto::Stream_Kind_BLOOM_FILTER_UTF8:
+      return proto::orc::Stream_Kind_BLOOM_FILTER_UTF8;
+    default:
+      VELOX_FAIL(
+          "Stream kind {} is not supported in ORC",
+          proto::Stream_Kind_Name(kind));
+  }
+}
+
+proto::orc::ColumnEncoding_Kind toOrcEncodingKind(
+    proto::ColumnEncoding_Kind kind) {
+  switch (kind) {
+    case proto::ColumnEncoding_Kind_DIRECT:
+      return proto::orc::ColumnEncoding_Kind_DIRECT;
+    case proto::ColumnEncoding_Kind_DICTIONARY:
+      return proto::orc::ColumnEncoding_Kind_DICTIONARY;
+    case proto::ColumnEncoding_Kind_DIRECT_V2:
+      return proto::orc::ColumnEncoding_Kind_DIRECT_V2;
+    case proto::ColumnEncoding_Kind_DICTIONARY_V2:
+      return proto::orc::ColumnEncoding_Kind_DICTIONARY_V2;
+    default:
+      VELOX_FAIL(
+          "Column encoding {} is not supported in ORC",
+          proto::ColumnEncoding_Kind_Name(kind));
+  }
+}
+
 } // namespace
 
 void ProtoUtils::writeType(
@@ -131,4 +189,138 @@ std::shared_ptr<const Type> ProtoUtils::fromFooter(
   }
 }
 
+void ProtoUtils::toOrc(
+    const proto::ColumnStatistics& stats,
+    proto::orc::ColumnStatistics& orcStats) {
+  if (stats.has_numberofvalues()) {
+    orcStats.set_numberofvalues(stats.numberofvalues());
+  }
+  if (stats.has_hasnull()) {
+    orcStats.set_hasnull(stats.hasnull());
+  }
+  if (stats.has_intstatistics()) {
+    copyMinMaxSum(stats.intstatistics(), *orcStats.mutable_intstatistics());
+  }
+  if (stats.has_doublestatistics()) {
+    copyMinMaxSum(
+        stats.doublestatistics(), *orcStats.mutable_doublestatistics());
+  }
+  if (stats.has_stringstatistics()) {
+    copyMinMaxSum(
+        stats.stringstatistics(), *orcStats.mutable_stringstatistics());
+  }
+  if (stats.has_bucketstatistics()) {
+    *orcStats.mutable_bucketstatistics()->mutable_count() =
+        stats.bucketstatistics().count();
+  }
+  if (stats.has_binarystatistics() && stats.binarystatistics().has_sum()) {
+    orcStats.mutable_binarystatistics()->set_sum(
+        stats.binarystatistics().sum());
+  }
+  if (stats.has_size()) {
+    orcStats.set_bytesondisk(stats.size());
+  }
+}
+
+void ProtoUtils::toOrc(
+    const proto::RowIndex& index,
+    proto::orc::RowIndex& orcIndex) {
+  for (const auto& entry : index.entry()) {
+    auto* orcEntry = orcIndex.add_entry();
+    *orcEntry->mutable_positions() = entry.positions();
+    if (entry.has_statistics()) {
+      toOrc(entry.statistics(), *orcEntry->mutable_statistics());
+    }
+  }
+}
+
+void ProtoUtils::toOrc(
+    const proto::StripeFooter& footer,
+    proto::orc::StripeFooter& orcFooter) {
+  VELOX_CHECK_EQ(
+      footer.encryptiongroups_size(), 0, "ORC stripes can't be encrypted");
+  for (const auto& stream : footer.streams()) {
+    // ORC has no stream sequences and computes the offsets of the streams
+    // from their lengths.
+    VELOX_CHECK_EQ(stream.sequence(), 0);
+    VELOX_CHECK(!stream.has_offset());
+    VELOX_CHECK(stream.usevints(), "ORC integers are varints");
+    auto* orcStream = orcFooter.add_streams();
+    orcStream->set_kind(toOrcStreamKind(stream.kind()));
+    orcStream->set_column(stream.node());
+    orcStream->set_length(stream.length());
+  }
+
+  // ORC finds the encoding of a column by position.
+  std::vector<const proto::ColumnEncoding*> encodings(footer.encoding_size());
+  for (const auto& encoding : footer.encoding()) {
+    VELOX_CHECK_EQ(encoding.sequence(), 0);
+    VELOX_CHECK_LT(encoding.node(), encodings.size());
+    VELOX_CHECK_NULL(encodings[encoding.node()]);
+    encodings[encoding.node()] = &encoding;
+  }
+  for (const auto* encoding : encodings) {
+    auto* orcEncoding = orcFooter.add_columns();
+    orcEncoding->set_kind(toOrcEncodingKind(encoding->kind()));
+    if (encoding->has_dictionarysize()) {
+      orcEncoding->set_dictionarysize(encoding->dictionarysize());
+    }
+  }
+  // Timestamps are written in UTC.
+  orcFooter.set_writertimezone("UTC");
+}
+
+void ProtoUtils::toOrc(
+    const proto::Footer& footer,
+    proto::orc::Footer& orcFooter) {
+  orcFooter.set_headerlength(footer.headerlength());
+  orcFooter.set_contentlength(footer.contentlength());
+  for (const auto& stripe : footer.stripes()) {
+    auto* orcStripe = orcFooter.add_stripes();
+    orcStripe->set_offset(stripe.offset());
+    orcStripe->set_indexlength(stripe.indexlength());
+    orcStripe->set_datalength(stripe.datalength());
+    orcStripe->set_footerlength(stripe.footerlength());
+    orcStripe->set_numberofrows(stripe.numberofrows());
+  }
+  // The type kinds of DWRF are the first ones of ORC.
+  for (const auto& type : footer.types()) {
+    auto* orcType = orcFooter.add_types();
+    orcType->set_kind(static_cast<proto::orc::Type_Kind>(type.kind()));
+    *orcType->mutable_subtypes() = type.subtypes();
+    *orcType->mutable_fieldnames() = type.fieldnames();
+  }
+  for (const auto& item : footer.metadata()) {
+    auto* orcItem = orcFooter.add_metadata();
+    orcItem->set_name(item.name());
+    orcItem->set_value(item.value());
+  }
+  orcFooter.set_numberofrows(footer.numberofrows());
+  for (const auto& stats : footer.statistics()) {
+    toOrc(stats, *orcFooter.add_statistics());
+  }
+  orcFooter.set_rowindexstride(footer.rowindexstride());
+}
+
+proto::orc::CompressionKind ProtoUtils::toOrc(common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind_NONE:
+      return proto::orc::CompressionKind::NONE;
+    case common::CompressionKind_ZLIB:
+      return proto::orc::CompressionKind::ZLIB;
+    case common::CompressionKind_SNAPPY:
+      return proto::orc::CompressionKind::SNAPPY;
+    case common::CompressionKind_LZO:
+      return proto::orc::CompressionKind::LZO;
+    case common::CompressionKind_LZ4:
+      return proto::orc::CompressionKind::LZ4;
+    case common::CompressionKind_ZSTD:
+      return proto::orc::CompressionKind::ZSTD;
+    default:
+      VELOX_FAIL(
+          "Compression kind {} is not supported in ORC",
+          common::compressionKindToString(kind));
+  }
+}
+
 } // namespace facebook::velox::dwrf
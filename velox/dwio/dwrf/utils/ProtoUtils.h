@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+#include "velox/dwio/dwrf/common/wrap/orc-proto-wrapper.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::dwrf {
@@ -34,6 +36,28 @@ class ProtoUtils final {
       std::function<bool(uint32_t)> selector = [](uint32_t) { return true; },
       uint32_t index = 0);
 
+  // Conversions of the metadata written by the DWRF writer to their ORC
+  // counterparts. DWRF only information, like raw sizes, map statistics and
+  // checksums, is dropped. Fails on streams and encodings that ORC does not
+  // have.
+  static void toOrc(
+      const proto::ColumnStatistics& stats,
+      proto::orc::ColumnStatistics& orcStats);
+
+  static void toOrc(
+      const proto::RowIndex& index,
+      proto::orc::RowIndex& orcIndex);
+
+  static void toOrc(
+      const proto::StripeFooter& footer,
+      proto::orc::StripeFooter& orcFooter);
+
+  static void toOrc(
+      const proto::Footer& footer,
+      proto::orc::Footer& orcFooter);
+
+  static proto::orc::CompressionKind toOrc(common::CompressionKind kind);
+
   // Deserialize proto from inputStream. Caller can optionally pass in the
   // object to serialize to.
   template <typename T>
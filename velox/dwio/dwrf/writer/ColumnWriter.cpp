@@ -293,12 +293,16 @@ class IntegerColumnWriter : public BaseColumnWriter {
       encoding.set_kind(
           proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY);
       encoding.set_dictionarysize(finalDictionarySize_);
+      setRleVersion(encoding);
+    } else if (context_.format() == DwrfFormat::kOrc) {
+      // The data stream of direct encoding is only run length encoded in ORC.
+      setRleVersion(encoding);
     }
   }
 
   void createIndexEntry() override {
     hasNull_ = hasNull_ || indexStatsBuilder_->hasNull().value();
-    fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    mergeIndexStats();
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
@@ -387,12 +391,19 @@ class IntegerColumnWriter : public BaseColumnWriter {
     if (!data_ && !dataDirect_) {
       if (dictEncoding) {
         data_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion(),
             newStream(StreamKind::StreamKind_DATA),
             getConfig(Config::USE_VINTS),
             sizeof(T));
         inDictionary_ = createBooleanRleEncoder(
             newStream(StreamKind::StreamKind_IN_DICTIONARY));
+      } else if (context_.format() == DwrfFormat::kOrc) {
+        // ORC has no plain varint encoding for integers.
+        dataDirect_ = createRleEncoder</* isSigned */ true>(
+            rleVersion(),
+            newStream(StreamKind::StreamKind_DATA),
+            getConfig(Config::USE_VINTS),
+            sizeof(T));
       } else {
         dataDirect_ = createDirectEncoder</* isSigned */ true>(
             newStream(StreamKind::StreamKind_DATA),
@@ -664,12 +675,12 @@ class TimestampColumnWriter : public BaseColumnWriter {
       std::function<void(IndexBuilder&)> onRecordPosition)
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         seconds_{createRleEncoder</* isSigned = */ true>(
-            RleVersion_1,
+            context.getConfig(Config::RLE_VERSION),
             newStream(StreamKind::StreamKind_DATA),
             context.getConfig(Config::USE_VINTS),
             LONG_BYTE_SIZE)},
         nanos_{createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            context.getConfig(Config::RLE_VERSION),
             newStream(StreamKind::StreamKind_NANO_DATA),
             context.getConfig(Config::USE_VINTS),
             LONG_BYTE_SIZE)} {
@@ -692,6 +703,11 @@ class TimestampColumnWriter : public BaseColumnWriter {
     nanos_->recordPosition(*indexBuilder_);
   }
 
+  void setEncoding(proto::ColumnEncoding& encoding) const override {
+    BaseColumnWriter::setEncoding(encoding);
+    setRleVersion(encoding);
+  }
+
  private:
   std::unique_ptr<IntEncoder<true>> seconds_;
   std::unique_ptr<IntEncoder<false>> nanos_;
@@ -895,11 +911,12 @@ class StringColumnWriter : public BaseColumnWriter {
           proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY);
       encoding.set_dictionarysize(finalDictionarySize_);
     }
+    setRleVersion(encoding);
   }
 
   void createIndexEntry() override {
     hasNull_ = hasNull_ || indexStatsBuilder_->hasNull().value();
-    fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    mergeIndexStats();
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
@@ -985,14 +1002,14 @@ class StringColumnWriter : public BaseColumnWriter {
     if (!data_ && !dataDirect_) {
       if (dictEncoding) {
         data_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion(),
             newStream(StreamKind::StreamKind_DATA),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
         dictionaryData_ = std::make_unique<AppendOnlyBufferedStream>(
             newStream(StreamKind::StreamKind_DICTIONARY_DATA));
         dictionaryDataLength_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion(),
             newStream(StreamKind::StreamKind_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
@@ -1001,7 +1018,7 @@ class StringColumnWriter : public BaseColumnWriter {
         strideDictionaryData_ = std::make_unique<AppendOnlyBufferedStream>(
             newStream(StreamKind::StreamKind_STRIDE_DICTIONARY));
         strideDictionaryDataLength_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion(),
             newStream(StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
@@ -1009,7 +1026,7 @@ class StringColumnWriter : public BaseColumnWriter {
         dataDirect_ = std::make_unique<AppendOnlyBufferedStream>(
             newStream(StreamKind::StreamKind_DATA));
         dataDirectLength_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion(),
             newStream(StreamKind::StreamKind_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
@@ -1217,7 +1234,9 @@ void StringColumnWriter::populateDictionaryEncodingStreams() {
       pool,
       sort_,
       DictionaryEncodingUtils::frequencyOrdering,
-      true,
+      // ORC has no stride dictionaries, all the keys go to the stripe
+      // dictionary.
+      /*dropInfrequentKeys=*/context_.format() != DwrfFormat::kOrc,
       lookupTable,
       inDict,
       strideDictCounts,
@@ -1490,7 +1509,7 @@ class BinaryColumnWriter : public BaseColumnWriter {
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         data_{newStream(StreamKind::StreamKind_DATA)},
         lengths_{createRleEncoder</* isSigned */ false>(
-            RleVersion_1,
+            context.getConfig(Config::RLE_VERSION),
             newStream(StreamKind::StreamKind_LENGTH),
             context.getConfig(Config::USE_VINTS),
             dwio::common::INT_BYTE_SIZE)} {
@@ -1513,6 +1532,11 @@ class BinaryColumnWriter : public BaseColumnWriter {
     lengths_->recordPosition(*indexBuilder_);
   }
 
+  void setEncoding(proto::ColumnEncoding& encoding) const override {
+    BaseColumnWriter::setEncoding(encoding);
+    setRleVersion(encoding);
+  }
+
  private:
   AppendOnlyBufferedStream data_;
   std::unique_ptr<IntEncoder<false>> lengths_;
@@ -1733,7 +1757,7 @@ class ListColumnWriter : public BaseColumnWriter {
       std::function<void(IndexBuilder&)> onRecordPosition)
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         lengths_{createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            context.getConfig(Config::RLE_VERSION),
             newStream(StreamKind::StreamKind_LENGTH),
             context.getConfig(Config::USE_VINTS),
             dwio::common::INT_BYTE_SIZE)} {
@@ -1755,6 +1779,11 @@ class ListColumnWriter : public BaseColumnWriter {
     lengths_->recordPosition(*indexBuilder_);
   }
 
+  void setEncoding(proto::ColumnEncoding& encoding) const override {
+    BaseColumnWriter::setEncoding(encoding);
+    setRleVersion(encoding);
+  }
+
  private:
   std::unique_ptr<IntEncoder</* isSigned = */ false>> lengths_;
 };
@@ -1860,7 +1889,7 @@ class MapColumnWriter : public BaseColumnWriter {
       std::function<void(IndexBuilder&)> onRecordPosition)
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         lengths_{createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            context.getConfig(Config::RLE_VERSION),
             newStream(StreamKind::StreamKind_LENGTH),
             context.getConfig(Config::USE_VINTS),
             dwio::common::INT_BYTE_SIZE)} {
@@ -1883,6 +1912,11 @@ class MapColumnWriter : public BaseColumnWriter {
     lengths_->recordPosition(*indexBuilder_);
   }
 
+  void setEncoding(proto::ColumnEncoding& encoding) const override {
+    BaseColumnWriter::setEncoding(encoding);
+    setRleVersion(encoding);
+  }
+
  private:
   std::unique_ptr<IntEncoder<false>> lengths_;
 };
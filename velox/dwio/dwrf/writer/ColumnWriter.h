@@ -52,6 +52,11 @@ class ColumnWriter {
   virtual uint64_t writeFileStats(
       std::function<proto::ColumnStatistics&(uint32_t)> statsFactory) const = 0;
 
+  /// Writes the stats of the current stripe and starts collecting them anew.
+  /// Stripe stats are only collected for ORC files.
+  virtual void writeStripeStats(
+      std::function<proto::ColumnStatistics&(uint32_t)> statsFactory) = 0;
+
   virtual bool tryAbandonDictionaries(bool force) = 0;
 
  protected:
@@ -81,7 +86,7 @@ class BaseColumnWriter : public ColumnWriter {
     hasNull_ = hasNull_ || indexStatsBuilder_->hasNull().value();
     // We cannot determine the physical size of columns/nodes until flush
     // time, yet we need to maintain and aggregate logical stats.
-    fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    mergeIndexStats();
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
     recordPosition();
@@ -131,6 +136,16 @@ class BaseColumnWriter : public ColumnWriter {
     return size;
   }
 
+  void writeStripeStats(std::function<proto::ColumnStatistics&(uint32_t)>
+                            statsFactory) override {
+    VELOX_CHECK_NOT_NULL(stripeStatsBuilder_);
+    stripeStatsBuilder_->toProto(statsFactory(id_));
+    stripeStatsBuilder_->reset();
+    for (auto& child : children_) {
+      child->writeStripeStats(statsFactory);
+    }
+  }
+
   /// Determines whether dictionary is the right encoding to use when writing
   /// the first stripe. We will continue using the same decision for all
   /// subsequent stripes. Returns true if an encoding change is performed, false
@@ -172,6 +187,25 @@ class BaseColumnWriter : public ColumnWriter {
         StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
+    if (context_.format() == DwrfFormat::kOrc) {
+      stripeStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
+    }
+    if (useBloomFilter()) {
+      indexStatsBuilder_->enableBloomFilter(
+          getConfig(Config::ROW_INDEX_STRIDE),
+          getConfig(Config::BLOOM_FILTER_FPP));
+      indexBuilder_->setBloomFilterStream(
+          newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8));
+    }
+  }
+
+  // Adds the stats of the current row index entry to the file and stripe
+  // stats.
+  void mergeIndexStats() {
+    fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    if (stripeStatsBuilder_) {
+      stripeStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    }
   }
 
   uint64_t writeNulls(const VectorPtr& slice, const common::Ranges& ranges) {
@@ -239,6 +273,32 @@ class BaseColumnWriter : public ColumnWriter {
     return context_.getConfig(config);
   }
 
+  // RLE version of the run length encoded integer streams.
+  RleVersion rleVersion() const {
+    return getConfig(Config::RLE_VERSION);
+  }
+
+  // Changes the kind of 'encoding' to its V2 counterpart if the run length
+  // encoded streams of the column are written with RLEv2. Readers pick the
+  // RLE version from the encoding kind.
+  void setRleVersion(proto::ColumnEncoding& encoding) const {
+    if (rleVersion() != RleVersion_2) {
+      return;
+    }
+    switch (encoding.kind()) {
+      case proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DIRECT:
+        encoding.set_kind(
+            proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DIRECT_V2);
+        break;
+      case proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY:
+        encoding.set_kind(
+            proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY_V2);
+        break;
+      default:
+        break;
+    }
+  }
+
   memory::MemoryPool& getMemoryPool(const MemoryUsageCategory& category) const {
     return context_.getMemoryPool(category);
   }
@@ -247,6 +307,30 @@ class BaseColumnWriter : public ColumnWriter {
     return context_.indexEnabled();
   }
 
+  // True if the values of each stride go in a Bloom filter. Only top level
+  // columns of the types whose stats builders maintain one are supported.
+  bool useBloomFilter() const {
+    if (!isIndexEnabled() || sequence_ != 0 || isRoot() ||
+        type_.parent()->parent() != nullptr) {
+      return false;
+    }
+    switch (type_.type()->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+        break;
+      default:
+        return false;
+    }
+    const auto& columns = getConfig(Config::BLOOM_FILTER_COLUMNS);
+    return std::find(columns.begin(), columns.end(), type_.column()) !=
+        columns.end();
+  }
+
   virtual bool useDictionaryEncoding() const {
     return (sequence_ == 0 ||
             !context_.getConfig(Config::MAP_FLAT_DISABLE_DICT_ENCODING)) &&
@@ -262,6 +346,8 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<IndexBuilder> indexBuilder_;
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
+  // Set for ORC files only.
+  std::unique_ptr<StatisticsBuilder> stripeStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
   bool hasNull_ = false;
   // callback used to inject the logic that captures positions for flat map
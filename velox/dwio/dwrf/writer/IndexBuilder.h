@@ -17,7 +17,9 @@
 #pragma once
 
 #include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/dwrf/common/FileMetadata.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+#include "velox/dwio/dwrf/utils/ProtoUtils.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 
 namespace facebook::velox::dwrf {
@@ -35,8 +37,11 @@ constexpr int32_t PRESENT_STREAM_INDEX_ENTRIES_PAGED =
 
 class IndexBuilder : public PositionRecorder {
  public:
-  IndexBuilder(std::unique_ptr<BufferedOutputStream> out)
-      : out_{std::move(out)} {}
+  /// Writes the row index as a proto::orc::RowIndex if 'format' is kOrc.
+  IndexBuilder(
+      std::unique_ptr<BufferedOutputStream> out,
+      DwrfFormat format = DwrfFormat::kDwrf)
+      : out_{std::move(out)}, format_{format} {}
 
   virtual ~IndexBuilder() = default;
 
@@ -44,11 +49,21 @@ class IndexBuilder : public PositionRecorder {
     getEntry(index)->add_positions(pos);
   }
 
+  /// Also writes the Bloom filter of each entry to 'out'. The stats builders
+  /// passed to addEntry() must have a Bloom filter.
+  void setBloomFilterStream(std::unique_ptr<BufferedOutputStream> out) {
+    bloomFilterOut_ = std::move(out);
+  }
+
   virtual void addEntry(const StatisticsBuilder& writer) {
     auto* stats = entry_.mutable_statistics();
     writer.toProto(*stats);
     *index_.add_entry() = entry_;
     entry_.Clear();
+    if (bloomFilterOut_) {
+      VELOX_CHECK_NOT_NULL(writer.bloomFilter());
+      writer.bloomFilter()->toProto(*bloomFilterIndex_.add_bloomfilter());
+    }
   }
 
   virtual size_t getEntrySize() const {
@@ -59,10 +74,21 @@ class IndexBuilder : public PositionRecorder {
 
   virtual void flush() {
     // remove isPresent positions if none is null
-    index_.SerializeToZeroCopyStream(out_.get());
+    if (format_ == DwrfFormat::kOrc) {
+      proto::orc::RowIndex orcIndex;
+      ProtoUtils::toOrc(index_, orcIndex);
+      orcIndex.SerializeToZeroCopyStream(out_.get());
+    } else {
+      index_.SerializeToZeroCopyStream(out_.get());
+    }
     out_->flush();
     index_.Clear();
     entry_.Clear();
+    if (bloomFilterOut_) {
+      bloomFilterIndex_.SerializeToZeroCopyStream(bloomFilterOut_.get());
+      bloomFilterOut_->flush();
+      bloomFilterIndex_.Clear();
+    }
   }
 
   void capturePresentStreamOffset() {
@@ -98,9 +124,12 @@ class IndexBuilder : public PositionRecorder {
   }
 
   const std::unique_ptr<BufferedOutputStream> out_;
+  const DwrfFormat format_;
   proto::RowIndex index_;
   proto::RowIndexEntry entry_;
   std::optional<int32_t> presentStreamOffset_;
+  std::unique_ptr<BufferedOutputStream> bloomFilterOut_;
+  proto::BloomFilterIndex bloomFilterIndex_;
 
   friend class IndexBuilderTest;
 };
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <velox/common/base/Exceptions.h>
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/Config.h"
 #include "velox/dwio/dwrf/common/Statistics.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
@@ -145,6 +146,21 @@ class StatisticsBuilder : public virtual dwio::common::ColumnStatistics {
    */
   virtual void reset() {
     init();
+    if (bloomFilter_) {
+      bloomFilter_->reset();
+    }
+  }
+
+  /*
+   * Also collect the added values in a Bloom filter. Supported by the
+   * integer, double and string builders.
+   */
+  void enableBloomFilter(uint64_t expectedEntries, double fpp) {
+    bloomFilter_ = std::make_unique<BloomFilter>(expectedEntries, fpp);
+  }
+
+  const BloomFilter* bloomFilter() const {
+    return bloomFilter_.get();
   }
 
   /*
@@ -174,6 +190,7 @@ class StatisticsBuilder : public virtual dwio::common::ColumnStatistics {
 
  protected:
   StatisticsBuilderOptions options_;
+  std::unique_ptr<BloomFilter> bloomFilter_;
 };
 
 class BooleanStatisticsBuilder : public StatisticsBuilder,
@@ -222,6 +239,9 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
 
   void addValues(int64_t value, uint64_t count = 1) {
     increaseValueCount(count);
+    if (bloomFilter_) {
+      bloomFilter_->addLong(value);
+    }
     if (min_.has_value() && value < min_.value()) {
       min_ = value;
     }
@@ -266,6 +286,9 @@ class DoubleStatisticsBuilder : public StatisticsBuilder,
 
   void addValues(double value, uint64_t count = 1) {
     increaseValueCount(count);
+    if (bloomFilter_) {
+      bloomFilter_->addDouble(value);
+    }
     // min/max/sum is defined only when none of the values added is NaN
     if (std::isnan(value)) {
       clear();
@@ -331,6 +354,9 @@ class StringStatisticsBuilder : public StatisticsBuilder,
     // differently.
     auto isSelfEmpty = isEmpty(*this);
     increaseValueCount(count);
+    if (bloomFilter_) {
+      bloomFilter_->addBytes({value.data(), value.size()});
+    }
     if (isSelfEmpty) {
       min_ = value;
       max_ = value;
@@ -54,6 +54,25 @@ dwio::common::StripeProgress getStripeProgress(const WriterContext& context) {
           : context.getEstimatedOutputStreamSize()};
 }
 
+// Returns 'config' with the encodings and features that ORC lacks turned off.
+// DWRF integer dictionaries use the IN_DICTIONARY stream, which ORC does not
+// have. String dictionaries are kept, the string writers put all the keys in
+// the stripe dictionary in ORC mode.
+std::shared_ptr<const Config> toOrcConfig(const Config& config) {
+  auto orcConfig = std::make_shared<Config>();
+  for (const auto& [key, value] : config.rawConfigsCopy()) {
+    orcConfig->set(key, value);
+  }
+  VELOX_USER_CHECK(
+      !orcConfig->get(Config::FLATTEN_MAP), "ORC has no flat maps");
+  orcConfig->set(Config::RLE_VERSION, RleVersion_2);
+  orcConfig->set(Config::USE_VINTS, true);
+  orcConfig->set(Config::INTEGER_DICTIONARY_ENCODING_ENABLED, false);
+  orcConfig->set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  orcConfig->set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  return orcConfig;
+}
+
 #define NON_RECLAIMABLE_SECTION_CHECK() \
   VELOX_CHECK(nonReclaimableSection_ == nullptr || *nonReclaimableSection_);
 } // namespace
@@ -69,13 +88,21 @@ Writer::Writer(
   VELOX_CHECK(
       spillConfig_ == nullptr || nonReclaimableSection_ != nullptr,
       "nonReclaimableSection_ must be set if writer memory reclaim is enabled");
+  const bool orc = options.format == DwrfFormat::kOrc;
+  VELOX_USER_CHECK(
+      !orc || options.encryptionSpec == nullptr,
+      "ORC files can't be encrypted");
   auto handler =
       (options.encryptionSpec ? encryption::EncryptionHandler::create(
                                     schema_,
                                     *options.encryptionSpec,
                                     options.encrypterFactory.get())
                               : nullptr);
-  writerBase_->initContext(options.config, pool, std::move(handler));
+  writerBase_->initContext(
+      orc ? toOrcConfig(*options.config) : options.config,
+      pool,
+      std::move(handler),
+      options.format);
 
   auto& context = writerBase_->getContext();
   VELOX_CHECK_EQ(
@@ -518,7 +545,13 @@ void Writer::flushStripe(bool close) {
   DWIO_ENSURE_EQ(footerOffset, stripeOffset + dataLength + indexLength);
 
   sink.setMode(WriterSink::Mode::Footer);
-  writerBase_->writeProto(encodingManager.getFooter());
+  if (context.format() == DwrfFormat::kOrc) {
+    proto::orc::StripeFooter orcFooter;
+    ProtoUtils::toOrc(encodingManager.getFooter(), orcFooter);
+    writerBase_->writeProto(orcFooter);
+  } else {
+    writerBase_->writeProto(encodingManager.getFooter());
+  }
   sink.setMode(WriterSink::Mode::None);
 
   auto& stripe = writerBase_->addStripeInfo();
@@ -527,6 +560,19 @@ void Writer::flushStripe(bool close) {
   stripe.set_datalength(dataLength);
   stripe.set_footerlength(sink.size() - footerOffset);
 
+  if (context.format() == DwrfFormat::kOrc) {
+    // All the row index entries of the stripe have been created.
+    google::protobuf::RepeatedPtrField<proto::ColumnStatistics> stripeStats;
+    writer_->writeStripeStats(
+        [&](uint32_t /* nodeId */) -> proto::ColumnStatistics& {
+          return *stripeStats.Add();
+        });
+    auto& orcStripeStats = writerBase_->addOrcStripeStatistics();
+    for (const auto& stats : stripeStats) {
+      ProtoUtils::toOrc(stats, *orcStripeStats.add_colstats());
+    }
+  }
+
   // set encryption key metadata
   if (handler.isEncrypted() && context.stripeIndex() == 0) {
     for (uint32_t i = 0; i < handler.getEncryptionGroupCount(); ++i) {
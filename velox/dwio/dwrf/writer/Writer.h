@@ -42,6 +42,11 @@ struct WriterOptions : public dwio::common::WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// Writes an ORC file if kOrc. The writer then uses the encodings and
+  /// streams that ORC has: RLEv2 integers, string dictionaries without stride
+  /// dictionaries, and no integer dictionaries, stripe cache, checksums,
+  /// encryption or flat maps.
+  DwrfFormat format{DwrfFormat::kDwrf};
 };
 
 class Writer : public dwio::common::Writer {
@@ -20,6 +20,14 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+// ORC-135: timestamp statistics are in UTC. Also implies UTF-8 Bloom filters
+// (ORC-101).
+constexpr uint32_t kOrcWriterVersion = 6;
+
+} // namespace
+
 void WriterBase::writeFooter(const Type& type) {
   auto pos = writerSink_->size();
   footer_.set_headerlength(ORC_MAGIC_LEN);
@@ -53,24 +61,54 @@ void WriterBase::writeFooter(const Type& type) {
   footer_.set_checksumalgorithm(
       (checksum != nullptr) ? checksum->getType()
                             : proto::ChecksumAlgorithm::NULL_);
-  writeProto(footer_);
+  const bool orc = context_->format() == DwrfFormat::kOrc;
+  uint64_t metadataLength = 0;
+  if (orc) {
+    // The stripe statistics precede the footer.
+    writeProto(orcMetadata_);
+    metadataLength = writerSink_->size() - pos;
+    pos = writerSink_->size();
+    proto::orc::Footer orcFooter;
+    ProtoUtils::toOrc(footer_, orcFooter);
+    writeProto(orcFooter);
+  } else {
+    writeProto(footer_);
+  }
   const auto footerLength = writerSink_->size() - pos;
 
   // write postscript
   pos = writerSink_->size();
-  proto::PostScript ps;
-  ps.set_writerversion(writerVersion);
-  ps.set_footerlength(footerLength);
-  ps.set_compression(
-      static_cast<proto::CompressionKind>(context_->compression()));
-  if (context_->compression() !=
-      common::CompressionKind::CompressionKind_NONE) {
-    ps.set_compressionblocksize(context_->compressionBlockSize());
+  if (orc) {
+    VELOX_CHECK_EQ(cacheSize, 0, "ORC files have no stripe cache");
+    proto::orc::PostScript ps;
+    ps.set_footerlength(footerLength);
+    ps.set_compression(ProtoUtils::toOrc(context_->compression()));
+    if (context_->compression() !=
+        common::CompressionKind::CompressionKind_NONE) {
+      ps.set_compressionblocksize(context_->compressionBlockSize());
+    }
+    // File format version 0.12.
+    ps.add_version(0);
+    ps.add_version(12);
+    ps.set_metadatalength(metadataLength);
+    ps.set_writerversion(kOrcWriterVersion);
+    ps.set_magic(ORC_MAGIC.data(), ORC_MAGIC_LEN);
+    writeProto(ps, common::CompressionKind::CompressionKind_NONE);
+  } else {
+    proto::PostScript ps;
+    ps.set_writerversion(writerVersion);
+    ps.set_footerlength(footerLength);
+    ps.set_compression(
+        static_cast<proto::CompressionKind>(context_->compression()));
+    if (context_->compression() !=
+        common::CompressionKind::CompressionKind_NONE) {
+      ps.set_compressionblocksize(context_->compressionBlockSize());
+    }
+    ps.set_cachemode(
+        static_cast<proto::StripeCacheMode>(writerSink_->getCacheMode()));
+    ps.set_cachesize(cacheSize);
+    writeProto(ps, common::CompressionKind::CompressionKind_NONE);
   }
-  ps.set_cachemode(
-      static_cast<proto::StripeCacheMode>(writerSink_->getCacheMode()));
-  ps.set_cachesize(cacheSize);
-  writeProto(ps, common::CompressionKind::CompressionKind_NONE);
   auto psLength = writerSink_->size() - pos;
   DWIO_ENSURE_LE(psLength, 0xff, "PostScript is too large: ", psLength);
   auto psLen = static_cast<char>(psLength);
@@ -74,9 +74,14 @@ class WriterBase {
   void initContext(
       const std::shared_ptr<const Config>& config,
       std::shared_ptr<velox::memory::MemoryPool> pool,
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr) {
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      DwrfFormat format = DwrfFormat::kDwrf) {
     context_ = std::make_unique<WriterContext>(
-        config, std::move(pool), sink_->metricsLog(), std::move(handler));
+        config,
+        std::move(pool),
+        sink_->metricsLog(),
+        std::move(handler),
+        format);
     writerSink_ = std::make_unique<WriterSink>(
         *sink_,
         context_->getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
@@ -144,6 +149,13 @@ class WriterBase {
     return footer_;
   }
 
+  /// Adds the statistics of the next stripe of an ORC file. They are written
+  /// before the footer.
+  proto::orc::StripeStatistics& addOrcStripeStatistics() {
+    VELOX_CHECK(context_->format() == DwrfFormat::kOrc);
+    return *orcMetadata_.add_stripestats();
+  }
+
   void validateStreamSize(
       const DwrfStreamIdentifier& streamId,
       uint64_t streamSize) {
@@ -164,6 +176,8 @@ class WriterBase {
   std::unique_ptr<dwio::common::FileSink> sink_;
   std::unique_ptr<WriterSink> writerSink_;
   proto::Footer footer_;
+  // Stripe statistics of ORC files.
+  proto::orc::Metadata orcMetadata_;
   std::unordered_map<std::string, std::string> userMetadata_;
 
   friend class WriterTest;
@@ -27,8 +27,10 @@ WriterContext::WriterContext(
     const std::shared_ptr<const Config>& config,
     std::shared_ptr<memory::MemoryPool> pool,
     const dwio::common::MetricsLogPtr& metricLogger,
-    std::unique_ptr<encryption::EncryptionHandler> handler)
+    std::unique_ptr<encryption::EncryptionHandler> handler,
+    DwrfFormat format)
     : config_{config},
+      format_{format},
       pool_{std::move(pool)},
       dictionaryPool_{
           pool_->addLeafChild(fmt::format("{}.dictionary", pool_->name()))},
@@ -23,6 +23,7 @@
 #include "velox/dwio/dwrf/common/Compression.h"
 #include "velox/dwio/dwrf/common/Config.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
+#include "velox/dwio/dwrf/common/FileMetadata.h"
 #include "velox/dwio/dwrf/writer/IndexBuilder.h"
 #include "velox/dwio/dwrf/writer/IntegerDictionaryEncoder.h"
 #include "velox/dwio/dwrf/writer/PhysicalSizeAggregator.h"
@@ -43,10 +44,17 @@ class WriterContext : public CompressionBufferPool {
       std::shared_ptr<memory::MemoryPool> pool,
       const dwio::common::MetricsLogPtr& metricLogger =
           dwio::common::MetricsLog::voidLog(),
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr);
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      DwrfFormat format = DwrfFormat::kDwrf);
 
   ~WriterContext() override;
 
+  /// Format of the file metadata. The streams of kOrc files are laid out
+  /// like in DWRF, only the protos describing them differ.
+  DwrfFormat format() const {
+    return format_;
+  }
+
   bool hasStream(const DwrfStreamIdentifier& stream) const {
     return streams_.find(stream) != streams_.end();
   }
@@ -139,7 +147,7 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream> stream) const {
     return indexBuilderFactory_
         ? indexBuilderFactory_(std::move(stream))
-        : std::make_unique<IndexBuilder>(std::move(stream));
+        : std::make_unique<IndexBuilder>(std::move(stream), format_);
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
@@ -612,6 +620,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   const std::shared_ptr<const Config> config_;
+  const DwrfFormat format_;
   const std::shared_ptr<memory::MemoryPool> pool_;
   const std::shared_ptr<memory::MemoryPool> dictionaryPool_;
   const std::shared_ptr<memory::MemoryPool> outputStreamPool_;
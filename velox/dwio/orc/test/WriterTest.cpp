@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/orc/writer/OrcWriter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::dwrf;
+using namespace facebook::velox::test;
+
+namespace {
+
+class OrcWriterTest : public testing::Test, public VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    orc::registerOrcWriterFactory();
+  }
+
+  static void TearDownTestCase() {
+    orc::unregisterOrcWriterFactory();
+  }
+
+  // Writes 'batches' with the ORC writer factory and returns the file. Each
+  // batch goes to its own stripe if 'stripePerBatch' is true.
+  std::string write(
+      const std::vector<RowVectorPtr>& batches,
+      const std::shared_ptr<Config>& config,
+      bool stripePerBatch = false) {
+    auto options = getWriterFactory(FileFormat::ORC)->createWriterOptions();
+    auto* dwrfOptions = dynamic_cast<dwrf::WriterOptions*>(options.get());
+    VELOX_CHECK_NOT_NULL(dwrfOptions);
+    dwrfOptions->config = config;
+    options->schema = batches[0]->type();
+    options->memoryPool = rootPool_.get();
+    auto sink = std::make_unique<MemorySink>(
+        1 << 20, FileSink::Options{.pool = pool()});
+    auto* sinkPtr = sink.get();
+    auto writer = getWriterFactory(FileFormat::ORC)
+                      ->createWriter(std::move(sink), std::move(options));
+    for (const auto& batch : batches) {
+      writer->write(batch);
+      if (stripePerBatch) {
+        writer->flush();
+      }
+    }
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  }
+
+  std::unique_ptr<DwrfReader> createReader(std::string data) {
+    ReaderOptions readerOpts{pool()};
+    readerOpts.setFileFormat(FileFormat::ORC);
+    return DwrfReader::create(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(std::move(data)), *pool()),
+        readerOpts);
+  }
+};
+
+} // namespace
+
+TEST_F(OrcWriterTest, roundTrip) {
+  constexpr int32_t kSize = 10'000;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return row * 1'000'003LL; },
+          [](auto row) { return row % 11 == 0; }),
+      // Few distinct values that would be dictionary encoded in DWRF.
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 7; }),
+      makeFlatVector<int16_t>(kSize, [](auto row) { return row - 5'000; }),
+      makeFlatVector<int8_t>(kSize, [](auto row) { return row % 100; }),
+      makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.25; }),
+      makeFlatVector<float>(kSize, [](auto row) { return row * 1.5f; }),
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) { return fmt::format("value {}", row % 20); },
+          [](auto row) { return row % 13 == 0; }),
+      makeFlatVector<Timestamp>(
+          kSize,
+          [](auto row) { return Timestamp(1'600'000'000 + row, row * 1'000); }),
+      makeArrayVector<int32_t>(
+          kSize,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; }),
+      makeMapVector<int32_t, int64_t>(
+          kSize,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row; },
+          [](auto row) { return row * 3; }),
+      makeRowVector({makeFlatVector<int64_t>(kSize, folly::identity)}),
+  });
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, common::CompressionKind_ZSTD);
+  config->set(Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1'000));
+  config->set(Config::INTEGER_DICTIONARY_ENCODING_ENABLED, true);
+  config->set(Config::STRING_DICTIONARY_ENCODING_ENABLED, true);
+  config->set<const std::vector<uint32_t>>(
+      Config::BLOOM_FILTER_COLUMNS, {0, 7});
+  auto data = write({batch, batch}, config);
+
+  // The postscript is an ORC one.
+  const auto psLength = static_cast<uint8_t>(data.back());
+  proto::orc::PostScript postScript;
+  ASSERT_TRUE(postScript.ParseFromArray(
+      data.data() + data.size() - 1 - psLength, psLength));
+  EXPECT_EQ("ORC", postScript.magic());
+  EXPECT_EQ(proto::orc::CompressionKind::ZSTD, postScript.compression());
+  ASSERT_EQ(2, postScript.version_size());
+  EXPECT_EQ(0, postScript.version(0));
+  EXPECT_EQ(12, postScript.version(1));
+
+  auto reader = createReader(std::move(data));
+  EXPECT_EQ(common::CompressionKind_ZSTD, reader->getCompression());
+  EXPECT_EQ(1'000, reader->strideSize());
+  EXPECT_EQ(2 * kSize, reader->numberOfRows().value());
+  auto stats = std::dynamic_pointer_cast<IntegerColumnStatistics>(
+      std::shared_ptr<ColumnStatistics>(reader->columnStatistics(1)));
+  ASSERT_NE(nullptr, stats);
+  EXPECT_TRUE(stats->hasNull().value());
+  EXPECT_EQ(1'000'003, stats->getMinimum().value());
+  // Row 9'999 is null.
+  EXPECT_EQ(9'998 * 1'000'003LL, stats->getMaximum().value());
+
+  // Integers and lengths are RLEv2 encoded. Only the strings use a
+  // dictionary.
+  auto rowReader = reader->createRowReader(RowReaderOptions());
+  auto* dwrfRowReader = dynamic_cast<DwrfRowReader*>(rowReader.get());
+  bool preload = true;
+  auto stripe = dwrfRowReader->fetchStripe(0, preload);
+  const auto& encodings = stripe->footer->encoding();
+  ASSERT_EQ(batch->type()->size() + 1 + 4, encodings.size());
+  for (auto node : {1, 2, 9, 10}) {
+    EXPECT_EQ(proto::ColumnEncoding_Kind_DIRECT_V2, encodings[node].kind())
+        << node;
+  }
+  EXPECT_EQ(proto::ColumnEncoding_Kind_DICTIONARY_V2, encodings[8].kind());
+  EXPECT_EQ(20, encodings[8].dictionarysize());
+  for (const auto& stream : stripe->footer->streams()) {
+    EXPECT_NE(proto::Stream_Kind_IN_DICTIONARY, stream.kind());
+    EXPECT_NE(proto::Stream_Kind_STRIDE_DICTIONARY, stream.kind());
+  }
+
+  VectorPtr result = BaseVector::create(batch->type(), 0, pool());
+  vector_size_t offset = 0;
+  while (rowReader->next(1'000, result) > 0) {
+    const auto expectedOffset = offset % kSize;
+    assertEqualVectors(batch->slice(expectedOffset, result->size()), result);
+    offset += result->size();
+  }
+  EXPECT_EQ(2 * kSize, offset);
+}
+
+// Filters skip strides by the row index stats and the Bloom filters, and the
+// readers seek to the surviving strides by the row index positions.
+TEST_F(OrcWriterTest, filteredRead) {
+  constexpr int32_t kStride = 1'000;
+  constexpr int32_t kNumStrides = 10;
+  constexpr int32_t kSize = kStride * kNumStrides;
+  // The values of c0 overlap in all strides, so that only Bloom filters can
+  // skip them. c1 is dictionary encoded and sorted, so that its stats skip
+  // strides.
+  auto c0 = [](auto row) -> int64_t {
+    return (row % kStride) * 10 + row / kStride;
+  };
+  auto c1 = [](auto row) {
+    return fmt::format("{:02} {}", row / kStride, row % 5);
+  };
+  auto c1IsNull = [](auto row) { return row % 7 == 0; };
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kSize, c0),
+      makeFlatVector<std::string>(kSize, c1, c1IsNull),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row * 3; }),
+  });
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, common::CompressionKind_ZSTD);
+  // Several compression blocks per stride.
+  config->set(Config::COMPRESSION_BLOCK_SIZE, static_cast<uint64_t>(1'024));
+  config->set(Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(kStride));
+  config->set<const std::vector<uint32_t>>(
+      Config::BLOOM_FILTER_COLUMNS, {0});
+  auto reader = createReader(write({batch}, config));
+  auto schema = asRowType(batch->type());
+
+  // Returns the rows that pass 'filter' on 'name'.
+  auto read = [&](const std::string& name,
+                  std::unique_ptr<common::Filter> filter,
+                  int64_t expectedSkippedStrides) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    spec->childByName(name)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(schema, 0, pool());
+    VectorPtr results = BaseVector::create(schema, 0, pool());
+    while (rowReader->next(300, result) > 0) {
+      const auto offset = results->size();
+      results->resize(offset + result->size());
+      results->copy(result.get(), offset, 0, result->size());
+    }
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(expectedSkippedStrides, stats.skippedStrides);
+    return results;
+  };
+
+  // Returns the rows of 'batch' for which 'predicate' is true.
+  auto expected = [&](std::function<bool(vector_size_t)> predicate) {
+    std::vector<vector_size_t> rows;
+    for (auto row = 0; row < kSize; ++row) {
+      if (predicate(row)) {
+        rows.push_back(row);
+      }
+    }
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            rows.size(), [&](auto i) { return c0(rows[i]); }),
+        makeFlatVector<std::string>(
+            rows.size(),
+            [&](auto i) { return c1(rows[i]); },
+            [&](auto i) { return c1IsNull(rows[i]); }),
+        makeFlatVector<int32_t>(
+            rows.size(), [&](auto i) { return rows[i] * 3; }),
+    });
+  };
+
+  // Only the Bloom filters skip strides.
+  assertEqualVectors(
+      expected([&](auto row) { return c0(row) == 53; }),
+      read("c0", std::make_unique<common::BigintRange>(53, 53, false), 9));
+
+  // The string stats skip strides.
+  assertEqualVectors(
+      expected([&](auto row) {
+        return !c1IsNull(row) && (c1(row) == "03 2" || c1(row) == "07 4");
+      }),
+      read(
+          "c1",
+          std::make_unique<common::BytesValues>(
+              std::vector<std::string>{"03 2", "07 4"}, false),
+          8));
+
+  // The integer stats skip the strides before and after the range, which
+  // starts in the middle of a stride.
+  assertEqualVectors(
+      expected([&](auto row) { return row >= 3'667 && row < 7'000; }),
+      read(
+          "c2",
+          std::make_unique<common::BigintRange>(11'000, 20'999, false),
+          6));
+}
+
+// Each stripe has its own statistics in the metadata section.
+TEST_F(OrcWriterTest, stripeStatistics) {
+  auto makeBatch = [&](int32_t start) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return start + row; }, nullEvery(10)),
+        makeFlatVector<std::string>(
+            1'000, [&](auto row) { return fmt::format("{}", start + row); }),
+    });
+  };
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, common::CompressionKind_NONE);
+  auto data = write(
+      {makeBatch(0), makeBatch(5'000), makeBatch(2'000)},
+      config,
+      /*stripePerBatch=*/true);
+
+  const auto psLength = static_cast<uint8_t>(data.back());
+  proto::orc::PostScript postScript;
+  ASSERT_TRUE(postScript.ParseFromArray(
+      data.data() + data.size() - 1 - psLength, psLength));
+  ASSERT_GT(postScript.metadatalength(), 0);
+  proto::orc::Metadata metadata;
+  ASSERT_TRUE(metadata.ParseFromArray(
+      data.data() + data.size() - 1 - psLength - postScript.footerlength() -
+          postScript.metadatalength(),
+      postScript.metadatalength()));
+
+  ASSERT_EQ(3, metadata.stripestats_size());
+  for (auto i = 0; i < 3; ++i) {
+    SCOPED_TRACE(i);
+    const auto start = std::vector<int64_t>{0, 5'000, 2'000}[i];
+    const auto& colStats = metadata.stripestats(i).colstats();
+    ASSERT_EQ(3, colStats.size());
+    EXPECT_EQ(1'000, colStats[0].numberofvalues());
+    EXPECT_EQ(900, colStats[1].numberofvalues());
+    EXPECT_TRUE(colStats[1].hasnull());
+    EXPECT_EQ(start + 1, colStats[1].intstatistics().minimum());
+    EXPECT_EQ(start + 999, colStats[1].intstatistics().maximum());
+    EXPECT_EQ(1'000, colStats[2].numberofvalues());
+    EXPECT_FALSE(colStats[2].hasnull());
+  }
+
+  auto reader = createReader(std::move(data));
+  EXPECT_EQ(3, reader->getNumberOfStripes());
+  EXPECT_EQ(3'000, reader->numberOfRows().value());
+}
+
+TEST_F(OrcWriterTest, unsupported) {
+  auto batch = makeRowVector({makeMapVector<int32_t, int32_t>(
+      10, [](auto) { return 1; }, folly::identity, folly::identity)});
+  auto config = std::make_shared<Config>();
+  config->set(Config::FLATTEN_MAP, true);
+  config->set<const std::vector<uint32_t>>(Config::MAP_FLAT_COLS, {0});
+  VELOX_ASSERT_USER_THROW(write({batch}, config), "ORC has no flat maps");
+}
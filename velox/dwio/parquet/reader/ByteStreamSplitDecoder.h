@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+
+// Number of values transposed per block. The block of output values and the
+// 'kWidth' input slices fit in L1.
+constexpr int32_t kByteStreamSplitBlock = 256;
+
+template <int32_t kWidth>
+void decodeByteStreamSplit(const char* data, int32_t numValues, char* values) {
+  for (int32_t begin = 0; begin < numValues;
+       begin += kByteStreamSplitBlock) {
+    const int32_t end = std::min(begin + kByteStreamSplitBlock, numValues);
+    for (int32_t stream = 0; stream < kWidth; ++stream) {
+      const char* input = data + static_cast<int64_t>(stream) * numValues;
+      char* output = values + stream;
+      // Strided stores of one byte stream. With a constant 'kWidth' the
+      // compiler turns this into shuffles.
+      for (int32_t i = begin; i < end; ++i) {
+        output[static_cast<int64_t>(i) * kWidth] = input[i];
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/// Decodes BYTE_STREAM_SPLIT. 'numValues' values of 'width' bytes are stored
+/// as 'width' streams of 'numValues' bytes, where stream i has byte i of each
+/// value. Writes the values in their plain layout to 'values', which must have
+/// space for 'numValues' * 'width' bytes. The plain values are then read with
+/// the same fast paths as PLAIN pages.
+inline void decodeByteStreamSplit(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* values) {
+  switch (width) {
+    case 4:
+      detail::decodeByteStreamSplit<4>(data, numValues, values);
+      break;
+    case 8:
+      detail::decodeByteStreamSplit<8>(data, numValues, values);
+      break;
+    default:
+      VELOX_UNSUPPORTED("Unsupported BYTE_STREAM_SPLIT width: {}", width);
+  }
+}
+
+} // namespace facebook::velox::parquet
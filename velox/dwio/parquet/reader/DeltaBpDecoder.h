@@ -78,6 +78,14 @@ class DeltaBpDecoder {
     }
   }
 
+  /// Reads the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(T* values, int64_t numValues) {
+    for (int64_t i = 0; i < numValues; ++i) {
+      values[i] = readLong();
+    }
+  }
+
   const char* bufferStart() {
     return bufferStart_;
   }
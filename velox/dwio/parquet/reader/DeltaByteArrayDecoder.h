@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+/// Decodes DELTA_LENGTH_BYTE_ARRAY. The page starts with the lengths of all
+/// values encoded as DELTA_BINARY_PACKED, followed by the concatenated value
+/// bytes. The lengths are decoded in one batch when the decoder is created,
+/// after which reading a value is a pointer bump.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(const char* start, const char* end)
+      : lengths_(readLengths(start)), bufferStart_(start), bufferEnd_(end) {}
+
+  /// Decodes a block of DELTA_BINARY_PACKED lengths starting at 'start' and
+  /// advances 'start' past them.
+  static std::vector<int32_t> readLengths(const char*& start) {
+    DeltaBpDecoder decoder(start);
+    std::vector<int32_t> lengths(decoder.validValuesCount());
+    decoder.readValues(lengths.data(), lengths.size());
+    start = decoder.bufferStart();
+    return lengths;
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(index_ + numValues, lengths_.size());
+    int64_t numBytes = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      numBytes += lengths_[index_ + i];
+    }
+    index_ += numValues;
+    bufferStart_ += numBytes;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(index_, lengths_.size());
+    const auto length = lengths_[index_++];
+    VELOX_DCHECK_LE(bufferStart_ + length, bufferEnd_);
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  const std::vector<int32_t> lengths_;
+  const char* bufferStart_;
+  const char* const bufferEnd_;
+  // Index of the next value in 'lengths_'.
+  size_t index_{0};
+};
+
+/// Decodes DELTA_BYTE_ARRAY, also known as incremental encoding. Each value is
+/// stored as the length of the prefix it shares with the previous value and
+/// the remaining suffix. The page has the prefix lengths encoded as
+/// DELTA_BINARY_PACKED, followed by the suffixes encoded as
+/// DELTA_LENGTH_BYTE_ARRAY. Values are reconstructed in a buffer that is
+/// valid until the next value is read.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(const char* start, const char* end)
+      : prefixLengths_(DeltaLengthByteArrayDecoder::readLengths(start)),
+        suffixDecoder_(start, end) {}
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    // The values after the skipped ones depend on the last skipped value.
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(index_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[index_++];
+    VELOX_CHECK_LE(
+        static_cast<size_t>(prefixLength),
+        lastValue_.size(),
+        "DELTA_BYTE_ARRAY prefix is longer than the previous value");
+    const auto suffix = suffixDecoder_.readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+ private:
+  const std::vector<int32_t> prefixLengths_;
+  DeltaLengthByteArrayDecoder suffixDecoder_;
+  // Index of the next value in 'prefixLengths_'.
+  size_t index_{0};
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
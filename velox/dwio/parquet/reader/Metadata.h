@@ -19,6 +19,10 @@
 #include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/common/compression/Compression.h"
 
+namespace facebook::velox::parquet::thrift {
+class Statistics;
+} // namespace facebook::velox::parquet::thrift
+
 namespace facebook::velox::parquet {
 
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
@@ -129,4 +133,12 @@ class FileMetaDataPtr {
   const void* ptr_;
 };
 
+/// Converts the Parquet 'stats' of 'numRows' values of 'type' into Velox
+/// column statistics. Used for column chunk stats as well as for the per page
+/// stats of the ColumnIndex.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& stats,
+    const velox::Type& type,
+    uint64_t numRows);
+
 } // namespace facebook::velox::parquet
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T>
+T deserialize(const char* data, int32_t size) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+int64_t pageEndRow(
+    const std::vector<thrift::PageLocation>& pages,
+    size_t index,
+    int64_t numRows) {
+  return index + 1 < pages.size() ? pages[index + 1].first_row_index
+                                  : numRows;
+}
+
+bool hasColumnIndex(const thrift::ColumnChunk& chunk) {
+  return chunk.__isset.column_index_offset &&
+      chunk.__isset.column_index_length && chunk.column_index_length > 0;
+}
+
+bool hasOffsetIndex(const thrift::ColumnChunk& chunk) {
+  return chunk.__isset.offset_index_offset &&
+      chunk.__isset.offset_index_length && chunk.offset_index_length > 0;
+}
+
+} // namespace
+
+std::vector<RowRange> matchingRowRanges(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows,
+    common::Filter& filter,
+    const TypePtr& type) {
+  const auto& pages = offsetIndex.page_locations;
+  VELOX_CHECK_EQ(pages.size(), columnIndex.null_pages.size());
+  std::vector<RowRange> ranges;
+  for (auto i = 0; i < pages.size(); ++i) {
+    const int64_t begin = pages[i].first_row_index;
+    const int64_t end = pageEndRow(pages, i, numRows);
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(end - begin);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (columnIndex.__isset.null_counts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, end - begin);
+    if (!testFilter(&filter, columnStats.get(), end - begin, type)) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = end;
+    } else {
+      ranges.push_back({begin, end});
+    }
+  }
+  return ranges;
+}
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    const auto begin = std::max(left[i].begin, right[j].begin);
+    const auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+void PageIndexFilter::build(
+    const thrift::FileMetaData& fileMetaData,
+    const std::vector<uint32_t>& rowGroupIds,
+    const std::vector<PageIndexFilterColumn>& filters,
+    const std::vector<uint32_t>& projectedColumns,
+    dwio::common::BufferedInput& input) {
+  rowGroups_.clear();
+  if (filters.empty()) {
+    return;
+  }
+
+  // Row groups that have all the needed indexes and the file range covering
+  // these indexes.
+  std::vector<uint32_t> indexedRowGroups;
+  uint64_t begin = std::numeric_limits<uint64_t>::max();
+  uint64_t end = 0;
+  for (auto rowGroupId : rowGroupIds) {
+    const auto& columns = fileMetaData.row_groups[rowGroupId].columns;
+    bool hasIndexes = true;
+    for (const auto& filter : filters) {
+      hasIndexes &= hasColumnIndex(columns[filter.column]);
+    }
+    for (auto column : projectedColumns) {
+      hasIndexes &= hasOffsetIndex(columns[column]);
+    }
+    if (!hasIndexes) {
+      continue;
+    }
+    indexedRowGroups.push_back(rowGroupId);
+    for (const auto& filter : filters) {
+      const auto& chunk = columns[filter.column];
+      begin = std::min<uint64_t>(begin, chunk.column_index_offset);
+      end = std::max<uint64_t>(
+          end, chunk.column_index_offset + chunk.column_index_length);
+    }
+    for (auto column : projectedColumns) {
+      const auto& chunk = columns[column];
+      begin = std::min<uint64_t>(begin, chunk.offset_index_offset);
+      end = std::max<uint64_t>(
+          end, chunk.offset_index_offset + chunk.offset_index_length);
+    }
+  }
+  if (indexedRowGroups.empty()) {
+    return;
+  }
+
+  auto stream = input.read(
+      begin, end - begin, dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> buffer(end - begin);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      end - begin, stream.get(), buffer.data(), bufferStart, bufferEnd);
+
+  for (auto rowGroupId : indexedRowGroups) {
+    const auto& rowGroup = fileMetaData.row_groups[rowGroupId];
+    RowGroupPages pages;
+    pages.numRows = rowGroup.num_rows;
+    for (auto column : projectedColumns) {
+      const auto& chunk = rowGroup.columns[column];
+      pages.offsetIndexes[column] = deserialize<thrift::OffsetIndex>(
+          buffer.data() + chunk.offset_index_offset - begin,
+          chunk.offset_index_length);
+    }
+    std::optional<std::vector<RowRange>> ranges;
+    for (const auto& filter : filters) {
+      const auto& chunk = rowGroup.columns[filter.column];
+      auto columnIndex = deserialize<thrift::ColumnIndex>(
+          buffer.data() + chunk.column_index_offset - begin,
+          chunk.column_index_length);
+      auto it = pages.offsetIndexes.find(filter.column);
+      VELOX_CHECK(it != pages.offsetIndexes.end());
+      auto matching = matchingRowRanges(
+          columnIndex, it->second, pages.numRows, *filter.filter, filter.type);
+      ranges = ranges.has_value() ? intersectRowRanges(*ranges, matching)
+                                  : std::move(matching);
+      if (ranges->empty()) {
+        break;
+      }
+    }
+    if (ranges->size() == 1 && ranges->front().begin == 0 &&
+        ranges->front().end == pages.numRows) {
+      // All pages may have hits, the row group is read as is.
+      continue;
+    }
+    pages.rowRanges = std::move(*ranges);
+    rowGroups_.emplace(rowGroupId, std::move(pages));
+  }
+}
+
+const std::vector<RowRange>* PageIndexFilter::rowRanges(
+    uint32_t rowGroup) const {
+  auto it = rowGroups_.find(rowGroup);
+  return it == rowGroups_.end() ? nullptr : &it->second.rowRanges;
+}
+
+std::vector<SkippedPage> PageIndexFilter::skippedPages(
+    uint32_t rowGroup,
+    uint32_t column,
+    uint64_t chunkOffset) const {
+  std::vector<SkippedPage> skipped;
+  auto it = rowGroups_.find(rowGroup);
+  if (it == rowGroups_.end()) {
+    return skipped;
+  }
+  auto indexIt = it->second.offsetIndexes.find(column);
+  if (indexIt == it->second.offsetIndexes.end()) {
+    return skipped;
+  }
+  const auto& ranges = it->second.rowRanges;
+  const auto& pages = indexIt->second.page_locations;
+  size_t range = 0;
+  for (auto i = 0; i < pages.size(); ++i) {
+    const int64_t begin = pages[i].first_row_index;
+    const int64_t end = pageEndRow(pages, i, it->second.numRows);
+    while (range < ranges.size() && ranges[range].end <= begin) {
+      ++range;
+    }
+    if (range < ranges.size() && ranges[range].begin < end) {
+      continue;
+    }
+    VELOX_CHECK_GE(pages[i].offset, chunkOffset);
+    skipped.push_back(
+        {pages[i].offset - chunkOffset,
+         pages[i].compressed_page_size,
+         end - begin});
+  }
+  return skipped;
+}
+
+PageSkippingInputStream::PageSkippingInputStream(std::vector<Range> ranges)
+    : ranges_(std::move(ranges)) {
+  for (auto i = 1; i < ranges_.size(); ++i) {
+    VELOX_CHECK_LE(
+        ranges_[i - 1].offset + ranges_[i - 1].length, ranges_[i].offset);
+  }
+  setPosition(0);
+}
+
+bool PageSkippingInputStream::Next(const void** data, int32_t* size) {
+  for (;;) {
+    if (current_ == ranges_.size()) {
+      return false;
+    }
+    if (ranges_[current_].stream->Next(data, size)) {
+      position_ += *size;
+      return true;
+    }
+    // At the end of the current range. Continue with the next range if it
+    // starts here.
+    setPosition(ranges_[current_].offset + ranges_[current_].length);
+  }
+}
+
+void PageSkippingInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_LT(current_, ranges_.size());
+  ranges_[current_].stream->BackUp(count);
+  position_ -= count;
+}
+
+bool PageSkippingInputStream::SkipInt64(int64_t count) {
+  VELOX_CHECK_GE(count, 0);
+  const auto target = position_ + count;
+  if (current_ < ranges_.size() &&
+      target < ranges_[current_].offset + ranges_[current_].length) {
+    ranges_[current_].stream->SkipInt64(count);
+    position_ = target;
+    return true;
+  }
+  setPosition(target);
+  return true;
+}
+
+void PageSkippingInputStream::seekToPosition(
+    dwio::common::PositionProvider& position) {
+  setPosition(position.next());
+}
+
+std::string PageSkippingInputStream::getName() const {
+  return fmt::format(
+      "PageSkippingInputStream {} in {} ranges", position_, ranges_.size());
+}
+
+void PageSkippingInputStream::setPosition(uint64_t position) {
+  position_ = position;
+  auto it = std::upper_bound(
+      ranges_.begin(),
+      ranges_.end(),
+      position,
+      [](uint64_t position, const Range& range) {
+        return position < range.offset;
+      });
+  if (it == ranges_.begin() || position >= (it - 1)->offset + (it - 1)->length) {
+    current_ = ranges_.size();
+    return;
+  }
+  current_ = it - 1 - ranges_.begin();
+  std::vector<uint64_t> offsetInRange = {position - ranges_[current_].offset};
+  dwio::common::PositionProvider provider(offsetInRange);
+  ranges_[current_].stream->seekToPosition(provider);
+}
+
+} // namespace facebook::velox::parquet
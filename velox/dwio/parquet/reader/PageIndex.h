@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::dwio::common {
+class BufferedInput;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Half open range of rows [begin, end) inside a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// A data page that is not read because none of its rows are in the row ranges
+/// selected by the page index. 'offset' is relative to the start of the column
+/// chunk stream and 'size' includes the page header.
+struct SkippedPage {
+  uint64_t offset;
+  int32_t size;
+  int64_t numRows;
+};
+
+/// A top level column with a filter that can be tested against the page index.
+struct PageIndexFilterColumn {
+  // Leaf column number in the Parquet schema.
+  uint32_t column;
+  common::Filter* filter;
+  TypePtr type;
+};
+
+/// Returns the ranges of the 'numRows' rows of a column chunk for which the
+/// page min/max values and null counts in 'columnIndex' do not exclude
+/// 'filter'. Adjacent matching pages are merged into one range.
+std::vector<RowRange> matchingRowRanges(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows,
+    common::Filter& filter,
+    const TypePtr& type);
+
+/// Returns the rows that are in both 'left' and 'right'.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
+/// Page level pruning based on the ColumnIndex and OffsetIndex structures that
+/// writers place between the column chunks and the footer. Built by the row
+/// reader after row group pruning and shared with the ParquetData of each leaf
+/// column, which then enqueues reads only for the pages that intersect the
+/// selected row ranges.
+class PageIndexFilter {
+ public:
+  /// Reads the page indexes of 'rowGroupIds' from 'input' and computes the row
+  /// ranges of each row group that may pass all of 'filters'. Offset indexes
+  /// are kept for 'projectedColumns' so that their pages outside of the ranges
+  /// can be skipped. Row groups where an index is missing are read in full.
+  /// The page indexes of all row groups are read with a single IO since
+  /// writers store them next to each other.
+  void build(
+      const thrift::FileMetaData& fileMetaData,
+      const std::vector<uint32_t>& rowGroupIds,
+      const std::vector<PageIndexFilterColumn>& filters,
+      const std::vector<uint32_t>& projectedColumns,
+      dwio::common::BufferedInput& input);
+
+  /// Returns the rows of 'rowGroup' that may pass the filters, nullptr if all
+  /// rows must be read. An empty result means that the row group has no hits.
+  const std::vector<RowRange>* rowRanges(uint32_t rowGroup) const;
+
+  /// Returns the data pages of leaf 'column' in 'rowGroup' that have no rows
+  /// in rowRanges(), in file order. 'chunkOffset' is the file offset of the
+  /// start of the column chunk stream.
+  std::vector<SkippedPage> skippedPages(
+      uint32_t rowGroup,
+      uint32_t column,
+      uint64_t chunkOffset) const;
+
+ private:
+  struct RowGroupPages {
+    int64_t numRows;
+    std::vector<RowRange> rowRanges;
+    folly::F14FastMap<uint32_t, thrift::OffsetIndex> offsetIndexes;
+  };
+
+  folly::F14FastMap<uint32_t, RowGroupPages> rowGroups_;
+};
+
+/// Presents a column chunk of which only some byte ranges are loaded as one
+/// stream with positions relative to the start of the chunk. Skipping over a
+/// range that is not loaded is allowed. Reading from one is an error.
+class PageSkippingInputStream : public dwio::common::SeekableInputStream {
+ public:
+  struct Range {
+    // Offset of the range from the start of the column chunk.
+    uint64_t offset;
+    uint64_t length;
+    std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  };
+
+  explicit PageSkippingInputStream(std::vector<Range> ranges);
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override;
+
+  bool SkipInt64(int64_t count) override;
+
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override;
+
+  size_t positionSize() override {
+    return 1;
+  }
+
+ private:
+  // Positions the stream of the range containing 'position_', if any.
+  void setPosition(uint64_t position);
+
+  std::vector<Range> ranges_;
+  // Index of the range containing 'position_', ranges_.size() if in a gap.
+  size_t current_{0};
+  uint64_t position_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -19,6 +19,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -49,6 +50,21 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
+    if (nextSkippedPage_ < skippedPages_.size() &&
+        skippedPages_[nextSkippedPage_].offset == pageStart_) {
+      // The page is not loaded. Skip it by its size in the offset index.
+      const auto& page = skippedPages_[nextSkippedPage_++];
+      VELOX_CHECK(
+          row != kRepDefOnly && row >= rowOfPage_ + page.numRows,
+          "Accessing row {} of a page excluded by the page index",
+          row);
+      dwio::common::skipBytes(
+          page.size, inputStream_.get(), bufferStart_, bufferEnd_);
+      pageStart_ += page.size;
+      numRowsInPage_ = page.numRows;
+      updateRowInfoAfterPageSkipped();
+      continue;
+    }
     PageHeader pageHeader = readPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
@@ -568,6 +584,7 @@ void PageReader::preloadRepDefs() {
   // Reset the input to start of column chunk.
   std::vector<uint64_t> rewind = {0};
   pageStart_ = 0;
+  nextSkippedPage_ = 0;
   dwio::common::PositionProvider position(rewind);
   inputStream_->seekToPosition(position);
   bufferStart_ = bufferEnd_ = nullptr;
@@ -699,11 +716,62 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK(
+          isStringEncodable(),
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports string types");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      VELOX_CHECK(
+          isStringEncodable(),
+          "DELTA_BYTE_ARRAY decoder only supports string types");
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE: {
+          const auto width = parquetTypeBytes(parquetType);
+          const auto numValues = encodedDataSize_ / width;
+          dwio::common::ensureCapacity<char>(
+              byteStreamSplitValues_, encodedDataSize_, &pool_);
+          decodeByteStreamSplit(
+              pageData_,
+              numValues,
+              width,
+              byteStreamSplitValues_->asMutable<char>());
+          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+              std::make_unique<dwio::common::SeekableArrayInputStream>(
+                  byteStreamSplitValues_->as<char>(), numValues * width),
+              false,
+              width);
+          break;
+        }
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT and DOUBLE");
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+bool PageReader::isStringEncodable() const {
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::BYTE_ARRAY:
+      return true;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      return type_->type()->isVarbinary() || type_->type()->isVarchar();
+    default:
+      return false;
+  }
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -731,6 +799,10 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
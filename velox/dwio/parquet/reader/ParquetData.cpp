@@ -24,7 +24,7 @@ std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), sessionTimezone_);
+      type, metaData_, pool(), sessionTimezone_, pageIndexFilter_);
 }
 
 void ParquetData::filterRowGroups(
@@ -86,6 +86,7 @@ void ParquetData::enqueueRowGroup(
     dwio::common::BufferedInput& input) {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
   streams_.resize(fileMetaDataPtr_.numRowGroups());
+  skippedPages_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
@@ -104,7 +105,32 @@ void ParquetData::enqueueRowGroup(
       : chunk.totalCompressedSize();
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  auto skippedPages = pageIndexFilter_
+      ? pageIndexFilter_->skippedPages(index, type_->column(), chunkReadOffset)
+      : std::vector<SkippedPage>();
+  if (skippedPages.empty()) {
+    streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+    return;
+  }
+  // Enqueue the byte ranges between the skipped pages. The first range
+  // includes the dictionary page, if any.
+  std::vector<PageSkippingInputStream::Range> ranges;
+  uint64_t offset = 0;
+  auto addRange = [&](uint64_t end) {
+    if (end > offset) {
+      ranges.push_back(
+          {offset,
+           end - offset,
+           input.enqueue({chunkReadOffset + offset, end - offset}, &id)});
+    }
+  };
+  for (const auto& page : skippedPages) {
+    addRange(page.offset);
+    offset = page.offset + page.size;
+  }
+  addRange(readSize);
+  streams_[index] = std::make_unique<PageSkippingInputStream>(std::move(ranges));
+  skippedPages_[index] = std::move(skippedPages);
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -119,6 +145,9 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       metadata.compression(),
       metadata.totalCompressedSize(),
       sessionTimezone_);
+  if (!skippedPages_[index].empty()) {
+    reader_->setSkippedPages(std::move(skippedPages_[index]));
+  }
   return dwio::common::PositionProvider(empty);
 }
 
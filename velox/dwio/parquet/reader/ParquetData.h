@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 namespace facebook::velox::common {
@@ -37,11 +38,13 @@ class ParquetParams : public dwio::common::FormatParams {
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
       const tz::TimeZone* sessionTimezone,
-      TimestampPrecision timestampPrecision)
+      TimestampPrecision timestampPrecision,
+      std::shared_ptr<const PageIndexFilter> pageIndexFilter = nullptr)
       : FormatParams(pool, stats),
         metaData_(metaData),
         sessionTimezone_(sessionTimezone),
-        timestampPrecision_(timestampPrecision) {}
+        timestampPrecision_(timestampPrecision),
+        pageIndexFilter_(std::move(pageIndexFilter)) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -54,6 +57,7 @@ class ParquetParams : public dwio::common::FormatParams {
   const FileMetaDataPtr metaData_;
   const tz::TimeZone* sessionTimezone_;
   const TimestampPrecision timestampPrecision_;
+  const std::shared_ptr<const PageIndexFilter> pageIndexFilter_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -63,16 +67,20 @@ class ParquetData : public dwio::common::FormatData {
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      std::shared_ptr<const PageIndexFilter> pageIndexFilter = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        pageIndexFilter_(std::move(pageIndexFilter)) {}
 
-  /// Prepares to read data for 'index'th row group.
+  /// Prepares to read data for 'index'th row group. If the page index
+  /// excludes some pages of the column chunk, only the remaining pages are
+  /// enqueued.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
@@ -212,10 +220,14 @@ class ParquetData : public dwio::common::FormatData {
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Pages left out of 'streams_' for each row group.
+  std::vector<std::vector<SkippedPage>> skippedPages_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
   const tz::TimeZone* sessionTimezone_;
+  const std::shared_ptr<const PageIndexFilter> pageIndexFilter_;
   std::unique_ptr<PageReader> reader_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
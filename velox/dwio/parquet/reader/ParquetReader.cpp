@@ -19,12 +19,78 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/dwio/parquet/common/XxHasher.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+// Decoded footer of a Parquet file and the Bloom filters that were read with
+// it. Shared by the readers of the file through a FileMetadataCache.
+struct ParquetFileFooter : public dwio::common::CachedFileMetadata {
+  thrift::FileMetaData fileMetaData;
+  uint64_t fileLength{0};
+  // File offset of the serialized FileMetaData.
+  uint64_t footerOffset{0};
+  // Bloom filters that were in the same read as the footer, i.e. the bytes
+  // from 'bloomFiltersOffset' to 'footerOffset'. Writers place all Bloom
+  // filters right before the footer, so these are usually all of them.
+  std::string bloomFilters;
+  uint64_t bloomFiltersOffset{0};
+  // Estimated heap size of 'fileMetaData'.
+  uint64_t fileMetaDataBytes{0};
+
+  uint64_t memoryBytes() const override {
+    return sizeof(*this) + fileMetaDataBytes + bloomFilters.size();
+  }
+};
+
+uint64_t statisticsBytes(const thrift::Statistics& statistics) {
+  return statistics.max.size() + statistics.min.size() +
+      statistics.max_value.size() + statistics.min_value.size();
+}
+
+// Returns the estimated heap size of the decoded 'metadata', not counting
+// sizeof(metadata). The decoded footer is usually several times larger than
+// the serialized one since every column chunk of every row group becomes a
+// ColumnChunk object.
+uint64_t decodedBytes(const thrift::FileMetaData& metadata) {
+  uint64_t bytes = metadata.created_by.size() +
+      metadata.schema.size() * sizeof(thrift::SchemaElement) +
+      metadata.row_groups.size() * sizeof(thrift::RowGroup) +
+      metadata.key_value_metadata.size() * sizeof(thrift::KeyValue);
+  for (const auto& element : metadata.schema) {
+    bytes += element.name.size();
+  }
+  for (const auto& keyValue : metadata.key_value_metadata) {
+    bytes += keyValue.key.size() + keyValue.value.size();
+  }
+  for (const auto& rowGroup : metadata.row_groups) {
+    bytes += rowGroup.columns.size() * sizeof(thrift::ColumnChunk) +
+        rowGroup.sorting_columns.size() * sizeof(thrift::SortingColumn);
+    for (const auto& column : rowGroup.columns) {
+      const auto& columnMetaData = column.meta_data;
+      bytes += column.file_path.size() +
+          columnMetaData.encodings.size() * sizeof(thrift::Encoding::type) +
+          columnMetaData.encoding_stats.size() *
+              sizeof(thrift::PageEncodingStats) +
+          columnMetaData.key_value_metadata.size() * sizeof(thrift::KeyValue) +
+          statisticsBytes(columnMetaData.statistics);
+      for (const auto& name : columnMetaData.path_in_schema) {
+        bytes += sizeof(std::string) + name.size();
+      }
+      for (const auto& keyValue : columnMetaData.key_value_metadata) {
+        bytes += keyValue.key.size() + keyValue.value.size();
+      }
+    }
+  }
+  return bytes;
+}
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -51,7 +117,7 @@ class ReaderBase {
   }
 
   FileMetaDataPtr fileMetaData() const {
-    return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
+    return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_));
   }
 
   const std::shared_ptr<const RowType>& schema() const {
@@ -87,10 +153,30 @@ class ReaderBase {
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Returns the Bloom filters of leaf 'columns' in 'rowGroups'. The filter of
+  /// column j in row group i is at i * columns.size() + j and is nullptr if the
+  /// column chunk has none. Filters that were read together with the footer
+  /// are not read again and the others are read with one coalesced load.
+  std::vector<std::unique_ptr<BlockSplitBloomFilter>> loadBloomFilters(
+      const std::vector<uint32_t>& rowGroups,
+      const std::vector<uint32_t>& columns) const;
+
  private:
-  // Reads and parses file footer.
+  // Reads and parses file footer. Uses the footer in the FileMetadataCache of
+  // 'options_' if there is one.
   void loadFileMetaData();
 
+  // Reads and parses file footer into 'footer'.
+  void readFileMetaData(ParquetFileFooter& footer);
+
+  // Returns the smallest Bloom filter offset in the file, if any.
+  std::optional<uint64_t> firstBloomFilterOffset() const;
+
+  // Returns the sorted start offsets of the structures in the file that may
+  // follow a Bloom filter, ending with the footer offset. The column metadata
+  // has no Bloom filter length, so a Bloom filter ends at the next of these.
+  std::vector<uint64_t> bloomFilterBoundaries() const;
+
   void initializeSchema();
 
   std::unique_ptr<ParquetTypeWithId> getParquetColumnInfo(
@@ -118,7 +204,9 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const ParquetFileFooter> footer_;
+  // Points to the FileMetaData of 'footer_'.
+  const thrift::FileMetaData* fileMetaData_{nullptr};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -144,6 +232,26 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* cache = options_.fileMetadataCache();
+  if (cache != nullptr) {
+    auto cached =
+        cache->find<ParquetFileFooter>(options_.fileMetadataCacheKey());
+    if (cached != nullptr && cached->fileLength == fileLength_) {
+      footer_ = std::move(cached);
+      fileMetaData_ = &footer_->fileMetaData;
+      return;
+    }
+  }
+  auto footer = std::make_shared<ParquetFileFooter>();
+  readFileMetaData(*footer);
+  footer_ = footer;
+  if (cache != nullptr) {
+    footer->fileMetaDataBytes = decodedBytes(footer->fileMetaData);
+    cache->insert(options_.fileMetadataCacheKey(), std::move(footer));
+  }
+}
+
+void ReaderBase::readFileMetaData(ParquetFileFooter& footer) {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -190,8 +298,119 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  footer.fileMetaData.read(thriftProtocol.get());
+  fileMetaData_ = &footer.fileMetaData;
+
+  footer.fileLength = fileLength_;
+  footer.footerOffset = fileLength_ - footerLength - 8;
+  if (footerOffsetInBuffer == 0) {
+    // 'copy' has only the footer.
+    return;
+  }
+  const uint64_t copyOffset = fileLength_ - readSize;
+  const auto bloomFiltersOffset = firstBloomFilterOffset();
+  if (bloomFiltersOffset.has_value() && *bloomFiltersOffset >= copyOffset &&
+      *bloomFiltersOffset < footer.footerOffset) {
+    footer.bloomFiltersOffset = *bloomFiltersOffset;
+    footer.bloomFilters.assign(
+        copy.data() + (footer.bloomFiltersOffset - copyOffset),
+        copy.data() + footerOffsetInBuffer);
+  }
+}
+
+std::optional<uint64_t> ReaderBase::firstBloomFilterOffset() const {
+  std::optional<uint64_t> result;
+  for (const auto& rowGroup : fileMetaData_->row_groups) {
+    for (const auto& chunk : rowGroup.columns) {
+      if (chunk.meta_data.__isset.bloom_filter_offset) {
+        const uint64_t offset = chunk.meta_data.bloom_filter_offset;
+        result = result.has_value() ? std::min(*result, offset) : offset;
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<uint64_t> ReaderBase::bloomFilterBoundaries() const {
+  std::vector<uint64_t> boundaries;
+  for (const auto& rowGroup : fileMetaData_->row_groups) {
+    for (const auto& chunk : rowGroup.columns) {
+      const auto& metaData = chunk.meta_data;
+      boundaries.push_back(metaData.data_page_offset);
+      if (metaData.__isset.dictionary_page_offset) {
+        boundaries.push_back(metaData.dictionary_page_offset);
+      }
+      if (metaData.__isset.bloom_filter_offset) {
+        boundaries.push_back(metaData.bloom_filter_offset);
+      }
+      if (chunk.__isset.column_index_offset) {
+        boundaries.push_back(chunk.column_index_offset);
+      }
+      if (chunk.__isset.offset_index_offset) {
+        boundaries.push_back(chunk.offset_index_offset);
+      }
+    }
+  }
+  boundaries.push_back(footer_->footerOffset);
+  std::sort(boundaries.begin(), boundaries.end());
+  return boundaries;
+}
+
+std::vector<std::unique_ptr<BlockSplitBloomFilter>>
+ReaderBase::loadBloomFilters(
+    const std::vector<uint32_t>& rowGroups,
+    const std::vector<uint32_t>& columns) const {
+  std::vector<std::unique_ptr<BlockSplitBloomFilter>> bloomFilters(
+      rowGroups.size() * columns.size());
+  std::vector<
+      std::pair<size_t, std::unique_ptr<dwio::common::SeekableInputStream>>>
+      streams;
+  std::vector<uint64_t> boundaries;
+  std::unique_ptr<dwio::common::BufferedInput> input;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    const auto& rowGroup = fileMetaData_->row_groups[rowGroups[i]];
+    for (auto j = 0; j < columns.size(); ++j) {
+      const auto& metaData = rowGroup.columns[columns[j]].meta_data;
+      if (!metaData.__isset.bloom_filter_offset) {
+        continue;
+      }
+      const uint64_t offset = metaData.bloom_filter_offset;
+      if (boundaries.empty()) {
+        boundaries = bloomFilterBoundaries();
+      }
+      auto next =
+          std::upper_bound(boundaries.begin(), boundaries.end(), offset);
+      VELOX_CHECK(
+          next != boundaries.end(),
+          "Bloom filter offset {} is not before the footer",
+          offset);
+      const uint64_t end = *next;
+      std::unique_ptr<dwio::common::SeekableInputStream> stream;
+      const auto& footerFilters = footer_->bloomFilters;
+      if (!footerFilters.empty() && offset >= footer_->bloomFiltersOffset) {
+        stream = std::make_unique<dwio::common::SeekableArrayInputStream>(
+            footerFilters.data() + (offset - footer_->bloomFiltersOffset),
+            end - offset);
+      } else {
+        if (!input) {
+          input = input_->clone();
+        }
+        // Enqueued on a clone of 'input_' so that the filters of all row
+        // groups are coalesced into as few reads as possible. A
+        // CachedBufferedInput serves and keeps these from the data cache.
+        stream = input->enqueue({offset, end - offset});
+      }
+      streams.emplace_back(i * columns.size() + j, std::move(stream));
+    }
+  }
+  if (input) {
+    input->load(dwio::common::LogType::STRIPE_INDEX);
+  }
+  for (auto& [index, stream] : streams) {
+    bloomFilters[index] = std::make_unique<BlockSplitBloomFilter>(
+        BlockSplitBloomFilter::deserialize(stream.get(), pool_));
+  }
+  return bloomFilters;
 }
 
 void ReaderBase::initializeSchema() {
@@ -810,6 +1029,99 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
 
 namespace {
 struct ParquetStatsContext : dwio::common::StatsContext {};
+
+// Filters with more values than this are not tested against Bloom filters.
+constexpr size_t kMaxBloomFilterValues = 1'000;
+
+// Returns the Bloom filter hashes of the values that pass 'filter' on a column
+// of 'type', std::nullopt if 'filter' is not a point lookup or the column is
+// not of a physical type for which the values can be hashed. Bloom filters
+// have no nulls, so that filters passing nulls are not considered either.
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter& filter,
+    const ParquetTypeWithId& type) {
+  if (filter.testNull() || !type.parquetType_.has_value() ||
+      type.type()->isDecimal()) {
+    return std::nullopt;
+  }
+  XxHasher hasher;
+  std::vector<uint64_t> hashes;
+  auto hashIntegers = [&](const auto& values) -> bool {
+    if (values.size() > kMaxBloomFilterValues) {
+      return false;
+    }
+    if (*type.parquetType_ == thrift::Type::INT64 &&
+        type.type()->kind() == TypeKind::BIGINT) {
+      for (int64_t value : values) {
+        hashes.push_back(hasher.hash(value));
+      }
+      return true;
+    }
+    if (*type.parquetType_ == thrift::Type::INT32 &&
+        (type.type()->kind() == TypeKind::INTEGER ||
+         type.type()->kind() == TypeKind::SMALLINT ||
+         type.type()->kind() == TypeKind::TINYINT)) {
+      for (int64_t value : values) {
+        // Values out of the range of the column cannot be in the file.
+        if (value >= std::numeric_limits<int32_t>::min() &&
+            value <= std::numeric_limits<int32_t>::max()) {
+          hashes.push_back(hasher.hash(static_cast<int32_t>(value)));
+        }
+      }
+      return true;
+    }
+    return false;
+  };
+  auto hashStrings = [&](const auto& values) -> bool {
+    if (values.size() > kMaxBloomFilterValues ||
+        *type.parquetType_ != thrift::Type::BYTE_ARRAY ||
+        (type.type()->kind() != TypeKind::VARCHAR &&
+         type.type()->kind() != TypeKind::VARBINARY)) {
+      return false;
+    }
+    for (const std::string& value : values) {
+      ByteArray byteArray(std::string_view{value});
+      hashes.push_back(hasher.hash(&byteArray));
+    }
+    return true;
+  };
+
+  bool supported = false;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(&filter);
+      supported = range->isSingleValue() &&
+          hashIntegers(std::vector<int64_t>{range->lower()});
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      supported = hashIntegers(
+          static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+              ->values());
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      supported = hashIntegers(
+          static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+              ->values());
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(&filter);
+      supported = range->isSingleValue() &&
+          hashStrings(std::vector<std::string>{range->lower()});
+      break;
+    }
+    case common::FilterKind::kBytesValues:
+      supported = hashStrings(
+          static_cast<const common::BytesValues*>(&filter)->values());
+      break;
+    default:
+      break;
+  }
+  if (!supported) {
+    return std::nullopt;
+  }
+  return hashes;
+}
 } // namespace
 
 class ParquetRowReader::Impl {
@@ -824,7 +1136,8 @@ class ParquetRowReader::Impl {
         nextRowGroupIdsIdx_{0},
         currentRowGroupPtr_{nullptr},
         rowsInCurrentRowGroup_{0},
-        currentRowInGroup_{0} {
+        currentRowInGroup_{0},
+        pageIndexFilter_{std::make_shared<PageIndexFilter>()} {
     // Validate the requested type is compatible with what's in the file
     std::function<std::string()> createExceptionContext = [&]() {
       std::string exceptionMessageContext = fmt::format(
@@ -846,7 +1159,8 @@ class ParquetRowReader::Impl {
         columnReaderStats_,
         readerBase_->fileMetaData(),
         readerBase->sessionTimezone(),
-        options_.timestampPrecision());
+        options_.timestampPrecision(),
+        pageIndexFilter_);
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -900,12 +1214,19 @@ class ParquetRowReader::Impl {
       }
       rowNumber += rowGroups_[i].num_rows;
     }
+    filterRowGroupsByBloomFilters();
+    filterPages();
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      if (skipToRowRange()) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -915,7 +1236,10 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    const uint64_t endOfRange = rowRanges_
+        ? (*rowRanges_)[nextRowRange_].end
+        : rowsInCurrentRowGroup_;
+    return std::min(size, endOfRange - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -953,6 +1277,7 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
   }
 
   void resetFilterCaches() {
@@ -964,6 +1289,144 @@ class ParquetRowReader::Impl {
   }
 
  private:
+  // Drops the row groups in 'rowGroupIds_' where the Bloom filter of a top
+  // level column has none of the values that pass an equality or IN filter on
+  // the column.
+  void filterRowGroupsByBloomFilters() {
+    if (rowGroupIds_.empty()) {
+      return;
+    }
+    const auto& fileType = *readerBase_->schemaWithId();
+    const auto& fileRowType = fileType.type()->asRow();
+    std::vector<uint32_t> columns;
+    std::vector<std::vector<uint64_t>> hashes;
+    for (const auto& childSpec : options_.scanSpec()->children()) {
+      if (childSpec->isConstant() || !childSpec->filter() ||
+          !fileRowType.containsChild(childSpec->fieldName())) {
+        continue;
+      }
+      const auto& child = static_cast<const ParquetTypeWithId&>(
+          *fileType.childByName(childSpec->fieldName()));
+      if (!child.isLeaf() || child.maxRepeat_ > 0) {
+        continue;
+      }
+      auto columnHashes = bloomFilterHashes(*childSpec->filter(), child);
+      if (columnHashes.has_value()) {
+        columns.push_back(child.column());
+        hashes.push_back(std::move(*columnHashes));
+      }
+    }
+    if (columns.empty()) {
+      return;
+    }
+    const auto bloomFilters =
+        readerBase_->loadBloomFilters(rowGroupIds_, columns);
+
+    size_t numKept = 0;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      bool mayMatch = true;
+      for (auto j = 0; j < columns.size() && mayMatch; ++j) {
+        const auto& bloomFilter = bloomFilters[i * columns.size() + j];
+        if (bloomFilter) {
+          mayMatch = std::any_of(
+              hashes[j].begin(), hashes[j].end(), [&](uint64_t hash) {
+                return bloomFilter->findHash(hash);
+              });
+        }
+      }
+      if (!mayMatch) {
+        continue;
+      }
+      rowGroupIds_[numKept] = rowGroupIds_[i];
+      firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+      ++numKept;
+    }
+    rowGroupIds_.resize(numKept);
+    firstRowOfRowGroup_.resize(numKept);
+  }
+
+  // Narrows the row groups in 'rowGroupIds_' down to the row ranges that may
+  // pass the filters according to the page indexes. Row groups without hits
+  // are dropped. This is done only when all projected columns are top level
+  // primitive columns, so that rows and leaf values correspond one to one.
+  void filterPages() {
+    if (rowGroupIds_.empty()) {
+      return;
+    }
+    const auto& fileType = *readerBase_->schemaWithId();
+    const auto& fileRowType = fileType.type()->asRow();
+    std::vector<PageIndexFilterColumn> filters;
+    std::vector<uint32_t> projectedColumns;
+    for (const auto& childSpec : options_.scanSpec()->children()) {
+      if (childSpec->isConstant()) {
+        continue;
+      }
+      if (!fileRowType.containsChild(childSpec->fieldName())) {
+        return;
+      }
+      const auto& child = static_cast<const ParquetTypeWithId&>(
+          *fileType.childByName(childSpec->fieldName()));
+      if (!child.getChildren().empty() || child.maxRepeat_ > 0) {
+        return;
+      }
+      projectedColumns.push_back(child.column());
+      if (childSpec->filter()) {
+        filters.push_back({child.column(), childSpec->filter(), child.type()});
+      }
+    }
+    if (filters.empty()) {
+      return;
+    }
+    pageIndexFilter_->build(
+        readerBase_->thriftFileMetaData(),
+        rowGroupIds_,
+        filters,
+        projectedColumns,
+        readerBase_->bufferedInput());
+
+    size_t numKept = 0;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      auto* ranges = pageIndexFilter_->rowRanges(rowGroupIds_[i]);
+      if (ranges && ranges->empty()) {
+        continue;
+      }
+      rowGroupIds_[numKept] = rowGroupIds_[i];
+      firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+      ++numKept;
+    }
+    rowGroupIds_.resize(numKept);
+    firstRowOfRowGroup_.resize(numKept);
+  }
+
+  // Positions the column readers at the next row of the current row group
+  // that is in 'rowRanges_'. Returns false if there is no such row, in which
+  // case the row group is consumed.
+  bool skipToRowRange() {
+    if (!rowRanges_) {
+      return true;
+    }
+    while (nextRowRange_ < rowRanges_->size() &&
+           (*rowRanges_)[nextRowRange_].end <=
+               static_cast<int64_t>(currentRowInGroup_)) {
+      ++nextRowRange_;
+    }
+    if (nextRowRange_ == rowRanges_->size()) {
+      // The next row group starts from the beginning of its column chunks,
+      // no need to skip the column readers.
+      skippedPageRows_ += rowsInCurrentRowGroup_ - currentRowInGroup_;
+      currentRowInGroup_ = rowsInCurrentRowGroup_;
+      return false;
+    }
+    const uint64_t begin = (*rowRanges_)[nextRowRange_].begin;
+    if (begin > currentRowInGroup_) {
+      const auto numRows = begin - currentRowInGroup_;
+      columnReader_->seekTo(columnReader_->readOffset() + numRows, false);
+      skippedPageRows_ += numRows;
+      currentRowInGroup_ = begin;
+    }
+    return true;
+  }
+
   bool advanceToNextRowGroup() {
     if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
       return false;
@@ -977,6 +1440,8 @@ class ParquetRowReader::Impl {
     currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
+    rowRanges_ = pageIndexFilter_->rowRanges(nextRowGroupIndex);
+    nextRowRange_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
     return true;
@@ -996,6 +1461,16 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Row ranges selected by the page indexes. Shared with the ParquetData of
+  // the leaf columns, which leave the pages outside of the ranges unread.
+  const std::shared_ptr<PageIndexFilter> pageIndexFilter_;
+  // Ranges of the current row group, nullptr if all rows are read.
+  const std::vector<RowRange>* rowRanges_{nullptr};
+  // Index of the first element of 'rowRanges_' not before the current row.
+  size_t nextRowRange_{0};
+  // Rows of the selected row groups that were skipped by the page indexes.
+  uint64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   TypePtr requestedType_;
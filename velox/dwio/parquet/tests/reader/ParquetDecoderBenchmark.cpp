@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/writer/arrow/Encoding.h"
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <random>
+
+// Decoding speed of the Parquet v2 encodings that are not read through the
+// shared dwio decoders. Each iteration decodes one page worth of values.
+
+using namespace facebook::velox::parquet;
+
+using facebook::velox::parquet::arrow::ByteArray;
+using facebook::velox::parquet::arrow::ByteArrayType;
+using facebook::velox::parquet::arrow::DoubleType;
+using facebook::velox::parquet::arrow::Encoding;
+using facebook::velox::parquet::arrow::FloatType;
+using facebook::velox::parquet::arrow::MakeTypedEncoder;
+
+namespace {
+
+constexpr int32_t kNumValues = 100'000;
+
+std::string toString(const std::shared_ptr<::arrow::Buffer>& buffer) {
+  return std::string(
+      reinterpret_cast<const char*>(buffer->data()), buffer->size());
+}
+
+// Strings with a common prefix that grows with the row number, as in sorted
+// keys.
+std::vector<std::string> makeStrings() {
+  std::vector<std::string> strings;
+  strings.reserve(kNumValues);
+  for (auto i = 0; i < kNumValues; ++i) {
+    strings.push_back(fmt::format("customer#{:09}", i * 7));
+  }
+  return strings;
+}
+
+std::string encodeStrings(Encoding::type encoding) {
+  const auto strings = makeStrings();
+  std::vector<ByteArray> values;
+  values.reserve(strings.size());
+  for (const auto& string : strings) {
+    values.emplace_back(std::string_view(string));
+  }
+  auto encoder = MakeTypedEncoder<ByteArrayType>(encoding);
+  encoder->Put(values.data(), values.size());
+  return toString(encoder->FlushValues());
+}
+
+template <typename DType>
+std::string encodeFloats() {
+  using T = typename DType::c_type;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<T> distribution(0, 1'000);
+  std::vector<T> values(kNumValues);
+  for (auto& value : values) {
+    value = distribution(rng);
+  }
+  auto encoder = MakeTypedEncoder<DType>(Encoding::BYTE_STREAM_SPLIT);
+  encoder->Put(values.data(), values.size());
+  return toString(encoder->FlushValues());
+}
+
+// Decodes BYTE_STREAM_SPLIT one value at a time for comparison.
+void decodeByteStreamSplitScalar(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* values) {
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto stream = 0; stream < width; ++stream) {
+      values[i * width + stream] = data[stream * numValues + i];
+    }
+  }
+}
+
+template <typename Decoder>
+size_t decodeStrings(const std::string& encoded) {
+  Decoder decoder(encoded.data(), encoded.data() + encoded.size());
+  size_t totalSize = 0;
+  for (auto i = 0; i < kNumValues; ++i) {
+    totalSize += decoder.readString().size();
+  }
+  return totalSize;
+}
+
+std::string deltaLengthByteArray;
+std::string deltaByteArray;
+std::string floats;
+std::string doubles;
+std::vector<char> output;
+
+BENCHMARK(deltaLengthByteArrayDecode) {
+  folly::doNotOptimizeAway(
+      decodeStrings<DeltaLengthByteArrayDecoder>(deltaLengthByteArray));
+}
+
+BENCHMARK(deltaByteArrayDecode) {
+  folly::doNotOptimizeAway(
+      decodeStrings<DeltaByteArrayDecoder>(deltaByteArray));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(byteStreamSplitFloatScalar) {
+  decodeByteStreamSplitScalar(
+      floats.data(), kNumValues, sizeof(float), output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK_RELATIVE(byteStreamSplitFloat) {
+  decodeByteStreamSplit(
+      floats.data(), kNumValues, sizeof(float), output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK(byteStreamSplitDoubleScalar) {
+  decodeByteStreamSplitScalar(
+      doubles.data(), kNumValues, sizeof(double), output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK_RELATIVE(byteStreamSplitDouble) {
+  decodeByteStreamSplit(
+      doubles.data(), kNumValues, sizeof(double), output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  deltaLengthByteArray = encodeStrings(Encoding::DELTA_LENGTH_BYTE_ARRAY);
+  deltaByteArray = encodeStrings(Encoding::DELTA_BYTE_ARRAY);
+  floats = encodeFloats<FloatType>();
+  doubles = encodeFloats<DoubleType>();
+  output.resize(kNumValues * sizeof(double));
+  folly::runBenchmarks();
+  return 0;
+}
@@ -14,7 +14,15 @@
  * limitations under the License.
  */
 
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
@@ -97,6 +105,43 @@ TEST_F(ParquetReaderTest, parseSample) {
       sampleSchema(), *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  FileMetadataCache cache(1 << 20);
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFileMetadataCache(
+      &cache, {StringIdLease(fileIds(), sample), /*modificationTime=*/1});
+
+  // The second reader uses the footer decoded by the first.
+  for (auto i = 0; i < 2; ++i) {
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    EXPECT_EQ(reader->rowType()->toString(), sampleSchema()->toString());
+
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+        makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+    });
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  }
+  auto stats = cache.stats();
+  EXPECT_EQ(1, stats.numMisses);
+  EXPECT_EQ(1, stats.numHits);
+  EXPECT_EQ(1, stats.numEntries);
+
+  // Another version of the file is a miss.
+  readerOptions.setFileMetadataCache(
+      &cache, {StringIdLease(fileIds(), sample), /*modificationTime=*/2});
+  createReader(sample, readerOptions);
+  stats = cache.stats();
+  EXPECT_EQ(2, stats.numMisses);
+  EXPECT_EQ(2, stats.numEntries);
+}
+
 TEST_F(ParquetReaderTest, parseUnannotatedList) {
   // unannotated_list.parquet has the following the schema
   // the list is defined without the middle layer
@@ -1488,3 +1533,337 @@ TEST_F(ParquetReaderTest, testEmptyV2DataPage) {
   assertReadWithReaderAndExpected(
       outputRowType, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  // 'a' is sorted, so that a range filter on it selects a few of its pages.
+  // 'b' has different page boundaries than 'a'. 'c' repeats in each row group.
+  constexpr vector_size_t kRows = 100'000;
+  auto data = makeRowVector(
+      {"a", "b", "c"},
+      {
+          makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              kRows,
+              [](auto row) { return fmt::format("value {}", row * 7); },
+              nullEvery(11)),
+          makeFlatVector<int32_t>(kRows, [](auto row) { return row % 50'000; }),
+      });
+  auto schema = asRowType(data->type());
+
+  auto writeFile = [&](bool enablePageIndex) {
+    auto sink = std::make_unique<MemorySink>(
+        64 << 20, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    options.dataPageSize = 4 << 10;
+    options.enablePageIndex = enablePageIndex;
+    options.flushPolicyFactory = []() {
+      return std::make_unique<LambdaFlushPolicy>(
+          kRows / 2, kBytesInRowGroup, []() { return false; });
+    };
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), options, schema);
+    writer->write(data);
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  auto read = [&](const std::string& file,
+                  FilterMap filters,
+                  const std::vector<vector_size_t>& expectedRows) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = std::make_unique<ParquetReader>(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(file), *leafPool_),
+        readerOptions);
+    auto scanSpec = makeScanSpec(schema);
+    for (auto& [column, filter] : filters) {
+      scanSpec->childByName(column)->setFilter(std::move(filter));
+    }
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto indices = makeIndices(
+        expectedRows.size(), [&](auto row) { return expectedRows[row]; });
+    std::vector<VectorPtr> children;
+    for (const auto& child : data->children()) {
+      children.push_back(wrapInDictionary(indices, child));
+    }
+    auto expected = makeRowVector(schema->names(), children);
+    // Reads to the end since rows after the last hit are scanned as well.
+    VectorPtr result = BaseVector::create(schema, 0, leafPool_.get());
+    vector_size_t total = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      assertEqualVectorPart(expected, result, total);
+      total += result->size();
+    }
+    EXPECT_EQ(total, expected->size());
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats;
+  };
+
+  auto filters = [](std::unique_ptr<Filter> a,
+                    std::unique_ptr<Filter> c = nullptr) {
+    FilterMap result;
+    result.emplace("a", std::move(a));
+    if (c) {
+      result.emplace("c", std::move(c));
+    }
+    return result;
+  };
+
+  const auto withIndex = writeFile(true);
+  const auto withoutIndex = writeFile(false);
+
+  // A range inside of the first row group. The second row group is excluded
+  // by its statistics, most pages of the first one by the page index.
+  std::vector<vector_size_t> rows(1'000);
+  std::iota(rows.begin(), rows.end(), 20'000);
+  auto stats = read(withIndex, filters(exec::between(20'000, 20'999)), rows);
+  EXPECT_EQ(stats.skippedStrides, 1);
+  EXPECT_GT(stats.skippedPageRows, 40'000);
+  EXPECT_LT(stats.skippedPageRows, 49'000);
+  stats = read(withoutIndex, filters(exec::between(20'000, 20'999)), rows);
+  EXPECT_EQ(stats.skippedStrides, 1);
+  EXPECT_EQ(stats.skippedPageRows, 0);
+
+  // Single values in both row groups, including the first and last rows of
+  // each.
+  rows = {0, 17, 49'999, 50'000, 77'777, 99'999};
+  const std::vector<int64_t> values(rows.begin(), rows.end());
+  stats = read(withIndex, filters(exec::in(values)), rows);
+  EXPECT_EQ(stats.skippedStrides, 0);
+  EXPECT_GT(stats.skippedPageRows, 80'000);
+  stats = read(withoutIndex, filters(exec::in(values)), rows);
+  EXPECT_EQ(stats.skippedPageRows, 0);
+
+  // Filters on two columns with different page boundaries.
+  rows.resize(2'000);
+  std::iota(rows.begin(), rows.end(), 48'000);
+  stats = read(
+      withIndex,
+      filters(exec::between(40'000, 49'999), exec::between(48'000, 60'000)),
+      rows);
+  EXPECT_EQ(stats.skippedStrides, 1);
+  EXPECT_GT(stats.skippedPageRows, 40'000);
+
+  // The row group statistics of the first row group match both filters but
+  // no page matches both. The row group is dropped.
+  stats = read(
+      withIndex,
+      filters(exec::between(0, 999), exec::between(40'000, 49'999)),
+      {});
+  EXPECT_EQ(stats.skippedStrides, 2);
+  stats = read(
+      withoutIndex,
+      filters(exec::between(0, 999), exec::between(40'000, 49'999)),
+      {});
+  EXPECT_EQ(stats.skippedStrides, 1);
+}
+
+TEST_F(ParquetReaderTest, bloomFilter) {
+  // Row group 0 has the even and row group 1 the odd ids, so that the row
+  // group statistics of both match any id in the range.
+  constexpr vector_size_t kRows = 20'000;
+  auto id = [](vector_size_t row) -> int64_t {
+    return row < kRows / 2 ? row * 2 : (row - kRows / 2) * 2 + 1;
+  };
+  auto key = [&](vector_size_t row) {
+    return fmt::format("key {}", id(row));
+  };
+  auto data = makeRowVector(
+      {"id", "key", "n"},
+      {
+          makeFlatVector<int64_t>(kRows, id),
+          makeFlatVector<std::string>(kRows, key),
+          makeFlatVector<int32_t>(
+              kRows, [&](auto row) { return static_cast<int32_t>(id(row)); }),
+      });
+  auto schema = asRowType(data->type());
+
+  auto sink = std::make_unique<MemorySink>(
+      64 << 20, FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions options;
+  options.memoryPool = rootPool_.get();
+  options.flushPolicyFactory = []() {
+    return std::make_unique<LambdaFlushPolicy>(
+        kRows / 2, kBytesInRowGroup, []() { return false; });
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), options, schema);
+  writer->write(data);
+  writer->close();
+  const std::string file(sinkPtr->data(), sinkPtr->size());
+
+  // The writer does not produce Bloom filters. Adds a Bloom filter for each
+  // column chunk between the last row group and the footer.
+  uint32_t footerLength;
+  std::memcpy(
+      &footerLength, file.data() + file.size() - 8, sizeof(footerLength));
+  const auto footerOffset = file.size() - 8 - footerLength;
+  facebook::velox::parquet::thrift::FileMetaData fileMetaData;
+  {
+    std::shared_ptr<facebook::velox::parquet::thrift::ThriftTransport>
+        transport = std::make_shared<
+            facebook::velox::parquet::thrift::ThriftBufferedTransport>(
+            file.data() + footerOffset, footerLength);
+    apache::thrift::protocol::TCompactProtocolT<
+        facebook::velox::parquet::thrift::ThriftTransport>
+        protocol(transport);
+    fileMetaData.read(&protocol);
+  }
+  ASSERT_EQ(fileMetaData.row_groups.size(), 2);
+  std::string withBloomFilters = file.substr(0, footerOffset);
+  for (auto rowGroup = 0; rowGroup < 2; ++rowGroup) {
+    for (auto column = 0; column < 3; ++column) {
+      BlockSplitBloomFilter bloomFilter(leafPool_.get());
+      bloomFilter.init(
+          BlockSplitBloomFilter::optimalNumOfBytes(kRows / 2, 0.01));
+      for (auto row = rowGroup * kRows / 2; row < (rowGroup + 1) * kRows / 2;
+           ++row) {
+        if (column == 0) {
+          bloomFilter.insertHash(bloomFilter.hash(id(row)));
+        } else if (column == 1) {
+          const auto value = key(row);
+          ByteArray byteArray(std::string_view{value});
+          bloomFilter.insertHash(bloomFilter.hash(&byteArray));
+        } else {
+          bloomFilter.insertHash(
+              bloomFilter.hash(static_cast<int32_t>(id(row))));
+        }
+      }
+      DataBufferHolder bufferHolder{*leafPool_, 1024};
+      AppendOnlyBufferedStream stream(
+          std::make_unique<BufferedOutputStream>(bufferHolder));
+      bloomFilter.writeTo(&stream);
+      stream.flush();
+      fileMetaData.row_groups[rowGroup]
+          .columns[column]
+          .meta_data.__set_bloom_filter_offset(withBloomFilters.size());
+      for (const auto& buffer : bufferHolder.getBuffers()) {
+        withBloomFilters.append(buffer.data(), buffer.size());
+      }
+    }
+  }
+  auto footer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      footerProtocol(footer);
+  fileMetaData.write(&footerProtocol);
+  uint8_t* footerData;
+  uint32_t newFooterLength;
+  footer->getBuffer(&footerData, &newFooterLength);
+  withBloomFilters.append(
+      reinterpret_cast<const char*>(footerData), newFooterLength);
+  withBloomFilters.append(
+      reinterpret_cast<const char*>(&newFooterLength), sizeof(uint32_t));
+  withBloomFilters.append("PAR1", 4);
+
+  auto read = [&](const std::string& file,
+                  uint64_t footerEstimatedSize,
+                  const std::string& column,
+                  std::unique_ptr<Filter> filter,
+                  const std::vector<vector_size_t>& expectedRows) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFooterEstimatedSize(footerEstimatedSize);
+    readerOptions.setFilePreloadThreshold(0);
+    auto reader = std::make_unique<ParquetReader>(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(file), *leafPool_),
+        readerOptions);
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->childByName(column)->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto indices = makeIndices(
+        expectedRows.size(), [&](auto row) { return expectedRows[row]; });
+    std::vector<VectorPtr> children;
+    for (const auto& child : data->children()) {
+      children.push_back(wrapInDictionary(indices, child));
+    }
+    auto expected = makeRowVector(schema->names(), children);
+    VectorPtr result = BaseVector::create(schema, 0, leafPool_.get());
+    vector_size_t total = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      assertEqualVectorPart(expected, result, total);
+      total += result->size();
+    }
+    EXPECT_EQ(total, expected->size());
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+
+  // Rows with ids 12'345 and 12'344. The rows after these have the next ids
+  // of the same parity.
+  const vector_size_t odd = kRows / 2 + 6'172;
+  const vector_size_t even = 6'172;
+  // The Bloom filters are either in the same read as the footer or read
+  // separately.
+  for (const uint64_t footerEstimatedSize : {256UL << 10, 1UL << 10}) {
+    SCOPED_TRACE(fmt::format("footerEstimatedSize {}", footerEstimatedSize));
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "id",
+            exec::equal(12'345),
+            {odd}),
+        1);
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "id",
+            exec::in({12'344, 12'347}),
+            {even, odd + 1}),
+        0);
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "key",
+            exec::equal("key 12344"),
+            {even}),
+        1);
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "key",
+            exec::in(std::vector<std::string>{"key 12345", "key 5x"}),
+            {odd}),
+        1);
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "key",
+            exec::equal("key 5x"),
+            {}),
+        2);
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "n",
+            exec::in({12'345, 1LL << 40}),
+            {odd}),
+        1);
+    // Ranges are not tested against the Bloom filters.
+    EXPECT_EQ(
+        read(
+            withBloomFilters,
+            footerEstimatedSize,
+            "id",
+            exec::between(12'345, 12'345 + 1),
+            {even + 1, odd}),
+        0);
+  }
+  // Without Bloom filters, only the statistics are used.
+  EXPECT_EQ(read(file, 256 << 10, "id", exec::equal(12'345), {odd}), 0);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+// Compares writing Parquet through the Arrow export with writing directly
+// from the Velox vectors.
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr vector_size_t kBatchSize = 10'000;
+constexpr int32_t kNumBatches = 100;
+
+class ParquetWriterBenchmark : public test::VectorTestBase {
+ public:
+  ParquetWriterBenchmark() {
+    const auto dictionary = makeFlatVector<std::string>(
+        1'000, [](auto row) { return fmt::format("dictionary value {}", row); });
+    for (auto i = 0; i < kNumBatches; ++i) {
+      flatNumbers_.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              kBatchSize, [&](auto row) { return (row + i) * 7; }),
+          makeFlatVector<int32_t>(
+              kBatchSize, [](auto row) { return row % 1'000; }, nullEvery(7)),
+          makeFlatVector<double>(
+              kBatchSize, [](auto row) { return row * 0.1; }),
+      }));
+      flatStrings_.push_back(makeRowVector({
+          makeFlatVector<std::string>(
+              kBatchSize,
+              [&](auto row) {
+                return fmt::format("value {}", (row * 31 + i) % 50'000);
+              },
+              nullEvery(11)),
+      }));
+      dictionaryStrings_.push_back(makeRowVector({
+          wrapInDictionary(
+              makeIndices(
+                  kBatchSize,
+                  [&](auto row) { return (row * 17 + i) % 1'000; }),
+              dictionary),
+      }));
+      constants_.push_back(makeRowVector({
+          makeConstant<int64_t>(i, kBatchSize),
+          makeConstant<std::string>("a constant string value", kBatchSize),
+      }));
+    }
+  }
+
+  void write(const std::vector<RowVectorPtr>& batches, bool useNativeWriter) {
+    auto sink = std::make_unique<dwio::common::MemorySink>(
+        1 << 30, dwio::common::FileSink::Options{.pool = pool()});
+    parquet::WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    options.useNativeWriter = useNativeWriter;
+    parquet::Writer writer(
+        std::move(sink), options, asRowType(batches[0]->type()));
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+  }
+
+  std::vector<RowVectorPtr> flatNumbers_;
+  std::vector<RowVectorPtr> flatStrings_;
+  std::vector<RowVectorPtr> dictionaryStrings_;
+  std::vector<RowVectorPtr> constants_;
+};
+
+std::unique_ptr<ParquetWriterBenchmark> benchmark;
+
+BENCHMARK(flatNumbersArrow) {
+  benchmark->write(benchmark->flatNumbers_, false);
+}
+
+BENCHMARK_RELATIVE(flatNumbersNative) {
+  benchmark->write(benchmark->flatNumbers_, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(flatStringsArrow) {
+  benchmark->write(benchmark->flatStrings_, false);
+}
+
+BENCHMARK_RELATIVE(flatStringsNative) {
+  benchmark->write(benchmark->flatStrings_, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(dictionaryStringsArrow) {
+  benchmark->write(benchmark->dictionaryStrings_, false);
+}
+
+BENCHMARK_RELATIVE(dictionaryStringsNative) {
+  benchmark->write(benchmark->dictionaryStrings_, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(constantsArrow) {
+  benchmark->write(benchmark->constants_, false);
+}
+
+BENCHMARK_RELATIVE(constantsNative) {
+  benchmark->write(benchmark->constants_, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<ParquetWriterBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
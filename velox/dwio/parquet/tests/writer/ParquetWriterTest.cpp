@@ -200,6 +200,175 @@ TEST_F(ParquetWriterTest, parquetWriteTimestampTimeZoneWithDefault) {
   writer->close();
 };
 
+TEST_F(ParquetWriterTest, nativeWriter) {
+  const vector_size_t kRows = 1'000;
+  const auto dictionary = makeFlatVector<std::string>(
+      {"apple", "banana", "a string that is too long to be inlined"});
+  const auto data = makeRowVector({
+      makeFlatVector<bool>(
+          kRows, [](auto row) { return row % 3 == 0; }, nullEvery(5)),
+      makeFlatVector<int8_t>(
+          kRows, [](auto row) { return row % 100 - 50; }, nullEvery(7)),
+      makeFlatVector<int16_t>(
+          kRows, [](auto row) { return row * 7; }, nullEvery(11)),
+      makeFlatVector<int32_t>(
+          kRows, [](auto row) { return row * 3; }, nullEvery(13)),
+      makeFlatVector<int64_t>(
+          kRows, [](auto row) { return row * 1'000'000'007L; }),
+      makeFlatVector<float>(
+          kRows, [](auto row) { return row * 0.5f; }, nullEvery(3)),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 0.25; }),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return std::string(row % 20, 'a' + row % 26); },
+          nullEvery(9)),
+      makeFlatVector<int32_t>(
+          kRows, [](auto row) { return row - 500; }, nullEvery(17), DATE()),
+      BaseVector::wrapInDictionary(
+          makeNulls(kRows, nullEvery(4)),
+          makeIndices(kRows, [](auto row) { return row % 3; }),
+          kRows,
+          dictionary),
+      wrapInDictionary(
+          makeIndices(kRows, [](auto row) { return (row * 7) % kRows; }),
+          makeFlatVector<int64_t>(kRows, [](auto row) { return row; })),
+      makeConstant<std::string>("constant", kRows),
+      makeNullConstant(TypeKind::INTEGER, kRows),
+  });
+  const auto schema = asRowType(data->type());
+
+  // Writes the data in two batches into row groups of 300 rows so that row
+  // groups span batches.
+  auto write = [&](bool useNativeWriter) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.useNativeWriter = useNativeWriter;
+    writerOptions.flushPolicyFactory = [&]() {
+      return std::make_unique<LambdaFlushPolicy>(
+          300, kBytesInRowGroup, []() { return false; });
+    };
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data->slice(0, 600));
+    writer->write(data->slice(600, kRows - 600));
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  for (const auto useNativeWriter : {false, true}) {
+    SCOPED_TRACE(fmt::format("useNativeWriter {}", useNativeWriter));
+    auto file = write(useNativeWriter);
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = std::make_unique<ParquetReader>(
+        std::make_unique<dwio::common::BufferedInput>(
+            std::make_shared<InMemoryReadFile>(std::move(file)),
+            readerOptions.memoryPool()),
+        readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    ASSERT_EQ(*reader->rowType(), *schema);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
+TEST_F(ParquetWriterTest, nativeWriterDictionary) {
+  const vector_size_t kRows = 10'000;
+  const auto dictionary = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("dictionary value {}", row); });
+  auto makeBatch = [&](const VectorPtr& base, int32_t seed) {
+    return makeRowVector({
+        BaseVector::wrapInDictionary(
+            makeNulls(kRows, nullEvery(10)),
+            makeIndices(
+                kRows,
+                [&](auto row) { return (row * 31 + seed) % base->size(); }),
+            kRows,
+            base),
+    });
+  };
+
+  // The first row group has the same dictionary in both batches, which is
+  // written as the dictionary page. The second row group has a different
+  // dictionary per batch and the values are encoded by the Parquet writer.
+  const auto otherDictionary = makeFlatVector<std::string>(
+      50, [](auto row) { return fmt::format("other value {}", row); });
+  const std::vector<RowVectorPtr> batches = {
+      makeBatch(dictionary, 0),
+      makeBatch(dictionary, 1),
+      makeBatch(dictionary, 2),
+      makeBatch(otherDictionary, 3),
+  };
+  const auto schema = asRowType(batches[0]->type());
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.useNativeWriter = true;
+  writerOptions.flushPolicyFactory = [&]() {
+    return std::make_unique<LambdaFlushPolicy>(
+        2 * kRows, kBytesInRowGroup, []() { return false; });
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  for (const auto& batch : batches) {
+    writer->write(batch);
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), batches.size() * kRows);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+  for (auto i = 0; i < 2; ++i) {
+    EXPECT_TRUE(reader->fileMetaData()
+                    .rowGroup(i)
+                    .columnChunk(0)
+                    .hasDictionaryPageOffset());
+  }
+  auto expected = BaseVector::create<RowVector>(schema, 0, pool());
+  for (const auto& batch : batches) {
+    expected->append(batch.get());
+  }
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, nativeWriterUnsupportedType) {
+  // Timestamps need unit conversion and are written through Arrow.
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<Timestamp>(
+          1'000, [](auto row) { return Timestamp(row, 0); }),
+  });
+  const auto schema = asRowType(data->type());
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.useNativeWriter = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), 1'000);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
 #ifdef VELOX_ENABLE_PARQUET
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromHiveConfig) {
   SCOPED_TESTVALUE_SET(
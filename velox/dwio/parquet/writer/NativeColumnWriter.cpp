@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeColumnWriter.h"
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/builder.h>
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+using arrow::ByteArray;
+
+// Fills 'defLevels' with the definition levels of rows [offset, offset +
+// size) given the nulls of a flat vector. Returns the number of non-null rows.
+vector_size_t fillDefinitionLevels(
+    const uint64_t* rawNulls,
+    vector_size_t offset,
+    vector_size_t size,
+    std::vector<int16_t>& defLevels) {
+  defLevels.resize(size);
+  if (rawNulls == nullptr) {
+    std::fill(defLevels.begin(), defLevels.end(), 1);
+    return size;
+  }
+  vector_size_t numNonNull = 0;
+  for (auto i = 0; i < size; ++i) {
+    const bool notNull = !bits::isBitNull(rawNulls, offset + i);
+    defLevels[i] = notNull;
+    numNonNull += notNull;
+  }
+  return numNonNull;
+}
+
+vector_size_t fillDefinitionLevels(
+    const DecodedVector& decoded,
+    vector_size_t offset,
+    vector_size_t size,
+    std::vector<int16_t>& defLevels) {
+  defLevels.resize(size);
+  if (!decoded.mayHaveNulls()) {
+    std::fill(defLevels.begin(), defLevels.end(), 1);
+    return size;
+  }
+  vector_size_t numNonNull = 0;
+  for (auto i = 0; i < size; ++i) {
+    const bool notNull = !decoded.isNullAt(offset + i);
+    defLevels[i] = notNull;
+    numNonNull += notNull;
+  }
+  return numNonNull;
+}
+
+// Returns the definition levels to pass to the Parquet writer, nullptr if the
+// column is required.
+const int16_t* definitionLevels(
+    const arrow::ColumnWriter& writer,
+    const std::vector<int16_t>& defLevels,
+    vector_size_t size,
+    vector_size_t numNonNull) {
+  if (writer.descr()->max_definition_level() > 0) {
+    return defLevels.data();
+  }
+  VELOX_CHECK_EQ(
+      numNonNull, size, "Null values in required Parquet column are invalid");
+  return nullptr;
+}
+
+// Writes values of Velox type 'T' into a Parquet column of physical type
+// 'DType'.
+template <typename T, typename DType>
+void writeFixedWidth(
+    const ColumnSlice& slice,
+    arrow::ColumnWriter& columnWriter,
+    std::vector<int16_t>& defLevels) {
+  using ParquetT = typename DType::c_type;
+  auto& writer = static_cast<arrow::TypedColumnWriter<DType>&>(columnWriter);
+  const auto& vector = *slice.vector;
+
+  if constexpr (std::is_same_v<T, ParquetT> && !std::is_same_v<T, bool>) {
+    if (vector.isFlatEncoding()) {
+      // Values and nulls have the Parquet layout, pass them in place.
+      const auto* rawValues =
+          vector.asUnchecked<FlatVector<T>>()->rawValues() + slice.offset;
+      const auto* rawNulls = vector.rawNulls();
+      const auto numNonNull =
+          fillDefinitionLevels(rawNulls, slice.offset, slice.size, defLevels);
+      const auto* levels =
+          definitionLevels(writer, defLevels, slice.size, numNonNull);
+      if (numNonNull == slice.size) {
+        writer.WriteBatch(slice.size, levels, nullptr, rawValues);
+      } else {
+        writer.WriteBatchSpaced(
+            slice.size,
+            levels,
+            nullptr,
+            reinterpret_cast<const uint8_t*>(rawNulls),
+            slice.offset,
+            rawValues);
+      }
+      return;
+    }
+  }
+
+  // Narrow types, booleans and non-flat encodings are gathered into a dense
+  // array of the non-null values.
+  DecodedVector decoded(vector);
+  const auto numNonNull =
+      fillDefinitionLevels(decoded, slice.offset, slice.size, defLevels);
+  raw_vector<ParquetT> values(numNonNull);
+  vector_size_t numValues = 0;
+  for (auto row = slice.offset; row < slice.offset + slice.size; ++row) {
+    if (!decoded.isNullAt(row)) {
+      values[numValues++] = static_cast<ParquetT>(decoded.valueAt<T>(row));
+    }
+  }
+  writer.WriteBatch(
+      slice.size,
+      definitionLevels(writer, defLevels, slice.size, numNonNull),
+      nullptr,
+      values.data());
+}
+
+// Returns the flat string vector that all 'slices' are dictionary encoded
+// over, nullptr if there is no such vector or if writing it as the dictionary
+// page is not worthwhile.
+const FlatVector<StringView>* sharedStringDictionary(
+    const std::vector<ColumnSlice>& slices) {
+  const BaseVector* base = nullptr;
+  vector_size_t numRows = 0;
+  for (const auto& slice : slices) {
+    const auto& vector = *slice.vector;
+    if (vector.encoding() != VectorEncoding::Simple::DICTIONARY) {
+      return nullptr;
+    }
+    const auto* sliceBase = vector.valueVector().get();
+    if (base != nullptr && base != sliceBase) {
+      return nullptr;
+    }
+    base = sliceBase;
+    numRows += slice.size;
+  }
+  // Nulls in the dictionary would need their indices remapped. A dictionary
+  // that is larger than the data it encodes is typically the result of a
+  // filter over flat data and would only add unreferenced values to the
+  // dictionary page.
+  if (base == nullptr || !base->isFlatEncoding() || base->mayHaveNulls() ||
+      base->size() >= numRows) {
+    return nullptr;
+  }
+  return base->asUnchecked<FlatVector<StringView>>();
+}
+
+// Copies the values of 'base' into an Arrow array to be written as the
+// dictionary page. Only the distinct values are copied, the indices are not.
+std::shared_ptr<::arrow::Array> makeArrowDictionary(
+    const FlatVector<StringView>& base,
+    ::arrow::MemoryPool* pool) {
+  const auto* values = base.rawValues();
+  int64_t numBytes = 0;
+  for (auto i = 0; i < base.size(); ++i) {
+    numBytes += values[i].size();
+  }
+  ::arrow::BinaryBuilder builder(pool);
+  PARQUET_THROW_NOT_OK(builder.Reserve(base.size()));
+  PARQUET_THROW_NOT_OK(builder.ReserveData(numBytes));
+  for (auto i = 0; i < base.size(); ++i) {
+    builder.UnsafeAppend(values[i].data(), values[i].size());
+  }
+  std::shared_ptr<::arrow::Array> dictionary;
+  PARQUET_THROW_NOT_OK(builder.Finish(&dictionary));
+  return dictionary;
+}
+
+// Writes a dictionary encoded slice as an Arrow DictionaryArray whose indices
+// wrap the Velox indices and nulls. The Parquet writer puts 'dictionary' in
+// the dictionary page on first use and encodes the indices directly.
+void writeStringDictionary(
+    const ColumnSlice& slice,
+    const std::shared_ptr<::arrow::Array>& dictionary,
+    arrow::ByteArrayWriter& writer,
+    arrow::ArrowWriteContext& context,
+    std::vector<int16_t>& defLevels) {
+  const auto& vector = *slice.vector;
+  const auto end = slice.offset + slice.size;
+  const auto* rawNulls = vector.rawNulls();
+  const auto numNonNull =
+      fillDefinitionLevels(rawNulls, slice.offset, slice.size, defLevels);
+  const auto* levels =
+      definitionLevels(writer, defLevels, slice.size, numNonNull);
+
+  auto indices = std::make_shared<::arrow::Int32Array>(
+      slice.size,
+      ::arrow::Buffer::Wrap(vector.wrapInfo()->as<vector_size_t>(), end),
+      rawNulls == nullptr
+          ? nullptr
+          : std::make_shared<::arrow::Buffer>(
+                reinterpret_cast<const uint8_t*>(rawNulls), bits::nbytes(end)),
+      slice.size - numNonNull,
+      slice.offset);
+  const ::arrow::DictionaryArray array(
+      ::arrow::dictionary(::arrow::int32(), dictionary->type()),
+      indices,
+      dictionary);
+  PARQUET_THROW_NOT_OK(writer.WriteArrow(
+      levels, nullptr, slice.size, array, &context, levels != nullptr));
+}
+
+void writeStrings(
+    const std::vector<ColumnSlice>& slices,
+    arrow::ColumnWriter& columnWriter,
+    arrow::ArrowWriteContext& context,
+    std::vector<int16_t>& defLevels) {
+  auto& writer = static_cast<arrow::ByteArrayWriter&>(columnWriter);
+
+  if (writer.properties()->dictionary_enabled(writer.descr()->path())) {
+    if (const auto* base = sharedStringDictionary(slices)) {
+      const auto dictionary = makeArrowDictionary(*base, context.memory_pool);
+      for (const auto& slice : slices) {
+        writeStringDictionary(slice, dictionary, writer, context, defLevels);
+      }
+      return;
+    }
+  }
+
+  std::vector<ByteArray> values;
+  for (const auto& slice : slices) {
+    DecodedVector decoded(*slice.vector);
+    const auto numNonNull =
+        fillDefinitionLevels(decoded, slice.offset, slice.size, defLevels);
+    // The references must point into the base vector, not to a copy of the
+    // StringView, since short strings are inlined.
+    const auto* rawValues = decoded.data<StringView>();
+    values.clear();
+    values.reserve(numNonNull);
+    for (auto row = slice.offset; row < slice.offset + slice.size; ++row) {
+      if (!decoded.isNullAt(row)) {
+        const auto& value = rawValues[decoded.index(row)];
+        values.emplace_back(
+            value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+      }
+    }
+    writer.WriteBatch(
+        slice.size,
+        definitionLevels(writer, defLevels, slice.size, numNonNull),
+        nullptr,
+        values.data());
+  }
+}
+
+template <typename T, typename DType>
+void writeFixedWidthSlices(
+    const std::vector<ColumnSlice>& slices,
+    arrow::ColumnWriter& writer,
+    std::vector<int16_t>& defLevels) {
+  for (const auto& slice : slices) {
+    writeFixedWidth<T, DType>(slice, writer, defLevels);
+  }
+}
+
+} // namespace
+
+bool isNativeWriteSupported(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    case TypeKind::INTEGER:
+      // Covers DATE, which is written as INT32 days since epoch.
+      return !type->isIntervalYearMonth();
+    case TypeKind::BIGINT:
+      // Decimals are rescaled and intervals are converted by the Arrow path.
+      return !type->isDecimal() && !type->isIntervalDayTime();
+    default:
+      return false;
+  }
+}
+
+void writeNativeColumn(
+    const std::vector<ColumnSlice>& slices,
+    arrow::ColumnWriter& writer,
+    arrow::ArrowWriteContext& context) {
+  if (slices.empty()) {
+    return;
+  }
+  std::vector<int16_t> defLevels;
+  const auto& type = slices[0].vector->type();
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      writeFixedWidthSlices<bool, arrow::BooleanType>(
+          slices, writer, defLevels);
+      break;
+    case TypeKind::TINYINT:
+      writeFixedWidthSlices<int8_t, arrow::Int32Type>(
+          slices, writer, defLevels);
+      break;
+    case TypeKind::SMALLINT:
+      writeFixedWidthSlices<int16_t, arrow::Int32Type>(
+          slices, writer, defLevels);
+      break;
+    case TypeKind::INTEGER:
+      writeFixedWidthSlices<int32_t, arrow::Int32Type>(
+          slices, writer, defLevels);
+      break;
+    case TypeKind::BIGINT:
+      writeFixedWidthSlices<int64_t, arrow::Int64Type>(
+          slices, writer, defLevels);
+      break;
+    case TypeKind::REAL:
+      writeFixedWidthSlices<float, arrow::FloatType>(slices, writer, defLevels);
+      break;
+    case TypeKind::DOUBLE:
+      writeFixedWidthSlices<double, arrow::DoubleType>(
+          slices, writer, defLevels);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      writeStrings(slices, writer, context, defLevels);
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported type for native Parquet write: {}", type->toString());
+  }
+}
+
+} // namespace facebook::velox::parquet
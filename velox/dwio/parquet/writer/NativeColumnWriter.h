@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet::arrow {
+class ColumnWriter;
+struct ArrowWriteContext;
+} // namespace facebook::velox::parquet::arrow
+
+namespace facebook::velox::parquet {
+
+/// A range of rows of a staged top level column.
+struct ColumnSlice {
+  VectorPtr vector;
+  vector_size_t offset;
+  vector_size_t size;
+};
+
+/// Returns true if top level columns of 'type' can be written with
+/// writeNativeColumn(). These are the primitive types whose Parquet physical
+/// representation matches the Velox in-memory one up to widening.
+bool isNativeWriteSupported(const TypePtr& type);
+
+/// Writes 'slices' in order into the column chunk of 'writer' without
+/// converting the data to Arrow. Flat values and nulls are passed to the
+/// Parquet encoders in place and strings are passed as references to the
+/// StringView data. If all 'slices' are dictionary encoded over the same
+/// string dictionary, that dictionary is written as the dictionary page of the
+/// column chunk and the Velox indices are encoded as is.
+void writeNativeColumn(
+    const std::vector<ColumnSlice>& slices,
+    arrow::ColumnWriter& writer,
+    arrow::ArrowWriteContext& context);
+
+} // namespace facebook::velox::parquet
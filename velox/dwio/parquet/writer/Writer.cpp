@@ -22,14 +22,21 @@
 #include "velox/common/config/Config.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/dwio/parquet/writer/NativeColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/ArrowSchema.h"
+#include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
 
 namespace facebook::velox::parquet {
 
+using facebook::velox::parquet::arrow::ArrowWriteContext;
 using facebook::velox::parquet::arrow::ArrowWriterProperties;
 using facebook::velox::parquet::arrow::Compression;
+using facebook::velox::parquet::arrow::ParquetFileWriter;
+using facebook::velox::parquet::arrow::SchemaDescriptor;
 using facebook::velox::parquet::arrow::WriterProperties;
 using facebook::velox::parquet::arrow::arrow::FileWriter;
 
@@ -105,6 +112,13 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+
+  // State of the native path, which bypasses the Arrow export and writes
+  // through the Parquet column writers directly.
+  std::unique_ptr<ParquetFileWriter> fileWriter;
+  std::shared_ptr<ArrowWriterProperties> arrowProperties;
+  std::unique_ptr<ArrowWriteContext> writeContext;
+  std::vector<RowVectorPtr> stagingVectors;
 };
 
 Compression::type getArrowParquetCompression(
@@ -143,6 +157,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
@@ -216,6 +233,41 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Renames the top level fields of 'arrowSchema' and their children after
+// 'schema'.
+std::shared_ptr<::arrow::Schema> renameFields(
+    const std::shared_ptr<::arrow::Schema>& arrowSchema,
+    const RowType& schema) {
+  std::vector<std::shared_ptr<::arrow::Field>> newFields;
+  newFields.reserve(schema.size());
+  for (auto i = 0; i < schema.size(); i++) {
+    newFields.push_back(updateFieldNameRecursive(
+        arrowSchema->fields()[i], *schema.childAt(i), schema.nameOf(i)));
+  }
+  return ::arrow::schema(newFields);
+}
+
+std::shared_ptr<ArrowWriterProperties> makeArrowWriterProperties(
+    bool writeInt96AsTimestamp) {
+  ArrowWriterProperties::Builder builder;
+  if (writeInt96AsTimestamp) {
+    builder.enable_deprecated_int96_timestamps();
+  }
+  return builder.build();
+}
+
+bool useNativeWriter(const WriterOptions& options, const RowType& schema) {
+  if (!options.useNativeWriter.value_or(false)) {
+    return false;
+  }
+  for (const auto& type : schema.children()) {
+    if (!isNativeWriteSupported(type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
 Writer::Writer(
@@ -245,6 +297,7 @@ Writer::Writer(
       getArrowParquetWriterOptions(options, flushPolicy_);
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
+  nativeWriter_ = useNativeWriter(options, *schema_);
 }
 
 Writer::Writer(
@@ -260,13 +313,13 @@ Writer::Writer(
           std::move(schema)} {}
 
 void Writer::flush() {
+  if (nativeWriter_) {
+    flushNative();
+    return;
+  }
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
-      ArrowWriterProperties::Builder builder;
-      if (writeInt96AsTimestamp_) {
-        builder.enable_deprecated_int96_timestamps();
-      }
-      auto arrowProperties = builder.build();
+      auto arrowProperties = makeArrowWriterProperties(writeInt96AsTimestamp_);
       PARQUET_ASSIGN_OR_THROW(
           arrowContext_->writer,
           FileWriter::Open(
@@ -322,6 +375,11 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
+  if (nativeWriter_) {
+    writeNative(data);
+    return;
+  }
+
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get(), options_);
@@ -332,16 +390,10 @@ void Writer::write(const VectorPtr& data) {
   auto arrowSchema = ::arrow::ImportSchema(&schema).ValueOrDie();
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::write", arrowSchema.get());
-  std::vector<std::shared_ptr<::arrow::Field>> newFields;
-  auto childSize = schema_->size();
-  for (auto i = 0; i < childSize; i++) {
-    newFields.push_back(updateFieldNameRecursive(
-        arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
-  }
 
   PARQUET_ASSIGN_OR_THROW(
       auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
+      ::arrow::ImportRecordBatch(&array, renameFields(arrowSchema, *schema_)));
   if (!arrowContext_->schema) {
     arrowContext_->schema = recordBatch->schema();
     for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
@@ -366,12 +418,118 @@ void Writer::write(const VectorPtr& data) {
   arrowContext_->stagingBytes += bytes;
 }
 
+void Writer::writeNative(const VectorPtr& data) {
+  auto input = std::dynamic_pointer_cast<RowVector>(
+      RowVector::pushDictionaryToRowVectorLeaves(data));
+  VELOX_CHECK_NOT_NULL(input);
+  // Lazy children must be loaded while their source is still positioned on
+  // this batch.
+  input->loadedVector();
+
+  auto bytes = input->estimateFlatSize();
+  auto numRows = input->size();
+  if (flushPolicy_->shouldFlush(getStripeProgress(
+          arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
+    flush();
+  }
+
+  arrowContext_->stagingVectors.push_back(std::move(input));
+  arrowContext_->stagingRows += numRows;
+  arrowContext_->stagingBytes += bytes;
+}
+
+void Writer::openNativeWriter() {
+  // The Parquet schema is derived the same way as on the Arrow path so that
+  // both paths produce the same column types.
+  ArrowSchema schema;
+  exportToArrow(
+      BaseVector::create(schema_, 0, generalPool_.get()), schema, options_);
+  auto arrowSchema = renameFields(
+      ::arrow::ImportSchema(&schema).ValueOrDie(), *schema_);
+
+  arrowContext_->arrowProperties =
+      makeArrowWriterProperties(writeInt96AsTimestamp_);
+  std::shared_ptr<SchemaDescriptor> parquetSchema;
+  PARQUET_THROW_NOT_OK(arrow::arrow::ToParquetSchema(
+      arrowSchema.get(),
+      *arrowContext_->properties,
+      *arrowContext_->arrowProperties,
+      &parquetSchema));
+  arrowContext_->fileWriter = ParquetFileWriter::Open(
+      stream_,
+      std::static_pointer_cast<arrow::schema::GroupNode>(
+          parquetSchema->schema_root()),
+      arrowContext_->properties);
+  arrowContext_->writeContext = std::make_unique<ArrowWriteContext>(
+      ::arrow::default_memory_pool(), arrowContext_->arrowProperties.get());
+}
+
+void Writer::flushNative() {
+  if (arrowContext_->stagingRows == 0) {
+    return;
+  }
+  if (!arrowContext_->fileWriter) {
+    openNativeWriter();
+  }
+
+  // Splits the staged rows into row groups of at most 'rowsInRowGroup' rows,
+  // as FileWriter::WriteTable does on the Arrow path.
+  const auto& staged = arrowContext_->stagingVectors;
+  const auto numColumns = schema_->size();
+  const auto rowsInRowGroup = flushPolicy_->rowsInRowGroup();
+  size_t batchIndex = 0;
+  vector_size_t batchOffset = 0;
+  auto remainingRows = arrowContext_->stagingRows;
+  std::vector<std::vector<ColumnSlice>> slices(numColumns);
+  while (remainingRows > 0) {
+    auto rowGroupRows = std::min(remainingRows, rowsInRowGroup);
+    remainingRows -= rowGroupRows;
+    for (auto& columnSlices : slices) {
+      columnSlices.clear();
+    }
+    while (rowGroupRows > 0) {
+      const auto& batch = staged[batchIndex];
+      const auto numRows = static_cast<vector_size_t>(std::min<uint64_t>(
+          batch->size() - batchOffset, rowGroupRows));
+      for (auto i = 0; i < numColumns; ++i) {
+        slices[i].push_back({batch->childAt(i), batchOffset, numRows});
+      }
+      rowGroupRows -= numRows;
+      batchOffset += numRows;
+      if (batchOffset == batch->size()) {
+        ++batchIndex;
+        batchOffset = 0;
+      }
+    }
+
+    auto* rowGroupWriter = arrowContext_->fileWriter->AppendRowGroup();
+    for (auto i = 0; i < numColumns; ++i) {
+      writeNativeColumn(
+          slices[i],
+          *rowGroupWriter->NextColumn(),
+          *arrowContext_->writeContext);
+    }
+    rowGroupWriter->Close();
+  }
+
+  PARQUET_THROW_NOT_OK(stream_->Flush());
+  arrowContext_->stagingVectors.clear();
+  arrowContext_->stagingRows = 0;
+  arrowContext_->stagingBytes = 0;
+}
+
 bool Writer::isCodecAvailable(common::CompressionKind compression) {
   return arrow::util::Codec::IsAvailable(
       getArrowParquetCompression(compression));
 }
 
 void Writer::newRowGroup(int32_t numRows) {
+  if (nativeWriter_) {
+    // Row groups are only started on flush, so flushing the staged rows makes
+    // the next write() start a new row group.
+    flushNative();
+    return;
+  }
   PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(numRows));
 }
 
@@ -382,9 +540,14 @@ void Writer::close() {
     PARQUET_THROW_NOT_OK(arrowContext_->writer->Close());
     arrowContext_->writer.reset();
   }
+  if (arrowContext_->fileWriter) {
+    arrowContext_->fileWriter->Close();
+    arrowContext_->fileWriter.reset();
+  }
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingVectors.clear();
 }
 
 void Writer::abort() {
@@ -91,6 +91,9 @@ struct WriterOptions : public dwio::common::WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  /// Writes the ColumnIndex and OffsetIndex of each column chunk. Readers use
+  /// these to skip pages whose min/max values do not match a filter.
+  bool enablePageIndex = false;
 
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
@@ -110,6 +113,14 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::optional<std::string> parquetWriteTimestampTimeZone;
   bool writeInt96AsTimestamp = false;
 
+  /// If true and all top level columns have primitive types supported by
+  /// NativeColumnWriter, the data is encoded into Parquet pages directly from
+  /// the Velox vectors instead of being exported to Arrow first. Dictionary
+  /// encoded string columns keep their dictionary as the dictionary page.
+  /// Schemas with other types always use the Arrow path. Default if not
+  /// specified: false.
+  std::optional<bool> useNativeWriter;
+
   // Parsing session and hive configs.
 
   // This isn't a typo; session and hive connector config names are different
@@ -118,6 +129,10 @@ struct WriterOptions : public dwio::common::WriterOptions {
       "hive.parquet.writer.timestamp_unit";
   static constexpr const char* kParquetHiveConnectorWriteTimestampUnit =
       "hive.parquet.writer.timestamp-unit";
+  static constexpr const char* kParquetSessionUseNativeWriter =
+      "hive.parquet.writer.use_native_writer";
+  static constexpr const char* kParquetHiveConnectorUseNativeWriter =
+      "hive.parquet.writer.use-native-writer";
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -162,6 +177,15 @@ class Writer : public dwio::common::Writer {
   // Sets the memory reclaimers for all the memory pools used by this writer.
   void setMemoryReclaimers();
 
+  // Stages 'data' for the native path. The vectors are referenced, not copied.
+  void writeNative(const VectorPtr& data);
+
+  // Writes the staged vectors of the native path into row groups.
+  void flushNative();
+
+  // Opens the Parquet file writer of the native path.
+  void openNativeWriter();
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
@@ -179,6 +203,10 @@ class Writer : public dwio::common::Writer {
 
   // Whether to write Int96 timestamps in Arrow Parquet write.
   bool writeInt96AsTimestamp_;
+
+  // Whether the data is written by NativeColumnWriter instead of being
+  // exported to Arrow.
+  bool nativeWriter_{false};
 };
 
 class ParquetWriterFactory : public dwio::common::WriterFactory {
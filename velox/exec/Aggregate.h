@@ -186,6 +186,34 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  // Returns true if addRawInputDense() is supported.
+  virtual bool supportsDenseInput() const {
+    return false;
+  }
+
+  // Updates partial accumulators from raw input data where the groups of the
+  // input rows are given as dense indices. Used by GroupingSet when the hash
+  // table is in array mode and the input has few distinct groups. The
+  // function may combine the input of each group into a dense array of
+  // values before updating the group rows, so that each group row is
+  // updated once per call.
+  // @param groups Pointers to the start of the distinct group rows.
+  // @param numGroups Number of entries in 'groups'.
+  // @param groupIndices Indices into 'groups' aligned with the 'args', e.g.
+  // data in the i-th row of the 'args' goes to groups[groupIndices[i]]. A
+  // group may have no rows in 'rows' if the aggregation has a mask.
+  // @param rows Rows of the 'args' to add to the accumulators. Same as in
+  // addRawInput().
+  // @param args Raw input.
+  virtual void addRawInputDense(
+      char** /*groups*/,
+      int32_t /*numGroups*/,
+      const vector_size_t* /*groupIndices*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_UNSUPPORTED("addRawInputDense is not supported");
+  }
+
   // Updates the single partial accumulator from raw input data for global
   // aggregation.
   // @param group Pointer to the start of the group row.
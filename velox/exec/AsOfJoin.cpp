@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/AsOfJoin.h"
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+using Op = core::IEJoinNode::Op;
+
+bool hasNull(
+    const RowVector& input,
+    const std::vector<column_index_t>& channels,
+    vector_size_t row) {
+  for (auto channel : channels) {
+    if (input.childAt(channel)->isNullAt(row)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void loadColumns(const RowVectorPtr& input) {
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+}
+} // namespace
+
+AsOfJoin::AsOfJoin(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::AsOfJoinNode>& joinNode)
+    : Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "AsOfJoin"),
+      joinType_{joinNode->joinType()},
+      rightType_{joinNode->sources()[1]->outputType()},
+      numKeys_{joinNode->leftKeys().size()},
+      backward_{
+          joinNode->matchCondition().op == Op::kGreaterThan ||
+          joinNode->matchCondition().op == Op::kGreaterThanOrEqual},
+      strict_{
+          joinNode->matchCondition().op == Op::kGreaterThan ||
+          joinNode->matchCondition().op == Op::kLessThan} {
+  const auto& leftType = joinNode->sources()[0]->outputType();
+  for (auto i = 0; i < numKeys_; ++i) {
+    leftChannels_.push_back(
+        leftType->getChildIdx(joinNode->leftKeys()[i]->name()));
+    rightChannels_.push_back(
+        rightType_->getChildIdx(joinNode->rightKeys()[i]->name()));
+  }
+  leftChannels_.push_back(
+      leftType->getChildIdx(joinNode->matchCondition().left->name()));
+  rightChannels_.push_back(
+      rightType_->getChildIdx(joinNode->matchCondition().right->name()));
+
+  for (auto i = 0; i < leftType->size(); ++i) {
+    auto outIndex = outputType_->getChildIdxIfExists(leftType->nameOf(i));
+    if (outIndex.has_value()) {
+      identityProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+  for (auto i = 0; i < rightType_->size(); ++i) {
+    auto outIndex = outputType_->getChildIdxIfExists(rightType_->nameOf(i));
+    if (outIndex.has_value()) {
+      rightProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+}
+
+void AsOfJoin::initialize() {
+  Operator::initialize();
+  // Fetched upfront so that close() releases the right side even if no left
+  // input arrives.
+  rightSource_ = operatorCtx_->task()->getMergeJoinSource(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+}
+
+BlockingReason AsOfJoin::isBlocked(ContinueFuture* future) {
+  if (futureRightSideInput_.valid()) {
+    *future = std::move(futureRightSideInput_);
+    return BlockingReason::kWaitForMergeJoinRightSide;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void AsOfJoin::addInput(RowVectorPtr input) {
+  loadColumns(input);
+  input_ = std::move(input);
+  leftRow_ = 0;
+}
+
+void AsOfJoin::close() {
+  if (rightSource_) {
+    rightSource_->close();
+  }
+  rightInput_ = nullptr;
+  candidate_ = nullptr;
+  matchVectors_.clear();
+  Operator::close();
+}
+
+int32_t AsOfJoin::compareKeys(const RowVector& right, vector_size_t rightRow)
+    const {
+  for (auto i = 0; i < numKeys_; ++i) {
+    // The join columns have no nulls.
+    const auto result = input_->childAt(leftChannels_[i])
+                            ->compare(
+                                right.childAt(rightChannels_[i]).get(),
+                                leftRow_,
+                                rightRow,
+                                CompareFlags{})
+                            .value();
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+int32_t AsOfJoin::compareMatchValue() const {
+  return input_->childAt(leftChannels_[numKeys_])
+      ->compare(
+          rightInput_->childAt(rightChannels_[numKeys_]).get(),
+          leftRow_,
+          rightRow_,
+          CompareFlags{})
+      .value();
+}
+
+bool AsOfJoin::nextRightInput() {
+  VELOX_CHECK_NULL(rightInput_);
+  while (!noMoreRightInput_ && rightInput_ == nullptr) {
+    const auto blockingReason =
+        rightSource_->next(&futureRightSideInput_, &rightInput_);
+    if (blockingReason != BlockingReason::kNotBlocked) {
+      return false;
+    }
+    if (rightInput_ == nullptr) {
+      noMoreRightInput_ = true;
+    } else if (rightInput_->size() == 0) {
+      rightInput_ = nullptr;
+    } else {
+      loadColumns(rightInput_);
+      rightRow_ = 0;
+    }
+  }
+  return true;
+}
+
+void AsOfJoin::advanceRight() {
+  if (++rightRow_ < rightInput_->size()) {
+    return;
+  }
+  if (candidate_ == rightInput_) {
+    // Copies the candidate so as not to keep the whole vector.
+    auto copy = std::static_pointer_cast<RowVector>(
+        BaseVector::create(rightType_, 1, pool()));
+    copy->copy(candidate_.get(), 0, candidateRow_, 1);
+    candidate_ = std::move(copy);
+    candidateRow_ = 0;
+  }
+  rightInput_ = nullptr;
+}
+
+bool AsOfJoin::addMatch() {
+  for (;;) {
+    if (rightInput_ == nullptr) {
+      if (!nextRightInput()) {
+        return false;
+      }
+      if (noMoreRightInput_) {
+        break;
+      }
+    }
+    if (hasNull(*rightInput_, rightChannels_, rightRow_)) {
+      advanceRight();
+      continue;
+    }
+    const auto keyResult = compareKeys(*rightInput_, rightRow_);
+    if (keyResult < 0) {
+      // The right keys are greater.
+      break;
+    }
+    if (keyResult == 0) {
+      const auto result = compareMatchValue();
+      if (backward_) {
+        // Stops at the first right value that is too large.
+        if (strict_ ? result <= 0 : result < 0) {
+          break;
+        }
+        candidate_ = rightInput_;
+        candidateRow_ = rightRow_;
+      } else if (strict_ ? result < 0 : result <= 0) {
+        // The first right value that is large enough is the nearest. It may
+        // also match the next left rows.
+        matchedLeftRows_.push_back(leftRow_);
+        matchSources_.push_back(rightInput_.get());
+        matchRows_.push_back(rightRow_);
+        if (matchVectors_.empty() || matchVectors_.back() != rightInput_) {
+          matchVectors_.push_back(rightInput_);
+        }
+        return true;
+      }
+    }
+    advanceRight();
+  }
+
+  if (backward_ && candidate_ != nullptr &&
+      compareKeys(*candidate_, candidateRow_) == 0) {
+    matchedLeftRows_.push_back(leftRow_);
+    matchSources_.push_back(candidate_.get());
+    matchRows_.push_back(candidateRow_);
+    if (matchVectors_.empty() || matchVectors_.back() != candidate_) {
+      matchVectors_.push_back(candidate_);
+    }
+  }
+  return true;
+}
+
+RowVectorPtr AsOfJoin::getOutput() {
+  if (input_ == nullptr) {
+    return nullptr;
+  }
+  for (; leftRow_ < input_->size(); ++leftRow_) {
+    if (hasNull(*input_, leftChannels_, leftRow_)) {
+      continue;
+    }
+    if (!addMatch()) {
+      return nullptr;
+    }
+  }
+  auto output = makeOutput();
+  input_ = nullptr;
+  matchedLeftRows_.clear();
+  matchSources_.clear();
+  matchRows_.clear();
+  matchVectors_.clear();
+  return output;
+}
+
+RowVectorPtr AsOfJoin::makeOutput() {
+  const vector_size_t numLeftRows = input_->size();
+  const vector_size_t numMatches = matchRows_.size();
+  const bool allMatched = numMatches == numLeftRows;
+  const auto numRows = isLeftJoin(joinType_) ? numLeftRows : numMatches;
+  if (numRows == 0) {
+    return nullptr;
+  }
+
+  // Copies the right side columns of the matches.
+  std::vector<VectorPtr> children(outputType_->size());
+  if (numMatches > 0) {
+    for (const auto& projection : rightProjections_) {
+      children[projection.outputChannel] = BaseVector::create(
+          outputType_->childAt(projection.outputChannel), numMatches, pool());
+    }
+    auto matches = std::make_shared<RowVector>(
+        pool(), outputType_, nullptr, numMatches, children);
+    gatherCopy(
+        matches.get(),
+        0,
+        numMatches,
+        matchSources_,
+        matchRows_,
+        rightProjections_);
+  }
+
+  if (isLeftJoin(joinType_) && !allMatched) {
+    // Adds nulls for the right side columns of the rows without a match.
+    BufferPtr indices;
+    BufferPtr nulls;
+    if (numMatches > 0) {
+      indices = allocateIndices(numLeftRows, pool());
+      nulls = allocateNulls(numLeftRows, pool(), bits::kNull);
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      auto* rawNulls = nulls->asMutable<uint64_t>();
+      for (auto i = 0; i < numMatches; ++i) {
+        rawIndices[matchedLeftRows_[i]] = i;
+        bits::clearNull(rawNulls, matchedLeftRows_[i]);
+      }
+    }
+    for (const auto& projection : rightProjections_) {
+      auto& child = children[projection.outputChannel];
+      child = numMatches == 0
+          ? BaseVector::createNullConstant(
+                outputType_->childAt(projection.outputChannel),
+                numLeftRows,
+                pool())
+          : wrapChild(numLeftRows, indices, child, nulls);
+    }
+  }
+
+  // The left rows are all in the output unless this is an inner join with
+  // unmatched rows.
+  BufferPtr leftIndices;
+  if (!allMatched && !isLeftJoin(joinType_)) {
+    leftIndices = allocateIndices(numMatches, pool());
+    std::copy(
+        matchedLeftRows_.begin(),
+        matchedLeftRows_.end(),
+        leftIndices->asMutable<vector_size_t>());
+  }
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] = wrapChild(
+        numRows, leftIndices, input_->childAt(projection.inputChannel));
+  }
+
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numRows, std::move(children));
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/MergeSource.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Implements an AS OF join (core::AsOfJoinNode). Like MergeJoin, assumes both
+/// streams, left (from addInput()) and right (from a MergeJoinSource), are
+/// sorted in ascending order on the equality keys followed by the match
+/// column.
+///
+/// For each left row, the right rows are advanced past the rows with smaller
+/// keys and, for the match conditions '>' and '>=', past the rows satisfying
+/// the condition. The last of the latter with the same keys is the nearest
+/// match. It is kept as the candidate match of the following left rows with
+/// the same keys. For '<' and '<=', the right rows are advanced past the rows
+/// not satisfying the condition and the first remaining row with the same keys
+/// is the nearest match. The left and right cursors only move forward, so the
+/// join is a single pass over both inputs.
+///
+/// The output is aligned to the left vectors: one output row per left row for
+/// left joins and one per matched left row for inner joins. The left columns
+/// are passed through or wrapped in a dictionary and the right columns are
+/// copied. The operator keeps the current vectors of both sides, the right
+/// vectors with matches of the current left vector and a copy of the candidate
+/// match, so its memory doesn't depend on the number of rows with the same
+/// keys.
+class AsOfJoin : public Operator {
+ public:
+  AsOfJoin(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::AsOfJoinNode>& joinNode);
+
+  void initialize() override;
+
+  BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool needsInput() const override {
+    return input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  void close() override;
+
+ private:
+  // Compares the keys of 'leftRow_' of 'input_' with the keys of 'rightRow'
+  // of 'right'.
+  int32_t compareKeys(const RowVector& right, vector_size_t rightRow) const;
+
+  // Compares the match column of 'leftRow_' of 'input_' with the one of
+  // 'rightRow_' of 'rightInput_'.
+  int32_t compareMatchValue() const;
+
+  // Gets the next batch of the right side into 'rightInput_'. Returns false if
+  // blocked waiting for the right side.
+  bool nextRightInput();
+
+  // Moves 'rightRow_' to the next row of the right side.
+  void advanceRight();
+
+  // Advances the right side for 'leftRow_' and adds its match, if any. Returns
+  // false if blocked waiting for the right side. It is then called again for
+  // the same row.
+  bool addMatch();
+
+  // Returns the output for 'input_' after all its rows have been processed.
+  RowVectorPtr makeOutput();
+
+  const core::JoinType joinType_;
+
+  const RowTypePtr rightType_;
+
+  // Number of equality keys.
+  const size_t numKeys_;
+
+  // True if the match condition is '>' or '>='. The nearest match then
+  // precedes the left row.
+  const bool backward_;
+
+  // True if the match condition is '>' or '<'.
+  const bool strict_;
+
+  // Channels of the equality keys followed by the match column on the left
+  // and right sides.
+  std::vector<column_index_t> leftChannels_;
+  std::vector<column_index_t> rightChannels_;
+
+  // Projections from the right side to the output. The projections from the
+  // left side are in 'identityProjections_'.
+  std::vector<IdentityProjection> rightProjections_;
+
+  std::shared_ptr<MergeJoinSource> rightSource_;
+
+  // Future for synchronizing with the right side.
+  ContinueFuture futureRightSideInput_{ContinueFuture::makeEmpty()};
+
+  bool noMoreRightInput_{false};
+
+  // The current right side vector and row.
+  RowVectorPtr rightInput_;
+  vector_size_t rightRow_{0};
+
+  // The candidate match of '>' and '>=' conditions: the last right row passed
+  // that satisfies the condition. Copied out of 'rightInput_' when moving to
+  // the next right vector.
+  RowVectorPtr candidate_;
+  vector_size_t candidateRow_{0};
+
+  // The left row being processed.
+  vector_size_t leftRow_{0};
+
+  // The left rows with a match and the right vector and row of each match.
+  std::vector<vector_size_t> matchedLeftRows_;
+  std::vector<const RowVector*> matchSources_;
+  std::vector<vector_size_t> matchRows_;
+
+  // Keeps the right vectors in 'matchSources_' alive.
+  std::vector<RowVectorPtr> matchVectors_;
+};
+
+} // namespace facebook::velox::exec
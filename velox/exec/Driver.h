@@ -298,7 +298,10 @@ struct DriverCtx {
   common::PrefixSortConfig prefixSortConfig() const {
     return common::PrefixSortConfig{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
-        queryConfig().prefixSortMinRows()};
+        queryConfig().prefixSortMinRows(),
+        queryConfig().prefixSortMaxStringPrefixLength(),
+        queryConfig().orderBySortMaxThreads(),
+        queryConfig().orderBySortMinRowsPerThread()};
   }
 };
 
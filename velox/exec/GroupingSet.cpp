@@ -116,27 +116,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*globalGroupingSets*/ std::vector<vector_size_t>{},
-      /*groupIdColumn*/ std::nullopt,
-      /*spillConfig*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx,
-      /*spillStats_*/ nullptr);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -240,6 +219,7 @@ void GroupingSet::addInputForActiveRows(
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
+  const bool useDenseGroups = prepareDenseGroups();
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -275,7 +255,14 @@ void GroupingSet::addInputForActiveRows(
     // this.
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
-    if (isRawInput_) {
+    if (useDenseGroups && !canPushdown && function->supportsDenseInput()) {
+      function->addRawInputDense(
+          denseGroups_.data(),
+          denseGroups_.size(),
+          denseGroupIndices_.data(),
+          rows,
+          tempVectors_);
+    } else if (isRawInput_) {
       function->addRawInput(groups, rows, tempVectors_, canPushdown);
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
@@ -291,6 +278,67 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+bool GroupingSet::prepareDenseGroups() {
+  if (!isRawInput_ || table_->hashMode() != BaseHashTable::HashMode::kArray ||
+      table_->capacity() > kMaxDenseGroupsCapacity) {
+    return false;
+  }
+  if (std::none_of(
+          aggregates_.begin(), aggregates_.end(), [](const auto& aggregate) {
+            return !aggregate.distinct && aggregate.sortingKeys.empty() &&
+                aggregate.function->supportsDenseInput();
+          })) {
+    return false;
+  }
+
+  // Combining values per group pays off only if groups repeat in the batch,
+  // i.e. there are at most half as many distinct groups as rows. The new
+  // groups of the batch are a lower bound for its distinct groups.
+  const auto& rows = lookup_->rows;
+  const auto maxGroups = rows.size() / 2;
+  if (lookup_->newGroups.size() > maxGroups) {
+    return false;
+  }
+  // After a batch with too many distinct groups, skip the pre-pass for a
+  // number of batches that doubles with each such batch in a row.
+  if (numDenseGroupsSkipBatches_ > 0) {
+    --numDenseGroupsSkipBatches_;
+    return false;
+  }
+
+  if (denseGroupSlots_.size() != table_->capacity() ||
+      ++denseGroupsBatch_ == 0) {
+    denseGroupSlots_.assign(table_->capacity(), DenseGroupSlot{});
+    denseGroupsBatch_ = 1;
+  }
+
+  // In array mode the hash of a row is the index of its slot in the table.
+  const auto* hashes = lookup_->hashes.data();
+  const auto* hits = lookup_->hits.data();
+  denseGroupIndices_.resize(lookup_->hits.size());
+  denseGroups_.clear();
+  for (auto row : rows) {
+    auto& slot = denseGroupSlots_[hashes[row]];
+    if (slot.batch != denseGroupsBatch_) {
+      if (denseGroups_.size() == maxGroups) {
+        denseGroupsBackoff_ = std::min<int32_t>(
+            std::max<int32_t>(1, denseGroupsBackoff_ * 2),
+            kMaxDenseGroupsBackoff);
+        numDenseGroupsSkipBatches_ = denseGroupsBackoff_;
+        return false;
+      }
+      slot.batch = denseGroupsBatch_;
+      slot.index = denseGroups_.size();
+      denseGroups_.push_back(hits[row]);
+    }
+    denseGroupIndices_[row] = slot.index;
+  }
+
+  denseGroupsBackoff_ = 0;
+  ++numDenseInputBatches_;
+  return true;
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
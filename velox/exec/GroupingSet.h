@@ -45,13 +45,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -127,6 +120,12 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the number of input batches whose raw input was pre-aggregated
+  /// per distinct group. See addRawInputDense() in Aggregate.
+  int64_t numDenseInputBatches() const {
+    return numDenseInputBatches_;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -184,6 +183,14 @@ class GroupingSet {
 
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
+  // Maps the groups of the rows of 'lookup_' to dense indices in
+  // 'denseGroupIndices_' and fills 'denseGroups_' with the distinct groups.
+  // Returns false if the raw input of the batch should not be added with
+  // addRawInputDense(), e.g. the table is not in array mode or the batch has
+  // too few rows per group. The mapping stops as soon as there are too many
+  // groups, and is skipped for the batches after such a batch.
+  bool prepareDenseGroups();
+
   // If the given aggregation has mask, the method returns reference to the
   // selectivity vector from the maskedActiveRows_ (based on the mask channel
   // index for this aggregation), otherwise it returns reference to activeRows_.
@@ -312,6 +319,35 @@ class GroupingSet {
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
 
+  // Maximum capacity of a hash table in array mode for which raw input is
+  // pre-aggregated per distinct group.
+  static constexpr uint64_t kMaxDenseGroupsCapacity = 64 << 10;
+
+  // Maximum number of batches to add without pre-aggregation after a batch
+  // with too few rows per group.
+  static constexpr int32_t kMaxDenseGroupsBackoff = 64;
+
+  struct DenseGroupSlot {
+    // The batch in which 'index' was set. The slot does not occur in the
+    // current batch if it is not 'denseGroupsBatch_'.
+    uint32_t batch{0};
+    int32_t index{0};
+  };
+
+  // Index into 'denseGroups_' for each array mode table slot. Stamping the
+  // slots with the batch avoids a pass to reset them after each batch.
+  std::vector<DenseGroupSlot> denseGroupSlots_;
+  uint32_t denseGroupsBatch_{0};
+  // Number of batches to skip the pre-aggregation for, and the number
+  // skipped after the last batch with too few rows per group.
+  int32_t numDenseGroupsSkipBatches_{0};
+  int32_t denseGroupsBackoff_{0};
+  // Index into 'denseGroups_' for each row of the current batch.
+  raw_vector<vector_size_t> denseGroupIndices_;
+  // Distinct groups of the current batch.
+  std::vector<char*> denseGroups_;
+  int64_t numDenseInputBatches_{0};
+
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
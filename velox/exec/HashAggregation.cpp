@@ -15,6 +15,7 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include "velox/common/hyperloglog/HllUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -45,6 +46,8 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      partialAggregationSampleRows_(
+          driverCtx->queryConfig().abandonPartialAggregationSampleRows()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -118,18 +121,70 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
       100 * numOutput / numInputRows_ >= abandonPartialAggregationMinPct_;
 }
 
-void HashAggregation::addInput(RowVectorPtr input) {
-  if (!pushdownChecked_) {
-    mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
-    pushdownChecked_ = true;
-  }
-  if (abandonedPartialAggregation_) {
-    input_ = input;
-    numInputRows_ += input->size();
+void HashAggregation::maybeStartSampling() {
+  // Sampling is skipped if the aggregation may be pushed into the scan, which
+  // then does not materialize the input.
+  if (partialAggregationSampleRows_ <= 0 || !isPartialOutput_ || isGlobal_ ||
+      isDistinct_ || mayPushdown_) {
     return;
   }
+  sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+  sampleHll_ = std::make_unique<common::hll::DenseHll>(
+      common::hll::toIndexBitLength(
+          common::hll::kDefaultApproxDistinctStandardError),
+      sampleAllocator_.get());
+}
+
+void HashAggregation::addSampleInput(const RowVectorPtr& input) {
+  // The input is kept past the next input of the source, so lazy vectors must
+  // be loaded now.
+  input->loadedVector();
+  const auto& hashers = groupingSet_->hashLookup().hashers;
+  for (vector_size_t row = 0; row < input->size(); ++row) {
+    uint64_t hash = 0;
+    for (const auto& hasher : hashers) {
+      hash = bits::hashMix(
+          hash, input->childAt(hasher->channel())->hashValueAt(row));
+    }
+    sampleHll_->insertHash(hash);
+  }
+  numSampleRows_ += input->size();
+  sampleInputs_.push_back(input);
+}
+
+void HashAggregation::finishSampling() {
+  VELOX_CHECK_NOT_NULL(sampleHll_);
+  const auto numGroups = sampleHll_->cardinality();
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+
+  // A sample cut short by the end of input is aggregated since the input is
+  // small.
+  if (numSampleRows_ >= partialAggregationSampleRows_) {
+    const double estimatedPct =
+        std::min<double>(100, 100.0 * numGroups / numSampleRows_);
+    addRuntimeStat(
+        "estimatedPartialAggregationPct", RuntimeCounter(estimatedPct));
+    if (estimatedPct >= abandonPartialAggregationMinPct_) {
+      groupingSet_->abandonPartialAggregation();
+      addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+      abandonedPartialAggregation_ = true;
+      return;
+    }
+    partialAggregationSampled_ = true;
+  }
+
+  // All of the sample is added even if the partial aggregation gets full on
+  // the way. This is bounded by the sample size.
+  auto inputs = std::move(sampleInputs_);
+  sampleInputs_.clear();
+  for (const auto& input : inputs) {
+    addInputToGroupingSet(input);
+  }
+}
+
+void HashAggregation::addInputToGroupingSet(const RowVectorPtr& input) {
   groupingSet_->addInput(input, mayPushdown_);
-  numInputRows_ += input->size();
 
   updateRuntimeStats();
 
@@ -137,12 +192,35 @@ void HashAggregation::addInput(RowVectorPtr input) {
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
+      !partialAggregationSampled_ &&
       abandonPartialAggregationEarly(groupingSet_->numDistinct());
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
     partialFull_ = true;
   }
+}
+
+void HashAggregation::addInput(RowVectorPtr input) {
+  if (!pushdownChecked_) {
+    mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
+    pushdownChecked_ = true;
+    maybeStartSampling();
+  }
+  if (abandonedPartialAggregation_) {
+    input_ = input;
+    numInputRows_ += input->size();
+    return;
+  }
+  numInputRows_ += input->size();
+  if (sampleHll_ != nullptr) {
+    addSampleInput(input);
+    if (numSampleRows_ >= partialAggregationSampleRows_) {
+      finishSampling();
+    }
+    return;
+  }
+  addInputToGroupingSet(input);
 
   if (isDistinct_) {
     newDistincts_ = !groupingSet_->hasSpilled() &&
@@ -188,6 +266,10 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (groupingSet_->numDenseInputBatches() > 0) {
+    runtimeStats["denseInputBatches"] =
+        RuntimeMetric(groupingSet_->numDenseInputBatches());
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -269,7 +351,11 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
   if (abandonedPartialAggregation_) {
-    if (noMoreInput_) {
+    if (input_ == nullptr && !sampleInputs_.empty()) {
+      input_ = std::move(sampleInputs_.front());
+      sampleInputs_.pop_front();
+    }
+    if (noMoreInput_ && sampleInputs_.empty()) {
       finished_ = true;
     }
     if (!input_) {
@@ -380,6 +466,9 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (sampleHll_ != nullptr) {
+    finishSampling();
+  }
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
@@ -438,6 +527,9 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  sampleInputs_.clear();
+  sampleHll_.reset();
+  sampleAllocator_.reset();
   groupingSet_.reset();
 }
 
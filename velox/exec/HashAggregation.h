@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -34,7 +37,9 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    // Input received while sampling is produced before taking more input.
+    return !noMoreInput_ && !partialFull_ &&
+        (sampleHll_ != nullptr || sampleInputs_.empty());
   }
 
   void noMoreInput() override;
@@ -70,6 +75,24 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Starts estimating the number of groups of partial aggregation on a sample
+  // of the input if enabled by 'partialAggregationSampleRows_'.
+  void maybeStartSampling();
+
+  // Buffers 'input' and adds the hashes of its grouping keys to 'sampleHll_'.
+  void addSampleInput(const RowVectorPtr& input);
+
+  // Ends sampling. If the sample has 'partialAggregationSampleRows_' rows and
+  // the estimated number of groups is at least
+  // 'abandonPartialAggregationMinPct_' % of the rows, abandons partial
+  // aggregation. The sampled input is then passed through by getOutput().
+  // Otherwise, adds the sampled input to 'groupingSet_'.
+  void finishSampling();
+
+  // Adds 'input' to 'groupingSet_' and checks whether the partial aggregation
+  // should be flushed.
+  void addInputToGroupingSet(const RowVectorPtr& input);
+
   RowVectorPtr getDistinctOutput();
 
   void updateEstimatedOutputRowSize();
@@ -86,6 +109,9 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of input rows to sample for estimating the number of groups before
+  // building the partial aggregation hash table. 0 means no sampling.
+  const int32_t partialAggregationSampleRows_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -100,6 +126,20 @@ class HashAggregation : public Operator {
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
+  // True if the sampled input has shown partial aggregation to be reducing.
+  // The check of the first 'abandonPartialAggregationMinRows_' rows is then
+  // skipped.
+  bool partialAggregationSampled_{false};
+
+  // Allocator of 'sampleHll_'.
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  // Estimates the number of distinct grouping keys in the sampled input. Set
+  // while sampling.
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  // Input received while sampling. Added to 'groupingSet_' or passed through
+  // after sampling.
+  std::deque<RowVectorPtr> sampleInputs_;
+  int64_t numSampleRows_{0};
 
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
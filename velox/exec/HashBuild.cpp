@@ -112,6 +112,16 @@ HashBuild::HashBuild(
   }
 
   tableType_ = ROW(std::move(names), std::move(types));
+
+  // NOTE: with grouped execution, each split group builds a table from
+  // different splits.
+  if (!joinNode_->hashTableCacheKey().empty() &&
+      operatorCtx_->driverCtx()->splitGroupId == kUngroupedGroupId) {
+    cacheEntry_ = joinBridge_->hashTableCacheEntry(
+        joinNode_->hashTableCacheKey(), operatorCtx_->task());
+    waitForCachedTable_ = !cacheEntry_->isBuilder(taskId());
+  }
+
   setupTable();
   setupSpiller();
   stateCleared_ = false;
@@ -153,7 +163,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool());
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -173,7 +183,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,12 +194,40 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool());
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
+memory::MemoryPool* HashBuild::tablePool() const {
+  if (cacheEntry_ != nullptr && !waitForCachedTable_) {
+    return cacheEntry_->pool();
+  }
+  return pool();
+}
+
+void HashBuild::maybeUseCachedTable() {
+  VELOX_CHECK(waitForCachedTable_);
+  auto result = cacheEntry_->tableOrFuture(&future_);
+  if (result.has_value()) {
+    waitForCachedTable_ = false;
+    cachedTable_ = std::move(result->table);
+    joinHasNullKeys_ = result->hasNullKeys;
+    // Finishes without processing the build input.
+    noMoreInput();
+    return;
+  }
+  if (future_.valid()) {
+    setState(State::kWaitForBuild);
+    return;
+  }
+  // The builder task has failed. Builds the table of this task from its own
+  // input. 'table_' has been allocated from pool().
+  waitForCachedTable_ = false;
+  cacheEntry_.reset();
+}
+
 void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
@@ -670,6 +708,12 @@ bool HashBuild::finishHashBuild() {
     }
   };
 
+  if (cachedTable_ != nullptr) {
+    stats_.wlock()->addRuntimeStat("hashTableCacheHit", RuntimeCounter(1));
+    joinBridge_->setHashTable(std::move(cachedTable_), {}, joinHasNullKeys_);
+    return true;
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -760,6 +804,9 @@ bool HashBuild::finishHashBuild() {
     }
 
     CpuWallTimer cpuWallTimer{timing};
+    table_->setRadixPartitionBytes(operatorCtx_->driverCtx()
+                                       ->queryConfig()
+                                       .hashJoinRadixPartitionBytes());
     table_->prepareJoinTable(
         std::move(otherTables),
         isInputFromSpill() ? spillConfig()->startPartitionBit
@@ -771,15 +818,114 @@ bool HashBuild::finishHashBuild() {
       BaseHashTable::kBuildWallNanos,
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
+  maybeBuildKeyBloomFilters(spillPartitions);
   addRuntimeStats();
-  joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+  if (cacheEntry_ != nullptr) {
+    // Shares the table with the tasks waiting for it.
+    VELOX_CHECK(spillPartitions.empty());
+    stats_.wlock()->addRuntimeStat("hashTableCacheBuild", RuntimeCounter(1));
+    joinBridge_->setHashTable(
+        cacheEntry_->setTable(std::move(table_), joinHasNullKeys_),
+        {},
+        joinHasNullKeys_);
+  } else {
+    joinBridge_->setHashTable(
+        std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+  }
   if (spillEnabled()) {
     stateCleared_ = true;
   }
   return true;
 }
 
+namespace {
+template <TypeKind Kind>
+void addKeysToBloomFilter(
+    const BaseVector& keys,
+    int32_t numKeys,
+    BloomFilter<>& bloomFilter) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < numKeys; ++i) {
+    if (flatKeys->isNullAt(i)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = flatKeys->valueAt(i);
+      bloomFilter.insert(
+          common::BloomFilterValues::hashBytes(value.data(), value.size()));
+    } else if constexpr (std::is_integral_v<T>) {
+      bloomFilter.insert(
+          common::BloomFilterValues::hashInt64(flatKeys->valueAt(i)));
+    } else {
+      VELOX_UNREACHABLE("Unsupported Bloom filter key type");
+    }
+  }
+}
+} // namespace
+
+void HashBuild::maybeBuildKeyBloomFilters(
+    const SpillPartitionSet& spillPartitions) {
+  const auto maxSize = operatorCtx_->driverCtx()
+                           ->queryConfig()
+                           .hashProbeBloomFilterPushdownMaxSize();
+  if (maxSize == 0 || !spillPartitions.empty() || isInputFromSpill() ||
+      table_->numDistinct() == 0) {
+    return;
+  }
+  // Same join types as HashProbe generates dynamic filters for.
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return;
+  }
+
+  const auto rowContainers = table_->allRows();
+  uint64_t numRows{0};
+  for (const auto* rowContainer : rowContainers) {
+    numRows += rowContainer->numRows();
+  }
+  // BloomFilter::reset() allocates 2 bytes per entry rounded up to a power of
+  // 2.
+  if (numRows > std::numeric_limits<int32_t>::max() ||
+      bits::nextPowerOfTwo(numRows) * 2 > maxSize) {
+    return;
+  }
+
+  const auto& hashers = table_->hashers();
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  for (auto i = 0; i < hashers.size(); ++i) {
+    const auto& type = hashers[i]->type();
+    if (!VectorHasher::typeKindSupportsBloomFilter(type->kind())) {
+      continue;
+    }
+    // Exact filters are preferred when the probe side can make them.
+    if (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+        hashers[i]->hasFilter()) {
+      continue;
+    }
+    auto bloomFilter = std::make_shared<BloomFilter<>>();
+    bloomFilter->reset(numRows);
+    auto keys = BaseVector::create(type, kBatchSize, pool());
+    for (auto* rowContainer : rowContainers) {
+      RowContainerIterator iter;
+      while (const auto numListed =
+                 rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+        rowContainer->extractColumn(rows.data(), numListed, i, keys);
+        VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            addKeysToBloomFilter,
+            type->kind(),
+            *keys,
+            numListed,
+            *bloomFilter);
+      }
+    }
+    hashers[i]->setBloomFilter(std::move(bloomFilter));
+    stats_.wlock()->addRuntimeStat(
+        fmt::format("bloomFilterKey{}", i), RuntimeCounter(1));
+  }
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -910,6 +1056,10 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  if (hashTableStats.numRadixPartitions != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kNumRadixPartitions] =
+        RuntimeMetric(hashTableStats.numRadixPartitions);
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -925,6 +1075,8 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kRunning:
       if (isInputFromSpill()) {
         processSpillInput();
+      } else if (waitForCachedTable_) {
+        maybeUseCachedTable();
       }
       break;
     case State::kYield:
@@ -946,7 +1098,11 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kWaitForProbe:
       if (!future_.valid()) {
         setRunning();
-        postHashBuildProcess();
+        if (waitForCachedTable_) {
+          maybeUseCachedTable();
+        } else {
+          postHashBuildProcess();
+        }
       }
       break;
     default:
@@ -1158,5 +1314,14 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  if (cacheEntry_ != nullptr) {
+    // Lets the waiting tasks build their own tables if this task has failed
+    // before building the shared one.
+    if (cacheEntry_->isBuilder(taskId())) {
+      cacheEntry_->abort();
+    }
+    cacheEntry_.reset();
+  }
+  cachedTable_.reset();
 }
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
@@ -72,7 +73,7 @@ class HashBuild final : public Operator {
   }
 
   bool needsInput() const override {
-    return !noMoreInput_;
+    return !noMoreInput_ && !waitForCachedTable_;
   }
 
   void noMoreInput() override;
@@ -99,6 +100,16 @@ class HashBuild final : public Operator {
   // Invoked to set up hash table to build.
   void setupTable();
 
+  // Returns the pool to allocate the hash table from. This is the pool of the
+  // 'cacheEntry_' if this task builds the table for the HashTableCache.
+  memory::MemoryPool* tablePool() const;
+
+  // Invoked if the table is built by another task for the HashTableCache.
+  // Waits for the table to be built and then finishes without processing the
+  // build input. Falls back to building the table from the build input if the
+  // other task fails to build it.
+  void maybeUseCachedTable();
+
   // Invoked when operator has finished processing the build input and wait for
   // all the other drivers to finish the processing. The last driver that
   // reaches to the hash build barrier, is responsible to build the hash table
@@ -196,6 +207,14 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Invoked after the join table is built to build Bloom filters over the join
+  // keys whose values cannot be pushed down as exact IN filters by the probe
+  // side. The Bloom filters are set on the table's VectorHashers. Skipped if
+  // the join type does not support dynamic filters, the table will not be
+  // complete because of spilling, or the filter would exceed
+  // QueryConfig::hashProbeBloomFilterPushdownMaxSize().
+  void maybeBuildKeyBloomFilters(const SpillPartitionSet& spillPartitions);
+
   // Indicates if this hash build operator is under non-reclaimable state or
   // not.
   bool nonReclaimableState() const;
@@ -235,6 +254,17 @@ class HashBuild final : public Operator {
   // building the final hash table.
   bool stateCleared_{false};
 
+  // Set if the table is shared with other tasks through the HashTableCache.
+  // Declared before 'table_' as it might own the memory pool of 'table_'.
+  std::shared_ptr<HashTableCache::Entry> cacheEntry_;
+
+  // True while waiting for another task to build the table of 'cacheEntry_'.
+  bool waitForCachedTable_{false};
+
+  // The table built by another task. The last driver to finish hands it over
+  // to the probe side.
+  std::shared_ptr<BaseHashTable> cachedTable_;
+
   // Container for the rows being accumulated.
   std::unique_ptr<BaseHashTable> table_;
 
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -33,8 +34,19 @@ void HashJoinBridge::addBuilder() {
   ++numBuilders_;
 }
 
+std::shared_ptr<HashTableCache::Entry> HashJoinBridge::hashTableCacheEntry(
+    const std::string& key,
+    const std::shared_ptr<Task>& task) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (hashTableCacheEntry_ == nullptr) {
+    hashTableCacheEntry_ = HashTableCache::instance().get(key, task->taskId());
+    hashTableCacheEntry_->addTask(task);
+  }
+  return hashTableCacheEntry_;
+}
+
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
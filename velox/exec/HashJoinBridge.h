@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spill.h"
@@ -39,11 +40,21 @@ class HashJoinBridge : public JoinBridge {
   /// HashBuild operators to parallelize the restoring operation.
   void addBuilder();
 
+  /// Invoked by the HashBuild operators of a join with a hash table cache key
+  /// to get the HashTableCache entry for 'key'. The first call looks up the
+  /// entry for 'task' and the others return the same entry, so that all the
+  /// drivers of the task use the same table even if the builder of the entry
+  /// aborts in between. The entry is held until the bridge is destroyed.
+  std::shared_ptr<HashTableCache::Entry> hashTableCacheEntry(
+      const std::string& key,
+      const std::shared_ptr<Task>& task);
+
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
-  /// 'table' which only applies if the disk spilling is enabled.
+  /// 'table' which only applies if the disk spilling is enabled. 'table' may
+  /// be shared with the other tasks through the HashTableCache.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys);
 
@@ -115,6 +126,9 @@ class HashJoinBridge : public JoinBridge {
  private:
   uint32_t numBuilders_{0};
 
+  // Set by the first call to hashTableCacheEntry().
+  std::shared_ptr<HashTableCache::Entry> hashTableCacheEntry_;
+
   std::optional<HashBuildResult> buildResult_;
 
   // restoringSpillPartitionXxx member variables are populated by the
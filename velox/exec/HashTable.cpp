@@ -602,7 +602,7 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = radixPartitionProbeRows(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -679,7 +679,7 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = radixPartitionProbeRows(lookup);
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
@@ -706,6 +706,62 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+namespace {
+// Probe batches with fewer rows than this per radix partition on average are
+// probed in their original order. The rows of a partition would be too few
+// to amortize the misses on the partition's range of the table.
+constexpr int32_t kMinProbeRowsPerRadixPartition = 8;
+} // namespace
+
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::radixPartitionProbeRows(
+    HashLookup& lookup) const {
+  const int32_t numRows = lookup.rows.size();
+  if (radixPartitionBits_.numBits() == 0 ||
+      numRows <
+          radixPartitionBits_.numPartitions() *
+              kMinProbeRowsPerRadixPartition) {
+    return lookup.rows.data();
+  }
+  // Counting sort of the rows by partition. Stable, so that the rows of a
+  // partition are probed in increasing row number.
+  const int32_t numPartitions = radixPartitionBits_.numPartitions();
+  const uint64_t* hashes = lookup.hashes.data();
+  std::array<int32_t, (1 << kMaxRadixPartitionBits) + 1> offsets{};
+  for (auto row : lookup.rows) {
+    ++offsets[radixPartitionBits_.partition(hashes[row]) + 1];
+  }
+  for (auto i = 1; i < numPartitions; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  lookup.partitionedRows.resize(numRows);
+  vector_size_t* partitionedRows = lookup.partitionedRows.data();
+  for (auto row : lookup.rows) {
+    partitionedRows[offsets[radixPartitionBits_.partition(hashes[row])]++] =
+        row;
+  }
+  return partitionedRows;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setRadixPartitionBits(uint64_t byteSize) {
+  radixPartitionBits_ = HashBitRange();
+  if (radixPartitionBytes_ == 0 || byteSize <= radixPartitionBytes_) {
+    return;
+  }
+  // A partition is a range of whole buckets given by the high bits of the
+  // bucket offset.
+  const int32_t maxBits = std::min<int32_t>(
+      kMaxRadixPartitionBits, sizeBits_ - __builtin_ctzll(kBucketSize));
+  int32_t numBits = 0;
+  while (numBits < maxBits && (byteSize >> numBits) > radixPartitionBytes_) {
+    ++numBits;
+  }
+  if (numBits > 0) {
+    radixPartitionBits_ = HashBitRange(sizeBits_ - numBits, sizeBits_);
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(
     uint64_t size,
@@ -720,6 +776,7 @@ void HashTable<ignoreNullKeys>::allocateTables(
   numBuckets_ = byteSize / kBucketSize;
   sizeBits_ = __builtin_popcountll(sizeMask_);
   checkHashBitsOverlap(spillInputStartPartitionBit);
+  setRadixPartitionBits(byteSize);
   bucketOffsetMask_ = sizeMask_ & ~(kBucketSize - 1);
   // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
   // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
@@ -1038,6 +1095,63 @@ void HashTable<ignoreNullKeys>::partitionRows(
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::canApplyRadixJoinBuild() const {
+  return isJoinBuild_ && hashMode_ != HashMode::kArray &&
+      radixPartitionBits_.numBits() > 0;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::radixJoinBuild() {
+  process::TraceContext trace("HashTable::radixJoinBuild");
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> rows(kBatch);
+  raw_vector<uint64_t> hashes(kBatch);
+  raw_vector<uint8_t> partitions(kBatch);
+  const auto getTable = [this](size_t i) INLINE_LAMBDA {
+    return i == 0 ? this : otherTables_[i - 1].get();
+  };
+
+  std::vector<std::unique_ptr<RowPartitions>> rowPartitions;
+  rowPartitions.reserve(1 + otherTables_.size());
+  for (auto i = 0; i <= otherTables_.size(); ++i) {
+    auto* table = getTable(i);
+    rowPartitions.push_back(table->rows()->createRowPartitions(*rows_->pool()));
+    RowContainerIterator iter;
+    while (const auto numRows = table->rows_->listRows(
+               &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+      // The VectorHashers have seen all the keys when the join table is
+      // built, so the keys are always mappable.
+      VELOX_CHECK(
+          hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes));
+      for (auto j = 0; j < numRows; ++j) {
+        partitions[j] = radixPartitionBits_.partition(hashes[j]);
+      }
+      rowPartitions.back()->appendPartitions(
+          folly::Range<const uint8_t*>(partitions.data(), numRows));
+    }
+  }
+
+  const int32_t numPartitions = radixPartitionBits_.numPartitions();
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    for (auto i = 0; i <= otherTables_.size(); ++i) {
+      auto* table = getTable(i);
+      RowContainerIterator iter;
+      while (const auto numRows = table->rows_->listPartitionRows(
+                 iter, partition, kBatch, *rowPartitions[i], rows.data())) {
+        hashRows(folly::Range(rows.data(), numRows), false, hashes);
+        insertForJoin(
+            table->rows_.get(),
+            rows.data(),
+            hashes.data(),
+            numRows,
+            nullptr,
+            &rows_->stringAllocator());
+      }
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::buildJoinPartition(
     uint8_t partition,
@@ -1318,6 +1432,10 @@ void HashTable<ignoreNullKeys>::rehash(
     parallelJoinBuild();
     return;
   }
+  if (canApplyRadixJoinBuild()) {
+    radixJoinBuild();
+    return;
+  }
   raw_vector<uint64_t> hashes;
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
@@ -1355,6 +1473,7 @@ void HashTable<ignoreNullKeys>::setHashMode(
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
     hashMode_ = HashMode::kArray;
+    radixPartitionBits_ = HashBitRange();
     rehash(true, spillInputStartPartitionBit);
   } else if (mode == HashMode::kHash) {
     hashMode_ = HashMode::kHash;
@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -95,6 +96,10 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory used by joinProbe to reorder 'rows' by radix partition
+  /// of a radix partitioned join table. 'rows' is left unchanged.
+  raw_vector<vector_size_t> partitionedRows;
 };
 
 struct HashTableStats {
@@ -103,6 +108,8 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Number of radix partitions of a join table. 0 if not partitioned.
+  int64_t numRadixPartitions{0};
 };
 
 class BaseHashTable {
@@ -132,6 +139,8 @@ class BaseHashTable {
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
+  static inline const std::string kNumRadixPartitions{
+      "hashtable.numRadixPartitions"};
 
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
@@ -283,6 +292,13 @@ class BaseHashTable {
       int8_t spillInputStartPartitionBit,
       folly::Executor* executor = nullptr) = 0;
 
+  /// Sets the target size in bytes of the radix partitions of a join table.
+  /// Must be called before prepareJoinTable. A table whose bucket array is
+  /// larger than 'bytes' is built and probed one range of buckets at a time.
+  /// 0 disables radix partitioning. See
+  /// QueryConfig::kHashJoinRadixPartitionBytes.
+  virtual void setRadixPartitionBytes(uint64_t bytes) = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -551,7 +567,13 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        radixPartitionBits_.numBits() == 0
+            ? 0
+            : radixPartitionBits_.numPartitions()};
   }
 
   bool hasDuplicateKeys() const override {
@@ -584,6 +606,17 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit,
       folly::Executor* executor = nullptr) override;
 
+  void setRadixPartitionBytes(uint64_t bytes) override {
+    VELOX_CHECK(isJoinBuild_);
+    radixPartitionBytes_ = bytes;
+  }
+
+  /// Returns the range of hash bits that gives the radix partition of a row,
+  /// or an empty range if the table is not radix partitioned.
+  const HashBitRange& radixPartitionBits() const {
+    return radixPartitionBits_;
+  }
+
   void prepareForJoinProbe(
       HashLookup& lookup,
       const RowVectorPtr& input,
@@ -704,6 +737,10 @@ class HashTable : public BaseHashTable {
   static_assert(sizeof(Bucket) == 128);
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // Max number of bits of a radix partition number. Partition numbers are
+  // kept in RowPartitions as uint8_t.
+  static constexpr int32_t kMaxRadixPartitionBits = 8;
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -857,6 +894,26 @@ class HashTable : public BaseHashTable {
       HashTable<ignoreNullKeys>& subtable,
       RowPartitions& rowPartitions);
 
+  // Sets 'radixPartitionBits_' for a table of 'byteSize' bytes from
+  // 'radixPartitionBytes_'.
+  void setRadixPartitionBits(uint64_t byteSize);
+
+  // Returns true if the join table is to be built one radix partition at a
+  // time, i.e. the table is radix partitioned and is not built in parallel.
+  bool canApplyRadixJoinBuild() const;
+
+  // Builds a join table one radix partition at a time. First assigns the rows
+  // of 'this' and 'otherTables_' to the radix partitions of their hashes, then
+  // inserts the rows partition by partition so that the inserts go to a
+  // cache-sized range of the table. Like 'parallelJoinBuild', this marks the
+  // RowContainers immutable and can be done once.
+  void radixJoinBuild();
+
+  // Returns the rows of 'lookup' to probe in the order of their radix
+  // partitions if 'this' is radix partitioned. The order is kept in
+  // 'lookup.partitionedRows'. Returns 'lookup.rows' otherwise.
+  const vector_size_t* radixPartitionProbeRows(HashLookup& lookup) const;
+
   // Calculates hashes for 'rows' and returns them in 'hashes'. If
   // 'initNormalizedKeys' is true, the normalized keys are stored below each row
   // in the container. If 'initNormalizedKeys' is false and the table is in
@@ -1087,6 +1144,14 @@ class HashTable : public BaseHashTable {
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
 
+  // Target size in bytes of a radix partition of a join table. 0 if radix
+  // partitioning is disabled.
+  uint64_t radixPartitionBytes_{0};
+
+  // The high bits of the bucket offset that give the radix partition of a
+  // hash. Empty if the table is not radix partitioned.
+  HashBitRange radixPartitionBits_;
+
   friend class ProbeState;
   friend test::HashTableTestHelper<ignoreNullKeys>;
 };
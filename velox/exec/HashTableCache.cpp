@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableCache.h"
+
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::shared_ptr<HashTableCache::Entry> HashTableCache::Entry::create(
+    std::string key,
+    std::string builderTaskId,
+    const std::string& poolName) {
+  auto entry =
+      std::make_shared<Entry>(std::move(key), std::move(builderTaskId));
+  entry->rootPool_ = memory::memoryManager()->addRootPool(
+      poolName, memory::kMaxMemory, std::make_unique<MemoryReclaimer>(entry));
+  entry->pool_ =
+      entry->rootPool_->addLeafChild(fmt::format("{}.table", poolName));
+  return entry;
+}
+
+HashTableCache::Entry::Entry(std::string key, std::string builderTaskId)
+    : key_(std::move(key)), builderTaskId_(std::move(builderTaskId)) {}
+
+HashTableCache::Entry::~Entry() {
+  // The table must be freed before its pool.
+  table_.reset();
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::Entry::setTable(
+    std::unique_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::vector<ContinuePromise> promises;
+  BaseHashTable* tablePtr;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(state_ == State::kBuilding, "Hash table {} already set", key_);
+    table_ = std::move(table);
+    tablePtr = table_.get();
+    hasNullKeys_ = hasNullKeys;
+    state_ = State::kReady;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  // Shares the ownership of this entry.
+  return std::shared_ptr<BaseHashTable>(shared_from_this(), tablePtr);
+}
+
+void HashTableCache::Entry::abort() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (state_ != State::kBuilding) {
+      return;
+    }
+    state_ = State::kAborted;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void HashTableCache::Entry::addTask(const std::shared_ptr<Task>& task) {
+  std::lock_guard<std::mutex> l(mutex_);
+  tasks_.erase(
+      std::remove_if(
+          tasks_.begin(),
+          tasks_.end(),
+          [](const auto& other) { return other.expired(); }),
+      tasks_.end());
+  tasks_.push_back(task);
+}
+
+void HashTableCache::Entry::abort(const std::exception_ptr& error) {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Task>> tasks;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    state_ = State::kAborted;
+    promises = std::move(promises_);
+    for (const auto& weakTask : tasks_) {
+      if (auto task = weakTask.lock()) {
+        tasks.push_back(std::move(task));
+      }
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  // The table is freed after all the tasks using it have released it.
+  for (auto& task : tasks) {
+    task->setError(error);
+  }
+}
+
+bool HashTableCache::Entry::MemoryReclaimer::reclaimableBytes(
+    const memory::MemoryPool& /*pool*/,
+    uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  return false;
+}
+
+uint64_t HashTableCache::Entry::MemoryReclaimer::reclaim(
+    memory::MemoryPool* /*pool*/,
+    uint64_t /*targetBytes*/,
+    uint64_t /*maxWaitMs*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  return 0;
+}
+
+void HashTableCache::Entry::MemoryReclaimer::abort(
+    memory::MemoryPool* /*pool*/,
+    const std::exception_ptr& error) {
+  if (auto entry = entry_.lock()) {
+    entry->abort(error);
+  }
+}
+
+std::optional<HashTableCache::Entry::Result>
+HashTableCache::Entry::tableOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  switch (state_) {
+    case State::kReady:
+      return Result{
+          std::shared_ptr<BaseHashTable>(shared_from_this(), table_.get()),
+          hasNullKeys_};
+    case State::kBuilding:
+      promises_.emplace_back("HashTableCache::Entry::tableOrFuture");
+      *future = promises_.back().getSemiFuture();
+      return std::nullopt;
+    case State::kAborted:
+      return std::nullopt;
+  }
+  VELOX_UNREACHABLE();
+}
+
+bool HashTableCache::Entry::aborted() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return state_ == State::kAborted;
+}
+
+// static
+HashTableCache& HashTableCache::instance() {
+  static HashTableCache cache;
+  return cache;
+}
+
+std::shared_ptr<HashTableCache::Entry> HashTableCache::get(
+    const std::string& key,
+    const std::string& taskId) {
+  return entries_.withLock([&](auto& entries) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+      auto entry = it->second.lock();
+      if (entry != nullptr && !entry->aborted()) {
+        return entry;
+      }
+    }
+    // Drops the entries that are no longer used by any task.
+    for (auto iter = entries.begin(); iter != entries.end();) {
+      if (iter->second.expired()) {
+        iter = entries.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    auto entry = Entry::create(
+        key, taskId, fmt::format("HashTableCache.{}", numEntriesCreated_++));
+    entries[key] = entry;
+    return entry;
+  });
+}
+
+size_t HashTableCache::size() const {
+  return entries_.withLock([](const auto& entries) {
+    size_t numLive = 0;
+    for (const auto& [key, entry] : entries) {
+      if (!entry.expired()) {
+        ++numLive;
+      }
+    }
+    return numLive;
+  });
+}
+
+} // namespace facebook::velox::exec
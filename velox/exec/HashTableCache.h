@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+class Task;
+
+/// Node level cache of hash join tables, used by the joins with
+/// core::HashJoinNode::hashTableCacheKey() set. Typically, many concurrent
+/// tasks of one or more queries join against the same small broadcast table.
+/// The first task to ask for a key builds the table and the other tasks wait
+/// for it and probe the same immutable table instead of building their own.
+///
+/// A cached table is allocated from a root memory pool of its own, so that it
+/// is accounted to neither of the tasks using it and is visible to the memory
+/// arbitrator. The table is immutable and has no spillable state, so there is
+/// nothing to reclaim from it. If the arbitrator aborts the pool, the tasks
+/// using the table fail, which frees it. Each task looks up its entry once,
+/// through its HashJoinBridge, and holds it until the task's join state is
+/// cleared. The cache itself only keeps weak references: the table and its
+/// pool are freed when the last task using them releases the entry.
+class HashTableCache {
+ public:
+  /// A table shared by the tasks with the same key.
+  class Entry : public std::enable_shared_from_this<Entry> {
+   public:
+    /// Creates an entry whose table is allocated from a new root pool named
+    /// 'poolName'.
+    static std::shared_ptr<Entry> create(
+        std::string key,
+        std::string builderTaskId,
+        const std::string& poolName);
+
+    Entry(std::string key, std::string builderTaskId);
+
+    ~Entry();
+
+    const std::string& key() const {
+      return key_;
+    }
+
+    /// Returns true if 'taskId' builds the table.
+    bool isBuilder(const std::string& taskId) const {
+      return taskId == builderTaskId_;
+    }
+
+    /// The pool to allocate the table from. Only used by the builder task.
+    memory::MemoryPool* pool() const {
+      return pool_.get();
+    }
+
+    /// Invoked by the builder task to publish the built 'table'. Returns the
+    /// table to hand over to the probe side. The returned pointer keeps this
+    /// entry, and hence the table memory, alive.
+    std::shared_ptr<BaseHashTable> setTable(
+        std::unique_ptr<BaseHashTable> table,
+        bool hasNullKeys);
+
+    /// Invoked by the builder task if it finishes without publishing the
+    /// table, e.g. on failure. The waiting tasks then build their own tables.
+    void abort();
+
+    /// Registers 'task' as a user of the table. The registered tasks fail if
+    /// the memory arbitrator aborts the table pool.
+    void addTask(const std::shared_ptr<Task>& task);
+
+    struct Result {
+      std::shared_ptr<BaseHashTable> table;
+      bool hasNullKeys;
+    };
+
+    /// Returns the table if it has been built. Otherwise, returns
+    /// std::nullopt and sets 'future' to wait for it if the table is being
+    /// built. 'future' is not set if the builder has aborted.
+    std::optional<Result> tableOrFuture(ContinueFuture* future);
+
+    /// Returns true if the builder has aborted.
+    bool aborted() const;
+
+   private:
+    enum class State { kBuilding, kReady, kAborted };
+
+    // Reclaimer of 'rootPool_'. Nothing can be reclaimed from the table, the
+    // abort is forwarded to the tasks using it.
+    class MemoryReclaimer : public memory::MemoryReclaimer {
+     public:
+      explicit MemoryReclaimer(std::weak_ptr<Entry> entry)
+          : entry_(std::move(entry)) {}
+
+      bool reclaimableBytes(
+          const memory::MemoryPool& pool,
+          uint64_t& reclaimableBytes) const override;
+
+      uint64_t reclaim(
+          memory::MemoryPool* pool,
+          uint64_t targetBytes,
+          uint64_t maxWaitMs,
+          memory::MemoryReclaimer::Stats& stats) override;
+
+      void abort(memory::MemoryPool* pool, const std::exception_ptr& error)
+          override;
+
+     private:
+      const std::weak_ptr<Entry> entry_;
+    };
+
+    // Invoked by the memory arbitrator to abort the table pool. Aborts the
+    // build if in progress and fails the tasks using the table.
+    void abort(const std::exception_ptr& error);
+
+    const std::string key_;
+    const std::string builderTaskId_;
+    std::shared_ptr<memory::MemoryPool> rootPool_;
+    std::shared_ptr<memory::MemoryPool> pool_;
+
+    mutable std::mutex mutex_;
+    State state_{State::kBuilding};
+    // The builder task and the tasks that have looked up this entry.
+    std::vector<std::weak_ptr<Task>> tasks_;
+    // Freed before 'pool_'.
+    std::unique_ptr<BaseHashTable> table_;
+    bool hasNullKeys_{false};
+    std::vector<ContinuePromise> promises_;
+  };
+
+  static HashTableCache& instance();
+
+  /// Returns the entry for 'key'. Creates a new entry to be built by 'taskId'
+  /// if there is none or if the builder of the existing one has aborted.
+  std::shared_ptr<Entry> get(const std::string& key, const std::string& taskId);
+
+  /// Returns the number of live entries.
+  size_t size() const;
+
+ private:
+  folly::Synchronized<
+      folly::F14FastMap<std::string, std::weak_ptr<Entry>>,
+      std::mutex>
+      entries_;
+  std::atomic<uint64_t> numEntriesCreated_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableInputSpiller.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+HashTableInputSpiller::HashTableInputSpiller(
+    Spiller::Type type,
+    RowTypePtr inputType,
+    BaseHashTable* table,
+    HashLookup* lookup,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats,
+    memory::MemoryPool* pool)
+    : type_(type),
+      inputType_(std::move(inputType)),
+      table_(table),
+      lookup_(lookup),
+      spillConfig_(spillConfig),
+      spillStats_(spillStats),
+      pool_(pool) {
+  VELOX_CHECK_NOT_NULL(table_);
+  VELOX_CHECK_NOT_NULL(lookup_);
+  VELOX_CHECK_NOT_NULL(spillConfig_);
+  setSpillPartitionBits();
+}
+
+void HashTableInputSpiller::ensureInputFits(
+    Operator* op,
+    const RowVectorPtr& input) {
+  const auto numDistinct = table_->numDistinct();
+  if (numDistinct == 0) {
+    // Table is empty. Nothing to spill.
+    return;
+  }
+
+  auto* rows = table_->rows();
+  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
+  const auto outOfLineBytes =
+      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const auto outOfLineBytesPerRow = outOfLineBytes / numDistinct;
+
+  // Test-only spill path.
+  if (testingTriggerSpill(pool_->name())) {
+    Operator::ReclaimableSectionGuard guard(op);
+    memory::testingRunArbitration(pool_);
+    return;
+  }
+
+  const auto currentUsage = pool_->usedBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  const auto availableReservationBytes = pool_->availableReservation();
+  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
+  const auto incrementBytes =
+      rows->sizeIncrement(input->size(), outOfLineBytesPerRow * input->size()) +
+      tableIncrementBytes;
+
+  // First to check if we have sufficient minimal memory reservation.
+  if (availableReservationBytes >= minReservationBytes) {
+    if ((tableIncrementBytes == 0) && (freeRows > input->size()) &&
+        (outOfLineBytes == 0 ||
+         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
+      // Enough free rows for input rows and enough variable length free space.
+      return;
+    }
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the maximum increment from this input and 'spillableReservationGrowthPct_'
+  // of the current memory usage.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    Operator::ReclaimableSectionGuard guard(op);
+    if (pool_->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << pool_->name()
+               << ", usage: " << succinctBytes(pool_->usedBytes())
+               << ", reservation: " << succinctBytes(pool_->reservedBytes());
+}
+
+void HashTableInputSpiller::spill() {
+  const auto spillPartitionSet = spillHashTable();
+  VELOX_CHECK_EQ(table_->numDistinct(), 0);
+
+  setupInputSpiller(spillPartitionSet);
+}
+
+SpillPartitionNumSet HashTableInputSpiller::spillHashTable() {
+  auto columnTypes = table_->rows()->columnTypes();
+  auto tableType = ROW(std::move(columnTypes));
+
+  auto hashTableSpiller = std::make_unique<Spiller>(
+      type_,
+      table_->rows(),
+      tableType,
+      spillPartitionBits_,
+      spillConfig_,
+      spillStats_);
+
+  hashTableSpiller->spill();
+  hashTableSpiller->finishSpill(spillHashTablePartitionSet_);
+
+  table_->clear();
+  pool_->release();
+  return hashTableSpiller->state().spilledPartitionSet();
+}
+
+void HashTableInputSpiller::setupInputSpiller(
+    const SpillPartitionNumSet& spillPartitionSet) {
+  VELOX_CHECK(!spillPartitionSet.empty());
+
+  inputSpiller_ = std::make_unique<Spiller>(
+      type_, inputType_, spillPartitionBits_, spillConfig_, spillStats_);
+  inputSpiller_->setPartitionsSpilled(spillPartitionSet);
+
+  const auto& hashers = table_->hashers();
+
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(hashers.size());
+  for (const auto& hasher : hashers) {
+    keyChannels.push_back(hasher->channel());
+  }
+
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      inputSpiller_->hashBits(), inputType_, keyChannels);
+}
+
+void HashTableInputSpiller::spillInput(
+    const RowVectorPtr& input,
+    memory::MemoryPool* pool) {
+  const auto numInput = input->size();
+
+  std::vector<uint32_t> spillPartitions(numInput);
+  const auto singlePartition =
+      spillHashFunction_->partition(*input, spillPartitions);
+
+  const auto numPartitions = spillHashFunction_->numPartitions();
+
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    partitionIndices[i] = allocateIndices(numInput, pool);
+    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
+  }
+
+  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
+
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = singlePartition.has_value() ? singlePartition.value()
+                                                       : spillPartitions[row];
+    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
+    const auto numInputs = numSpillInputs[partition];
+    if (numInputs == 0) {
+      continue;
+    }
+
+    inputSpiller_->spill(
+        partition, wrap(numInputs, partitionIndices[partition], input));
+  }
+}
+
+void HashTableInputSpiller::finishInputSpill() {
+  VELOX_CHECK(spillingInput());
+  inputSpiller_->finishSpill(spillInputPartitionSet_);
+  removeEmptyPartitions(spillInputPartitionSet_);
+}
+
+bool HashTableInputSpiller::restoreNextPartition(
+    const std::function<void(const RowVectorPtr& rows)>& rowsAdded) {
+  VELOX_CHECK_NULL(spillInputReader_);
+  if (spillInputPartitionSet_.empty()) {
+    return false;
+  }
+
+  auto it = spillInputPartitionSet_.begin();
+  spillInputReader_ = it->second->createUnorderedReader(
+      spillConfig_->readBufferSize, pool_, spillStats_);
+
+  // Find matching partition for the hash table.
+  auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
+  if (hashTableIt != spillHashTablePartitionSet_.end()) {
+    auto spillHashTableReader = hashTableIt->second->createUnorderedReader(
+        spillConfig_->readBufferSize, pool_, spillStats_);
+
+    setSpillPartitionBits(&(it->first));
+
+    RowVectorPtr data;
+    while (spillHashTableReader->nextBatch(data)) {
+      // 'data' contains the key columns followed by the dependent columns of
+      // the hash table. Transform 'data' to match 'inputType_' so it can be
+      // added to the 'table_'. Move key columns and leave other columns unset.
+      std::vector<VectorPtr> columns(inputType_->size());
+
+      const auto& hashers = table_->hashers();
+      for (auto i = 0; i < hashers.size(); ++i) {
+        columns[hashers[i]->channel()] = data->childAt(i);
+      }
+
+      auto input = std::make_shared<RowVector>(
+          pool_, inputType_, nullptr, data->size(), std::move(columns));
+
+      SelectivityVector rows(input->size());
+      table_->prepareForGroupProbe(
+          *lookup_, input, rows, spillConfig_->startPartitionBit);
+      table_->groupProbe(*lookup_, spillConfig_->startPartitionBit);
+
+      if (rowsAdded != nullptr) {
+        rowsAdded(data);
+      }
+    }
+  }
+
+  spillInputPartitionSet_.erase(it);
+  return true;
+}
+
+bool HashTableInputSpiller::nextInput(RowVectorPtr& input) {
+  VELOX_CHECK_NOT_NULL(spillInputReader_);
+  if (spillInputReader_->nextBatch(input)) {
+    return true;
+  }
+  input = nullptr;
+  spillInputReader_ = nullptr;
+  return false;
+}
+
+bool HashTableInputSpiller::respillInput(Driver* driver) {
+  VELOX_CHECK_NOT_NULL(spillInputReader_);
+  RowVectorPtr input;
+  while (spillInputReader_->nextBatch(input)) {
+    spillInput(input, pool_);
+
+    if (driver->shouldYield()) {
+      return false;
+    }
+  }
+
+  spillInputReader_ = nullptr;
+  finishInputSpill();
+  return true;
+}
+
+void HashTableInputSpiller::setSpillPartitionBits(
+    const SpillPartitionId* restoredPartitionId) {
+  const auto startPartitionBitOffset = restoredPartitionId == nullptr
+      ? spillConfig_->startPartitionBit
+      : restoredPartitionId->partitionBitOffset() +
+          spillConfig_->numPartitionBits;
+  if (spillConfig_->exceedSpillLevelLimit(startPartitionBitOffset)) {
+    exceededMaxSpillLevelLimit_ = true;
+    return;
+  }
+
+  exceededMaxSpillLevelLimit_ = false;
+  spillPartitionBits_ = HashBitRange(
+      startPartitionBitOffset,
+      startPartitionBitOffset + spillConfig_->numPartitionBits);
+}
+
+} // namespace facebook::velox::exec
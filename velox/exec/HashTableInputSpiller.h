@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/Spiller.h"
+
+namespace facebook::velox::exec {
+
+class Driver;
+class Operator;
+
+/// Spills an operator that keeps one hash table entry per distinct key of its
+/// input and processes each input row against the entry of its key, e.g.
+/// RowNumber and MarkDistinct.
+///
+/// spill() spills the hash table by hash partition and clears it. The input
+/// received afterwards is spilled to the same partitions by spillInput().
+/// After all the input has been received, the partitions are processed one at
+/// a time: restoreNextPartition() loads the spilled hash table rows of a
+/// partition back into the hash table and nextInput() then reads its spilled
+/// input. The partition being restored can be spilled again. Its remaining
+/// input is then spilled to sub-partitions by respillInput(), up to the max
+/// spill level.
+class HashTableInputSpiller {
+ public:
+  /// 'type' is the spiller type of the operator. 'table' and 'lookup' are the
+  /// hash table of the operator and the lookup used to add rows to it.
+  HashTableInputSpiller(
+      Spiller::Type type,
+      RowTypePtr inputType,
+      BaseHashTable* table,
+      HashLookup* lookup,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats,
+      memory::MemoryPool* pool);
+
+  /// Reserves memory in the pool of 'op' for adding 'input' to the hash table.
+  /// If the reservation can't be made, memory arbitration may spill 'op'.
+  void ensureInputFits(Operator* op, const RowVectorPtr& input);
+
+  /// Returns true if the hash table can't be spilled because the spill level
+  /// of the partition being restored is already at the max spill level.
+  bool exceededMaxSpillLevelLimit() const {
+    return exceededMaxSpillLevelLimit_;
+  }
+
+  /// Spills the hash table and clears it. The input received afterwards has
+  /// to be spilled by spillInput().
+  void spill();
+
+  /// Returns true if the hash table has been spilled and the input has to be
+  /// spilled too.
+  bool spillingInput() const {
+    return inputSpiller_ != nullptr && !inputSpiller_->finalized();
+  }
+
+  /// Spills 'input' to the partitions of the hash table. 'pool' is used for
+  /// the temporary buffers.
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  /// Finishes spilling the input. Invoked after all the input has been
+  /// received, before restoring the spilled partitions.
+  void finishInputSpill();
+
+  /// Loads the spilled hash table rows of the next spilled partition into the
+  /// hash table and starts reading the spilled input of the partition.
+  /// 'rowsAdded' is invoked for each batch of hash table rows after it has
+  /// been added, with the hits of the rows in the lookup. Returns false if
+  /// there is no spilled partition left.
+  bool restoreNextPartition(
+      const std::function<void(const RowVectorPtr& rows)>& rowsAdded =
+          nullptr);
+
+  /// Returns true if the spilled input of a partition is being read.
+  bool restoringInput() const {
+    return spillInputReader_ != nullptr;
+  }
+
+  /// Reads the next batch of the spilled input of the partition being
+  /// restored into 'input'. Returns false after the last batch. The caller
+  /// then clears the hash table and restores the next partition.
+  bool nextInput(RowVectorPtr& input);
+
+  /// Spills the rest of the input of the partition being restored after the
+  /// partition has been spilled again. Returns false if 'driver' should yield
+  /// before it is done, in which case it is to be invoked again. The caller
+  /// restores the next partition after it returns true.
+  bool respillInput(Driver* driver);
+
+ private:
+  // Sets 'spillPartitionBits_' for (recursive) spill. If
+  // 'restoredPartitionId' is not null, use it to set 'spillPartitionBits_',
+  // otherwise use 'spillConfig_'. If the new 'spillPartitionBits_' exceeds the
+  // 'maxSpillLevel', set 'exceededMaxSpillLevelLimit_' to true.
+  void setSpillPartitionBits(
+      const SpillPartitionId* restoredPartitionId = nullptr);
+
+  SpillPartitionNumSet spillHashTable();
+
+  void setupInputSpiller(const SpillPartitionNumSet& spillPartitionSet);
+
+  const Spiller::Type type_;
+  const RowTypePtr inputType_;
+  BaseHashTable* const table_;
+  HashLookup* const lookup_;
+  const common::SpillConfig* const spillConfig_;
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+  memory::MemoryPool* const pool_;
+
+  // The spill partition bits used by both hash table content spill and input
+  // data spill.
+  HashBitRange spillPartitionBits_;
+
+  bool exceededMaxSpillLevelLimit_{false};
+
+  SpillPartitionSet spillHashTablePartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to restore previously spilled input.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+};
+} // namespace facebook::velox::exec
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/IEJoinIndex.h"
+
+#include <numeric>
+
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+IEJoinIndex::IEJoinIndex(
+    std::vector<RowVectorPtr> buildVectors,
+    const core::IEJoinNode& joinNode,
+    memory::MemoryPool* pool)
+    : buildVectors_(std::move(buildVectors)) {
+  const auto& buildType = joinNode.sources()[1]->outputType();
+  const auto numKeys = joinNode.rightKeys().size();
+  std::vector<column_index_t> channels;
+  for (const auto& key : joinNode.rightKeys()) {
+    channels.push_back(buildType->getChildIdx(key->name()));
+  }
+  for (const auto& condition : joinNode.conditions()) {
+    channels.push_back(buildType->getChildIdx(condition.right->name()));
+  }
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<IdentityProjection> projections;
+  for (auto i = 0; i < channels.size(); ++i) {
+    names.push_back(fmt::format("c{}", i));
+    types.push_back(buildType->childAt(channels[i]));
+    projections.emplace_back(channels[i], i);
+  }
+  const auto indexType = ROW(std::move(names), std::move(types));
+
+  // Rows with a null in a join column never match.
+  std::vector<const RowVector*> sources;
+  std::vector<vector_size_t> rows;
+  for (const auto& vector : buildVectors_) {
+    for (auto row = 0; row < vector->size(); ++row) {
+      if (!hasNull(*vector, channels, row)) {
+        sources.push_back(vector.get());
+        rows.push_back(row);
+      }
+    }
+  }
+  const vector_size_t numRows = rows.size();
+  if (numRows == 0) {
+    return;
+  }
+
+  auto unsorted = std::static_pointer_cast<RowVector>(
+      BaseVector::create(indexType, numRows, pool));
+  gatherCopy(unsorted.get(), 0, numRows, sources, rows, projections);
+
+  // Sorts on the keys and the first condition column.
+  std::vector<vector_size_t> order(numRows);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](auto left, auto right) {
+    for (auto i = 0; i <= numKeys; ++i) {
+      const auto& column = *unsorted->childAt(i);
+      const auto result = compare(column, left, column, right);
+      if (result != 0) {
+        return result < 0;
+      }
+    }
+    return false;
+  });
+
+  rows_ = std::static_pointer_cast<RowVector>(
+      BaseVector::create(indexType, numRows, pool));
+  gatherCopy(
+      rows_.get(),
+      0,
+      numRows,
+      std::vector<const RowVector*>(numRows, unsorted.get()),
+      order);
+  buildSources_.resize(numRows);
+  buildRows_.resize(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    buildSources_[i] = sources[order[i]];
+    buildRows_[i] = rows[order[i]];
+  }
+
+  groupStarts_.push_back(0);
+  for (auto row = 1; row < numRows; ++row) {
+    for (auto i = 0; i < numKeys; ++i) {
+      const auto& column = *rows_->childAt(i);
+      if (compare(column, row, column, row - 1) != 0) {
+        groupStarts_.push_back(row);
+        break;
+      }
+    }
+  }
+  groupStarts_.push_back(numRows);
+
+  if (joinNode.conditions().size() < 2) {
+    return;
+  }
+  // Sorts the rows of each group on the second condition column.
+  const auto& yColumn = *rows_->childAt(numKeys + 1);
+  yOrder_.resize(numRows);
+  std::iota(yOrder_.begin(), yOrder_.end(), 0);
+  for (auto group = 0; group + 1 < groupStarts_.size(); ++group) {
+    std::sort(
+        yOrder_.begin() + groupStarts_[group],
+        yOrder_.begin() + groupStarts_[group + 1],
+        [&](auto left, auto right) {
+          return compare(yColumn, left, yColumn, right) < 0;
+        });
+  }
+}
+
+// static
+bool IEJoinIndex::hasNull(
+    const RowVector& input,
+    const std::vector<column_index_t>& channels,
+    vector_size_t row) {
+  for (auto channel : channels) {
+    if (input.childAt(channel)->isNullAt(row)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace facebook::velox::exec
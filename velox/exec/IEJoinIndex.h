@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// The index over the build side rows of a core::IEJoinNode used by
+/// IEJoinProbe. The build rows without nulls in the join columns are sorted
+/// on (keys, x) into 'rows()'. A group is a range of rows with the same keys.
+/// With two conditions, the rows of each group are also ordered on y by
+/// 'yOrder()'.
+///
+/// The index is immutable once built. The index over the build vectors kept
+/// in memory is built once by the last NestedLoopJoinBuild operator and
+/// shared by all the probe operators through the NestedLoopJoinBridge.
+class IEJoinIndex {
+ public:
+  /// Builds the index over 'buildVectors'. The memory of the index is
+  /// allocated from 'pool'.
+  IEJoinIndex(
+      std::vector<RowVectorPtr> buildVectors,
+      const core::IEJoinNode& joinNode,
+      memory::MemoryPool* pool);
+
+  /// Returns true if there are no build rows without nulls in the join
+  /// columns. Nothing matches then.
+  bool empty() const {
+    return rows_ == nullptr;
+  }
+
+  /// The join columns of the indexed rows: the equality keys followed by the
+  /// columns of the conditions.
+  const RowVector& rows() const {
+    return *rows_;
+  }
+
+  /// The build vector and row of the indexed row at 'position'.
+  const RowVector* buildSource(vector_size_t position) const {
+    return buildSources_[position];
+  }
+
+  vector_size_t buildRow(vector_size_t position) const {
+    return buildRows_[position];
+  }
+
+  /// Start of each group in 'rows()', followed by the number of rows.
+  const std::vector<vector_size_t>& groupStarts() const {
+    return groupStarts_;
+  }
+
+  /// The rows of each group ordered on the second condition column. Only set
+  /// with two conditions.
+  const std::vector<vector_size_t>& yOrder() const {
+    return yOrder_;
+  }
+
+  /// Returns true if 'row' of 'input' has a null in one of 'channels'.
+  static bool hasNull(
+      const RowVector& input,
+      const std::vector<column_index_t>& channels,
+      vector_size_t row);
+
+  /// Compares two values of join columns, which have no nulls.
+  static int32_t compare(
+      const BaseVector& left,
+      vector_size_t leftRow,
+      const BaseVector& right,
+      vector_size_t rightRow) {
+    return left.compare(&right, leftRow, rightRow, CompareFlags{}).value();
+  }
+
+ private:
+  // The indexed build vectors. 'buildSources_' point into them.
+  const std::vector<RowVectorPtr> buildVectors_;
+
+  RowVectorPtr rows_;
+
+  std::vector<const RowVector*> buildSources_;
+  std::vector<vector_size_t> buildRows_;
+
+  std::vector<vector_size_t> groupStarts_;
+
+  std::vector<vector_size_t> yOrder_;
+};
+
+} // namespace facebook::velox::exec
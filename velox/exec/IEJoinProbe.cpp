@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/IEJoinProbe.h"
+
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+using Op = core::IEJoinNode::Op;
+
+std::vector<IdentityProjection> extractProjections(
+    const RowTypePtr& srcType,
+    const RowTypePtr& destType) {
+  std::vector<IdentityProjection> projections;
+  for (auto i = 0; i < srcType->size(); ++i) {
+    auto name = srcType->nameOf(i);
+    auto outIndex = destType->getChildIdxIfExists(name);
+    if (outIndex.has_value()) {
+      projections.emplace_back(i, outIndex.value());
+    }
+  }
+  return projections;
+}
+
+// Returns the first index in [begin, end) at which the build value is greater
+// than (if 'upper') or greater than or equal to (otherwise) 'row' of 'probe'.
+// The build values at 'positions[begin, end)', or at [begin, end) if
+// 'positions' is nullptr, are in ascending order.
+vector_size_t bound(
+    const BaseVector& probe,
+    vector_size_t row,
+    const BaseVector& build,
+    const vector_size_t* positions,
+    vector_size_t begin,
+    vector_size_t end,
+    bool upper) {
+  while (begin < end) {
+    const auto middle = begin + (end - begin) / 2;
+    const auto position = positions != nullptr ? positions[middle] : middle;
+    const auto result = IEJoinIndex::compare(probe, row, build, position);
+    if (upper ? result < 0 : result <= 0) {
+      end = middle;
+    } else {
+      begin = middle + 1;
+    }
+  }
+  return begin;
+}
+
+// Returns the range of indices in [begin, end) at which the build value
+// satisfies 'probe value' 'op' 'build value'.
+std::pair<vector_size_t, vector_size_t> matchRange(
+    Op op,
+    const BaseVector& probe,
+    vector_size_t row,
+    const BaseVector& build,
+    const vector_size_t* positions,
+    vector_size_t begin,
+    vector_size_t end) {
+  switch (op) {
+    case Op::kLessThan:
+      return {bound(probe, row, build, positions, begin, end, true), end};
+    case Op::kLessThanOrEqual:
+      return {bound(probe, row, build, positions, begin, end, false), end};
+    case Op::kGreaterThan:
+      return {begin, bound(probe, row, build, positions, begin, end, false)};
+    case Op::kGreaterThanOrEqual:
+      return {begin, bound(probe, row, build, positions, begin, end, true)};
+  }
+  VELOX_UNREACHABLE();
+}
+} // namespace
+
+IEJoinProbe::IEJoinProbe(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::IEJoinNode>& joinNode)
+    : Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "IEJoinProbe",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      outputBatchSize_{outputBatchRows()},
+      joinNode_(joinNode),
+      joinType_(joinNode->joinType()),
+      probeType_(joinNode->sources()[0]->outputType()),
+      numKeys_(joinNode->leftKeys().size()) {
+  const auto& buildType = joinNode->sources()[1]->outputType();
+  for (const auto& key : joinNode->leftKeys()) {
+    probeChannels_.push_back(probeType_->getChildIdx(key->name()));
+  }
+  for (const auto& condition : joinNode->conditions()) {
+    probeChannels_.push_back(probeType_->getChildIdx(condition.left->name()));
+    conditionOps_.push_back(condition.op);
+  }
+  if (twoConditions()) {
+    ySuffix_ = conditionOps_[1] == Op::kLessThan ||
+        conditionOps_[1] == Op::kLessThanOrEqual;
+  }
+
+  identityProjections_ = extractProjections(probeType_, outputType_);
+  buildProjections_ = extractProjections(buildType, outputType_);
+}
+
+BlockingReason IEJoinProbe::isBlocked(ContinueFuture* future) {
+  switch (state_) {
+    case ProbeOperatorState::kRunning:
+      [[fallthrough]];
+    case ProbeOperatorState::kFinish:
+      return BlockingReason::kNotBlocked;
+    case ProbeOperatorState::kWaitForBuild: {
+      std::vector<SpillFiles> spilledBuildChunks;
+      if (!getBuildData(future, spilledBuildChunks)) {
+        return BlockingReason::kWaitForJoinBuild;
+      }
+      if (!spilledBuildChunks.empty()) {
+        setupInputSpiller(std::move(spilledBuildChunks));
+      }
+      setState(ProbeOperatorState::kRunning);
+      return BlockingReason::kNotBlocked;
+    }
+    default:
+      VELOX_UNREACHABLE(probeOperatorStateName(state_));
+  }
+}
+
+bool IEJoinProbe::getBuildData(
+    ContinueFuture* future,
+    std::vector<SpillFiles>& spilledBuildChunks) {
+  VELOX_CHECK_NULL(index_);
+
+  auto bridge = operatorCtx_->task()->getNestedLoopJoinBridge(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  if (!bridge->dataOrFuture(future).has_value()) {
+    return false;
+  }
+
+  // The build vectors are referenced by the index built by the last build
+  // operator.
+  setIndex(bridge->ieJoinIndex());
+  spilledBuildChunks = bridge->spilledChunks();
+  return true;
+}
+
+void IEJoinProbe::setupInputSpiller(
+    std::vector<SpillFiles> spilledBuildChunks) {
+  VELOX_CHECK(spillConfig_.has_value());
+  VELOX_CHECK(isInnerJoin(joinType_));
+  VELOX_CHECK_NULL(inputSpiller_);
+
+  inputSpiller_ = std::make_unique<NestedLoopJoinProbeSpiller>(
+      probeType_,
+      std::move(spilledBuildChunks),
+      &spillConfig_.value(),
+      &spillStats_,
+      pool());
+}
+
+void IEJoinProbe::nextSpilledProbeInput() {
+  VELOX_CHECK(buildSpilled());
+  VELOX_CHECK_NULL(input_);
+  while (!inputSpiller_->nextInput(input_)) {
+    std::vector<RowVectorPtr> buildVectors;
+    if (!inputSpiller_->nextBuild(buildVectors)) {
+      index_ = nullptr;
+      setState(ProbeOperatorState::kFinish);
+      return;
+    }
+    setIndex(std::make_shared<IEJoinIndex>(
+        std::move(buildVectors), *joinNode_, pool()));
+  }
+  inputPrepared_ = false;
+}
+
+void IEJoinProbe::setIndex(std::shared_ptr<const IEJoinIndex> index) {
+  VELOX_CHECK_NOT_NULL(index);
+  index_ = std::move(index);
+  bits_.clear();
+  bitsGroup_ = -1;
+  if (twoConditions() && !index_->empty()) {
+    bits_.resize(bits::nwords(index_->groupStarts().back()));
+  }
+}
+
+bool IEJoinProbe::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  const bool reclaimable = canReclaim();
+  reclaimableBytes = reclaimable && buildSpilled() &&
+          inputSpiller_->buildLoaded()
+      ? pool()->reservedBytes()
+      : 0;
+  return reclaimable;
+}
+
+void IEJoinProbe::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  // NOTE: only the spilled build vectors read by this operator and their
+  // index can be released. The in-memory ones are shared by all the probe
+  // operators through the bridge.
+  if (!buildSpilled() || !inputSpiller_->buildLoaded()) {
+    return;
+  }
+  VELOX_CHECK(outputBuildSources_.empty());
+  index_ = nullptr;
+  inputSpiller_->releaseBuild();
+  pool()->release();
+}
+
+void IEJoinProbe::reloadBuild() {
+  std::vector<RowVectorPtr> buildVectors;
+  inputSpiller_->reloadBuild(buildVectors);
+  // The same build rows give the same index, so the index positions in
+  // 'probeRows_' and 'bits_' remain valid.
+  index_ = std::make_shared<IEJoinIndex>(
+      std::move(buildVectors), *joinNode_, pool());
+}
+
+void IEJoinProbe::close() {
+  index_ = nullptr;
+  inputSpiller_.reset();
+  Operator::close();
+}
+
+void IEJoinProbe::addInput(RowVectorPtr input) {
+  // The input is wrapped in dictionaries a few rows at a time in getOutput().
+  // Lazy vectors cannot be wrapped in different dictionaries, so load them
+  // here.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  if (buildSpilled()) {
+    if (input->size() == 0) {
+      return;
+    }
+    // Keep the input for joining with the spilled build chunks.
+    inputSpiller_->spillInput(input);
+  }
+  if (index_->empty() && isInnerJoin(joinType_)) {
+    return;
+  }
+  input_ = std::move(input);
+  inputPrepared_ = false;
+}
+
+void IEJoinProbe::noMoreInput() {
+  Operator::noMoreInput();
+  if (state_ != ProbeOperatorState::kRunning || input_ != nullptr) {
+    return;
+  }
+  if (buildSpilled()) {
+    nextSpilledProbeInput();
+    return;
+  }
+  setState(ProbeOperatorState::kFinish);
+}
+
+int32_t IEJoinProbe::findGroup(vector_size_t row) const {
+  const auto& groupStarts = index_->groupStarts();
+  const int32_t numGroups = groupStarts.size() - 1;
+  if (numKeys_ == 0) {
+    return numGroups > 0 ? 0 : -1;
+  }
+  int32_t low = 0;
+  int32_t high = numGroups - 1;
+  while (low <= high) {
+    const auto middle = low + (high - low) / 2;
+    int32_t result = 0;
+    for (auto i = 0; i < numKeys_ && result == 0; ++i) {
+      result = IEJoinIndex::compare(
+          *input_->childAt(probeChannels_[i]),
+          row,
+          *index_->rows().childAt(i),
+          groupStarts[middle]);
+    }
+    if (result == 0) {
+      return middle;
+    }
+    if (result < 0) {
+      high = middle - 1;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return -1;
+}
+
+void IEJoinProbe::prepareInput() {
+  probeRows_.clear();
+  probeIndex_ = 0;
+  probeRowStarted_ = false;
+  clearBits();
+  if (isLeftJoin(joinType_)) {
+    probeMatched_.resizeFill(input_->size(), false);
+  }
+  inputPrepared_ = true;
+  if (index_->empty()) {
+    return;
+  }
+
+  const auto& groupStarts = index_->groupStarts();
+  const auto& probeX = *input_->childAt(probeChannels_[numKeys_]);
+  const auto& buildX = *index_->rows().childAt(numKeys_);
+  for (auto row = 0; row < input_->size(); ++row) {
+    if (IEJoinIndex::hasNull(*input_, probeChannels_, row)) {
+      continue;
+    }
+    const auto group = findGroup(row);
+    if (group < 0) {
+      continue;
+    }
+    const auto groupBegin = groupStarts[group];
+    const auto groupEnd = groupStarts[group + 1];
+    const auto [xBegin, xEnd] = matchRange(
+        conditionOps_[0], probeX, row, buildX, nullptr, groupBegin, groupEnd);
+    if (xBegin >= xEnd) {
+      continue;
+    }
+    vector_size_t yBound = 0;
+    if (twoConditions()) {
+      const auto [yBegin, yEnd] = matchRange(
+          conditionOps_[1],
+          *input_->childAt(probeChannels_[numKeys_ + 1]),
+          row,
+          *index_->rows().childAt(numKeys_ + 1),
+          index_->yOrder().data(),
+          groupBegin,
+          groupEnd);
+      if (yBegin >= yEnd) {
+        continue;
+      }
+      yBound = ySuffix_ ? yBegin : yEnd;
+    }
+    probeRows_.push_back({row, group, xBegin, xEnd, yBound});
+  }
+
+  if (twoConditions()) {
+    // Within a group, the rows satisfying the second condition only grow from
+    // one probe row to the next.
+    std::sort(
+        probeRows_.begin(),
+        probeRows_.end(),
+        [&](const auto& left, const auto& right) {
+          if (left.group != right.group) {
+            return left.group < right.group;
+          }
+          return ySuffix_ ? left.yBound > right.yBound
+                          : left.yBound < right.yBound;
+        });
+  }
+}
+
+void IEJoinProbe::clearBits() {
+  if (bitsGroup_ < 0) {
+    return;
+  }
+  const auto& groupStarts = index_->groupStarts();
+  bits::fillBits(
+      bits_.data(),
+      groupStarts[bitsGroup_],
+      groupStarts[bitsGroup_ + 1],
+      false);
+  bitsGroup_ = -1;
+}
+
+void IEJoinProbe::markYMatches(const ProbeRow& probeRow) {
+  const auto& groupStarts = index_->groupStarts();
+  const auto& yOrder = index_->yOrder();
+  if (probeRow.group != bitsGroup_) {
+    clearBits();
+    bitsGroup_ = probeRow.group;
+    yPosition_ = ySuffix_ ? groupStarts[bitsGroup_ + 1]
+                          : groupStarts[bitsGroup_];
+  }
+  if (ySuffix_) {
+    while (yPosition_ > probeRow.yBound) {
+      bits::setBit(bits_.data(), yOrder[--yPosition_]);
+    }
+  } else {
+    while (yPosition_ < probeRow.yBound) {
+      bits::setBit(bits_.data(), yOrder[yPosition_++]);
+    }
+  }
+}
+
+bool IEJoinProbe::addMatches() {
+  while (probeIndex_ < probeRows_.size()) {
+    const auto& probeRow = probeRows_[probeIndex_];
+    if (!probeRowStarted_) {
+      if (twoConditions()) {
+        markYMatches(probeRow);
+      }
+      scanPosition_ = probeRow.xBegin;
+      probeRowStarted_ = true;
+    }
+    for (;;) {
+      auto position = scanPosition_;
+      if (twoConditions()) {
+        position = bits::findFirstBit(bits_.data(), position, probeRow.xEnd);
+        if (position < 0) {
+          break;
+        }
+      } else if (position >= probeRow.xEnd) {
+        break;
+      }
+      if (numOutputRows_ == outputBatchSize_) {
+        scanPosition_ = position;
+        return false;
+      }
+      if (probeOutputIndices_ == nullptr) {
+        probeOutputIndices_ = allocateIndices(outputBatchSize_, pool());
+        rawProbeOutputIndices_ =
+            probeOutputIndices_->asMutable<vector_size_t>();
+      }
+      rawProbeOutputIndices_[numOutputRows_++] = probeRow.row;
+      outputBuildSources_.push_back(index_->buildSource(position));
+      outputBuildRows_.push_back(index_->buildRow(position));
+      if (isLeftJoin(joinType_)) {
+        probeMatched_.setValid(probeRow.row, true);
+      }
+      scanPosition_ = position + 1;
+    }
+    ++probeIndex_;
+    probeRowStarted_ = false;
+  }
+  return true;
+}
+
+RowVectorPtr IEJoinProbe::makeOutput() {
+  VELOX_CHECK_GT(numOutputRows_, 0);
+  std::vector<VectorPtr> children(outputType_->size());
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] = wrapChild(
+        numOutputRows_,
+        probeOutputIndices_,
+        input_->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : buildProjections_) {
+    children[projection.outputChannel] = BaseVector::create(
+        outputType_->childAt(projection.outputChannel),
+        numOutputRows_,
+        pool());
+  }
+  auto output = std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numOutputRows_, std::move(children));
+  gatherCopy(
+      output.get(),
+      0,
+      numOutputRows_,
+      outputBuildSources_,
+      outputBuildRows_,
+      buildProjections_);
+
+  // The indices are shared with the output.
+  probeOutputIndices_ = nullptr;
+  rawProbeOutputIndices_ = nullptr;
+  outputBuildSources_.clear();
+  outputBuildRows_.clear();
+  numOutputRows_ = 0;
+  return output;
+}
+
+RowVectorPtr IEJoinProbe::makeMismatchOutput() {
+  probeMatched_.updateBounds();
+  const auto numRows = input_->size() - probeMatched_.countSelected();
+  if (numRows == 0) {
+    return nullptr;
+  }
+  auto indices = allocateIndices(numRows, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numMismatches = 0;
+  for (auto row = 0; row < input_->size(); ++row) {
+    if (!probeMatched_.isValid(row)) {
+      rawIndices[numMismatches++] = row;
+    }
+  }
+
+  std::vector<VectorPtr> children(outputType_->size());
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] = wrapChild(
+        numRows, indices, input_->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : buildProjections_) {
+    children[projection.outputChannel] = BaseVector::createNullConstant(
+        outputType_->childAt(projection.outputChannel), numRows, pool());
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numRows, std::move(children));
+}
+
+RowVectorPtr IEJoinProbe::getOutput() {
+  if (state_ == ProbeOperatorState::kRunning && buildSpilled() &&
+      inputSpiller_->buildReleased()) {
+    reloadBuild();
+  }
+  RowVectorPtr output;
+  while (output == nullptr && state_ == ProbeOperatorState::kRunning &&
+         input_ != nullptr) {
+    if (!inputPrepared_) {
+      prepareInput();
+    }
+    if (!addMatches() || numOutputRows_ > 0) {
+      return makeOutput();
+    }
+    // All the matches of 'input_' have been produced.
+    if (isLeftJoin(joinType_)) {
+      output = makeMismatchOutput();
+    }
+    finishProbeInput();
+  }
+  return output;
+}
+
+void IEJoinProbe::finishProbeInput() {
+  VELOX_CHECK_NOT_NULL(input_);
+  input_.reset();
+  probeRows_.clear();
+  inputPrepared_ = false;
+
+  if (!noMoreInput_) {
+    return;
+  }
+  if (buildSpilled()) {
+    nextSpilledProbeInput();
+    return;
+  }
+  setState(ProbeOperatorState::kFinish);
+}
+
+} // namespace facebook::velox::exec
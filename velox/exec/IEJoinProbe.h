@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/IEJoinIndex.h"
+#include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/NestedLoopJoinProbeSpiller.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/ProbeOperatorState.h"
+
+namespace facebook::velox::exec {
+
+/// Implements an inequality join (core::IEJoinNode) between the probe input
+/// and the build side rows collected by NestedLoopJoinBuild operators. It
+/// supports inner and left joins on one or two inequality conditions, e.g.
+/// 'l.x < r.x AND l.y > r.y', and optional equality keys.
+///
+/// The build rows without nulls in the join columns are sorted on (keys, x)
+/// into an IEJoinIndex, built once by the last build operator and shared by
+/// the probe operators. A group is a range of index rows with the same keys.
+/// For each probe row, the build rows satisfying the x condition are a
+/// contiguous range of its group found by binary search.
+///
+/// With a single condition, all the rows in the x range match. With two
+/// conditions, the IEJoin algorithm is used: the rows of each group are also
+/// sorted on y (permutation array) and the probe rows are processed in an
+/// order in which the build rows satisfying the y condition only grow. These
+/// rows are marked in a bit array over the index positions. The matches of a
+/// probe row are then the marked bits in its x range. The cost is then
+/// proportional to the input size plus the number of matches instead of to
+/// the size of the cross product.
+///
+/// The output follows the order of the probe rows for a single condition. For
+/// two conditions, the probe rows of each input batch are reordered. The
+/// unmatched probe rows of a left join are produced after the matches of each
+/// input batch.
+///
+/// For inner joins, the build operators may spill their input under memory
+/// pressure, see NestedLoopJoinProbe. The probe input is then spilled and
+/// joined with each piece of the spilled build side after the in-memory build
+/// rows, see NestedLoopJoinProbeSpiller. Each probe operator builds its own
+/// index over each piece. Under memory pressure, the piece and its index are
+/// released and built again before the next output.
+class IEJoinProbe : public Operator {
+ public:
+  IEJoinProbe(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::IEJoinNode>& joinNode);
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  bool needsInput() const override {
+    return state_ == ProbeOperatorState::kRunning && input_ == nullptr &&
+        !noMoreInput_;
+  }
+
+  void noMoreInput() override;
+
+  BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override {
+    return state_ == ProbeOperatorState::kFinish;
+  }
+
+  void close() override;
+
+  /// Only the piece of the spilled build side being joined and its index are
+  /// reclaimable.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  /// Releases the piece of the spilled build side being joined and its
+  /// index. They are read and built again by the next getOutput().
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
+ private:
+  // A probe row with its range of matching index rows.
+  struct ProbeRow {
+    vector_size_t row;
+    // Index of the group of build rows with the same keys.
+    int32_t group;
+    // Range of index rows satisfying the first condition.
+    vector_size_t xBegin;
+    vector_size_t xEnd;
+    // Position in 'yOrder_' of the first row satisfying the second condition
+    // if 'ySuffix_', otherwise of the first row after the ones satisfying it.
+    vector_size_t yBound;
+  };
+
+  bool twoConditions() const {
+    return conditionOps_.size() == 2;
+  }
+
+  // Gets the index over the in-memory build vectors and the spill files of
+  // the spilled build chunks into 'spilledBuildChunks' from the nested loop
+  // join bridge. Returns false if the data is not ready yet.
+  bool getBuildData(
+      ContinueFuture* future,
+      std::vector<SpillFiles>& spilledBuildChunks);
+
+  // Returns true if some build vectors have been spilled. The probe input is
+  // then spilled too, to be joined with the spilled build chunks later.
+  bool buildSpilled() const {
+    return inputSpiller_ != nullptr;
+  }
+
+  void setupInputSpiller(std::vector<SpillFiles> spilledBuildChunks);
+
+  // Loads the next batch of the spilled probe input into 'input_'. Loads the
+  // next piece of the spilled build side and builds its index when the
+  // spilled probe input has been joined with the current one. Sets the state
+  // to kFinish after the last piece.
+  void nextSpilledProbeInput();
+
+  // Sets the index to join the probe input with.
+  void setIndex(std::shared_ptr<const IEJoinIndex> index);
+
+  // Reads the piece of the spilled build side released by reclaim() again and
+  // rebuilds its index.
+  void reloadBuild();
+
+  // Finds the groups and match ranges of the rows of 'input_' into
+  // 'probeRows_'.
+  void prepareInput();
+
+  // Returns the index of the group with the same keys as 'row' of 'input_'
+  // or -1 if there is none.
+  int32_t findGroup(vector_size_t row) const;
+
+  // Adds the matches of 'probeRows_' to the output. Returns false if the
+  // output is full before all the matches are added.
+  bool addMatches();
+
+  // Marks the rows of 'probeRow's group that satisfy its second condition in
+  // 'bits_'.
+  void markYMatches(const ProbeRow& probeRow);
+
+  // Clears the bits of the group marked in 'bits_', if any.
+  void clearBits();
+
+  // Returns the output rows added since the last call.
+  RowVectorPtr makeOutput();
+
+  // Returns the rows of 'input_' without a match with nulls for the build
+  // side columns, or nullptr if all rows matched.
+  RowVectorPtr makeMismatchOutput();
+
+  // Called after all the output of 'input_' has been produced.
+  void finishProbeInput();
+
+  void setState(ProbeOperatorState state) {
+    state_ = state;
+  }
+
+  // Maximum number of rows in the output batch.
+  const vector_size_t outputBatchSize_;
+
+  const std::shared_ptr<const core::IEJoinNode> joinNode_;
+
+  const core::JoinType joinType_;
+
+  const RowTypePtr probeType_;
+
+  // Channels of the equality keys followed by the columns of the conditions
+  // in the probe input.
+  std::vector<column_index_t> probeChannels_;
+
+  const size_t numKeys_;
+
+  // Comparison of each condition. The probe column is on the left side.
+  std::vector<core::IEJoinNode::Op> conditionOps_;
+
+  // True if the build rows satisfying the second condition form a suffix of
+  // the rows of a group sorted on y, false if they form a prefix.
+  bool ySuffix_{false};
+
+  // Projections from the build input to the output. The projections from the
+  // probe input are in 'identityProjections_'.
+  std::vector<IdentityProjection> buildProjections_;
+
+  ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
+
+  // Build side state.
+
+  // The index over the build rows joined with the probe input.
+  std::shared_ptr<const IEJoinIndex> index_;
+
+  // One bit per row of 'index_'. Marks the rows satisfying the second
+  // condition of the current probe row.
+  std::vector<uint64_t> bits_;
+
+  // Group of the bits set in 'bits_', -1 if none is set.
+  int32_t bitsGroup_{-1};
+
+  // Position in 'yOrder_' of the boundary of the rows marked in 'bits_'.
+  vector_size_t yPosition_{0};
+
+  // Probe side state.
+
+  // True if 'probeRows_' have been set for 'input_'.
+  bool inputPrepared_{false};
+
+  // The rows of 'input_' that have a group.
+  std::vector<ProbeRow> probeRows_;
+
+  // Index into 'probeRows_' of the row being processed.
+  size_t probeIndex_{0};
+
+  // True if the bits of the row at 'probeIndex_' have been marked.
+  bool probeRowStarted_{false};
+
+  // Next index row of the row at 'probeIndex_' to check.
+  vector_size_t scanPosition_{0};
+
+  // The rows of 'input_' with a match. Only used for left joins.
+  SelectivityVector probeMatched_;
+
+  // Output state.
+
+  // Dictionary indices of the probe columns of the output rows.
+  BufferPtr probeOutputIndices_;
+  vector_size_t* rawProbeOutputIndices_{nullptr};
+
+  // The build vector and row of the output rows.
+  std::vector<const RowVector*> outputBuildSources_;
+  std::vector<vector_size_t> outputBuildRows_;
+
+  vector_size_t numOutputRows_{0};
+
+  // Spilling state.
+
+  // Spills the probe input and reads the spilled build side if the build
+  // side has spilled.
+  std::unique_ptr<NestedLoopJoinProbeSpiller> inputSpiller_;
+};
+
+} // namespace facebook::velox::exec
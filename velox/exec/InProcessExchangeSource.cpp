@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <folly/futures/Future.h>
+
+#include "velox/exec/ExchangeClient.h"
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool)
+    : ExchangeSource(taskId, destination, std::move(queue), pool),
+      producerTaskId_(
+          taskId.compare(0, kScheme.size(), kScheme) == 0
+              ? taskId.substr(kScheme.size())
+              : taskId) {}
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (taskId.compare(0, kScheme.size(), kScheme) != 0) {
+    auto buffers = OutputBufferManager::getInstance().lock();
+    if (buffers == nullptr || buffers->getBufferIfExists(taskId) == nullptr) {
+      return nullptr;
+    }
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  ++numRequests_;
+  VELOX_CHECK(requestPending_);
+
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  std::shared_ptr<PendingRequest> pending;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise_ = std::move(promise);
+    pending = std::make_shared<PendingRequest>(sequence_);
+  }
+
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "invalid OutputBufferManager");
+
+  // The producer task may not have created its buffer yet or may be gone. The
+  // request then completes empty after 'maxWait' and is retried.
+  auto self = shared_from_this();
+  buffers->getData(
+      producerTaskId_,
+      destination_,
+      maxBytes,
+      pending->sequence,
+      [self, this, pending](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        processData(
+            pending, std::move(data), sequence, std::move(remainingBytes));
+      });
+
+  // Does not keep 'this' alive, a source closed before the timeout has no
+  // request to complete.
+  std::weak_ptr<ExchangeSource> weakSelf = self;
+  folly::futures::sleep(
+      std::chrono::duration_cast<std::chrono::milliseconds>(maxWait))
+      .toUnsafeFuture()
+      .thenValue([weakSelf, this, pending](auto&& /* unused */) {
+        auto self = weakSelf.lock();
+        if (self == nullptr) {
+          return;
+        }
+        processData(pending, {}, 0, {});
+      });
+  return future;
+}
+
+void InProcessExchangeSource::processData(
+    const std::shared_ptr<PendingRequest>& pending,
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  // Only the first of the data callback and the timeout has an effect. Data
+  // delivered after a timeout is not acknowledged and is fetched again by the
+  // next request.
+  if (pending->completed.exchange(true)) {
+    return;
+  }
+  if (data.empty()) {
+    sequence = pending->sequence;
+  } else if (pending->sequence > sequence) {
+    // Pages before the requested sequence have been received already.
+    const int64_t numExtra = pending->sequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+    sequence = pending->sequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  pages.reserve(data.size());
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  for (auto& iobuf : data) {
+    if (iobuf == nullptr) {
+      atEnd = true;
+      // There could be more than one end marker.
+      continue;
+    }
+    totalBytes += iobuf->computeChainDataLength();
+    // No copy, the page shares the producer's buffers.
+    pages.push_back(std::make_unique<SerializedPage>(std::move(iobuf)));
+  }
+  numPages_ += pages.size();
+  totalBytes_ += totalBytes;
+
+  VeloxPromise<Response> requestPromise;
+  std::vector<ContinuePromise> queuePromises;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    requestPromise = std::move(promise_);
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    if (atEnd) {
+      queue_->enqueueLocked(nullptr, queuePromises);
+      atEnd_ = true;
+    }
+    if (!data.empty()) {
+      sequence_ = sequence + pages.size();
+    }
+  }
+  for (auto& promise : queuePromises) {
+    promise.setValue();
+  }
+
+  if (atEnd) {
+    if (auto buffers = OutputBufferManager::getInstance().lock()) {
+      buffers->deleteResults(producerTaskId_, destination_);
+    }
+  }
+
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(
+        Response{totalBytes, atEnd, std::move(remainingBytes)});
+  }
+}
+
+void InProcessExchangeSource::pause() {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "invalid OutputBufferManager");
+  int64_t ackSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    ackSequence = sequence_;
+  }
+  buffers->acknowledge(producerTaskId_, destination_, ackSequence);
+}
+
+void InProcessExchangeSource::close() {
+  setEmptyResponse();
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(producerTaskId_, destination_);
+  }
+}
+
+void InProcessExchangeSource::setEmptyResponse() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+      {"inProcessExchangeSource.numRequests", RuntimeMetric(numRequests_)},
+      // Pages are handed over on the producer's or the consumer's thread.
+      {ExchangeClient::kBackgroundCpuTimeMs,
+       RuntimeMetric(0, RuntimeCounter::Unit::kNanos)},
+  };
+}
+
+} // namespace facebook::velox::exec
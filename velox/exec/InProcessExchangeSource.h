@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource that reads from an OutputBuffer of a task running in the
+/// same process through the OutputBufferManager singleton. This skips the
+/// network round trip for co-located producer and consumer tasks.
+///
+/// The pages are handed over without copying: the consumer gets clones of the
+/// producer's IOBufs, whose memory stays accounted to the producer's pool and
+/// keeps the producer task alive until the consumer releases the page. Flow
+/// control works as for remote sources. Each request implicitly acknowledges
+/// the pages received by the previous one, and pause() acknowledges early.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  /// Prefix of the remote task ids that are always read in-process.
+  static constexpr std::string_view kScheme{"inprocess://"};
+
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// ExchangeSource::Factory. Returns a source if 'taskId' starts with
+  /// 'kScheme' or if a task with this id has an output buffer in this process.
+  /// Returns nullptr otherwise so that the next factory is consulted. Register
+  /// before the factories of remote sources to bypass them for local tasks.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void pause() override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // State of one request, shared by the data callback and the timeout.
+  struct PendingRequest {
+    explicit PendingRequest(int64_t _sequence) : sequence(_sequence) {}
+
+    // The sequence number requested.
+    const int64_t sequence;
+    // Set by the first of the data callback and the timeout.
+    std::atomic_bool completed{false};
+  };
+
+  // Enqueues 'data' and fulfills the request. Called with empty 'data' on
+  // timeout.
+  void processData(
+      const std::shared_ptr<PendingRequest>& pending,
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Fulfills the pending request, if any, with an empty response.
+  void setEmptyResponse();
+
+  // 'taskId_' without 'kScheme'. The OutputBufferManager knows the producer
+  // by this id.
+  const std::string producerTaskId_;
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+  std::atomic<int64_t> numRequests_{0};
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+};
+
+} // namespace facebook::velox::exec
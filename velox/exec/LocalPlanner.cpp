@@ -16,6 +16,7 @@
 #include "velox/exec/LocalPlanner.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/exec/ArrowStream.h"
+#include "velox/exec/AsOfJoin.h"
 #include "velox/exec/AssignUniqueId.h"
 #include "velox/exec/CallbackSink.h"
 #include "velox/exec/EnforceSingleRow.h"
@@ -26,6 +27,7 @@
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashProbe.h"
+#include "velox/exec/IEJoinProbe.h"
 #include "velox/exec/Limit.h"
 #include "velox/exec/MarkDistinct.h"
 #include "velox/exec/Merge.h"
@@ -50,6 +52,14 @@ namespace facebook::velox::exec {
 
 namespace detail {
 
+/// Returns true if 'planNode' is a join whose build side is handed over to
+/// the probe side through a NestedLoopJoinBridge.
+bool usesNestedLoopJoinBridge(const core::PlanNodePtr& planNode) {
+  return std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(
+             planNode) != nullptr ||
+      std::dynamic_pointer_cast<const core::IEJoinNode>(planNode) != nullptr;
+}
+
 /// Returns true if source nodes must run in a separate pipeline.
 bool mustStartNewPipeline(
     const std::shared_ptr<const core::PlanNode>& planNode,
@@ -110,15 +120,14 @@ OperatorSupplier makeConsumerSupplier(
     };
   }
 
-  if (auto join =
-          std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(planNode)) {
-    return [join](int32_t operatorId, DriverCtx* ctx) {
-      return std::make_unique<NestedLoopJoinBuild>(operatorId, ctx, join);
+  if (usesNestedLoopJoinBridge(planNode)) {
+    return [planNode](int32_t operatorId, DriverCtx* ctx) {
+      return std::make_unique<NestedLoopJoinBuild>(operatorId, ctx, planNode);
     };
   }
 
-  if (auto join =
-          std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
+  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode) ||
+      std::dynamic_pointer_cast<const core::AsOfJoinNode>(planNode)) {
     auto planNodeId = planNode->id();
     return [planNodeId](int32_t operatorId, DriverCtx* ctx) {
       auto source =
@@ -166,8 +175,9 @@ void plan(
 // Sometimes consumer limits the number of drivers its producer can run.
 uint32_t maxDriversForConsumer(
     const std::shared_ptr<const core::PlanNode>& node) {
-  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
-    // MergeJoinNode must run single-threaded.
+  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node) ||
+      std::dynamic_pointer_cast<const core::AsOfJoinNode>(node)) {
+    // MergeJoinNode and AsOfJoinNode must run single-threaded.
     return 1;
   }
   return std::numeric_limits<uint32_t>::max();
@@ -224,6 +234,9 @@ uint32_t maxDrivers(
     } else if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
       // Merge join must run single-threaded.
       return 1;
+    } else if (std::dynamic_pointer_cast<const core::AsOfJoinNode>(node)) {
+      // AS OF join must run single-threaded.
+      return 1;
     } else if (
         auto join = std::dynamic_pointer_cast<const core::HashJoinNode>(node)) {
       // Right semi project doesn't support multi-threaded execution.
@@ -368,10 +381,7 @@ void LocalPlanner::markMixedJoinBridges(
             break;
           }
         }
-      } else if (
-          auto joinNode =
-              std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(
-                  planNode)) {
+      } else if (detail::usesNestedLoopJoinBridge(planNode)) {
         // See if the build source (2nd) belongs to an ungrouped execution.
         auto& buildSourceNode = planNode->sources()[1];
         for (auto& factoryOther : driverFactories) {
@@ -493,6 +503,11 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
                 planNode)) {
       operators.push_back(
           std::make_unique<NestedLoopJoinProbe>(id, ctx.get(), joinNode));
+    } else if (
+        auto joinNode =
+            std::dynamic_pointer_cast<const core::IEJoinNode>(planNode)) {
+      operators.push_back(
+          std::make_unique<IEJoinProbe>(id, ctx.get(), joinNode));
     } else if (
         auto aggregationNode =
             std::dynamic_pointer_cast<const core::AggregationNode>(planNode)) {
@@ -557,6 +572,11 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
       auto mergeJoinOp = std::make_unique<MergeJoin>(id, ctx.get(), mergeJoin);
       ctx->task->createMergeJoinSource(ctx->splitGroupId, mergeJoin->id());
       operators.push_back(std::move(mergeJoinOp));
+    } else if (
+        auto asOfJoin =
+            std::dynamic_pointer_cast<const core::AsOfJoinNode>(planNode)) {
+      ctx->task->createMergeJoinSource(ctx->splitGroupId, asOfJoin->id());
+      operators.push_back(std::make_unique<AsOfJoin>(id, ctx.get(), asOfJoin));
     } else if (
         auto localPartitionNode =
             std::dynamic_pointer_cast<const core::LocalPartitionNode>(
@@ -682,13 +702,11 @@ std::vector<core::PlanNodeId> DriverFactory::needsNestedLoopJoinBridges()
         mixedExecutionModeNestedLoopJoinNodeIds.end());
   }
   for (const auto& planNode : planNodes) {
-    if (auto joinNode =
-            std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(
-                planNode)) {
+    if (detail::usesNestedLoopJoinBridge(planNode)) {
       // Grouped execution pipelines should not create cross-mode bridges.
       if (!groupedExecution ||
-          !mixedExecutionModeNestedLoopJoinNodeIds.contains(joinNode->id())) {
-        planNodeIds.emplace_back(joinNode->id());
+          !mixedExecutionModeNestedLoopJoinNodeIds.contains(planNode->id())) {
+        planNodeIds.emplace_back(planNode->id());
       }
     }
   }
@@ -13,14 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/vector/FlatVector.h"
 
-#include <algorithm>
-#include <utility>
-
 namespace facebook::velox::exec {
 
 MarkDistinct::MarkDistinct(
@@ -32,35 +29,110 @@ MarkDistinct::MarkDistinct(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
-
+          "MarkDistinct",
+          planNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_(planNode->sources()[0]->outputType()) {
   // Set all input columns as identity projection.
-  for (auto i = 0; i < inputType->size(); ++i) {
+  for (auto i = 0; i < inputType_->size(); ++i) {
     identityProjections_.emplace_back(i, i);
   }
 
   // We will use result[0] for distinct mask output.
-  resultProjections_.emplace_back(0, inputType->size());
+  resultProjections_.emplace_back(0, inputType_->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  table_ = HashTable<false>::createForAggregation(
+      createVectorHashers(inputType_, planNode->distinctKeys()),
+      std::vector<Accumulator>{},
+      pool());
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
 
   results_.resize(1);
+
+  if (spillEnabled()) {
+    spiller_ = std::make_unique<HashTableInputSpiller>(
+        Spiller::Type::kMarkDistinct,
+        inputType_,
+        table_.get(),
+        lookup_.get(),
+        &spillConfig_.value(),
+        &spillStats_,
+        pool());
+  }
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  if (spiller_ != nullptr) {
+    spiller_->ensureInputFits(this, input);
+    if (spiller_->spillingInput()) {
+      spiller_->spillInput(input, pool());
+      return;
+    }
+  }
+
+  SelectivityVector rows(input->size());
+  table_->prepareForGroupProbe(
+      *lookup_, input, rows, BaseHashTable::kNoSpillInputStartPartitionBit);
+  table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
 
   input_ = std::move(input);
 }
 
+void MarkDistinct::addSpillInput() {
+  VELOX_CHECK_NOT_NULL(input_);
+  spiller_->ensureInputFits(this, input_);
+  if (respillingInput()) {
+    // Memory arbitration triggered by ensureInputFits() has spilled the
+    // partition being restored. Spill 'input_' to its sub-partitions.
+    spiller_->spillInput(input_, pool());
+    input_ = nullptr;
+    return;
+  }
+
+  SelectivityVector rows(input_->size());
+  table_->prepareForGroupProbe(
+      *lookup_, input_, rows, spillConfig_->startPartitionBit);
+  table_->groupProbe(*lookup_, spillConfig_->startPartitionBit);
+}
+
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+
+  if (spiller_ != nullptr && spiller_->spillingInput()) {
+    spiller_->finishInputSpill();
+    restoreNextSpillPartition();
+  }
+}
+
+void MarkDistinct::restoreNextSpillPartition() {
+  // The keys in the hash table of the partition have been seen before the
+  // spill and are not distinct in the spilled input.
+  if (!spiller_->restoreNextPartition()) {
+    return;
+  }
+
+  // NOTE: the spilled input of a partition has at least one batch.
+  const bool hasInput = spiller_->nextInput(input_);
+  VELOX_CHECK(hasInput);
+  addSpillInput();
+}
+
 RowVectorPtr MarkDistinct::getOutput() {
-  if (isFinished() || !input_) {
-    return nullptr;
+  if (input_ == nullptr) {
+    if (spiller_ == nullptr || !spiller_->restoringInput()) {
+      return nullptr;
+    }
+
+    recursiveSpillInput();
+    if (yield_) {
+      yield_ = false;
+      return nullptr;
+    }
+
+    if (input_ == nullptr) {
+      return nullptr;
+    }
   }
 
   auto outputSize = input_->size();
@@ -79,7 +151,7 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  for (const auto i : lookup_->newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
@@ -88,10 +160,58 @@ RowVectorPtr MarkDistinct::getOutput() {
   // allow for memory reuse.
   input_ = nullptr;
 
+  // If the partition being restored has been spilled again, the rest of its
+  // input is spilled to the sub-partitions by the next getOutput().
+  if (spiller_ != nullptr && spiller_->restoringInput() &&
+      !respillingInput()) {
+    if (spiller_->nextInput(input_)) {
+      addSpillInput();
+    } else {
+      table_->clear();
+      restoreNextSpillPartition();
+    }
+  }
+
   return output;
 }
 
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && input_ == nullptr &&
+      (spiller_ == nullptr || !spiller_->restoringInput());
+}
+
+void MarkDistinct::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (table_->numDistinct() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  if (spiller_->exceededMaxSpillLevelLimit()) {
+    LOG(WARNING) << "Exceeded mark distinct spill level limit: "
+                 << spillConfig_->maxSpillLevel
+                 << ", and abandon spilling for memory pool: "
+                 << pool()->name();
+    ++spillStats_.wlock()->spillMaxLevelExceededCount;
+    return;
+  }
+
+  // NOTE: an input that has already been added to the hash table is not
+  // spilled. Its distinct rows are known from 'lookup_' and it is output as
+  // usual.
+  spiller_->spill();
 }
+
+void MarkDistinct::recursiveSpillInput() {
+  if (!spiller_->respillInput(operatorCtx_->driver())) {
+    yield_ = true;
+    return;
+  }
+  restoreNextSpillPartition();
+}
+
 } // namespace facebook::velox::exec
@@ -13,14 +13,24 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableInputSpiller.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// Appends a boolean column that is true for the first row of each distinct
+/// combination of the distinct keys. The keys seen so far are kept in a hash
+/// table.
+///
+/// Under memory pressure, the hash table is spilled by hash partition and the
+/// input received afterwards is spilled to the same partitions. After all the
+/// input has been received, the partitions are processed one at a time: the
+/// spilled keys are loaded back into the hash table as seen and then the
+/// spilled input is marked against them. The output then doesn't follow the
+/// input order.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -29,7 +39,7 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -38,6 +48,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +58,45 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Returns true if the input being restored from a spilled partition is
+  // spilled again to a number of sub-partitions.
+  bool respillingInput() const {
+    return spiller_ != nullptr && spiller_->restoringInput() &&
+        spiller_->spillingInput();
+  }
+
+  // Adds the keys of 'input_' read from a spilled partition to the hash table.
+  void addSpillInput();
+
+  void restoreNextSpillPartition();
+
+  // Used by recursive spill processing to spill the rest of the input of the
+  // partition being restored to its sub-partitions. After that, restores one
+  // of the newly spilled partitions.
+  void recursiveSpillInput();
+
+  const RowTypePtr inputType_;
+
+  // Hash table of the distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+
+  // The lookup of the current input. 'newGroups' has the distinct rows.
+  std::unique_ptr<HashLookup> lookup_;
+
+  // Spills 'table_' and the input received afterwards. Set if spilling is
+  // enabled.
+  std::unique_ptr<HashTableInputSpiller> spiller_;
+
+  // The cpu may be voluntarily yield after running too long when processing
+  // input from spilled file.
+  bool yield_{false};
 };
 } // namespace facebook::velox::exec
@@ -14,16 +14,22 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
-void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+void NestedLoopJoinBridge::setData(
+    std::vector<RowVectorPtr> buildVectors,
+    std::vector<SpillFiles> spilledChunks,
+    std::shared_ptr<const IEJoinIndex> ieJoinIndex) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
     buildVectors_ = std::move(buildVectors);
+    spilledChunks_ = std::move(spilledChunks);
+    ieJoinIndex_ = std::move(ieJoinIndex);
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -41,25 +47,100 @@ std::optional<std::vector<RowVectorPtr>> NestedLoopJoinBridge::dataOrFuture(
   return std::nullopt;
 }
 
+std::vector<SpillFiles> NestedLoopJoinBridge::spilledChunks() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(buildVectors_.has_value());
+  return spilledChunks_;
+}
+
+std::shared_ptr<const IEJoinIndex> NestedLoopJoinBridge::ieJoinIndex() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(buildVectors_.has_value());
+  return ieJoinIndex_;
+}
+
 NestedLoopJoinBuild::NestedLoopJoinBuild(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    std::shared_ptr<const core::NestedLoopJoinNode> joinNode)
+    std::shared_ptr<const core::PlanNode> joinNode)
     : Operator(
           driverCtx,
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          fmt::format("{}Build", joinNode->name()),
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      buildType_(joinNode->sources()[1]->outputType()),
+      ieJoinNode_(
+          std::dynamic_pointer_cast<const core::IEJoinNode>(joinNode)) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
-  if (input->size() > 0) {
-    // Load lazy vectors before storing.
-    for (auto& child : input->children()) {
-      child->loadedVector();
+  if (input->size() == 0) {
+    return;
+  }
+  // Load lazy vectors before storing.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  if (spillEnabled()) {
+    // Test-only spill path.
+    if (!dataVectors_.empty() && testingTriggerSpill(pool()->name())) {
+      Operator::ReclaimableSectionGuard guard(this);
+      memory::testingRunArbitration(pool());
     }
-    dataVectors_.emplace_back(std::move(input));
+    dataBytes_ += input->retainedSize();
+  }
+  dataVectors_.emplace_back(std::move(input));
+}
+
+bool NestedLoopJoinBuild::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  const bool reclaimable = canReclaim();
+  reclaimableBytes = reclaimable ? pool()->reservedBytes() + dataBytes_ : 0;
+  return reclaimable;
+}
+
+void NestedLoopJoinBuild::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  // NOTE: the build vectors are handed over to the last build operator when
+  // all the build operators have finished, after which there is nothing left
+  // to spill.
+  if (dataVectors_.empty()) {
+    return;
+  }
+  spill();
+}
+
+void NestedLoopJoinBuild::spill() {
+  VELOX_CHECK(spillEnabled());
+  const auto& spillConfig = spillConfig_.value();
+
+  // The build side is not partitioned. All the build vectors go to the single
+  // partition of the spiller.
+  Spiller spiller(
+      Spiller::Type::kNestedLoopJoinBuild,
+      buildType_,
+      HashBitRange{},
+      &spillConfig,
+      &spillStats_);
+  spiller.setPartitionsSpilled({0});
+  for (const auto& vector : dataVectors_) {
+    spiller.spill(0, vector);
   }
+
+  SpillPartitionSet spillPartitionSet;
+  spiller.finishSpill(spillPartitionSet);
+  VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+  spilledChunks_.push_back(spillPartitionSet.begin()->second->files());
+
+  dataVectors_.clear();
+  dataBytes_ = 0;
+  pool()->release();
 }
 
 BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
@@ -100,15 +181,33 @@ void NestedLoopJoinBuild::noMoreInput() {
       VELOX_CHECK_NOT_NULL(build);
       dataVectors_.insert(
           dataVectors_.begin(),
-          build->dataVectors_.begin(),
-          build->dataVectors_.end());
+          std::make_move_iterator(build->dataVectors_.begin()),
+          std::make_move_iterator(build->dataVectors_.end()));
+      build->dataVectors_.clear();
+      build->dataBytes_ = 0;
+      spilledChunks_.insert(
+          spilledChunks_.end(),
+          std::make_move_iterator(build->spilledChunks_.begin()),
+          std::make_move_iterator(build->spilledChunks_.end()));
+      build->spilledChunks_.clear();
     }
   }
 
+  // The index is built once here instead of by each probe operator.
+  std::shared_ptr<const IEJoinIndex> ieJoinIndex;
+  if (ieJoinNode_ != nullptr) {
+    ieJoinIndex =
+        std::make_shared<IEJoinIndex>(dataVectors_, *ieJoinNode_, pool());
+  }
+
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(
+          std::move(dataVectors_),
+          std::move(spilledChunks_),
+          std::move(ieJoinIndex));
+  dataBytes_ = 0;
 }
 
 bool NestedLoopJoinBuild::isFinished() {
@@ -15,27 +15,53 @@
  */
 #pragma once
 
+#include "velox/exec/IEJoinIndex.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
 class NestedLoopJoinBridge : public JoinBridge {
  public:
-  void setData(std::vector<RowVectorPtr> buildVectors);
+  /// Sets the build side data. 'buildVectors' are the build vectors kept in
+  /// memory and 'spilledChunks' are the build vectors spilled under memory
+  /// pressure, one set of spill files per spill run. 'ieJoinIndex' is the
+  /// index over 'buildVectors' for a core::IEJoinNode, nullptr otherwise.
+  void setData(
+      std::vector<RowVectorPtr> buildVectors,
+      std::vector<SpillFiles> spilledChunks = {},
+      std::shared_ptr<const IEJoinIndex> ieJoinIndex = nullptr);
 
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the spilled build chunks. Can only be called after the data has
+  /// been set. The spill files are not consumed, so every probe operator can
+  /// read all the chunks.
+  std::vector<SpillFiles> spilledChunks();
+
+  /// Returns the index over the in-memory build vectors shared by the probe
+  /// operators of a core::IEJoinNode. Can only be called after the data has
+  /// been set.
+  std::shared_ptr<const IEJoinIndex> ieJoinIndex();
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  std::vector<SpillFiles> spilledChunks_;
+  std::shared_ptr<const IEJoinIndex> ieJoinIndex_;
 };
 
+/// Collects the build side input of a core::NestedLoopJoinNode or a
+/// core::IEJoinNode and hands it over to the probe side through a
+/// NestedLoopJoinBridge.
 class NestedLoopJoinBuild : public Operator {
  public:
+  /// 'joinNode' is either a core::NestedLoopJoinNode or a core::IEJoinNode.
+  /// The operator type is the name of the join node followed by 'Build'.
   NestedLoopJoinBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      std::shared_ptr<const core::NestedLoopJoinNode> joinNode);
+      std::shared_ptr<const core::PlanNode> joinNode);
 
   void addInput(RowVectorPtr input) override;
 
@@ -55,12 +81,43 @@ class NestedLoopJoinBuild : public Operator {
 
   void close() override {
     dataVectors_.clear();
+    dataBytes_ = 0;
     Operator::close();
   }
 
+  /// The build vectors are not copied into the memory pool of this operator.
+  /// The memory they hold counts as reclaimable as it is released by spilling
+  /// them.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  /// Spills all the build vectors buffered by this operator to disk as one
+  /// chunk. The probe side joins each spilled chunk with its whole input after
+  /// the in-memory build vectors.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  void spill();
+
+  const RowTypePtr buildType_;
+
+  // Set if the build side is for a core::IEJoinNode. The last build operator
+  // then builds the index over the build vectors for the probe operators.
+  const std::shared_ptr<const core::IEJoinNode> ieJoinNode_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
+  // Retained size of 'dataVectors_'. Only tracked if spilling is enabled.
+  uint64_t dataBytes_{0};
+
+  // Spill files of the build vectors spilled by this operator, one entry per
+  // spill run.
+  std::vector<SpillFiles> spilledChunks_;
+
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
   ContinueFuture future_{ContinueFuture::makeEmpty()};
@@ -54,13 +54,16 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinProbe"),
+          "NestedLoopJoinProbe",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinNode_(joinNode),
-      joinType_(joinNode_->joinType()) {
-  auto probeType = joinNode_->sources()[0]->outputType();
+      joinType_(joinNode_->joinType()),
+      probeType_(joinNode_->sources()[0]->outputType()) {
   auto buildType = joinNode_->sources()[1]->outputType();
-  identityProjections_ = extractProjections(probeType, outputType_);
+  identityProjections_ = extractProjections(probeType_, outputType_);
   buildProjections_ = extractProjections(buildType, outputType_);
 }
 
@@ -137,11 +140,16 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
       return BlockingReason::kNotBlocked;
     case ProbeOperatorState::kWaitForBuild: {
       VELOX_CHECK(!buildVectors_.has_value());
-      if (!getBuildData(future)) {
+      std::vector<SpillFiles> spilledBuildChunks;
+      if (!getBuildData(future, spilledBuildChunks)) {
         return BlockingReason::kWaitForJoinBuild;
       }
       VELOX_CHECK(buildVectors_.has_value());
 
+      if (!spilledBuildChunks.empty()) {
+        setupInputSpiller(std::move(spilledBuildChunks));
+      }
+
       // If we just got build data, check if this is a right or full join where
       // we need to hit track of hits on build records. If it is, initialize the
       // selectivity vectors that do so.
@@ -165,6 +173,7 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  inputSpiller_.reset();
   Operator::close();
 }
 
@@ -175,11 +184,22 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   for (auto& child : input->children()) {
     child->loadedVector();
   }
-  input_ = std::move(input);
-  if (input_->size() > 0) {
+  if (input->size() > 0) {
     probeSideEmpty_ = false;
   }
   VELOX_CHECK_EQ(buildIndex_, 0);
+
+  if (buildSpilled()) {
+    if (input->size() == 0) {
+      return;
+    }
+    // Keep the input for joining with the spilled build chunks.
+    inputSpiller_->spillInput(input);
+    if (isBuildSideEmpty()) {
+      return;
+    }
+  }
+  input_ = std::move(input);
 }
 
 void NestedLoopJoinProbe::noMoreInput() {
@@ -187,6 +207,10 @@ void NestedLoopJoinProbe::noMoreInput() {
   if (state_ != ProbeOperatorState::kRunning || input_ != nullptr) {
     return;
   }
+  if (buildSpilled()) {
+    nextSpilledProbeInput();
+    return;
+  }
   if (!needsBuildMismatch(joinType_)) {
     setState(ProbeOperatorState::kFinish);
     return;
@@ -194,27 +218,85 @@ void NestedLoopJoinProbe::noMoreInput() {
   beginBuildMismatch();
 }
 
-bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
+bool NestedLoopJoinProbe::getBuildData(
+    ContinueFuture* future,
+    std::vector<SpillFiles>& spilledBuildChunks) {
   VELOX_CHECK(!buildVectors_.has_value());
 
-  auto buildData =
-      operatorCtx_->task()
-          ->getNestedLoopJoinBridge(
-              operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-          ->dataOrFuture(future);
+  auto bridge = operatorCtx_->task()->getNestedLoopJoinBridge(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  auto buildData = bridge->dataOrFuture(future);
   if (!buildData.has_value()) {
     return false;
   }
 
   buildVectors_ = std::move(buildData);
+  spilledBuildChunks = bridge->spilledChunks();
   return true;
 }
 
+void NestedLoopJoinProbe::setupInputSpiller(
+    std::vector<SpillFiles> spilledBuildChunks) {
+  VELOX_CHECK(spillConfig_.has_value());
+  VELOX_CHECK(!needsProbeMismatch(joinType_) && !needsBuildMismatch(joinType_));
+  VELOX_CHECK_NULL(inputSpiller_);
+
+  inputSpiller_ = std::make_unique<NestedLoopJoinProbeSpiller>(
+      probeType_,
+      std::move(spilledBuildChunks),
+      &spillConfig_.value(),
+      &spillStats_,
+      pool());
+}
+
+void NestedLoopJoinProbe::nextSpilledProbeInput() {
+  VELOX_CHECK(buildSpilled());
+  VELOX_CHECK_NULL(input_);
+  while (!inputSpiller_->nextInput(input_)) {
+    if (!inputSpiller_->nextBuild(buildVectors_.value())) {
+      setState(ProbeOperatorState::kFinish);
+      return;
+    }
+  }
+}
+
+bool NestedLoopJoinProbe::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  const bool reclaimable = canReclaim();
+  reclaimableBytes = reclaimable && buildSpilled() &&
+          inputSpiller_->buildLoaded()
+      ? pool()->reservedBytes()
+      : 0;
+  return reclaimable;
+}
+
+void NestedLoopJoinProbe::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  // NOTE: only the spilled build vectors read by this operator can be
+  // released. The in-memory build vectors are shared by all the probe
+  // operators through the bridge.
+  if (!buildSpilled() || !inputSpiller_->buildLoaded()) {
+    return;
+  }
+  // The join state only refers to the build vectors by position, and no
+  // output is pending between calls, so the piece can be read again in the
+  // next getOutput().
+  buildVectors_->clear();
+  inputSpiller_->releaseBuild();
+  pool()->release();
+}
+
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
   if (state_ == ProbeOperatorState::kFinish ||
       state_ == ProbeOperatorState::kWaitForPeers) {
     return nullptr;
   }
+  if (buildSpilled() && inputSpiller_->buildReleased()) {
+    inputSpiller_->reloadBuild(buildVectors_.value());
+  }
   RowVectorPtr output{nullptr};
   while (output == nullptr) {
     // If we are done processing all build and probe data, and this is the
@@ -600,6 +682,11 @@ void NestedLoopJoinProbe::finishProbeInput() {
     return;
   }
 
+  if (buildSpilled()) {
+    nextSpilledProbeInput();
+    return;
+  }
+
   // From now one we finished processing the probe side. Check now if this is a
   // right or full outer join, and hence we may need to start emitting buid
   // mismatch records.
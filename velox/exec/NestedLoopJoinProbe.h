@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/NestedLoopJoinProbeSpiller.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
 
@@ -65,6 +66,14 @@ namespace facebook::velox::exec {
 /// to be copied, then performs the copies in batch, column-by-column. It
 /// produces at most `outputBatchSize_` records, but it may produce fewer since
 /// the output needs to follow the probe vector boundaries.
+///
+/// For inner and cross joins, the build operators may spill their vectors
+/// under memory pressure, in one chunk per spill run. The probe operator then
+/// joins its input with the build vectors kept in memory while spilling the
+/// input to disk. After the probe input is done, it reads the spilled build
+/// chunks in pieces that fit in its memory pool and joins each with the
+/// spilled probe input, see NestedLoopJoinProbeSpiller. The output then
+/// doesn't follow the order of the probe side rows.
 class NestedLoopJoinProbe : public Operator {
  public:
   NestedLoopJoinProbe(
@@ -93,6 +102,14 @@ class NestedLoopJoinProbe : public Operator {
 
   void close() override;
 
+  /// Only the piece of the spilled build side being joined is reclaimable.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  /// Releases the piece of the spilled build side being joined. It is read
+  /// again from disk by the next getOutput().
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
   // TODO: maybe consolidate initializeFilter routine across operators like
   // HashProbe and MergeJoin.
@@ -101,11 +118,29 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
-  // Materializes build data from nested loop join bridge into `buildVectors_`.
-  // Returns whether the data has been materialized and is ready for use. Nested
-  // loop join requires all build data to be materialized and available in
-  // `buildVectors_` before it can produce output.
-  bool getBuildData(ContinueFuture* future);
+  // Materializes build data from nested loop join bridge into `buildVectors_`
+  // and the spill files of the spilled build chunks into
+  // 'spilledBuildChunks'. Returns whether the data has been materialized and
+  // is ready for use. Nested loop join requires all build data to be
+  // materialized and available in `buildVectors_` before it can produce
+  // output.
+  bool getBuildData(
+      ContinueFuture* future,
+      std::vector<SpillFiles>& spilledBuildChunks);
+
+  // Returns true if some build vectors have been spilled. The probe input is
+  // then spilled too, to be joined with the spilled build chunks later.
+  bool buildSpilled() const {
+    return inputSpiller_ != nullptr;
+  }
+
+  void setupInputSpiller(std::vector<SpillFiles> spilledBuildChunks);
+
+  // Loads the next batch of the spilled probe input into 'input_'. Loads the
+  // next piece of the spilled build side into 'buildVectors_' when the spilled
+  // probe input has been joined with the current one. Sets the state to
+  // kFinish after the last piece.
+  void nextSpilledProbeInput();
 
   // Generates output from join matches between probe and build sides, as well
   // as probe mismatches (for left and full outer joins). As much as possible,
@@ -365,6 +400,14 @@ class NestedLoopJoinProbe : public Operator {
   std::vector<IdentityProjection> filterBuildProjections_;
 
   BufferPtr buildOutMapping_;
+
+  // Spilling state.
+
+  const RowTypePtr probeType_;
+
+  // Spills the probe input and reads the spilled build side if the build
+  // side has spilled.
+  std::unique_ptr<NestedLoopJoinProbeSpiller> inputSpiller_;
 };
 
 } // namespace facebook::velox::exec
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/NestedLoopJoinProbeSpiller.h"
+
+namespace facebook::velox::exec {
+
+NestedLoopJoinProbeSpiller::NestedLoopJoinProbeSpiller(
+    RowTypePtr probeType,
+    std::vector<SpillFiles> buildChunks,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats,
+    memory::MemoryPool* pool)
+    : spillConfig_(spillConfig),
+      spillStats_(spillStats),
+      pool_(pool),
+      buildChunks_(std::move(buildChunks)) {
+  VELOX_CHECK_NOT_NULL(spillConfig_);
+  VELOX_CHECK(!buildChunks_.empty());
+  // The probe input is joined with every build piece, so it is not
+  // partitioned.
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kNestedLoopJoinProbe,
+      std::move(probeType),
+      HashBitRange{},
+      spillConfig_,
+      spillStats_);
+  inputSpiller_->setPartitionsSpilled({0});
+}
+
+void NestedLoopJoinProbeSpiller::spillInput(const RowVectorPtr& input) {
+  VELOX_CHECK(!restoring());
+  if (input->size() == 0) {
+    return;
+  }
+  inputSpiller_->spill(0, input);
+}
+
+bool NestedLoopJoinProbeSpiller::nextInput(RowVectorPtr& input) {
+  VELOX_CHECK(!buildReleased_);
+  if (inputReader_ == nullptr) {
+    return false;
+  }
+  while (inputReader_->nextBatch(input)) {
+    if (input->size() > 0) {
+      return true;
+    }
+  }
+  input = nullptr;
+  inputReader_.reset();
+  return false;
+}
+
+bool NestedLoopJoinProbeSpiller::nextBuild(
+    std::vector<RowVectorPtr>& buildVectors) {
+  if (!restoring()) {
+    SpillPartitionSet spillPartitionSet;
+    inputSpiller_->finishSpill(spillPartitionSet);
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    spilledInput_ = spillPartitionSet.begin()->second->files();
+  }
+
+  inputReader_.reset();
+  buildVectors.clear();
+  buildReleased_ = false;
+  pieceStart_ += pieceNumBatches_;
+  pieceNumBatches_ = 0;
+  pool_->release();
+  if (spilledInput_.empty()) {
+    // Nothing to join the build side with.
+    buildReader_.reset();
+    chunk_ = buildChunks_.size();
+    return false;
+  }
+
+  for (;;) {
+    if (buildReader_ == nullptr) {
+      if (chunk_ >= buildChunks_.size()) {
+        return false;
+      }
+      buildReader_ = openBuildChunk(chunk_);
+      pieceStart_ = 0;
+    }
+    RowVectorPtr vector;
+    while (buildReader_->nextBatch(vector)) {
+      ++pieceNumBatches_;
+      const auto bytes = vector->retainedSize();
+      buildVectors.push_back(std::move(vector));
+      // Ends the piece if the memory pool is unlikely to grow by another
+      // batch of the same size.
+      if (!pool_->maybeReserve(bytes)) {
+        break;
+      }
+    }
+    if (pieceNumBatches_ > 0) {
+      break;
+    }
+    buildReader_.reset();
+    ++chunk_;
+  }
+
+  inputReader_ = SpillPartition(SpillPartitionId(0, 0), spilledInput_)
+                     .createUnorderedReader(
+                         spillConfig_->readBufferSize, pool_, spillStats_);
+  return true;
+}
+
+void NestedLoopJoinProbeSpiller::releaseBuild() {
+  if (!buildLoaded()) {
+    return;
+  }
+  // The reader is positioned again by reloadBuild().
+  buildReader_.reset();
+  buildReleased_ = true;
+}
+
+void NestedLoopJoinProbeSpiller::reloadBuild(
+    std::vector<RowVectorPtr>& buildVectors) {
+  VELOX_CHECK(buildReleased_);
+  VELOX_CHECK(buildVectors.empty());
+  VELOX_CHECK_NULL(buildReader_);
+
+  buildReader_ = openBuildChunk(chunk_);
+  RowVectorPtr vector;
+  for (auto i = 0; i < pieceStart_ + pieceNumBatches_; ++i) {
+    VELOX_CHECK(buildReader_->nextBatch(vector));
+    if (i >= pieceStart_) {
+      buildVectors.push_back(std::move(vector));
+    }
+  }
+  buildReleased_ = false;
+}
+
+std::unique_ptr<UnorderedStreamReader<BatchStream>>
+NestedLoopJoinProbeSpiller::openBuildChunk(size_t chunk) const {
+  VELOX_CHECK_LT(chunk, buildChunks_.size());
+  return SpillPartition(SpillPartitionId(0, 0), buildChunks_[chunk])
+      .createUnorderedReader(spillConfig_->readBufferSize, pool_, spillStats_);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Spiller.h"
+
+namespace facebook::velox::exec {
+
+/// Spills the probe input of a join whose build side is collected by
+/// NestedLoopJoinBuild operators, e.g. NestedLoopJoinProbe and IEJoinProbe,
+/// after some of the build vectors have been spilled in chunks.
+///
+/// The probe operator joins its input with the build vectors kept in memory
+/// and spills it by spillInput(). After all the input has been received, the
+/// spilled build side is joined with the spilled probe input one piece at a
+/// time: nextBuild() reads the next piece of a spilled build chunk into the
+/// build vectors of the operator and nextInput() then reads the spilled probe
+/// input from the beginning. A piece holds as many batches of a chunk as fit
+/// in the memory pool, but at least one. The build vectors of a piece can be
+/// released to reclaim memory by releaseBuild() and are read again by
+/// reloadBuild(), with the same batches in the same order.
+class NestedLoopJoinProbeSpiller {
+ public:
+  /// 'buildChunks' are the spill files of the build chunks spilled by the
+  /// build operators, see NestedLoopJoinBridge::spilledChunks().
+  NestedLoopJoinProbeSpiller(
+      RowTypePtr probeType,
+      std::vector<SpillFiles> buildChunks,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats,
+      memory::MemoryPool* pool);
+
+  /// Spills a batch of the probe input to join it with the spilled build
+  /// side later.
+  void spillInput(const RowVectorPtr& input);
+
+  /// Returns true after all the probe input has been spilled.
+  bool restoring() const {
+    return inputSpiller_->finalized();
+  }
+
+  /// Reads the next non-empty batch of the spilled probe input into 'input'.
+  /// Returns false after the last batch, or if no piece of the build side has
+  /// been read yet. nextBuild() is then to be invoked.
+  bool nextInput(RowVectorPtr& input);
+
+  /// Replaces 'buildVectors' with the next piece of the spilled build side
+  /// and starts reading the spilled probe input from the beginning. Finishes
+  /// spilling the probe input on the first call. Returns false if there is
+  /// no piece left, in which case 'buildVectors' is left empty.
+  bool nextBuild(std::vector<RowVectorPtr>& buildVectors);
+
+  /// Returns true if the build vectors of a piece are in memory.
+  bool buildLoaded() const {
+    return pieceNumBatches_ > 0 && !buildReleased_;
+  }
+
+  /// Marks the build vectors of the current piece as released. The caller
+  /// drops its references to them, and to anything derived from them, to
+  /// free their memory.
+  void releaseBuild();
+
+  /// Returns true if the build vectors of the current piece have been
+  /// released and have to be read again before they are joined further.
+  bool buildReleased() const {
+    return buildReleased_;
+  }
+
+  /// Reads the current piece of the build side into 'buildVectors' again
+  /// after releaseBuild().
+  void reloadBuild(std::vector<RowVectorPtr>& buildVectors);
+
+ private:
+  // Opens a reader over the spill files of the build chunk at 'chunk' in
+  // 'buildChunks_'.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> openBuildChunk(
+      size_t chunk) const;
+
+  const common::SpillConfig* const spillConfig_;
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+  memory::MemoryPool* const pool_;
+
+  const std::vector<SpillFiles> buildChunks_;
+
+  // Spills the probe input to a single partition.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Spill files of the probe input, set after all the input has been spilled.
+  SpillFiles spilledInput_;
+
+  // Reads the spilled probe input for joining with the current piece.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> inputReader_;
+
+  // Index into 'buildChunks_' of the chunk of the current piece, or of the
+  // next chunk to read if 'buildReader_' is not set.
+  size_t chunk_{0};
+
+  // Reads the chunk at 'chunk_'. Positioned after the current piece.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> buildReader_;
+
+  // Index of the first batch of the current piece in its chunk and number of
+  // batches in the piece.
+  size_t pieceStart_{0};
+  size_t pieceNumBatches_{0};
+
+  // True if the build vectors of the current piece have been released.
+  bool buildReleased_{false};
+};
+} // namespace facebook::velox::exec
@@ -67,7 +67,8 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       driverCtx->prefixSortConfig(),
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      driverCtx->task->queryCtx()->executor());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -15,7 +15,14 @@
  */
 #include "velox/exec/PrefixSort.h"
 
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/testutil/TestValue.h"
+#include "velox/exec/TreeOfLosers.h"
+
 using namespace facebook::velox::exec::prefixsort;
+using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 
@@ -36,6 +43,9 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
   std::optional<T> value;
   if (RowContainer::isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
     value = std::nullopt;
+  } else if constexpr (std::is_same_v<T, int128_t>) {
+    // int128_t values in RowContainer may be unaligned.
+    value = HugeInt::deserialize(row + rowColumn.offset());
   } else {
     value = *(reinterpret_cast<T*>(row + rowColumn.offset()));
   }
@@ -43,6 +53,27 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  std::string storage;
+  if (RowContainer::isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = std::nullopt;
+  } else {
+    // Strings in RowContainer may be stored in multiple parts.
+    value = HashStringAllocator::contiguousString(
+        *(reinterpret_cast<StringView*>(row + rowColumn.offset())), storage);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value,
+      prefix + prefixSortLayout.prefixOffsets[index],
+      prefixSortLayout.stringPrefixLength);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -76,6 +107,17 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::HUGEINT: {
+      encodeRowColumn<int128_t>(
+          prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -114,33 +156,78 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
   return 0;
 }
 
+// A range of sorted rows to merge with other ranges in parallelSort().
+class SortedRowsMergeStream : public MergeStream {
+ public:
+  SortedRowsMergeStream(
+      std::vector<char*> rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags)
+      : rows_(std::move(rows)),
+        rowContainer_(rowContainer),
+        compareFlags_(compareFlags) {}
+
+  bool hasData() const override {
+    return index_ < rows_.size();
+  }
+
+  int32_t compare(const MergeStream& other) const override {
+    return rowContainer_->compareRows(
+        current(),
+        static_cast<const SortedRowsMergeStream&>(other).current(),
+        compareFlags_);
+  }
+
+  char* current() const {
+    return rows_[index_];
+  }
+
+  void pop() {
+    ++index_;
+  }
+
+ private:
+  const std::vector<char*> rows_;
+  RowContainer* const rowContainer_;
+  const std::vector<CompareFlags>& compareFlags_;
+  size_t index_{0};
+};
 } // namespace
 
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
+  bool lastNormalizedKeyIsPrefix = false;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
-  // cannot be normalized is encountered.
+  // cannot be normalized is encountered. A string key is encoded as a prefix
+  // which may not decide the order, so the loop stops after it as well.
   for (auto i = 0; i < numKeys; ++i) {
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
     std::optional<uint32_t> encodedSize =
         PrefixSortEncoder::encodedSize(types[i]->kind());
+    if (!encodedSize.has_value() && maxStringPrefixLength > 0) {
+      encodedSize = PrefixSortEncoder::encodedPrefixSize(
+          types[i]->kind(), maxStringPrefixLength);
+      lastNormalizedKeyIsPrefix = encodedSize.has_value();
+    }
     if (encodedSize.has_value()) {
       prefixOffsets.push_back(normalizedKeySize);
       encoders.push_back(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
-    } else {
+    }
+    if (!encodedSize.has_value() || lastNormalizedKeyIsPrefix) {
       break;
     }
   }
@@ -153,10 +240,12 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      numNormalizedKeys < numKeys || lastNormalizedKeyIsPrefix,
       std::move(prefixOffsets),
       std::move(encoders),
-      padding};
+      padding,
+      maxStringPrefixLength,
+      lastNormalizedKeyIsPrefix};
 }
 
 FOLLY_ALWAYS_INLINE int PrefixSort::compareAllNormalizedKeys(
@@ -171,10 +260,14 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   if (result != 0) {
     return result;
   }
-  // If prefixes are equal, compare the left sort keys with rowContainer.
+  // If prefixes are equal, compare the left sort keys with rowContainer. The
+  // last normalized key is compared again if it is a string prefix.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  const auto firstKey = sortLayout_.lastNormalizedKeyIsPrefix
+      ? sortLayout_.numNormalizedKeys - 1
+      : sortLayout_.numNormalizedKeys;
+  for (auto i = firstKey; i < sortLayout_.numKeys; ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -220,6 +313,7 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixAllocation;
   // 1. Allocate prefixes data.
+  TestValue::adjust("facebook::velox::exec::PrefixSort::sortInternal", pool_);
   {
     const auto numPages =
         memory::AllocationTraits::numPages(numRows * entrySize);
@@ -254,4 +348,78 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
   }
 }
 
+// static
+void PrefixSort::parallelSort(
+    folly::Range<char**> rows,
+    memory::MemoryPool* pool,
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    const velox::common::PrefixSortConfig& config,
+    folly::Executor* executor) {
+  const size_t numRows = rows.size();
+  const size_t numRanges = executor == nullptr
+      ? 1
+      : std::min<size_t>(
+            std::max(config.maxSortThreads, 1),
+            numRows / std::max(config.minRowsPerSortThread, 1));
+  if (numRanges <= 1) {
+    std::vector<char*> sortedRows(rows.begin(), rows.end());
+    sort(sortedRows, pool, rowContainer, compareFlags, config);
+    std::copy(sortedRows.begin(), sortedRows.end(), rows.begin());
+    return;
+  }
+
+  std::vector<std::vector<char*>> ranges(numRanges);
+  for (auto i = 0; i < numRanges; ++i) {
+    ranges[i].assign(
+        rows.begin() + numRows * i / numRanges,
+        rows.begin() + numRows * (i + 1) / numRanges);
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> sortSteps;
+  sortSteps.reserve(numRanges);
+  // The sort steps reference 'ranges', so all of them must finish before
+  // returning, also on error.
+  auto syncSortSteps = [&]() {
+    std::exception_ptr error;
+    for (auto& step : sortSteps) {
+      try {
+        step->move();
+      } catch (const std::exception&) {
+        error = std::current_exception();
+      }
+    }
+    return error;
+  };
+  auto sync = folly::makeGuard([&]() { syncSortSteps(); });
+
+  for (auto i = 0; i < numRanges; ++i) {
+    sortSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [&, range = &ranges[i]]() {
+          sort(*range, pool, rowContainer, compareFlags, config);
+          return std::make_unique<bool>(true);
+        }));
+    executor->add([step = sortSteps.back()]() { step->prepare(); });
+  }
+  sync.dismiss();
+  if (auto error = syncSortSteps()) {
+    std::rethrow_exception(error);
+  }
+
+  std::vector<std::unique_ptr<SortedRowsMergeStream>> streams;
+  streams.reserve(numRanges);
+  for (auto& range : ranges) {
+    streams.push_back(std::make_unique<SortedRowsMergeStream>(
+        std::move(range), rowContainer, compareFlags));
+  }
+  TreeOfLosers<SortedRowsMergeStream> merger(std::move(streams));
+  for (auto i = 0; i < numRows; ++i) {
+    auto* stream = merger.next();
+    VELOX_CHECK_NOT_NULL(stream);
+    rows[i] = stream->current();
+    stream->pop();
+  }
+  VELOX_CHECK_NULL(merger.next());
+}
+
 } // namespace facebook::velox::exec
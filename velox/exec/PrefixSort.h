@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/RowContainer.h"
@@ -44,13 +46,14 @@ FOLLY_ALWAYS_INLINE void stdSort(
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
 /// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
+/// A VARCHAR or VARBINARY key is normalized by encoding a fixed length prefix
+/// of its value. Such a key is always the last normalized key and is compared
+/// again with RowContainer::compare when the prefixes are equal.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedBufferSize + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -69,7 +72,8 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the sort keys contains non-normalized key, or the last normalized
+  /// key is a string prefix that may not decide the order.
   const bool hasNonNormalizedKey;
 
   /// Offsets of normalized keys, used to find write locations when
@@ -83,10 +87,22 @@ struct PrefixSortLayout {
   /// during ‘memcmp’
   const int32_t padding;
 
+  /// Number of bytes of a VARCHAR or VARBINARY value encoded in the prefix.
+  /// Only used if 'lastNormalizedKeyIsPrefix' is true.
+  const uint32_t stringPrefixLength;
+
+  /// Whether the last normalized key is a VARCHAR or VARBINARY prefix. If so,
+  /// rows with equal prefixes are compared from that key on with
+  /// RowContainer::compare.
+  const bool lastNormalizedKeyIsPrefix;
+
+  /// @param maxStringPrefixLength Max number of bytes of a VARCHAR or VARBINARY
+  /// key to encode in the prefix. 0 means string keys are not normalized.
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength);
 };
 
 class PrefixSort {
@@ -107,11 +123,10 @@ class PrefixSort {
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For keys can part-normalized(Varchar, Varbinary), we store a fixed length
+  /// prefix of the value and compare the full values with RowContainer`s
+  /// compare method when the prefixes are equal. Such a key ends the
+  /// normalized keys.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
@@ -131,7 +146,10 @@ class PrefixSort {
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -143,6 +161,21 @@ class PrefixSort {
     prefixSort.sortInternal(rows);
   }
 
+  /// Sorts 'rows' in place using up to 'config.maxSortThreads' threads. The
+  /// rows are split into ranges of at least 'config.minRowsPerSortThread' rows
+  /// which are sorted with sort() on 'executor' and then merged with
+  /// TreeOfLosers. A range not picked up by 'executor' is sorted on the calling
+  /// thread. If 'executor' is null or there are too few rows, sorts on the
+  /// calling thread. 'rows' is left unchanged if this throws, e.g. if the
+  /// prefixes cannot be allocated from 'pool'.
+  static void parallelSort(
+      folly::Range<char**> rows,
+      memory::MemoryPool* pool,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const velox::common::PrefixSortConfig& config,
+      folly::Executor* executor);
+
  private:
   void sortInternal(std::vector<char*>& rows);
 
@@ -14,7 +14,6 @@
  * limitations under the License.
  */
 #include "velox/exec/RowNumber.h"
-#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
@@ -54,6 +53,17 @@ RowNumber::RowNumber(
     numRowsOffset_ = numRowsColumn.offset();
 
     inputType_ = rowNumberNode->sources()[0]->outputType();
+
+    if (spillEnabled()) {
+      spiller_ = std::make_unique<HashTableInputSpiller>(
+          Spiller::Type::kRowNumber,
+          inputType_,
+          table_.get(),
+          lookup_.get(),
+          &spillConfig_.value(),
+          &spillStats_,
+          pool());
+    }
   }
 
   identityProjections_.reserve(inputType->size());
@@ -65,21 +75,18 @@ RowNumber::RowNumber(
     resultProjections_.emplace_back(0, inputType->size());
     results_.resize(1);
   }
-
-  if (spillEnabled()) {
-    setSpillPartitionBits();
-  }
 }
 
 void RowNumber::addInput(RowVectorPtr input) {
   const auto numInput = input->size();
 
   if (table_) {
-    ensureInputFits(input);
-
-    if (inputSpiller_ != nullptr) {
-      spillInput(input, pool());
-      return;
+    if (spiller_ != nullptr) {
+      spiller_->ensureInputFits(this, input);
+      if (spiller_->spillingInput()) {
+        spiller_->spillInput(input, pool());
+        return;
+      }
     }
 
     SelectivityVector rows(numInput);
@@ -98,7 +105,7 @@ void RowNumber::addInput(RowVectorPtr input) {
 
 void RowNumber::addSpillInput() {
   VELOX_CHECK_NOT_NULL(input_);
-  ensureInputFits(input_);
+  spiller_->ensureInputFits(this, input_);
   if (input_ == nullptr) {
     // Memory arbitration might be triggered by ensureInputFits() which will
     // spill 'input_'.
@@ -108,7 +115,6 @@ void RowNumber::addSpillInput() {
   const auto numInput = input_->size();
   SelectivityVector rows(numInput);
 
-  VELOX_CHECK(spillConfig_.has_value());
   table_->prepareForGroupProbe(
       *lookup_, input_, rows, spillConfig_->startPartitionBit);
   table_->groupProbe(*lookup_, spillConfig_->startPartitionBit);
@@ -122,136 +128,33 @@ void RowNumber::addSpillInput() {
 void RowNumber::noMoreInput() {
   Operator::noMoreInput();
 
-  if (inputSpiller_ != nullptr) {
-    inputSpiller_->finishSpill(spillInputPartitionSet_);
-    removeEmptyPartitions(spillInputPartitionSet_);
+  if (spiller_ != nullptr && spiller_->spillingInput()) {
+    spiller_->finishInputSpill();
     restoreNextSpillPartition();
   }
 }
 
 void RowNumber::restoreNextSpillPartition() {
-  if (spillInputPartitionSet_.empty()) {
+  // The spilled hash table rows contain partition-by keys and count.
+  const auto restored =
+      spiller_->restoreNextPartition([&](const RowVectorPtr& rows) {
+        auto* counts = rows->children().back()->as<FlatVector<int64_t>>();
+
+        for (auto i = 0; i < rows->size(); ++i) {
+          auto* partition = lookup_->hits[i];
+          setNumRows(partition, counts->valueAt(i));
+        }
+      });
+  if (!restored) {
     return;
   }
 
-  auto it = spillInputPartitionSet_.begin();
-  spillInputReader_ = it->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
-
-  // Find matching partition for the hash table.
-  auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
-  if (hashTableIt != spillHashTablePartitionSet_.end()) {
-    spillHashTableReader_ = hashTableIt->second->createUnorderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
-
-    setSpillPartitionBits(&(it->first));
-
-    RowVectorPtr data;
-    while (spillHashTableReader_->nextBatch(data)) {
-      // 'data' contains partition-by keys and count. Transform 'data' to match
-      // 'inputType_' so it can be added to the 'table_'. Move partition-by
-      // columns and leave other columns unset.
-      std::vector<VectorPtr> columns(inputType_->size());
-
-      const auto& hashers = table_->hashers();
-      for (auto i = 0; i < hashers.size(); ++i) {
-        columns[hashers[i]->channel()] = data->childAt(i);
-      }
-
-      auto input = std::make_shared<RowVector>(
-          pool(), inputType_, nullptr, data->size(), std::move(columns));
-
-      const auto numInput = input->size();
-      SelectivityVector rows(numInput);
-      table_->prepareForGroupProbe(
-          *lookup_, input, rows, spillConfig_->startPartitionBit);
-      table_->groupProbe(*lookup_, spillConfig_->startPartitionBit);
-
-      auto* counts = data->children().back()->as<FlatVector<int64_t>>();
-
-      for (auto i = 0; i < numInput; ++i) {
-        auto* partition = lookup_->hits[i];
-        setNumRows(partition, counts->valueAt(i));
-      }
-    }
-  }
-
-  spillInputPartitionSet_.erase(it);
-
-  spillInputReader_->nextBatch(input_);
-  VELOX_CHECK_NOT_NULL(input_);
-  // NOTE: spillInputReader_ will at least produce one batch output.
+  // NOTE: the spilled input of a partition has at least one batch.
+  const bool hasInput = spiller_->nextInput(input_);
+  VELOX_CHECK(hasInput);
   addSpillInput();
 }
 
-void RowNumber::ensureInputFits(const RowVectorPtr& input) {
-  if (!spillEnabled()) {
-    // Spilling is disabled.
-    return;
-  }
-
-  if (table_ == nullptr) {
-    // No hash table. Nothing to spill.
-    return;
-  }
-
-  const auto numDistinct = table_->numDistinct();
-  if (numDistinct == 0) {
-    // Table is empty. Nothing to spill.
-    return;
-  }
-
-  auto* rows = table_->rows();
-  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
-  const auto outOfLineBytes =
-      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
-  const auto outOfLineBytesPerRow = outOfLineBytes / numDistinct;
-
-  // Test-only spill path.
-  if (testingTriggerSpill(pool()->name())) {
-    Operator::ReclaimableSectionGuard guard(this);
-    memory::testingRunArbitration(pool());
-    return;
-  }
-
-  const auto currentUsage = pool()->usedBytes();
-  const auto minReservationBytes =
-      currentUsage * spillConfig_->minSpillableReservationPct / 100;
-  const auto availableReservationBytes = pool()->availableReservation();
-  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
-  const auto incrementBytes =
-      rows->sizeIncrement(input->size(), outOfLineBytesPerRow * input->size()) +
-      tableIncrementBytes;
-
-  // First to check if we have sufficient minimal memory reservation.
-  if (availableReservationBytes >= minReservationBytes) {
-    if ((tableIncrementBytes == 0) && (freeRows > input->size()) &&
-        (outOfLineBytes == 0 ||
-         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
-      // Enough free rows for input rows and enough variable length free space.
-      return;
-    }
-  }
-
-  // Check if we can increase reservation. The increment is the largest of twice
-  // the maximum increment from this input and 'spillableReservationGrowthPct_'
-  // of the current memory usage.
-  const auto targetIncrementBytes = std::max<int64_t>(
-      incrementBytes * 2,
-      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
-  {
-    Operator::ReclaimableSectionGuard guard(this);
-    if (pool()->maybeReserve(targetIncrementBytes)) {
-      return;
-    }
-  }
-
-  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
-               << " for memory pool " << pool()->name()
-               << ", usage: " << succinctBytes(pool()->usedBytes())
-               << ", reservation: " << succinctBytes(pool()->reservedBytes());
-}
-
 FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
   VectorPtr& result = results_[0];
   if (result && result.unique()) {
@@ -264,7 +167,7 @@ FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
 
 RowVectorPtr RowNumber::getOutput() {
   if (input_ == nullptr) {
-    if (spillInputReader_ == nullptr) {
+    if (spiller_ == nullptr || !spiller_->restoringInput()) {
       return nullptr;
     }
 
@@ -330,12 +233,10 @@ RowVectorPtr RowNumber::getOutput() {
     output = fillOutput(numInput, nullptr);
   }
 
-  if (spillInputReader_ != nullptr) {
-    if (spillInputReader_->nextBatch(input_)) {
+  if (spiller_ != nullptr && spiller_->restoringInput()) {
+    if (spiller_->nextInput(input_)) {
       addSpillInput();
     } else {
-      input_ = nullptr;
-      spillInputReader_ = nullptr;
       table_->clear();
       restoreNextSpillPartition();
     }
@@ -393,7 +294,7 @@ void RowNumber::reclaim(
     return;
   }
 
-  if (exceededMaxSpillLevelLimit_) {
+  if (spiller_->exceededMaxSpillLevelLimit()) {
     LOG(WARNING) << "Exceeded row spill level limit: "
                  << spillConfig_->maxSpillLevel
                  << ", and abandon spilling for memory pool: "
@@ -405,146 +306,22 @@ void RowNumber::reclaim(
   spill();
 }
 
-SpillPartitionNumSet RowNumber::spillHashTable() {
-  // TODO Replace joinPartitionBits and Spiller::Type::kHashJoinBuild.
-  VELOX_CHECK_NOT_NULL(table_);
-
-  auto columnTypes = table_->rows()->columnTypes();
-  auto tableType = ROW(std::move(columnTypes));
-  const auto& spillConfig = spillConfig_.value();
-
-  auto hashTableSpiller = std::make_unique<Spiller>(
-      Spiller::Type::kRowNumber,
-      table_->rows(),
-      tableType,
-      spillPartitionBits_,
-      &spillConfig,
-      &spillStats_);
-
-  hashTableSpiller->spill();
-  hashTableSpiller->finishSpill(spillHashTablePartitionSet_);
-
-  table_->clear();
-  pool()->release();
-  return hashTableSpiller->state().spilledPartitionSet();
-}
-
-void RowNumber::setupInputSpiller(
-    const SpillPartitionNumSet& spillPartitionSet) {
-  VELOX_CHECK(!spillPartitionSet.empty());
-
-  const auto& spillConfig = spillConfig_.value();
-
-  // TODO Replace Spiller::Type::kHashJoinProbe.
-  inputSpiller_ = std::make_unique<Spiller>(
-      Spiller::Type::kHashJoinProbe,
-      inputType_,
-      spillPartitionBits_,
-      &spillConfig,
-      &spillStats_);
-  inputSpiller_->setPartitionsSpilled(spillPartitionSet);
-
-  const auto& hashers = table_->hashers();
-
-  std::vector<column_index_t> keyChannels;
-  keyChannels.reserve(hashers.size());
-  for (const auto& hasher : hashers) {
-    keyChannels.push_back(hasher->channel());
-  }
-
-  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
-      inputSpiller_->hashBits(), inputType_, keyChannels);
-}
-
 void RowNumber::spill() {
   VELOX_CHECK(spillEnabled());
 
-  const auto spillPartitionSet = spillHashTable();
-  VELOX_CHECK_EQ(table_->numDistinct(), 0);
-
-  setupInputSpiller(spillPartitionSet);
+  spiller_->spill();
   if (input_ != nullptr) {
-    spillInput(input_, memory::spillMemoryPool());
+    spiller_->spillInput(input_, memory::spillMemoryPool());
     input_ = nullptr;
   }
 }
 
-void RowNumber::spillInput(
-    const RowVectorPtr& input,
-    memory::MemoryPool* pool) {
-  const auto numInput = input->size();
-
-  std::vector<uint32_t> spillPartitions(numInput);
-  const auto singlePartition =
-      spillHashFunction_->partition(*input, spillPartitions);
-
-  const auto numPartitions = spillHashFunction_->numPartitions();
-
-  std::vector<BufferPtr> partitionIndices(numPartitions);
-  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
-
-  for (auto i = 0; i < numPartitions; ++i) {
-    partitionIndices[i] = allocateIndices(numInput, pool);
-    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
-  }
-
-  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
-
-  for (auto row = 0; row < numInput; ++row) {
-    const auto partition = singlePartition.has_value() ? singlePartition.value()
-                                                       : spillPartitions[row];
-    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
-  }
-
-  // Ensure vector are lazy loaded before spilling.
-  for (auto i = 0; i < input->childrenSize(); ++i) {
-    input->childAt(i)->loadedVector();
-  }
-
-  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
-    const auto numInputs = numSpillInputs[partition];
-    if (numInputs == 0) {
-      continue;
-    }
-
-    inputSpiller_->spill(
-        partition, wrap(numInputs, partitionIndices[partition], input));
-  }
-}
-
 void RowNumber::recursiveSpillInput() {
-  RowVectorPtr input;
-  while (spillInputReader_->nextBatch(input)) {
-    spillInput(input, pool());
-
-    if (operatorCtx_->driver()->shouldYield()) {
-      yield_ = true;
-      return;
-    }
-  }
-
-  inputSpiller_->finishSpill(spillInputPartitionSet_);
-  spillInputReader_ = nullptr;
-
-  removeEmptyPartitions(spillInputPartitionSet_);
-  restoreNextSpillPartition();
-}
-
-void RowNumber::setSpillPartitionBits(
-    const SpillPartitionId* restoredPartitionId) {
-  const auto startPartitionBitOffset = restoredPartitionId == nullptr
-      ? spillConfig_->startPartitionBit
-      : restoredPartitionId->partitionBitOffset() +
-          spillConfig_->numPartitionBits;
-  if (spillConfig_->exceedSpillLevelLimit(startPartitionBitOffset)) {
-    exceededMaxSpillLevelLimit_ = true;
+  if (!spiller_->respillInput(operatorCtx_->driver())) {
+    yield_ = true;
     return;
   }
-
-  exceededMaxSpillLevelLimit_ = false;
-  spillPartitionBits_ = HashBitRange(
-      startPartitionBitOffset,
-      startPartitionBitOffset + spillConfig_->numPartitionBits);
+  restoreNextSpillPartition();
 }
 
 } // namespace facebook::velox::exec
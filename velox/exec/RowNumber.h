@@ -15,8 +15,8 @@
  */
 #pragma once
 
-#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableInputSpiller.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -44,7 +44,7 @@ class RowNumber : public Operator {
 
   bool isFinished() override {
     return (noMoreInput_ && input_ == nullptr &&
-            spillInputReader_ == nullptr) ||
+            (spiller_ == nullptr || !spiller_->restoringInput())) ||
         finishedEarly_;
   }
 
@@ -56,20 +56,12 @@ class RowNumber : public Operator {
     return spillConfig_.has_value();
   }
 
-  void setupInputSpiller(const SpillPartitionNumSet& spillPartitionSet);
-
-  void ensureInputFits(const RowVectorPtr& input);
-
-  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
-
   void spill();
 
   void addSpillInput();
 
   void restoreNextSpillPartition();
 
-  SpillPartitionNumSet spillHashTable();
-
   int64_t numRows(char* partition);
 
   void setNumRows(char* partition, int64_t numRows);
@@ -78,23 +70,11 @@ class RowNumber : public Operator {
 
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
 
-  // Used by recursive spill processing to read the spilled input data from the
-  // previous spill run through 'spillInputReader_' and then spill them back
-  // into a number of sub-partitions. After that, the function restores one of
-  // the newly spilled partitions and resets 'spillInputReader_' accordingly.
+  // Used by recursive spill processing to spill the rest of the input of the
+  // partition being restored to its sub-partitions. After that, restores one
+  // of the newly spilled partitions.
   void recursiveSpillInput();
 
-  // Set 'spillPartitionBits_' for (recursive) spill. If 'restoredPartitionId'
-  // is not null, use it to set 'spillPartitionBits_', otherwise use
-  // 'spillConfig_'. If the new 'spillPartitionBits_' exceeds the
-  // 'maxSpillLevel', set 'exceededMaxSpillLevelLimit_' to true.
-  //
-  // NOTE: we don't increment 'spillMaxLevelExceededCount' here, as the actual
-  // increment happens in the 'reclaim()' method if
-  // 'exceededMaxSpillLevelLimit_' is true.
-  void setSpillPartitionBits(
-      const SpillPartitionId* restoredPartitionId = nullptr);
-
   const std::optional<int32_t> limit_;
   const bool generateRowNumber_;
 
@@ -115,30 +95,12 @@ class RowNumber : public Operator {
 
   RowTypePtr inputType_;
 
-  // The spill partition bits used by both hash table content spill and input
-  // data spill.
-  HashBitRange spillPartitionBits_;
-
-  // Used to restore previously spilled hash table.
-  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillHashTableReader_;
-
-  SpillPartitionSet spillHashTablePartitionSet_;
-
-  // Spiller for input received after spilling has been triggered.
-  std::unique_ptr<Spiller> inputSpiller_;
-
-  // Used to restore previously spilled input.
-  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
-
-  SpillPartitionSet spillInputPartitionSet_;
-
-  // Used to calculate the spill partition numbers of the inputs.
-  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+  // Spills 'table_' and the input received afterwards. Set if spilling is
+  // enabled and there are partitioning keys.
+  std::unique_ptr<HashTableInputSpiller> spiller_;
 
   // The cpu may be voluntarily yield after running too long when processing
   // input from spilled file.
   bool yield_{false};
-
-  bool exceededMaxSpillLevelLimit_{false};
 };
 } // namespace facebook::velox::exec
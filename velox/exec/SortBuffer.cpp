@@ -27,14 +27,16 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     common::PrefixSortConfig prefixSortConfig,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    folly::Executor* sortExecutor)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       prefixSortConfig_(prefixSortConfig),
       spillConfig_(spillConfig),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      sortExecutor_(sortExecutor) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -121,8 +123,7 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    PrefixSort::sort(
-        sortedRows_, pool_, data_.get(), sortCompareFlags_, prefixSortConfig_);
+    sortRows();
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -285,6 +286,21 @@ void SortBuffer::updateEstimatedOutputRowSize() {
   }
 }
 
+void SortBuffer::sortRows() {
+  if (sortExecutor_ != nullptr && prefixSortConfig_.maxSortThreads > 1) {
+    PrefixSort::parallelSort(
+        folly::Range<char**>(sortedRows_.data(), sortedRows_.size()),
+        pool_,
+        data_.get(),
+        sortCompareFlags_,
+        prefixSortConfig_,
+        sortExecutor_);
+    return;
+  }
+  PrefixSort::sort(
+      sortedRows_, pool_, data_.get(), sortCompareFlags_, prefixSortConfig_);
+}
+
 void SortBuffer::spillInput() {
   if (spiller_ == nullptr) {
     VELOX_CHECK(!noMoreInput_);
@@ -295,7 +311,8 @@ void SortBuffer::spillInput() {
         data_->keyTypes().size(),
         sortCompareFlags_,
         spillConfig_,
-        spillStats_);
+        spillStats_,
+        prefixSortConfig_);
   }
   spiller_->spill();
   data_->clear();
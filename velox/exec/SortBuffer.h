@@ -39,7 +39,8 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       common::PrefixSortConfig prefixSortConfig,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      folly::Executor* sortExecutor = nullptr);
 
   ~SortBuffer();
 
@@ -86,6 +87,8 @@ class SortBuffer {
   // Finish spill, and we shouldn't get any rows from non-spilled partition as
   // there is only one hash partition for SortBuffer.
   void finishSpill();
+  // Sorts 'sortedRows_', in parallel on 'sortExecutor_' if configured.
+  void sortRows();
 
   const RowTypePtr input_;
   const std::vector<CompareFlags> sortCompareFlags_;
@@ -98,6 +101,9 @@ class SortBuffer {
   const common::PrefixSortConfig prefixSortConfig_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  // Executor to sort the rows in parallel if
+  // 'prefixSortConfig_.maxSortThreads' is more than 1. Not owned.
+  folly::Executor* const sortExecutor_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
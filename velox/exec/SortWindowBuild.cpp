@@ -152,6 +152,14 @@ void SortWindowBuild::setupSpiller() {
 }
 
 void SortWindowBuild::spill() {
+  if (noMoreInput_) {
+    spillOutput();
+    return;
+  }
+  spillInput();
+}
+
+void SortWindowBuild::spillInput() {
   if (spiller_ == nullptr) {
     setupSpiller();
   }
@@ -161,6 +169,53 @@ void SortWindowBuild::spill() {
   data_->pool()->release();
 }
 
+void SortWindowBuild::spillOutput() {
+  if (merge_ != nullptr) {
+    // 'data_' only holds the partition being output, the rest is on disk.
+    return;
+  }
+
+  // The first partition that has not been handed to the Window operator.
+  const vector_size_t nextPartition = currentPartition_ + 1;
+  if (partitionStartRows_.empty() ||
+      nextPartition >= partitionStartRows_.size() - 1) {
+    return;
+  }
+
+  VELOX_CHECK_NULL(spiller_);
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kOrderByOutput,
+      data_.get(),
+      inputType_,
+      spillConfig_,
+      spillStats_);
+  // The rows are already sorted by partition and sorting keys, so they are
+  // written as a single sorted run.
+  std::vector<char*> spillRows(
+      sortedRows_.begin() + partitionStartRows_[nextPartition],
+      sortedRows_.end());
+  spiller_->spill(spillRows);
+
+  SpillPartitionSet spillPartitionSet;
+  spiller_->finishSpill(spillPartitionSet);
+  VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+  merge_ = spillPartitionSet.begin()->second->createOrderedReader(
+      spillConfig_->readBufferSize, pool_, spillStats_);
+  partitionStartRows_.clear();
+
+  if (currentPartition_ < 0) {
+    // No partition is being output, all the rows are on disk.
+    sortedRows_.clear();
+    data_->clear();
+    data_->pool()->release();
+    return;
+  }
+
+  // Keep the rows of the current partition. They are cleared by
+  // loadNextPartitionFromSpill() once the Window operator has consumed them.
+  sortedRows_.resize(sortedRows_.size() - spillRows.size());
+}
+
 // Use double front and back search algorithm to find next partition start row.
 // It is more efficient than linear or binary search.
 // This algorithm is described at
@@ -228,14 +283,16 @@ void SortWindowBuild::sortPartitions() {
 }
 
 void SortWindowBuild::noMoreInput() {
+  noMoreInput_ = true;
   if (numRows_ == 0) {
     return;
   }
 
   if (spiller_ != nullptr) {
     // Spill remaining data to avoid running out of memory while sort-merging
-    // spilled data.
-    spill();
+    // spilled data. The input spiller has to write these rows: spill() is
+    // already in output mode at this point.
+    spillInput();
 
     VELOX_CHECK_NULL(merge_);
     SpillPartitionSet spillPartitionSet;
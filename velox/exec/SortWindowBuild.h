@@ -60,6 +60,17 @@ class SortWindowBuild : public WindowBuild {
 
   void setupSpiller();
 
+  // Spills all the rows in 'data_' with the input spiller. Called before and
+  // at noMoreInput().
+  void spillInput();
+
+  // Spills the rows of the partitions that have not been handed to the Window
+  // operator yet. Called after noMoreInput(). The rows of the partition being
+  // output stay in 'data_' until the Window operator moves to the next
+  // partition, after which partitions are read back from spill one at a time.
+  // This bounds the output memory by the size of the largest partition.
+  void spillOutput();
+
   // Main sorting function loop done after all input rows are received
   // by WindowBuild.
   void sortPartitions();
@@ -88,6 +99,8 @@ class SortWindowBuild : public WindowBuild {
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  bool noMoreInput_{false};
+
   // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
   // It is used to perform a full sorting of the input rows to be able to
   // separate partitions and sort the rows in it. The rows are output in
@@ -277,6 +277,13 @@ class SpillPartition {
     return files_.size();
   }
 
+  /// Returns the spill files of this partition. The files are not deleted
+  /// after being read, so they can be read more than once by creating a new
+  /// partition from them.
+  const SpillFiles& files() const {
+    return files_;
+  }
+
   /// Returns the total file byte size of this spilled partition.
   uint64_t size() const {
     return size_;
@@ -21,6 +21,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
 using facebook::velox::common::testutil::TestValue;
@@ -32,6 +33,22 @@ namespace {
 
 #define CHECK_FINALIZED() \
   VELOX_CHECK(finalized_, "Spiller hasn't been finalized yet");
+
+// Returns true if 'type' of spiller has no row container and only appends the
+// vectors given by the operator to the spilling partitions.
+bool isVectorSpillType(Spiller::Type type) {
+  return type == Spiller::Type::kHashJoinProbe ||
+      type == Spiller::Type::kNestedLoopJoinBuild ||
+      type == Spiller::Type::kNestedLoopJoinProbe;
+}
+
+// Returns true if 'type' of spiller spills a hash table from its row container
+// and, with a second spiller without row container, the input received after
+// that.
+bool isHashTableSpillType(Spiller::Type type) {
+  return type == Spiller::Type::kRowNumber ||
+      type == Spiller::Type::kMarkDistinct;
+}
 } // namespace
 
 Spiller::Spiller(
@@ -41,7 +58,8 @@ Spiller::Spiller(
     int32_t numSortingKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig)
     : Spiller(
           type,
           container,
@@ -66,6 +84,9 @@ Spiller::Spiller(
       "Unexpected spiller type: {}",
       typeName(type_));
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
+  if (prefixSortConfig.has_value()) {
+    prefixSortConfig_.emplace(prefixSortConfig.value());
+  }
 }
 
 Spiller::Spiller(
@@ -158,9 +179,8 @@ Spiller::Spiller(
           0,
           spillConfig->fileCreateConfig,
           spillStats) {
-  VELOX_CHECK_EQ(
-      type_,
-      Type::kHashJoinProbe,
+  VELOX_CHECK(
+      isVectorSpillType(type_) || isHashTableSpillType(type_),
       "Unexpected spiller type: {}",
       typeName(type_));
 }
@@ -220,7 +240,10 @@ Spiller::Spiller(
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
-  VELOX_CHECK_EQ(type_, Type::kRowNumber);
+  VELOX_CHECK(
+      isHashTableSpillType(type_),
+      "Unexpected spiller type: {}",
+      typeName(type_));
 }
 
 Spiller::Spiller(
@@ -265,7 +288,11 @@ Spiller::Spiller(
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
-  VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
+  if (isVectorSpillType(type_)) {
+    VELOX_CHECK_NULL(container_);
+  } else if (!isHashTableSpillType(type_)) {
+    VELOX_CHECK_NOT_NULL(container_);
+  }
   spillRuns_.reserve(state_.maxPartitions());
   for (int i = 0; i < state_.maxPartitions(); ++i) {
     spillRuns_.emplace_back(*memory::spillMemoryPool());
@@ -305,7 +332,7 @@ int64_t Spiller::extractSpillVector(
     int64_t maxBytes,
     RowVectorPtr& spillVector,
     size_t& nextBatchIndex) {
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NOT_NULL(container_);
 
   auto limit = std::min<size_t>(rows.size() - nextBatchIndex, maxRows);
   VELOX_CHECK(!rows.empty());
@@ -417,13 +444,39 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeNs{0};
   {
     NanosecondTimer timer(&sortTimeNs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    bool sorted{false};
+    if (prefixSortConfig_.has_value()) {
+      // The prefixes are allocated while spilling, i.e. when memory is short.
+      // Falls back to timsort, which needs no memory, if the allocation fails.
+      // parallelSort() leaves the rows unchanged in this case.
+      try {
+        PrefixSort::parallelSort(
+            folly::Range<char**>(run.rows.data(), run.rows.size()),
+            memory::spillMemoryPool(),
+            container_,
+            state_.sortCompareFlags(),
+            prefixSortConfig_.value(),
+            executor_);
+        sorted = true;
+      } catch (const VeloxRuntimeError& e) {
+        if (e.errorCode() != error_code::kMemCapExceeded &&
+            e.errorCode() != error_code::kMemAllocError) {
+          throw;
+        }
+        LOG(WARNING) << "Failed to allocate memory for prefix sort of "
+                     << run.rows.size()
+                     << " spill rows, falling back to timsort: " << e.what();
+      }
+    }
+    if (!sorted) {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
 
@@ -433,7 +486,7 @@ void Spiller::ensureSorted(SpillRun& run) {
 }
 
 std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NOT_NULL(container_);
   // Target size of a single vector of spilled content. One of
   // these will be materialized at a time for each stream of the
   // merge.
@@ -537,8 +590,8 @@ void Spiller::updateSpillSortTime(uint64_t timeNs) {
 }
 
 bool Spiller::needSort() const {
-  return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
-      type_ != Type::kRowNumber && type_ != Type::kAggregateOutput &&
+  return !isVectorSpillType(type_) && !isHashTableSpillType(type_) &&
+      type_ != Type::kHashJoinBuild && type_ != Type::kAggregateOutput &&
       type_ != Type::kOrderByOutput;
 }
 
@@ -553,7 +606,7 @@ void Spiller::spill(const RowContainerIterator& startRowIter) {
 
 void Spiller::spill(const RowContainerIterator* startRowIter) {
   CHECK_NOT_FINALIZED();
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NOT_NULL(container_);
   VELOX_CHECK_NE(type_, Type::kOrderByOutput);
 
   markAllPartitionsSpilled();
@@ -601,8 +654,8 @@ void Spiller::markAllPartitionsSpilled() {
 void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK(
-      type_ == Type::kHashJoinProbe || type_ == Type::kHashJoinBuild ||
-          type_ == Type::kRowNumber,
+      isVectorSpillType(type_) || isHashTableSpillType(type_) ||
+          type_ == Type::kHashJoinBuild,
       "Unexpected spiller type: {}",
       typeName(type_));
   if (FOLLY_UNLIKELY(!state_.isPartitionSpilled(partition))) {
@@ -737,6 +790,12 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_OUTPUT";
     case Type::kRowNumber:
       return "ROW_NUMBER";
+    case Type::kNestedLoopJoinBuild:
+      return "NESTED_LOOP_JOIN_BUILD";
+    case Type::kMarkDistinct:
+      return "MARK_DISTINCT";
+    case Type::kNestedLoopJoinProbe:
+      return "NESTED_LOOP_JOIN_PROBE";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
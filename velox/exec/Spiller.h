@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/exec/HashBitRange.h"
@@ -41,8 +42,14 @@ class Spiller {
     kOrderByOutput = 5,
     // Used for row number.
     kRowNumber = 6,
+    // Used for nested loop join build.
+    kNestedLoopJoinBuild = 7,
+    // Used for mark distinct.
+    kMarkDistinct = 8,
+    // Used for nested loop join probe.
+    kNestedLoopJoinProbe = 9,
     // Number of spiller types.
-    kNumTypes = 7,
+    kNumTypes = 10,
   };
 
   static std::string typeName(Type);
@@ -64,6 +71,10 @@ class Spiller {
       folly::Synchronized<common::SpillStats>* spillStats);
 
   /// type == Type::kOrderByInput
+  ///
+  /// If 'prefixSortConfig' is set, the spill runs are sorted with PrefixSort,
+  /// in parallel on the spill executor if
+  /// 'prefixSortConfig->maxSortThreads' is more than 1.
   Spiller(
       Type type,
       RowContainer* container,
@@ -71,7 +82,9 @@ class Spiller {
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       const common::SpillConfig* spillConfig,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt);
 
   /// type == Type::kAggregateOutput || type == Type::kOrderByOutput
   Spiller(
@@ -81,7 +94,11 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kHashJoinProbe
+  /// type == Type::kHashJoinProbe || type == Type::kNestedLoopJoinBuild ||
+  /// type == Type::kNestedLoopJoinProbe
+  ///
+  /// Also used with type == Type::kRowNumber || type == Type::kMarkDistinct to
+  /// spill the input received after the hash table has been spilled.
   Spiller(
       Type type,
       RowTypePtr rowType,
@@ -99,7 +116,7 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kRowNumber
+  /// type == Type::kRowNumber || type == Type::kMarkDistinct
   Spiller(
       Type type,
       RowContainer* container,
@@ -181,11 +198,8 @@ class Spiller {
 
   /// Invokes to set a set of 'partitions' as spilling.
   void setPartitionsSpilled(const SpillPartitionNumSet& partitions) {
-    VELOX_CHECK_EQ(
-        type_,
-        Spiller::Type::kHashJoinProbe,
-        "Unexpected spiller type: ",
-        typeName(type_));
+    VELOX_CHECK_NULL(
+        container_, "Unexpected spiller type: {}", typeName(type_));
     for (const auto& partition : partitions) {
       state_.setPartitionSpilled(partition);
     }
@@ -329,6 +343,9 @@ class Spiller {
   const RowTypePtr rowType_;
   const bool spillProbedFlag_;
   const uint64_t maxSpillRunRows_;
+  // Config to sort the spill runs with PrefixSort. Only set for
+  // 'kOrderByInput' spiller type.
+  std::optional<common::PrefixSortConfig> prefixSortConfig_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
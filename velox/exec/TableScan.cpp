@@ -368,10 +368,13 @@ void TableScan::addDynamicFilter(
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
   auto& currentFilter = dynamicFilters_[outputChannel];
-  if (currentFilter) {
-    currentFilter = currentFilter->mergeWith(filter.get());
-  } else {
+  if (!currentFilter) {
     currentFilter = filter;
+  } else if (filter->kind() == common::FilterKind::kBloomFilterValues) {
+    // Exact filters do not merge with Bloom filters, see ScanSpec::addFilter.
+    currentFilter = filter->mergeWith(currentFilter.get());
+  } else {
+    currentFilter = currentFilter->mergeWith(filter.get());
   }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
@@ -102,7 +102,8 @@ struct SplitGroupState {
       unordered_map<core::PlanNodeId, std::vector<std::shared_ptr<MergeSource>>>
           localMergeSources;
 
-  /// Map of merge join sources keyed on MergeJoinNode plan node ID.
+  /// Map of merge join sources keyed on MergeJoinNode or AsOfJoinNode plan
+  /// node ID.
   std::unordered_map<core::PlanNodeId, std::shared_ptr<MergeJoinSource>>
       mergeJoinSources;
 
@@ -672,6 +672,14 @@ std::unique_ptr<common::Filter> VectorHasher::getFilter(
   }
 }
 
+std::unique_ptr<common::Filter> VectorHasher::getBloomFilter(
+    bool nullAllowed) const {
+  if (bloomFilter_ == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<common::BloomFilterValues>(bloomFilter_, nullAllowed);
+}
+
 namespace {
 template <typename T>
 // Adds 'reserve' to either end of the range between 'min' and 'max' while
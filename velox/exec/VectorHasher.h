@@ -244,6 +244,44 @@ class VectorHasher {
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
 
+  // Returns true if getFilter() returns an exact filter.
+  bool hasFilter() const {
+    switch (typeKind_) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        return !distinctOverflow_;
+      default:
+        return false;
+    }
+  }
+
+  // Returns a probabilistic filter over all the values of the key if a Bloom
+  // filter has been set with setBloomFilter(). Returns null otherwise.
+  std::unique_ptr<common::Filter> getBloomFilter(bool nullAllowed) const;
+
+  // Sets a Bloom filter of the hashes of all the values of the key, computed
+  // with common::BloomFilterValues::hashInt64() or hashBytes(). Used to push
+  // down a filter on join keys for which getFilter() returns null.
+  void setBloomFilter(std::shared_ptr<const BloomFilter<>> bloomFilter) {
+    bloomFilter_ = std::move(bloomFilter);
+  }
+
+  static bool typeKindSupportsBloomFilter(TypeKind kind) {
+    switch (kind) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
@@ -582,6 +620,10 @@ class VectorHasher {
   // Memory for unique string values.
   std::vector<std::string> uniqueValuesStorage_;
   uint64_t distinctStringsBytes_ = 0;
+
+  // Bloom filter of all the values of a join build key. Set after the join
+  // table is built.
+  std::shared_ptr<const BloomFilter<>> bloomFilter_;
 };
 
 template <>
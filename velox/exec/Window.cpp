@@ -233,16 +233,9 @@ void Window::reclaim(
   VELOX_CHECK(canReclaim());
   VELOX_CHECK(!nonReclaimableSection_);
 
-  if (noMoreInput_) {
-    ++stats.numNonReclaimableAttempts;
-    // TODO Add support for spilling after noMoreInput().
-    LOG(WARNING)
-        << "Can't reclaim from window operator which has started producing output: "
-        << pool()->name() << ", usage: " << succinctBytes(pool()->usedBytes())
-        << ", reservation: " << succinctBytes(pool()->reservedBytes());
-    return;
-  }
-
+  // After noMoreInput() this spills the partitions that have not been output
+  // yet. The memory of the partition being output is freed once the operator
+  // moves past it.
   windowBuild_->spill();
 }
 
@@ -687,6 +680,11 @@ RowVectorPtr Window::getOutput() {
 
   // Compute the output values of window functions.
   auto numResultRows = callApplyLoop(numOutputRows, result);
+
+  // Test-only spill path to spill while a partition is being output.
+  if (spillConfig_.has_value() && testingTriggerSpill(pool()->name())) {
+    windowBuild_->spill();
+  }
   return numResultRows < numOutputRows
       ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
       : result;
@@ -44,7 +44,8 @@ class WindowBuild {
   /// Adds new input rows to the WindowBuild.
   virtual void addInput(RowVectorPtr input) = 0;
 
-  /// Can be called any time before noMoreInput().
+  /// Spills the input rows. After noMoreInput(), spills the rows of the
+  /// partitions that have not been returned by nextPartition() yet.
   virtual void spill() = 0;
 
   /// Returns the spiller stats including total bytes and rows spilled so far.
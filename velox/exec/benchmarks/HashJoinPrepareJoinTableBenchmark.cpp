@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -36,18 +37,24 @@ struct HashTableBenchmarkParams {
   //  -the build row schema,
   //  -the expected hash table size,
   //  -number of building rows,
-  //  -number of build RowContainers.
+  //  -number of build RowContainers,
+  //  -the target radix partition size in bytes, 0 for no radix partitioning,
+  //  -whether to time the probe of the table instead of its build.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
       int64_t hashTableSize,
       int64_t buildSize,
-      int32_t numWays)
+      int32_t numWays,
+      uint64_t radixPartitionBytes = 0,
+      bool probe = false)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         buildSize{buildSize},
-        numWays{numWays} {
+        numWays{numWays},
+        radixPartitionBytes{radixPartitionBytes},
+        probe{probe} {
     VELOX_CHECK_LE(hashTableSize, buildSize);
     VELOX_CHECK_GE(numWays, 1);
 
@@ -71,6 +78,12 @@ struct HashTableBenchmarkParams {
         numWays > 1,
         buildSize > hashTableSize,
         BaseHashTable::modeString(mode));
+    if (radixPartitionBytes > 0) {
+      title += fmt::format(",radix:{}", succinctBytes(radixPartitionBytes));
+    }
+    if (probe) {
+      title += ",probe";
+    }
   }
 
   // Expected mode.
@@ -88,6 +101,13 @@ struct HashTableBenchmarkParams {
   // Number of build RowContainers.
   int32_t numWays;
 
+  // Target size of the radix partitions of the table. 0 if not partitioned.
+  uint64_t radixPartitionBytes{0};
+
+  // If true, the table is built in 'prepare' and 'run' probes it with the
+  // build keys in random order.
+  bool probe{false};
+
   // Title for reporting
   std::string title;
 
@@ -121,11 +141,25 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     params_ = params;
     topTable_.reset();
     otherTables_.clear();
+    probeBatches_.clear();
     createTable();
+    topTable_->setRadixPartitionBytes(params_.radixPartitionBytes);
+    if (params_.probe) {
+      buildTable();
+    }
   }
 
-  // Run 'prepareJoinTable'.
+  // Run 'prepareJoinTable' or probe the table.
   void run() {
+    if (params_.probe) {
+      probeTable();
+    } else {
+      buildTable();
+    }
+  }
+
+ private:
+  void buildTable() {
     topTable_->prepareJoinTable(
         std::move(otherTables_),
         BaseHashTable::kNoSpillInputStartPartitionBit,
@@ -133,7 +167,27 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     VELOX_CHECK_EQ(topTable_->hashMode(), params_.mode);
   }
 
- private:
+  // Probes the table with 'probeBatches_'. Every probe row has a match.
+  void probeTable() {
+    std::vector<std::unique_ptr<VectorHasher>> probeHashers;
+    for (int32_t i = 0; i < params_.numFields; ++i) {
+      probeHashers.push_back(
+          std::make_unique<VectorHasher>(params_.buildType->childAt(i), i));
+    }
+    HashLookup lookup(probeHashers);
+    int64_t numHits = 0;
+    for (const auto& batch : probeBatches_) {
+      SelectivityVector rows(batch->size());
+      topTable_->prepareForJoinProbe(lookup, batch, rows, true);
+      lookup.hits.resize(lookup.rows.back() + 1);
+      topTable_->joinProbe(lookup);
+      for (auto row : lookup.rows) {
+        numHits += lookup.hits[row] != nullptr;
+      }
+    }
+    folly::doNotOptimizeAway(numHits);
+  }
+
   // Create the row vector for the build side, where the first column is used
   // as the join key, and the remaining columns are dependent fields.
   // If expect mode is array, the key is within the range [0, hashTableSize];
@@ -223,6 +277,18 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
           pool_.get());
 
       copyVectorsToTable(batches[i], table.get());
+      if (params_.probe) {
+        // Probes in batches of 10K rows, the rows within a build batch are
+        // already shuffled.
+        constexpr vector_size_t kProbeBatchSize = 10'000;
+        for (vector_size_t offset = 0; offset < batches[i]->size();
+             offset += kProbeBatchSize) {
+          probeBatches_.push_back(
+              std::dynamic_pointer_cast<RowVector>(batches[i]->slice(
+                  offset,
+                  std::min(kProbeBatchSize, batches[i]->size() - offset))));
+        }
+      }
       if (i == 0) {
         topTable_ = std::move(table);
       } else {
@@ -234,6 +300,7 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
   std::default_random_engine randomEngine_;
   std::unique_ptr<HashTable<true>> topTable_;
   std::vector<std::unique_ptr<BaseHashTable>> otherTables_;
+  std::vector<RowVectorPtr> probeBatches_;
   HashTableBenchmarkParams params_;
 };
 
@@ -296,6 +363,33 @@ void initHashModeBenchmarkParams(
     }
   }
 }
+
+// Builds and probes kHash mode tables from 1MB to 256MB with and without radix
+// partitioning into 1MB ranges. Radix partitioning starts paying off once the
+// table no longer fits in the last level cache.
+void initRadixModeBenchmarkParams(
+    std::vector<HashTableBenchmarkParams>& params) {
+  TypePtr threeKeyType{ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()})};
+  constexpr uint64_t kRadixPartitionBytes = 1 << 20;
+  // The table has 1 slot of 8 bytes per row rounded up to a power of 2,
+  // i.e. 1MB for 100K rows.
+  std::vector<int64_t> buildSizeVector = {
+      100'000, 400'000, 1'600'000, 6'400'000, 25'600'000};
+  for (auto buildSize : buildSizeVector) {
+    for (auto probe : {false, true}) {
+      for (auto radixPartitionBytes : {0UL, kRadixPartitionBytes}) {
+        params.push_back(HashTableBenchmarkParams(
+            BaseHashTable::HashMode::kHash,
+            threeKeyType,
+            buildSize,
+            buildSize,
+            1,
+            radixPartitionBytes,
+            probe));
+      }
+    }
+  }
+}
 } // namespace
 
 int main(int argc, char** argv) {
@@ -312,6 +406,7 @@ int main(int argc, char** argv) {
   // initArrayModeBenchmarkParams(params);
   initNormalizedKeyModeBenchmarkParams(params);
   initHashModeBenchmarkParams(params);
+  initRadixModeBenchmarkParams(params);
 
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm]() {
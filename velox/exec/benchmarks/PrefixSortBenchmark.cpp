@@ -320,6 +320,36 @@ class PrefixSortBenchmark {
         "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
   }
 
+  void smallVarchar() {
+    const auto iterations = 100'000;
+    const std::vector<vector_size_t> batchSizes = {10, 50, 100, 500};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({VARCHAR()}),
+        ROW({BIGINT(), VARCHAR()}),
+    };
+    std::vector<int> numKeys = {1, 2};
+    benchmark(
+        "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
+  }
+
+  void largeLongDecimal() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        1'000, 10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({DECIMAL(38, 2)}),
+        ROW({DECIMAL(38, 2), DECIMAL(38, 2)}),
+    };
+    std::vector<int> numKeys = {1, 2};
+    benchmark(
+        "no-payloads",
+        "long-decimal",
+        batchSizes,
+        rowTypes,
+        numKeys,
+        iterations);
+  }
+
   void smallint(
       bool noPayload,
       int numIterations,
@@ -383,6 +413,8 @@ int main(int argc, char** argv) {
   bm.largeBigintWithPayloads();
   bm.smallBigintWithPayload();
   bm.largeVarchar();
+  bm.smallVarchar();
+  bm.largeLongDecimal();
   bm.smallSmallint();
   bm.largeSmallint();
   bm.smallSmallintWithPayload();
@@ -70,6 +70,12 @@ DEFINE_uint64(
 
 DEFINE_bool(enable_checksum, true, "Enable checksum write to SSD.");
 
+DEFINE_string(
+    eviction_policy,
+    "",
+    "Eviction policy of the memory cache: 'RecencyFrequency' or 'TinyLfu'. "
+    "If empty, a random policy is used in each iteration.");
+
 DEFINE_bool(
     enable_checksum_read_verification,
     true,
@@ -209,10 +215,26 @@ void CacheFuzzer::initializeCache() {
   memoryManager_ = std::make_unique<memory::MemoryManager>(options);
 
   // TODO: Test different ssd write behaviors with AsyncDataCache::Options.
+  AsyncDataCache::Options cacheOptions;
+  const bool tinyLfu = FLAGS_eviction_policy.empty()
+      ? folly::Random::oneIn(2, rng_)
+      : FLAGS_eviction_policy == "TinyLfu";
+  VELOX_CHECK(
+      tinyLfu || FLAGS_eviction_policy.empty() ||
+          FLAGS_eviction_policy == "RecencyFrequency",
+      "Unknown eviction policy: {}",
+      FLAGS_eviction_policy);
+  if (tinyLfu) {
+    cacheOptions.evictionPolicyFactory = []() {
+      return std::make_unique<TinyLfuEvictionPolicy>();
+    };
+  }
+  LOG(INFO) << "Eviction policy: "
+            << (tinyLfu ? "TinyLfu" : "RecencyFrequency");
   cache_ = AsyncDataCache::create(
       dynamic_cast<memory::MmapAllocator*>(memoryManager_->allocator()),
       std::move(ssdCache),
-      {});
+      cacheOptions);
 }
 
 void CacheFuzzer::initializeInputs() {
@@ -344,7 +366,13 @@ void CacheFuzzer::go() {
 
     // TODO: Test cache restart.
 
-    LOG(INFO) << cache_->refreshStats().toString();
+    const auto stats = cache_->refreshStats();
+    LOG(INFO) << stats.toString();
+    LOG(INFO) << "Memory cache hit rate: "
+              << (stats.numHit + stats.numNew == 0
+                      ? 0
+                      : 100.0 * stats.numHit / (stats.numHit + stats.numNew))
+              << "%";
 
     reset();
 
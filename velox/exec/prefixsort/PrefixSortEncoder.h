@@ -22,6 +22,8 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/HugeInt.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +36,8 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, int128_t, float, double, Timestamp). Strings are encoded by the
+  /// overload below.
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -54,10 +57,44 @@ class PrefixSortEncoder {
   }
 
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
-  /// int32_t, int16_t, uint16_t, float, double, Timestamp.
+  /// int32_t, int16_t, uint16_t, int128_t, float, double, Timestamp.
   template <typename T>
   FOLLY_ALWAYS_INLINE void encodeNoNulls(T value, char* dest) const;
 
+  /// Encodes the first 'prefixLength' bytes of a string. The null byte is
+  /// encoded as for the fixed width types and is followed by 'prefixLength'
+  /// bytes.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t prefixLength) const {
+    if (value.has_value()) {
+      dest[0] = nullsFirst_ ? 1 : 0;
+      encodeNoNulls(value.value(), dest + 1, prefixLength);
+    } else {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixLength);
+    }
+  }
+
+  /// Copies the first 'prefixLength' bytes of 'value' to 'dest' and pads
+  /// shorter values with zeros. Unsigned byte-wise comparison of the result
+  /// gives the order of the values except that a value and its extensions by
+  /// trailing zeros compare equal, as do values that differ only after
+  /// 'prefixLength' bytes. The caller must compare full values to break ties.
+  /// Bits are inverted for descending order.
+  FOLLY_ALWAYS_INLINE void
+  encodeNoNulls(StringView value, char* dest, uint32_t prefixLength) const {
+    const auto size = std::min<uint32_t>(value.size(), prefixLength);
+    std::memcpy(dest, value.data(), size);
+    simd::memset(dest + size, 0, prefixLength - size);
+    if (!ascending_) {
+      for (auto i = 0; i < prefixLength; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   bool isAscending() const {
     return ascending_;
   }
@@ -89,6 +126,26 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::HUGEINT: {
+        return 17;
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+
+  /// @return For VARCHAR and VARBINARY, returns the encoded size of a prefix
+  /// of 'prefixLength' bytes, assume nullable. For other types, returns
+  /// 'std::nullopt'.
+  FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedPrefixSize(
+      TypeKind typeKind,
+      uint32_t prefixLength) {
+    switch (typeKind) {
+      case ::facebook::velox::TypeKind::VARCHAR:
+        [[fallthrough]];
+      case ::facebook::velox::TypeKind::VARBINARY: {
+        return 1 + prefixLength;
+      }
       default:
         return std::nullopt;
     }
@@ -240,6 +297,16 @@ FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
   encodeNoNulls(detail::encodeFloat(value), dest);
 }
 
+/// Same as int64_t for the upper 64 bits, followed by the lower 64 bits as
+/// an unsigned integer.
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    int128_t value,
+    char* dest) const {
+  encodeNoNulls(static_cast<int64_t>(HugeInt::upper(value)), dest);
+  encodeNoNulls(HugeInt::lower(value), dest + 8);
+}
+
 /// When comparing Timestamp, first compare seconds and then compare nanos, so
 /// when encoding, just encode seconds and nanos in sequence.
 template <>
@@ -336,6 +336,96 @@ TEST_F(PrefixEncoderTest, encode) {
     descExpected[1] = 0xbbccddeeffffffff;
     testEncode<Timestamp>(value, (char*)ascExpected, (char*)descExpected);
   }
+
+  {
+    int128_t value = HugeInt::build(0x1122334455667788, 0x1122334455667788);
+    uint64_t ascExpected[2];
+    uint64_t descExpected[2];
+    ascExpected[0] = 0x8877665544332291;
+    ascExpected[1] = 0x8877665544332211;
+    descExpected[0] = 0x778899aabbccdd6e;
+    descExpected[1] = 0x778899aabbccddee;
+    testEncode<int128_t>(value, (char*)ascExpected, (char*)descExpected);
+  }
+}
+
+TEST_F(PrefixEncoderTest, encodeString) {
+  constexpr uint32_t kPrefixLength = 6;
+  char encoded[kPrefixLength + 1];
+
+  // Short values are padded with zeros.
+  ascNullsFirstEncoder_.encode(
+      std::optional<StringView>("abc"), encoded, kPrefixLength);
+  ASSERT_EQ(std::memcmp(encoded, "\1abc\0\0\0", kPrefixLength + 1), 0);
+
+  // Long values are truncated.
+  ascNullsLastEncoder_.encode(
+      std::optional<StringView>("abcdefghijklmn"), encoded, kPrefixLength);
+  ASSERT_EQ(std::memcmp(encoded, "\0abcdef", kPrefixLength + 1), 0);
+
+  // Bits are inverted for descending order.
+  descNullsFirstEncoder_.encode(
+      std::optional<StringView>("abc"), encoded, kPrefixLength);
+  ASSERT_EQ(encoded[0], 1);
+  for (auto i = 0; i < kPrefixLength; ++i) {
+    ASSERT_EQ(encoded[i + 1], (char)~("abc\0\0\0"[i]));
+  }
+
+  descNullsLastEncoder_.encode(
+      std::optional<StringView>(std::nullopt), encoded, kPrefixLength);
+  ASSERT_EQ(std::memcmp(encoded, "\1\0\0\0\0\0\0", kPrefixLength + 1), 0);
+}
+
+TEST_F(PrefixEncoderTest, compareString) {
+  constexpr uint32_t kPrefixLength = 12;
+  const std::vector<std::string> values = {
+      "",
+      std::string("\0", 1),
+      "a",
+      "aa",
+      "ab",
+      "abcdefghijkl",
+      "abcdefghijklm",
+      "b",
+      "\xff\xff"};
+  char leftEncoded[kPrefixLength + 1];
+  char rightEncoded[kPrefixLength + 1];
+
+  auto compare = [&](const PrefixSortEncoder& encoder,
+                     const std::optional<StringView>& left,
+                     const std::optional<StringView>& right) {
+    encoder.encode(left, leftEncoded, kPrefixLength);
+    encoder.encode(right, rightEncoded, kPrefixLength);
+    return std::memcmp(leftEncoded, rightEncoded, kPrefixLength + 1);
+  };
+
+  for (auto i = 0; i < values.size(); ++i) {
+    for (auto j = 0; j < values.size(); ++j) {
+      SCOPED_TRACE(fmt::format("{} vs {}", i, j));
+      const StringView left(values[i]);
+      const StringView right(values[j]);
+      const auto expected = left.compare(right);
+      // The prefix encoding never contradicts the order of the full values
+      // but may consider different values equal.
+      const auto asc = compare(ascNullsFirstEncoder_, left, right);
+      ASSERT_TRUE(asc == 0 || (asc < 0) == (expected < 0));
+      const auto desc = compare(descNullsLastEncoder_, left, right);
+      ASSERT_TRUE(desc == 0 || (desc < 0) == (expected > 0));
+      if (values[i].size() <= kPrefixLength &&
+          values[j].size() <= kPrefixLength &&
+          values[i].find('\0') == std::string::npos &&
+          values[j].find('\0') == std::string::npos) {
+        ASSERT_EQ(asc < 0, expected < 0);
+        ASSERT_EQ(asc == 0, expected == 0);
+      }
+    }
+    // Nulls.
+    const StringView value(values[i]);
+    ASSERT_LT(compare(ascNullsFirstEncoder_, std::nullopt, value), 0);
+    ASSERT_GT(compare(ascNullsLastEncoder_, std::nullopt, value), 0);
+    ASSERT_LT(compare(descNullsFirstEncoder_, std::nullopt, value), 0);
+    ASSERT_GT(compare(descNullsLastEncoder_, std::nullopt, value), 0);
+  }
 }
 
 TEST_F(PrefixEncoderTest, compare) {
@@ -348,6 +438,7 @@ TEST_F(PrefixEncoderTest, compare) {
   testCompare<float>();
   testCompare<double>();
   testCompare<Timestamp>();
+  testCompare<int128_t>();
 }
 
 TEST_F(PrefixEncoderTest, fuzzySmallInt) {
@@ -374,4 +465,8 @@ TEST_F(PrefixEncoderTest, fuzzyTimestamp) {
   testFuzz<TypeKind::TIMESTAMP>();
 }
 
+TEST_F(PrefixEncoderTest, fuzzyHugeint) {
+  testFuzz<TypeKind::HUGEINT>();
+}
+
 } // namespace facebook::velox::exec::prefixsort::test
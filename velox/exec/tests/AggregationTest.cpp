@@ -955,6 +955,151 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationSampling) {
+  constexpr int32_t kSampleRows = 2'000;
+  // Unique keys make partial aggregation non-reducing. Keys that repeat every
+  // 10 rows make it reducing.
+  std::vector<RowVectorPtr> uniqueVectors;
+  std::vector<RowVectorPtr> repeatedVectors;
+  for (auto i = 0; i < 10; ++i) {
+    uniqueVectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return i * 1'000 + row; })}));
+    repeatedVectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; })}));
+  }
+
+  const auto runQuery = [&](const std::vector<RowVectorPtr>& vectors,
+                            int32_t sampleRows) {
+    createDuckDbTable(vectors);
+    core::PlanNodeId partialAggId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .partialAggregation({"c0"}, {"count(1)"})
+                    .capturePlanNodeId(partialAggId)
+                    .finalAggregation()
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        QueryConfig::kAbandonPartialAggregationSampleRows,
+                        sampleRows)
+                    .config(QueryConfig::kAbandonPartialAggregationMinPct, 80)
+                    .config("max_drivers_per_task", 1)
+                    .assertResults("SELECT c0, count(1) FROM tmp GROUP BY c0");
+    return toPlanStats(task->taskStats()).at(partialAggId).customStats;
+  };
+
+  // The estimate abandons partial aggregation before building a hash table,
+  // so that there is no flush.
+  auto stats = runQuery(uniqueVectors, kSampleRows);
+  ASSERT_EQ(1, stats.count("estimatedPartialAggregationPct"));
+  EXPECT_LE(90, stats.at("estimatedPartialAggregationPct").sum);
+  ASSERT_EQ(1, stats.count("abandonedPartialAggregation"));
+  EXPECT_EQ(0, stats.count("flushRowCount"));
+
+  // The estimate keeps partial aggregation.
+  stats = runQuery(repeatedVectors, kSampleRows);
+  ASSERT_EQ(1, stats.count("estimatedPartialAggregationPct"));
+  EXPECT_GE(1, stats.at("estimatedPartialAggregationPct").sum);
+  EXPECT_EQ(0, stats.count("abandonedPartialAggregation"));
+
+  // The input ends before the sample is complete.
+  stats = runQuery(uniqueVectors, 100'000);
+  EXPECT_EQ(0, stats.count("estimatedPartialAggregationPct"));
+  EXPECT_EQ(0, stats.count("abandonedPartialAggregation"));
+
+  // No sampling by default.
+  stats = runQuery(uniqueVectors, 0);
+  EXPECT_EQ(0, stats.count("estimatedPartialAggregationPct"));
+}
+
+TEST_F(AggregationTest, denseInput) {
+  // Few distinct keys make the hash table use array mode and repeat each group
+  // many times per batch, so that sum, count, min and max combine the input of
+  // each group before updating the group rows.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; }),
+        makeFlatVector<int64_t>(
+            1'000,
+            [i](auto row) { return i * 1'000 + row; },
+            [](auto row) { return row % 11 == 0; }),
+        makeFlatVector<double>(1'000, [](auto row) { return row % 100 * 0.5; }),
+        makeFlatVector<bool>(1'000, [](auto row) { return row % 3 == 0; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)",
+                       "count(c1)",
+                       "count(1)",
+                       "min(c1)",
+                       "max(c2)",
+                       "sum(c2)",
+                       "sum(c1)"},
+                      {"", "", "", "", "", "", "c3"})
+                  .capturePlanNodeId(aggId)
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config("max_drivers_per_task", 1)
+          .assertResults(
+              "SELECT c0, sum(c1), count(c1), count(1), min(c1), max(c2), "
+              "sum(c2), sum(c1) FILTER (WHERE c3) FROM tmp GROUP BY c0");
+  auto stats = toPlanStats(task->taskStats()).at(aggId).customStats;
+  ASSERT_EQ(1, stats.count("denseInputBatches"));
+  EXPECT_LT(0, stats.at("denseInputBatches").max);
+
+  // Unique keys do not repeat within a batch and take the regular path.
+  std::vector<RowVectorPtr> uniqueVectors;
+  for (const auto& vector : vectors) {
+    uniqueVectors.push_back(
+        makeRowVector({vector->childAt(1), vector->childAt(2)}));
+  }
+  createDuckDbTable(uniqueVectors);
+  plan = PlanBuilder()
+             .values(uniqueVectors)
+             .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+             .capturePlanNodeId(aggId)
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config("max_drivers_per_task", 1)
+             .assertResults(
+                 "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+  stats = toPlanStats(task->taskStats()).at(aggId).customStats;
+  EXPECT_EQ(0, stats.count("denseInputBatches"));
+
+  // The first batch has only new groups and the second repeats none of them.
+  // The batch after the second one is added without the pre-pass, and the
+  // remaining 7 batches, which repeat their groups, are pre-aggregated.
+  std::vector<RowVectorPtr> mixedVectors;
+  for (auto i = 0; i < 10; ++i) {
+    mixedVectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return i < 2 ? row : row % 7; }),
+        makeFlatVector<int64_t>(1'000, [i](auto row) { return i + row; }),
+    }));
+  }
+  createDuckDbTable(mixedVectors);
+  plan = PlanBuilder()
+             .values(mixedVectors)
+             .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+             .capturePlanNodeId(aggId)
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config("max_drivers_per_task", 1)
+             .assertResults(
+                 "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+  stats = toPlanStats(task->taskStats()).at(aggId).customStats;
+  ASSERT_EQ(1, stats.count("denseInputBatches"));
+  EXPECT_EQ(7, stats.at("denseInputBatches").max);
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
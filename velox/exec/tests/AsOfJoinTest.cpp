@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class AsOfJoinTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    for (auto i = 0; i < 3; ++i) {
+      leftVectors_.push_back(makeRowVector(
+          {"t0", "t1", "t2"},
+          {makeFlatVector<int64_t>(
+               100,
+               [i](auto row) { return (row * 7 + i) % 12; },
+               nullEvery(31)),
+           makeFlatVector<int32_t>(
+               100,
+               [i](auto row) { return (row * 11 + i) % 110 - 5; },
+               nullEvery(17)),
+           makeFlatVector<int32_t>(
+               100, [i](auto row) { return (row * 13 + i) % 260 - 5; })}));
+    }
+    // (u0, u1) and u2 are unique, so that the nearest match is unique.
+    for (auto i = 0; i < 3; ++i) {
+      rightVectors_.push_back(makeRowVector(
+          {"u0", "u1", "u2"},
+          {makeFlatVector<int64_t>(
+               80, [i](auto row) { return (i * 80 + row) % 10; }),
+           makeFlatVector<int32_t>(
+               80,
+               [i](auto row) {
+                 const auto n = i * 80 + row;
+                 return n / 10 * 4 + n % 3;
+               },
+               nullEvery(23)),
+           makeFlatVector<int32_t>(
+               80, [i](auto row) { return i * 80 + row; })}));
+    }
+    createDuckDbTable("t", leftVectors_);
+    createDuckDbTable("u", rightVectors_);
+  }
+
+  // Returns a plan that sorts both inputs and joins them.
+  core::PlanNodePtr makePlan(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const std::string& matchCondition,
+      core::JoinType joinType,
+      const std::string& leftFilter = "true") {
+    auto leftSortKeys = leftKeys;
+    leftSortKeys.push_back(matchColumn(matchCondition, true));
+    auto rightSortKeys = rightKeys;
+    rightSortKeys.push_back(matchColumn(matchCondition, false));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(leftVectors_)
+        .filter(leftFilter)
+        .orderBy(leftSortKeys, false)
+        .asOfJoin(
+            leftKeys,
+            rightKeys,
+            PlanBuilder(planNodeIdGenerator)
+                .values(rightVectors_)
+                .orderBy(rightSortKeys, false)
+                .planNode(),
+            matchCondition,
+            {"t0", "t1", "t2", "u0", "u1", "u2"},
+            joinType)
+        .planNode();
+  }
+
+  // Returns the left or right column of a condition like "t1 >= u1".
+  static std::string matchColumn(const std::string& condition, bool left) {
+    std::vector<std::string> parts;
+    folly::split(' ', condition, parts);
+    return left ? parts[0] : parts[2];
+  }
+
+  // Returns the DuckDB query finding the nearest match with a correlated
+  // subquery.
+  static std::string makeSql(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const std::string& matchCondition,
+      core::JoinType joinType) {
+    const auto leftColumn = matchColumn(matchCondition, true);
+    const auto rightColumn = matchColumn(matchCondition, false);
+    const auto op = matchCondition.substr(
+        leftColumn.size() + 1,
+        matchCondition.size() - leftColumn.size() - rightColumn.size() - 2);
+    const auto* aggregate = (op[0] == '>') ? "max" : "min";
+
+    std::vector<std::string> clauses;
+    for (auto i = 0; i < leftKeys.size(); ++i) {
+      clauses.push_back(fmt::format("{} = {}", leftKeys[i], rightKeys[i]));
+    }
+    auto subqueryClauses = clauses;
+    subqueryClauses.push_back(matchCondition);
+    clauses.push_back(fmt::format("nearest = {}", rightColumn));
+
+    return fmt::format(
+        "WITH tn AS (SELECT *, (SELECT {}({}) FROM u WHERE {}) AS nearest "
+        "FROM t) SELECT t0, t1, t2, u0, u1, u2 FROM tn {} JOIN u ON {}",
+        aggregate,
+        rightColumn,
+        folly::join(" AND ", subqueryClauses),
+        core::joinTypeName(joinType),
+        folly::join(" AND ", clauses));
+  }
+
+  void runTest(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const std::string& matchCondition,
+      core::JoinType joinType = core::JoinType::kInner) {
+    const auto sql = makeSql(leftKeys, rightKeys, matchCondition, joinType);
+    for (const auto batchSize : {1'000, 7}) {
+      SCOPED_TRACE(fmt::format("{}, batchSize: {}", sql, batchSize));
+      AssertQueryBuilder(
+          makePlan(leftKeys, rightKeys, matchCondition, joinType),
+          duckDbQueryRunner_)
+          .config(
+              core::QueryConfig::kPreferredOutputBatchRows,
+              std::to_string(batchSize))
+          .assertResults(sql);
+    }
+  }
+
+  std::vector<RowVectorPtr> leftVectors_;
+  std::vector<RowVectorPtr> rightVectors_;
+};
+
+TEST_F(AsOfJoinTest, basic) {
+  for (const auto* op : {">=", ">", "<=", "<"}) {
+    runTest({"t0"}, {"u0"}, fmt::format("t1 {} u1", op));
+  }
+}
+
+TEST_F(AsOfJoinTest, leftJoin) {
+  for (const auto* op : {">=", ">", "<=", "<"}) {
+    runTest({"t0"}, {"u0"}, fmt::format("t1 {} u1", op), core::JoinType::kLeft);
+  }
+}
+
+TEST_F(AsOfJoinTest, noKeys) {
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    runTest({}, {}, "t2 >= u2", joinType);
+    runTest({}, {}, "t2 < u2", joinType);
+  }
+}
+
+TEST_F(AsOfJoinTest, emptyRight) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(leftVectors_)
+                  .orderBy({"t0", "t1"}, false)
+                  .asOfJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(rightVectors_)
+                          .filter("u0 < 0")
+                          .planNode(),
+                      "t1 >= u1",
+                      {"t0", "u0"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT t0, null FROM t");
+}
+
+TEST_F(AsOfJoinTest, leftFinishesFirst) {
+  // The join finishes before consuming all of the right side.
+  auto plan = makePlan(
+      {"t0"}, {"u0"}, "t1 <= u1", core::JoinType::kInner, "t0 < 2");
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(fmt::format(
+          "{} WHERE t0 < 2",
+          makeSql({"t0"}, {"u0"}, "t1 <= u1", core::JoinType::kInner)));
+}
+
+TEST_F(AsOfJoinTest, invalidNode) {
+  auto right = PlanBuilder().values(rightVectors_).planNode();
+  VELOX_ASSERT_USER_THROW(
+      PlanBuilder()
+          .values(leftVectors_)
+          .asOfJoin(
+              {"t0"}, {"u0"}, right, "t1 >= u1", {"t0"}, core::JoinType::kFull),
+      "The join type is not supported by AS OF join");
+  VELOX_ASSERT_USER_THROW(
+      PlanBuilder()
+          .values(leftVectors_)
+          .asOfJoin({"t0"}, {"u1"}, right, "t1 >= u1", {"t0"}),
+      "AS OF join column types on both sides must match");
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableCache.h"
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class HashTableCacheTest : public OperatorTestBase {
+ protected:
+  std::unique_ptr<BaseHashTable> makeTable(memory::MemoryPool* pool) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(VectorHasher::create(BIGINT(), 0));
+    return HashTable<true>::createForJoin(
+        std::move(hashers), {}, true, false, 1'000, pool);
+  }
+
+  core::PlanNodePtr makePlan(
+      const std::string& cacheKey,
+      const std::vector<RowVectorPtr>& probe,
+      const std::vector<RowVectorPtr>& build,
+      core::PlanNodeId& joinId) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probe)
+        .hashJoin(
+            {"c0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator).values(build).planNode(),
+            "",
+            {"c0", "c1", "u1"},
+            core::JoinType::kInner,
+            false,
+            cacheKey)
+        .capturePlanNodeId(joinId)
+        .planNode();
+  }
+};
+
+TEST_F(HashTableCacheTest, entry) {
+  auto& cache = HashTableCache::instance();
+  const std::string key = "entry";
+
+  auto entry = cache.get(key, "t1");
+  ASSERT_TRUE(entry->isBuilder("t1"));
+  auto other = cache.get(key, "t2");
+  ASSERT_EQ(other, entry);
+  ASSERT_FALSE(other->isBuilder("t2"));
+
+  ContinueFuture future;
+  ASSERT_FALSE(other->tableOrFuture(&future).has_value());
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+
+  auto table = entry->setTable(makeTable(entry->pool()), false);
+  ASSERT_TRUE(future.isReady());
+  VELOX_ASSERT_THROW(
+      entry->setTable(makeTable(entry->pool()), false), "already set");
+
+  ContinueFuture unused;
+  auto result = other->tableOrFuture(&unused);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->table, table);
+  ASSERT_FALSE(result->hasNullKeys);
+
+  // The table outlives the references to the entry.
+  const auto numEntries = cache.size();
+  entry.reset();
+  other.reset();
+  ASSERT_EQ(cache.size(), numEntries);
+  table.reset();
+  result.reset();
+  ASSERT_EQ(cache.size(), numEntries - 1);
+
+  // The last release frees the table, the next task builds a new one.
+  entry = cache.get(key, "t3");
+  ASSERT_TRUE(entry->isBuilder("t3"));
+}
+
+TEST_F(HashTableCacheTest, abort) {
+  auto& cache = HashTableCache::instance();
+  const std::string key = "abort";
+
+  auto entry = cache.get(key, "t1");
+  auto other = cache.get(key, "t2");
+  ContinueFuture future;
+  ASSERT_FALSE(other->tableOrFuture(&future).has_value());
+
+  entry->abort();
+  ASSERT_TRUE(future.isReady());
+  ContinueFuture noFuture;
+  ASSERT_FALSE(other->tableOrFuture(&noFuture).has_value());
+  ASSERT_FALSE(noFuture.valid());
+
+  // An aborted entry is replaced.
+  auto next = cache.get(key, "t3");
+  ASSERT_NE(next, entry);
+  ASSERT_TRUE(next->isBuilder("t3"));
+}
+
+TEST_F(HashTableCacheTest, join) {
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row * 10; })});
+  std::vector<RowVectorPtr> probe;
+  for (auto i = 0; i < 4; ++i) {
+    probe.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(50, [&](auto row) { return row * 3 + i; }),
+         makeFlatVector<int64_t>(50, [](auto row) { return row; })}));
+  }
+  createDuckDbTable("t", probe);
+  createDuckDbTable("u", {build});
+  const std::string sql =
+      "SELECT t.c0, t.c1, u.u1 FROM t, u WHERE t.c0 = u.u0";
+
+  const std::string key = "join";
+  core::PlanNodeId joinId;
+  const auto plan = makePlan(key, probe, {build}, joinId);
+
+  // Runs the first query until it has produced its first batch. Its table is
+  // then built and in use.
+  CursorParameters params;
+  params.planNode = plan;
+  params.serialExecution = true;
+  auto cursor = TaskCursor::create(params);
+  ASSERT_TRUE(cursor->moveNext());
+  std::vector<RowVectorPtr> firstResults{cursor->current()};
+  auto entry = HashTableCache::instance().get(key, "other");
+  ASSERT_FALSE(entry->isBuilder("other"));
+  entry.reset();
+
+  // The second query reuses the table of the first one.
+  core::PlanNodeId secondJoinId;
+  auto task = AssertQueryBuilder(
+                  makePlan(key, probe, {build}, secondJoinId),
+                  duckDbQueryRunner_)
+                  .assertResults(sql);
+  auto stats = toPlanStats(task->taskStats()).at(secondJoinId).customStats;
+  ASSERT_EQ(stats.at("hashTableCacheHit").sum, 1);
+  ASSERT_EQ(stats.count("hashTableCacheBuild"), 0);
+
+  while (cursor->moveNext()) {
+    firstResults.push_back(cursor->current());
+  }
+  assertResults(
+      firstResults, asRowType(plan->outputType()), sql, duckDbQueryRunner_);
+  stats = toPlanStats(cursor->task()->taskStats()).at(joinId).customStats;
+  ASSERT_EQ(stats.at("hashTableCacheBuild").sum, 1);
+  ASSERT_EQ(stats.count("hashTableCacheHit"), 0);
+}
+
+TEST_F(HashTableCacheTest, sameEntryPerTask) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2})});
+  CursorParameters params;
+  params.planNode = PlanBuilder().values({data}).planNode();
+  auto cursor = TaskCursor::create(params);
+  const auto& task = cursor->task();
+
+  // The first driver of the task to look up the entry is not its builder. The
+  // builder aborts and a later driver of the same task gets the same aborted
+  // entry instead of a new one, so that all of them build their own tables.
+  const std::string key = "sameEntryPerTask";
+  auto builderEntry = HashTableCache::instance().get(key, "builder");
+  auto bridge = std::make_shared<HashJoinBridge>();
+  auto entry = bridge->hashTableCacheEntry(key, task);
+  ASSERT_EQ(entry, builderEntry);
+  builderEntry->abort();
+  ASSERT_EQ(bridge->hashTableCacheEntry(key, task), entry);
+  ASSERT_TRUE(entry->aborted());
+
+  // Another task gets a new entry.
+  auto otherBridge = std::make_shared<HashJoinBridge>();
+  ASSERT_NE(otherBridge->hashTableCacheEntry(key, task), entry);
+}
+
+TEST_F(HashTableCacheTest, arbitratorAbort) {
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row * 10; })});
+  std::vector<RowVectorPtr> probe;
+  for (auto i = 0; i < 4; ++i) {
+    probe.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(50, [&](auto row) { return row * 3 + i; }),
+         makeFlatVector<int64_t>(50, [](auto row) { return row; })}));
+  }
+
+  const std::string key = "arbitratorAbort";
+  core::PlanNodeId joinId;
+  CursorParameters params;
+  params.planNode = makePlan(key, probe, {build}, joinId);
+  params.serialExecution = true;
+  auto cursor = TaskCursor::create(params);
+  ASSERT_TRUE(cursor->moveNext());
+
+  // The table pool has nothing to reclaim. Aborting it fails the task using
+  // the table.
+  auto entry = HashTableCache::instance().get(key, "other");
+  ASSERT_FALSE(entry->isBuilder("other"));
+  auto* rootPool = entry->pool()->root();
+  ASSERT_NE(rootPool->reclaimer(), nullptr);
+  ASSERT_FALSE(rootPool->reclaimableBytes().has_value());
+  try {
+    VELOX_MEM_POOL_ABORTED("Aborted the cached hash table");
+  } catch (const VeloxRuntimeError&) {
+    rootPool->abort(std::current_exception());
+  }
+  ASSERT_TRUE(entry->aborted());
+  ASSERT_FALSE(cursor->moveNext());
+  ASSERT_NE(cursor->task()->error(), nullptr);
+  VELOX_ASSERT_THROW(
+      std::rethrow_exception(cursor->task()->error()),
+      "Aborted the cached hash table");
+
+  // The next task builds a new table.
+  entry = HashTableCache::instance().get(key, "next");
+  ASSERT_TRUE(entry->isBuilder("next"));
+}
+
+TEST_F(HashTableCacheTest, unsupportedJoinType) {
+  auto data = makeRowVector({"c0"}, {makeFlatVector<int64_t>({1, 2})});
+  auto build = makeRowVector({"u0"}, {makeFlatVector<int64_t>({1, 2})});
+  VELOX_ASSERT_USER_THROW(
+      PlanBuilder()
+          .values({data})
+          .hashJoin(
+              {"c0"},
+              {"u0"},
+              PlanBuilder().values({build}).planNode(),
+              "",
+              {"c0", "u0"},
+              core::JoinType::kFull,
+              false,
+              "key"),
+      "Hash table cache is supported only for");
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -156,6 +156,7 @@ class HashTableTest : public testing::TestWithParam<bool>,
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
+    topTable_->setRadixPartitionBytes(radixPartitionBytes_);
     topTable_->prepareJoinTable(
         std::move(otherTables),
         BaseHashTable::kNoSpillInputStartPartitionBit,
@@ -164,6 +165,11 @@ class HashTableTest : public testing::TestWithParam<bool>,
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
     ASSERT_EQ(topTable_->hashMode(), mode);
+    if (radixPartitionBytes_ > 0) {
+      ASSERT_EQ(
+          topTable_->stats().numRadixPartitions,
+          topTable_->capacity() * sizeof(char*) / radixPartitionBytes_);
+    }
     ASSERT_EQ(topTable_->allRows().size(), numWays);
     uint64_t rowCount{0};
     for (auto* rowContainer : topTable_->allRows()) {
@@ -579,6 +585,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // Target size of the radix partitions of the join table. 0 if not radix
+  // partitioned.
+  uint64_t radixPartitionBytes_ = 0;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -631,6 +640,22 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, radixPartitionedNormalized) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  radixPartitionBytes_ = 64 << 10;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedHash) {
+  auto type =
+      ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), ROW({"s1"}, {BIGINT()})});
+  keySpacing_ = 1000;
+  radixPartitionBytes_ = 64 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 3);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class IEJoinTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    for (auto i = 0; i < 4; ++i) {
+      probeVectors_.push_back(makeRowVector(
+          {"t0", "t1", "t2"},
+          {makeFlatVector<int64_t>(
+               100, [i](auto row) { return (row * 7 + i) % 13; }),
+           makeFlatVector<int32_t>(
+               100,
+               [i](auto row) { return (row * 11 + i) % 97; },
+               nullEvery(17)),
+           makeFlatVector<int32_t>(
+               100, [i](auto row) { return (row * 3 + i * 5) % 89; })}));
+      buildVectors_.push_back(makeRowVector(
+          {"u0", "u1", "u2"},
+          {makeFlatVector<int64_t>(
+               60, [i](auto row) { return (row * 5 + i) % 11; }),
+           makeFlatVector<int32_t>(
+               60,
+               [i](auto row) { return (row * 13 + i * 3) % 101; },
+               nullEvery(19)),
+           makeFlatVector<int32_t>(
+               60, [i](auto row) { return (row * 17 + i) % 83; })}));
+    }
+    createDuckDbTable("t", probeVectors_);
+    createDuckDbTable("u", buildVectors_);
+  }
+
+  core::PlanNodePtr makePlan(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const std::vector<std::string>& conditions,
+      core::JoinType joinType,
+      core::PlanNodeId& joinNodeId) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probeVectors_)
+        .localPartition({"t0"})
+        .ieJoin(
+            leftKeys,
+            rightKeys,
+            PlanBuilder(planNodeIdGenerator)
+                .values(buildVectors_)
+                .localPartition({"u0"})
+                .planNode(),
+            conditions,
+            {"t0", "t1", "t2", "u0", "u1", "u2"},
+            joinType)
+        .capturePlanNodeId(joinNodeId)
+        .planNode();
+  }
+
+  void runTest(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const std::vector<std::string>& conditions,
+      core::JoinType joinType = core::JoinType::kInner) {
+    std::vector<std::string> clauses;
+    for (auto i = 0; i < leftKeys.size(); ++i) {
+      clauses.push_back(fmt::format("{} = {}", leftKeys[i], rightKeys[i]));
+    }
+    clauses.insert(clauses.end(), conditions.begin(), conditions.end());
+    const auto sql = fmt::format(
+        "SELECT t0, t1, t2, u0, u1, u2 FROM t {} JOIN u ON {}",
+        core::joinTypeName(joinType),
+        folly::join(" AND ", clauses));
+
+    for (const auto numDrivers : {1, 4}) {
+      for (const auto batchSize : {1'000, 7}) {
+        SCOPED_TRACE(fmt::format(
+            "{}, numDrivers: {}, batchSize: {}", sql, numDrivers, batchSize));
+        core::PlanNodeId joinNodeId;
+        AssertQueryBuilder(
+            makePlan(leftKeys, rightKeys, conditions, joinType, joinNodeId),
+            duckDbQueryRunner_)
+            .maxDrivers(numDrivers)
+            .config(
+                core::QueryConfig::kPreferredOutputBatchRows,
+                std::to_string(batchSize))
+            .assertResults(sql);
+      }
+    }
+  }
+
+  std::vector<RowVectorPtr> probeVectors_;
+  std::vector<RowVectorPtr> buildVectors_;
+};
+
+TEST_F(IEJoinTest, singleCondition) {
+  for (const auto* op : {"<", "<=", ">", ">="}) {
+    runTest({}, {}, {fmt::format("t1 {} u1", op)});
+  }
+}
+
+TEST_F(IEJoinTest, twoConditions) {
+  for (const auto* xOp : {"<", "<=", ">", ">="}) {
+    for (const auto* yOp : {"<", "<=", ">", ">="}) {
+      runTest(
+          {},
+          {},
+          {fmt::format("t1 {} u1", xOp), fmt::format("t2 {} u2", yOp)});
+    }
+  }
+}
+
+TEST_F(IEJoinTest, band) {
+  runTest({}, {}, {"t2 >= u1", "t2 <= u2"});
+}
+
+TEST_F(IEJoinTest, equalityKeys) {
+  runTest({"t0"}, {"u0"}, {"t1 < u1"});
+  runTest({"t0"}, {"u0"}, {"t1 >= u1", "t2 < u2"});
+}
+
+TEST_F(IEJoinTest, leftJoin) {
+  runTest({}, {}, {"t1 > u1"}, core::JoinType::kLeft);
+  runTest({"t0"}, {"u0"}, {"t1 <= u1", "t2 > u2"}, core::JoinType::kLeft);
+}
+
+TEST_F(IEJoinTest, emptyBuild) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors_)
+                  .ieJoin(
+                      {},
+                      {},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors_)
+                          .filter("u0 < 0")
+                          .planNode(),
+                      {"t1 < u1"},
+                      {"t0", "u0"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT t0, null FROM t");
+}
+
+TEST_F(IEJoinTest, spill) {
+  for (const auto& conditions : std::vector<std::vector<std::string>>{
+           {"t1 < u1"}, {"t1 >= u1", "t2 < u2"}}) {
+    SCOPED_TRACE(folly::join(" AND ", conditions));
+    const auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+
+    core::PlanNodeId joinNodeId;
+    auto task =
+        AssertQueryBuilder(
+            makePlan({}, {}, conditions, core::JoinType::kInner, joinNodeId),
+            duckDbQueryRunner_)
+            .maxDrivers(4)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kJoinSpillEnabled, true)
+            .assertResults(fmt::format(
+                "SELECT t0, t1, t2, u0, u1, u2 FROM t, u WHERE {}",
+                folly::join(" AND ", conditions)));
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& joinStats = planStats.at(joinNodeId);
+    ASSERT_GT(joinStats.spilledBytes, 0);
+    ASSERT_GT(joinStats.spilledFiles, 0);
+  }
+}
+
+// The probe operators release the spilled build rows they read and their index
+// under memory pressure, and rebuild them in the middle of a probe batch.
+TEST_F(IEJoinTest, reclaimSpilledBuild) {
+  for (const auto& conditions : std::vector<std::vector<std::string>>{
+           {"t1 < u1"}, {"t1 >= u1", "t2 < u2"}}) {
+    SCOPED_TRACE(folly::join(" AND ", conditions));
+    const auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+
+    std::atomic_int numReclaims{0};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::getOutput",
+        std::function<void(Operator*)>(([&](Operator* op) {
+          if (op->operatorType() != "IEJoinProbe") {
+            return;
+          }
+          uint64_t reclaimableBytes{0};
+          if (!op->reclaimableBytes(reclaimableBytes) ||
+              reclaimableBytes == 0) {
+            return;
+          }
+          ++numReclaims;
+          testingRunArbitration(op->pool(), 0);
+        })));
+
+    core::PlanNodeId joinNodeId;
+    AssertQueryBuilder(
+        makePlan({}, {}, conditions, core::JoinType::kInner, joinNodeId),
+        duckDbQueryRunner_)
+        .maxDrivers(4)
+        .spillDirectory(spillDirectory->getPath())
+        .config(core::QueryConfig::kSpillEnabled, true)
+        .config(core::QueryConfig::kJoinSpillEnabled, true)
+        .config(core::QueryConfig::kPreferredOutputBatchRows, 7)
+        .assertResults(fmt::format(
+            "SELECT t0, t1, t2, u0, u1, u2 FROM t, u WHERE {}",
+            folly::join(" AND ", conditions)));
+    ASSERT_GT(numReclaims, 0);
+  }
+}
+
+TEST_F(IEJoinTest, invalidNode) {
+  auto right = PlanBuilder().values(buildVectors_).planNode();
+  VELOX_ASSERT_USER_THROW(
+      PlanBuilder()
+          .values(probeVectors_)
+          .ieJoin(
+              {},
+              {},
+              right,
+              {"t1 < u1"},
+              {"t0", "u0"},
+              core::JoinType::kFull),
+      "The join type is not supported by IEJoin");
+  VELOX_ASSERT_USER_THROW(
+      PlanBuilder()
+          .values(probeVectors_)
+          .ieJoin(
+              {},
+              {},
+              right,
+              {"t1 < u1", "t2 < u2", "t0 < u0"},
+              {"t0", "u0"}),
+      "IEJoin must have one or two inequality conditions");
+  VELOX_ASSERT_USER_THROW(
+      PlanBuilder()
+          .values(probeVectors_)
+          .ieJoin({}, {}, right, {"t0 < u1"}, {"t0", "u0"}),
+      "IEJoin condition types on the left and right sides must match");
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <gtest/gtest.h>
+#include "velox/exec/ExchangeClient.h"
+#include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+class InProcessExchangeSourceTest : public testing::Test,
+                                    public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+    ExchangeSource::factories().clear();
+    ExchangeSource::registerFactory(InProcessExchangeSource::create);
+    if (!isRegisteredVectorSerde()) {
+      serializer::presto::PrestoVectorSerde::registerVectorSerde();
+    }
+    bufferManager_ = OutputBufferManager::getInstance().lock();
+  }
+
+  void TearDown() override {
+    ExchangeSource::factories().clear();
+    test::waitForAllTasksToBeDeleted();
+  }
+
+  std::unique_ptr<SerializedPage> toSerializedPage(const RowVectorPtr& vector) {
+    auto data = std::make_unique<VectorStreamGroup>(pool());
+    auto size = vector->size();
+    auto range = IndexRange{0, size};
+    data->createStreamTree(asRowType(vector->type()), size);
+    data->append(vector, folly::Range(&range, 1));
+    IOBufOutputStream stream(*pool(), nullptr, data->size());
+    data->flush(&stream);
+    return std::make_unique<SerializedPage>(stream.getIOBuf(), nullptr, size);
+  }
+
+  std::shared_ptr<Task> makeTask(const std::string& taskId) {
+    auto queryCtx = core::QueryCtx::create(executor_.get());
+    queryCtx->testingOverrideMemoryPool(
+        memory::memoryManager()->addRootPool(queryCtx->queryId()));
+    auto plan = test::PlanBuilder().values({}).planNode();
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        std::move(queryCtx),
+        Task::ExecutionMode::kParallel);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+    return task;
+  }
+
+  // Enqueues 'data' for 'destination' of 'taskId'. Returns the address of the
+  // serialized bytes.
+  const uint8_t* enqueue(
+      const std::string& taskId,
+      int32_t destination,
+      const RowVectorPtr& data) {
+    auto page = toSerializedPage(data);
+    const auto* bytes = page->getIOBuf()->data();
+    ContinueFuture unused;
+    bufferManager_->enqueue(taskId, destination, std::move(page), &unused);
+    return bytes;
+  }
+
+  std::unique_ptr<SerializedPage> fetchPage(
+      ExchangeClient& client,
+      bool& atEnd) {
+    for (;;) {
+      ContinueFuture future;
+      auto pages = client.next(1, &atEnd, &future);
+      if (!pages.empty()) {
+        EXPECT_EQ(pages.size(), 1);
+        return std::move(pages[0]);
+      }
+      if (atEnd) {
+        return nullptr;
+      }
+      auto& exec = folly::QueuedImmediateExecutor::instance();
+      std::move(future).via(&exec).wait();
+    }
+  }
+
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<OutputBufferManager> bufferManager_;
+};
+
+TEST_F(InProcessExchangeSourceTest, create) {
+  auto queue = std::make_shared<ExchangeQueue>();
+  ASSERT_EQ(
+      InProcessExchangeSource::create(
+          "http://host/v1/task/t0", 0, queue, pool()),
+      nullptr);
+  // Task ids with the scheme are read in-process even before the producer
+  // has created its buffer.
+  ASSERT_NE(
+      InProcessExchangeSource::create("inprocess://t0", 0, queue, pool()),
+      nullptr);
+
+  const std::string taskId = "t1";
+  auto task = makeTask(taskId);
+  ASSERT_NE(
+      InProcessExchangeSource::create(taskId, 0, queue, pool()), nullptr);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(InProcessExchangeSourceTest, zeroCopy) {
+  const std::string taskId = "t2";
+  auto task = makeTask(taskId);
+
+  std::vector<RowVectorPtr> data = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({4, 5})}),
+  };
+  std::vector<const uint8_t*> producerBytes;
+  for (const auto& vector : data) {
+    producerBytes.push_back(enqueue(taskId, 1, vector));
+  }
+  bufferManager_->noMoreData(taskId);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "t", 1, ExchangeClient::kDefaultMaxQueuedBytes, pool(), executor_.get());
+  // The scheme is stripped to find the producer's buffers.
+  client->addRemoteTaskId(
+      fmt::format("{}{}", InProcessExchangeSource::kScheme, taskId));
+  client->noMoreRemoteTasks();
+
+  bool atEnd = false;
+  for (auto i = 0; i < data.size(); ++i) {
+    auto page = fetchPage(*client, atEnd);
+    ASSERT_NE(page, nullptr);
+    // The consumer reads the producer's buffers.
+    ASSERT_EQ(page->getIOBuf()->data(), producerBytes[i]);
+
+    auto input = page->prepareStreamForDeserialize();
+    RowVectorPtr result;
+    VectorStreamGroup::read(
+        input.get(), pool(), asRowType(data[i]->type()), &result);
+    test::assertEqualVectors(data[i], result);
+  }
+  ASSERT_EQ(fetchPage(*client, atEnd), nullptr);
+  ASSERT_TRUE(atEnd);
+
+  const auto stats = client->stats();
+  ASSERT_EQ(stats.at("inProcessExchangeSource.numPages").sum, data.size());
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+}
+
+TEST_F(InProcessExchangeSourceTest, timeout) {
+  const std::string taskId = "t3";
+  auto task = makeTask(taskId);
+
+  auto queue = std::make_shared<ExchangeQueue>();
+  auto source = ExchangeSource::create(
+      fmt::format("{}{}", InProcessExchangeSource::kScheme, taskId),
+      0,
+      queue,
+      pool());
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    ASSERT_TRUE(source->shouldRequestLocked());
+  }
+  // No data is produced, the request completes empty after 'maxWait'.
+  auto response =
+      source->request(1 << 20, std::chrono::milliseconds(10)).get();
+  ASSERT_EQ(response.bytes, 0);
+  ASSERT_FALSE(response.atEnd);
+
+  // Data produced after the timeout is returned by the next request.
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  enqueue(taskId, 0, data);
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    ASSERT_TRUE(source->shouldRequestLocked());
+  }
+  response = source->request(1 << 20, std::chrono::seconds(10)).get();
+  ASSERT_GT(response.bytes, 0);
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    ASSERT_FALSE(queue->empty());
+  }
+
+  source->close();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -24,6 +27,10 @@ using namespace facebook::velox::exec::test;
 
 class MarkDistinctTest : public OperatorTestBase {
  public:
+  MarkDistinctTest() {
+    filesystems::registerLocalFileSystem();
+  }
+
   void runBasicTest(const VectorPtr& base) {
     const vector_size_t size = base->size() * 2;
     auto indices = makeIndices(size, [](auto row) { return row / 2; });
@@ -141,3 +148,59 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 8; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return (row + i * 1'000) % 173; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    uint32_t maxSpillInjections;
+    int32_t maxSpillLevel;
+
+    std::string debugString() const {
+      return fmt::format(
+          "maxSpillInjections {}, maxSpillLevel {}",
+          maxSpillInjections,
+          maxSpillLevel);
+    }
+  } testSettings[] = {
+      {1, 1},
+      // Spills again while restoring the spilled partitions.
+      {std::numeric_limits<uint32_t>::max(), 2}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    const auto spillDirectory = TempDirectoryPath::create();
+    exec::TestScopedSpillInjection scopedSpillInjection(
+        100, ".*", testData.maxSpillInjections);
+
+    core::PlanNodeId markDistinctNodeId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .markDistinct("c0_c1_distinct", {"c0", "c1"})
+                    .capturePlanNodeId(markDistinctNodeId)
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kMarkDistinctSpillEnabled, true)
+            .config(core::QueryConfig::kMaxSpillLevel, testData.maxSpillLevel)
+            .assertResults(
+                "SELECT c0, c1, row_number() OVER (PARTITION BY c0, c1) = 1 FROM tmp");
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& markDistinctStats = planStats.at(markDistinctNodeId);
+    ASSERT_GT(markDistinctStats.spilledBytes, 0);
+    ASSERT_GT(markDistinctStats.spilledRows, 0);
+    ASSERT_GT(markDistinctStats.spilledFiles, 0);
+  }
+}
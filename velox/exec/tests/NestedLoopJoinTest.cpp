@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -569,5 +571,163 @@ TEST_F(NestedLoopJoinTest, outputOrder) {
   assertEqualVectors(expectedLeft, results);
 }
 
+TEST_F(NestedLoopJoinTest, spill) {
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(
+        makeRowVector({"t0"}, {sequence<int32_t>(100, i * 100)}));
+    buildVectors.push_back(
+        makeRowVector({"u0"}, {sequence<int32_t>(50, i * 100)}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    std::string joinCondition;
+    std::string duckDbSql;
+    int32_t numDrivers;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinCondition: {}, numDrivers: {}", joinCondition, numDrivers);
+    }
+  } testSettings[] = {
+      {"t0 < u0", "SELECT t0, u0 FROM t, u WHERE t0 < u0", 1},
+      {"t0 < u0", "SELECT t0, u0 FROM t, u WHERE t0 < u0", 4},
+      {"", "SELECT t0, u0 FROM t, u", 1},
+      {"", "SELECT t0, u0 FROM t, u", 4}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    const auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+
+    core::PlanNodeId joinNodeId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .localPartition({"t0"})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .localPartition({"u0"})
+                            .planNode(),
+                        testData.joinCondition,
+                        {"t0", "u0"},
+                        core::JoinType::kInner)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .maxDrivers(testData.numDrivers)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(core::QueryConfig::kSpillEnabled, true)
+                    .config(core::QueryConfig::kJoinSpillEnabled, true)
+                    .assertResults(testData.duckDbSql);
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& joinStats = planStats.at(joinNodeId);
+    ASSERT_GT(joinStats.spilledBytes, 0);
+    ASSERT_GT(joinStats.spilledFiles, 0);
+  }
+}
+
+// The probe operators release the spilled build vectors they read under memory
+// pressure and read them again before joining them further.
+TEST_F(NestedLoopJoinTest, reclaimSpilledBuild) {
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(
+        makeRowVector({"t0"}, {sequence<int32_t>(100, i * 100)}));
+    buildVectors.push_back(
+        makeRowVector({"u0"}, {sequence<int32_t>(50, i * 100)}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+
+  std::atomic_int numReclaims{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::getOutput",
+      std::function<void(Operator*)>(([&](Operator* op) {
+        if (op->operatorType() != "NestedLoopJoinProbe") {
+          return;
+        }
+        uint64_t reclaimableBytes{0};
+        if (!op->reclaimableBytes(reclaimableBytes) ||
+            reclaimableBytes == 0) {
+          return;
+        }
+        ++numReclaims;
+        testingRunArbitration(op->pool(), 0);
+      })));
+
+  core::PlanNodeId joinNodeId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .nestedLoopJoin(
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "t0 < u0",
+                      {"t0", "u0"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->getPath())
+                  .config(core::QueryConfig::kSpillEnabled, true)
+                  .config(core::QueryConfig::kJoinSpillEnabled, true)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, 10)
+                  .assertResults("SELECT t0, u0 FROM t, u WHERE t0 < u0");
+
+  ASSERT_GT(numReclaims, 0);
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_GT(planStats.at(joinNodeId).spilledBytes, 0);
+}
+
+// Outer joins don't spill.
+TEST_F(NestedLoopJoinTest, noSpillForOuterJoin) {
+  auto probeVectors = {makeRowVector({"t0"}, {sequence<int32_t>(100)})};
+  auto buildVectors = {
+      makeRowVector({"u0"}, {sequence<int32_t>(50)}),
+      makeRowVector({"u0"}, {sequence<int32_t>(50, 50)})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+
+  core::PlanNodeId joinNodeId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .nestedLoopJoin(
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "t0 < u0",
+                      {"t0", "u0"},
+                      core::JoinType::kFull)
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->getPath())
+          .config(core::QueryConfig::kSpillEnabled, true)
+          .config(core::QueryConfig::kJoinSpillEnabled, true)
+          .assertResults("SELECT t0, u0 FROM t FULL OUTER JOIN u ON t0 < u0");
+
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(joinNodeId).spilledBytes, 0);
+}
+
 } // namespace
 } // namespace facebook::velox::exec::test
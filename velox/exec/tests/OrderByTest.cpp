@@ -525,6 +525,91 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, parallelSort) {
+  const vector_size_t batchSize = 10'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](vector_size_t row) { return (row * 7919 + i) % 1'000; },
+            nullEvery(7)),
+        makeFlatVector<std::string>(
+            batchSize,
+            [&](vector_size_t row) {
+              return fmt::format("value_{}", (row + i) % 333);
+            }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy({"c0 DESC NULLS FIRST", "c1"}, false)
+                        .planNode();
+  for (bool spill : {false, true}) {
+    SCOPED_TRACE(fmt::format("spill: {}", spill));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(spill ? 100 : 0);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .spillDirectory(spillDirectory->getPath())
+        .config(core::QueryConfig::kSpillEnabled, spill)
+        .config(core::QueryConfig::kOrderBySpillEnabled, spill)
+        .config(core::QueryConfig::kOrderBySortMaxThreads, 4)
+        .config(core::QueryConfig::kOrderBySortMinRowsPerThread, 1'000)
+        .assertResults(
+            "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1", {{0, 1}});
+  }
+}
+
+// The spill runs are sorted with timsort if the prefixes cannot be allocated.
+DEBUG_ONLY_TEST_F(OrderByTest, spillSortAllocationFailure) {
+  const vector_size_t batchSize = 10'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](vector_size_t row) { return (row * 7919 + i) % 1'000; },
+            nullEvery(7)),
+        makeFlatVector<std::string>(
+            batchSize,
+            [&](vector_size_t row) {
+              return fmt::format("value_{}", (row + i) % 333);
+            }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  std::atomic_int numFailedAllocations{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::PrefixSort::sortInternal",
+      std::function<void(memory::MemoryPool*)>([&](memory::MemoryPool* pool) {
+        if (pool == memory::spillMemoryPool()) {
+          ++numFailedAllocations;
+          VELOX_MEM_POOL_CAP_EXCEEDED("Injected allocation failure");
+        }
+      }));
+
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy({"c0 DESC NULLS FIRST", "c1"}, false)
+                        .planNode();
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->getPath())
+          .config(core::QueryConfig::kSpillEnabled, true)
+          .config(core::QueryConfig::kOrderBySpillEnabled, true)
+          .config(core::QueryConfig::kOrderBySortMaxThreads, 4)
+          .config(core::QueryConfig::kOrderBySortMinRowsPerThread, 1'000)
+          .assertResults(
+              "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1", {{0, 1}});
+  ASSERT_GT(spilledStats(*task).spilledRows, 0);
+  ASSERT_GT(numFailedAllocations, 0);
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
@@ -167,6 +167,68 @@ TEST_F(PlanNodeSerdeTest, nestedLoopJoin) {
   }
 }
 
+TEST_F(PlanNodeSerdeTest, ieJoin) {
+  auto left = makeRowVector(
+      {"t0", "t1", "t2"},
+      {
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeFlatVector<int64_t>({10, 20, 30}),
+          makeFlatVector<bool>({true, true, false}),
+      });
+
+  auto right = makeRowVector(
+      {"u0", "u1", "u2"},
+      {
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeFlatVector<int64_t>({10, 20, 30}),
+          makeFlatVector<bool>({true, true, false}),
+      });
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({left})
+          .ieJoin(
+              {"t2"},
+              {"u2"},
+              PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+              {"t0 <= u0", "t1 > u1"},
+              {"t0", "u1", "t2", "t1"},
+              core::JoinType::kLeft)
+          .planNode();
+  testSerde(plan);
+}
+
+TEST_F(PlanNodeSerdeTest, asOfJoin) {
+  auto left = makeRowVector(
+      {"t0", "t1"},
+      {
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeFlatVector<int64_t>({10, 20, 30}),
+      });
+
+  auto right = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeFlatVector<int64_t>({10, 20, 30}),
+      });
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({left})
+          .asOfJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+              "t1 >= u1",
+              {"t0", "t1", "u1"},
+              core::JoinType::kLeft)
+          .planNode();
+  testSerde(plan);
+}
+
 TEST_F(PlanNodeSerdeTest, enforceSingleRow) {
   auto plan = PlanBuilder().values({data_}).enforceSingleRow().planNode();
   testSerde(plan);
@@ -300,6 +362,21 @@ TEST_F(PlanNodeSerdeTest, mergeJoin) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({probe})
+             .hashJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+                 "", // no filter
+                 {"t0", "t1", "u2", "t2"},
+                 core::JoinType::kInner,
+                 false,
+                 "fragment-1:splits-2")
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, orderBy) {
@@ -386,6 +463,21 @@ TEST_F(PlanNodeSerdeTest, hashJoin) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({probe})
+             .hashJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+                 "", // no filter
+                 {"t0", "t1", "u2", "t2"},
+                 core::JoinType::kInner,
+                 false,
+                 "fragment-1:splits-2")
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, topN) {
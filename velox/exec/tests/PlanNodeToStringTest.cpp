@@ -470,6 +470,50 @@ TEST_F(PlanNodeToStringTest, nestedLoopJoin) {
       plan->toString(true, false));
 }
 
+TEST_F(PlanNodeToStringTest, ieJoin) {
+  auto plan = PlanBuilder()
+                  .values({data_})
+                  .project({"c0 as t_c0", "c1 as t_c1"})
+                  .ieJoin(
+                      {"t_c0"},
+                      {"u_c0"},
+                      PlanBuilder()
+                          .values({data_})
+                          .project({"c0 as u_c0", "c1 as u_c1"})
+                          .planNode(),
+                      {"t_c1 < u_c1"},
+                      {"t_c0", "t_c1", "u_c1"},
+                      core::JoinType::kLeft)
+                  .planNode();
+
+  ASSERT_EQ("-- IEJoin[2]\n", plan->toString());
+  ASSERT_EQ(
+      "-- IEJoin[2][LEFT t_c0=u_c0 AND t_c1 < u_c1] -> t_c0:SMALLINT, t_c1:INTEGER, u_c1:INTEGER\n",
+      plan->toString(true, false));
+}
+
+TEST_F(PlanNodeToStringTest, asOfJoin) {
+  auto plan = PlanBuilder()
+                  .values({data_})
+                  .project({"c0 as t_c0", "c1 as t_c1"})
+                  .asOfJoin(
+                      {"t_c0"},
+                      {"u_c0"},
+                      PlanBuilder()
+                          .values({data_})
+                          .project({"c0 as u_c0", "c1 as u_c1"})
+                          .planNode(),
+                      "t_c1 >= u_c1",
+                      {"t_c0", "t_c1", "u_c1"},
+                      core::JoinType::kLeft)
+                  .planNode();
+
+  ASSERT_EQ("-- AsOfJoin[2]\n", plan->toString());
+  ASSERT_EQ(
+      "-- AsOfJoin[2][LEFT t_c0=u_c0 AND t_c1 >= u_c1] -> t_c0:SMALLINT, t_c1:INTEGER, u_c1:INTEGER\n",
+      plan->toString(true, false));
+}
+
 TEST_F(PlanNodeToStringTest, orderBy) {
   auto plan = PlanBuilder()
                   .values({data_})
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 
 #include "velox/exec/PrefixSort.h"
@@ -41,7 +42,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      int32_t maxStringPrefixLength = 12,
+      int32_t maxSortThreads = 1) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -60,15 +63,25 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
     std::vector<char*> rows = storeRows(numRows, data, &rowContainer);
 
     // Use PrefixSort to sort rows.
-    PrefixSort::sort(
-        rows,
-        pool_.get(),
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0});
+    const common::PrefixSortConfig config{
+        1024,
+        // Set threshold to 0 to enable prefix-sort in small dataset.
+        0,
+        maxStringPrefixLength,
+        maxSortThreads,
+        // Use small ranges to sort small datasets in parallel.
+        100};
+    if (maxSortThreads > 1) {
+      PrefixSort::parallelSort(
+          folly::Range<char**>(rows.data(), rows.size()),
+          pool_.get(),
+          &rowContainer,
+          compareFlags,
+          config,
+          executor_.get());
+    } else {
+      PrefixSort::sort(rows, pool_.get(), &rowContainer, compareFlags, config);
+    }
 
     // Extract data from the RowContainer in order.
     const RowVectorPtr actual =
@@ -81,6 +94,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
     velox::test::assertEqualVectors(actual, expectedResult);
   }
 
+  const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(4)};
+
  private:
   // Use std::sort to generate expected result.
   const RowVectorPtr generateExpectedResult(
@@ -218,6 +234,94 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringKeys) {
+  // Strings shorter, equal to and longer than the encoded prefix, with long
+  // common prefixes, embedded zero bytes and nulls.
+  const auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"abcdefghijklmnop",
+           "abcdefghijklmnoa",
+           "abcdefghijkl",
+           std::nullopt,
+           "abcdefghijk",
+           std::string("abc\0", 4),
+           "abc",
+           "",
+           "abcdefghijklmnopqrstuvwxyz",
+           std::nullopt,
+           "b",
+           "abcdefghijklmnop"}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}),
+  });
+
+  for (const auto maxStringPrefixLength : {0, 1, 4, 12, 16, 100}) {
+    SCOPED_TRACE(fmt::format("prefix length: {}", maxStringPrefixLength));
+    testPrefixSort({kAsc}, data, maxStringPrefixLength);
+    testPrefixSort({kDesc}, data, maxStringPrefixLength);
+    // Keys after a string key are compared with the full values.
+    testPrefixSort({kAsc, kDesc}, data, maxStringPrefixLength);
+    testPrefixSort({kDesc, kAsc}, data, maxStringPrefixLength);
+  }
+}
+
+TEST_F(PrefixSortTest, stringKeyInMiddle) {
+  const auto data = makeRowVector({
+      makeNullableFlatVector<int32_t>({1, 2, 1, 2, 1, std::nullopt, 1}),
+      makeNullableFlatVector<std::string>(
+          {"aaaaaaaaaaaaaaab",
+           "x",
+           "aaaaaaaaaaaaaaaa",
+           std::nullopt,
+           "aaaaaaaaaaaaaaab",
+           "x",
+           std::nullopt}),
+      makeFlatVector<int64_t>({3, 2, 1, 7, 1, 5, 4}),
+  });
+
+  testPrefixSort({kAsc, kAsc, kAsc}, data);
+  testPrefixSort({kDesc, kAsc, kDesc}, data);
+  testPrefixSort({kAsc, kDesc, kAsc}, data, 4);
+}
+
+TEST_F(PrefixSortTest, hugeintKeys) {
+  const auto data = makeRowVector({
+      makeNullableFlatVector<int128_t>(
+          {HugeInt::build(1, 0),
+           -1,
+           std::nullopt,
+           0,
+           HugeInt::build(0, 0xFFFFFFFFFFFFFFFF),
+           std::numeric_limits<int128_t>::max(),
+           std::numeric_limits<int128_t>::min(),
+           HugeInt::build(-2, 5)},
+          DECIMAL(38, 2)),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8}),
+  });
+
+  testPrefixSort({kAsc}, data);
+  testPrefixSort({kDesc}, data);
+  testPrefixSort({kAsc, kDesc}, data);
+}
+
+TEST_F(PrefixSortTest, parallelSort) {
+  VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
+  const auto data =
+      fuzzer.fuzzRow(ROW({BIGINT(), VARCHAR(), INTEGER(), VARCHAR()}));
+
+  for (const auto maxSortThreads : {2, 3, 8, 200}) {
+    SCOPED_TRACE(fmt::format("maxSortThreads: {}", maxSortThreads));
+    testPrefixSort({kAsc}, data, 12, maxSortThreads);
+    testPrefixSort({kDesc, kAsc}, data, 12, maxSortThreads);
+    testPrefixSort({kAsc, kDesc, kAsc}, data, 12, maxSortThreads);
+  }
+
+  // Too few rows to split.
+  const auto smallData = makeRowVector({
+      makeFlatVector<int64_t>({5, 4, 3, 2, 1}),
+  });
+  testPrefixSort({kAsc}, smallData, 12, 4);
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -266,6 +370,7 @@ TEST_F(PrefixSortTest, fuzzMulti) {
 
     testPrefixSort({kAsc, kAsc}, data);
     testPrefixSort({kDesc, kDesc}, data);
+    testPrefixSort({kAsc, kDesc}, data, 4);
   }
 }
 } // namespace
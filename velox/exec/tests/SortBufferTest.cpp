@@ -515,6 +515,79 @@ DEBUG_ONLY_TEST_F(SortBufferTest, reserveMemoryGetOutput) {
   ASSERT_EQ(numInputs, 1);
 }
 
+TEST_F(SortBufferTest, parallelSort) {
+  const velox::common::PrefixSortConfig parallelSortConfig{
+      std::numeric_limits<int32_t>::max(), 130, 12, 4, 1'000};
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("parallelSortSource");
+
+  // Returns the result of comparing the sort keys of two rows.
+  const auto compareKeys = [&](const RowVectorPtr& left,
+                               vector_size_t leftRow,
+                               const RowVectorPtr& right,
+                               vector_size_t rightRow) {
+    for (auto i = 0; i < sortColumnIndices_.size(); ++i) {
+      const auto column = sortColumnIndices_[i];
+      const auto result = left->childAt(column)
+                              ->compare(
+                                  right->childAt(column).get(),
+                                  leftRow,
+                                  rightRow,
+                                  sortCompareFlags_[i])
+                              .value();
+      if (result != 0) {
+        return result;
+      }
+    }
+    return 0;
+  };
+
+  for (bool triggerSpill : {false, true}) {
+    SCOPED_TRACE(fmt::format("triggerSpill {}", triggerSpill));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto spillConfig = getSpillConfig(spillDirectory->getPath());
+    folly::Synchronized<common::SpillStats> spillStats;
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        parallelSortConfig,
+        triggerSpill ? &spillConfig : nullptr,
+        &spillStats,
+        executor_.get());
+
+    TestScopedSpillInjection scopedSpillInjection(triggerSpill ? 100 : 0);
+    VectorFuzzer fuzzer(
+        {.vectorSize = 4096, .nullRatio = 0.1}, fuzzerPool.get());
+    const int numInputs = 3;
+    for (int i = 0; i < numInputs; ++i) {
+      sortBuffer->addInput(fuzzer.fuzzRow(inputType_));
+    }
+    sortBuffer->noMoreInput();
+    ASSERT_EQ(spillStats.rlock()->empty(), !triggerSpill);
+
+    // The output vector is reused across getOutput() calls, so keep a copy of
+    // the last row of the previous batch.
+    RowVectorPtr lastRow;
+    uint64_t numOutputRows = 0;
+    while (auto output = sortBuffer->getOutput(1'000)) {
+      if (lastRow != nullptr) {
+        ASSERT_LE(compareKeys(lastRow, 0, output, 0), 0);
+      }
+      for (auto row = 1; row < output->size(); ++row) {
+        ASSERT_LE(compareKeys(output, row - 1, output, row), 0);
+      }
+      lastRow = std::static_pointer_cast<RowVector>(
+          BaseVector::create(inputType_, 1, pool_.get()));
+      lastRow->copy(output.get(), 0, output->size() - 1, 1);
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, numInputs * 4096);
+  }
+}
+
 TEST_F(SortBufferTest, emptySpill) {
   const std::shared_ptr<memory::MemoryPool> fuzzerPool =
       memory::memoryManager()->addLeafPool("emptySpillSource");
@@ -206,6 +206,14 @@ class SpillerTest : public exec::test::RowContainerTestBase {
   }
 
  protected:
+  // Returns true if the spiller under test has no row container and only
+  // spills the vectors appended by the caller.
+  bool isVectorSpiller() const {
+    return type_ == Spiller::Type::kHashJoinProbe ||
+        type_ == Spiller::Type::kNestedLoopJoinBuild ||
+        type_ == Spiller::Type::kNestedLoopJoinProbe;
+  }
+
   SpillPartitionNumSet allPartitionNumSet() const {
     std::vector<uint32_t> spillPartitionNums(numPartitions_);
     std::iota(spillPartitionNums.begin(), spillPartitionNums.end(), 0);
@@ -383,7 +391,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     // spilling will be tested separately.
     rowContainer_ = makeRowContainer(keys, dependents, false);
 
-    if (numRows == 0 || type_ == Spiller::Type::kHashJoinProbe) {
+    if (numRows == 0 || isVectorSpiller()) {
       return;
     }
     const SelectivityVector allRows(numRows);
@@ -556,8 +564,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     spillConfig_.maxFileSize = targetFileSize;
     spillConfig_.fileCreateConfig = {};
 
-    if (type_ == Spiller::Type::kHashJoinProbe) {
-      // kHashJoinProbe doesn't have associated row container.
+    if (isVectorSpiller()) {
+      // kHashJoinProbe, kNestedLoopJoinBuild and kNestedLoopJoinProbe don't
+      // have associated row container.
       spiller_ = std::make_unique<Spiller>(
           type_, rowType_, hashBits_, &spillConfig_, &spillStats_);
     } else if (type_ == Spiller::Type::kAggregateInput) {
@@ -585,7 +594,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
         type_ == Spiller::Type::kOrderByOutput) {
       spiller_ = std::make_unique<Spiller>(
           type_, rowContainer_.get(), rowType_, &spillConfig_, &spillStats_);
-    } else if (type_ == Spiller::Type::kRowNumber) {
+    } else if (
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kMarkDistinct) {
       spiller_ = std::make_unique<Spiller>(
           type_,
           rowContainer_.get(),
@@ -772,10 +783,10 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       uint64_t readBufferSize = 1 << 20) {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
-        type_ == Spiller::Type::kHashJoinProbe ||
-        type_ == Spiller::Type::kRowNumber);
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kMarkDistinct || isVectorSpiller());
 
-    const int numSpillPartitions = type_ != Spiller::Type::kHashJoinProbe
+    const int numSpillPartitions = !isVectorSpiller()
         ? numPartitions_
         : 1 + folly::Random().rand32() % numPartitions_;
     SpillPartitionNumSet spillPartitionNumSet;
@@ -802,7 +813,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       const auto prevGStats = common::globalSpillStats();
       setupSpillData(
           numKeys_,
-          type_ != Spiller::Type::kHashJoinProbe ? numBatchRows * 10 : 0,
+          !isVectorSpiller() ? numBatchRows * 10 : 0,
           1,
           nullptr,
           {});
@@ -811,7 +822,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       VELOX_ASSERT_THROW(spiller_->spill(0, rowVector_), "");
 
       splitByPartition(rowVector_, spillHashFunction, inputsByPartition);
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (isVectorSpiller()) {
         spiller_->setPartitionsSpilled(spillPartitionNumSet);
 #ifndef NDEBUG
         VELOX_ASSERT_THROW(
@@ -834,7 +845,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       }
       // Assert that hash probe type of spiller type doesn't support incremental
       // spilling.
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (isVectorSpiller()) {
         VELOX_ASSERT_THROW(spiller_->spill(), "");
       } else {
         spiller_->spill();
@@ -843,7 +854,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
 
       const auto stats = spiller_->stats();
       ASSERT_GE(stats.spilledFiles, 0);
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (isVectorSpiller()) {
         if (numAppendBatches == 0) {
           ASSERT_EQ(stats.spilledRows, 0);
           ASSERT_EQ(stats.spilledBytes, 0);
@@ -870,7 +881,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       ASSERT_GT(stats.spilledPartitions, 0);
       ASSERT_EQ(stats.spillSortTimeNanos, 0);
       if (type_ == Spiller::Type::kHashJoinBuild ||
-          type_ == Spiller::Type::kRowNumber) {
+          type_ == Spiller::Type::kRowNumber ||
+          type_ == Spiller::Type::kMarkDistinct) {
         ASSERT_GT(stats.spillFillTimeNanos, 0);
       } else {
         ASSERT_EQ(stats.spillFillTimeNanos, 0);
@@ -927,7 +939,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
-        type_ == Spiller::Type::kHashJoinProbe);
+        type_ == Spiller::Type::kMarkDistinct || isVectorSpiller());
 
     SpillPartitionSet spillPartitionSet;
     for (auto& spiller : spillers) {
@@ -944,7 +956,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
           hashBits_.begin(), spillPartitionEntry.first.partitionBitOffset());
       auto reader = spillPartitionEntry.second->createUnorderedReader(
           spillConfig_.readBufferSize, pool(), &spillStats_);
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (isVectorSpiller()) {
         // For hash probe type, we append each input vector as one batch in
         // spill file so that we can do one-to-one comparison.
         for (int i = 0; i < inputsByPartition[partition].size(); ++i) {
@@ -999,7 +1011,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
-        type_ == Spiller::Type::kHashJoinProbe);
+        type_ == Spiller::Type::kMarkDistinct || isVectorSpiller());
 
     SpillPartitionSet spillPartitionSet;
     spiller_->finishSpill(spillPartitionSet);
@@ -1015,7 +1027,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
           hashBits_.begin(), spillPartitionEntry.first.partitionBitOffset());
       auto reader = spillPartitionEntry.second->createUnorderedReader(
           spillConfig_.readBufferSize, pool(), &spillStats_);
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (isVectorSpiller()) {
         // For hash probe type, we append each input vector as one batch in
         // spill file so that we can do one-to-one comparison.
         for (int i = 0; i < inputsByPartition[partition].size(); ++i) {
@@ -1211,7 +1223,10 @@ class NoHashJoin : public SpillerTest,
             {Spiller::Type::kHashJoinProbe,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
-             Spiller::Type::kOrderByOutput}}
+             Spiller::Type::kOrderByOutput,
+             Spiller::Type::kNestedLoopJoinBuild,
+             Spiller::Type::kNestedLoopJoinProbe,
+             Spiller::Type::kMarkDistinct}}
         .getTestParams();
   }
 };
@@ -1271,7 +1286,9 @@ class HashJoinBuildOnly : public SpillerTest,
              Spiller::Type::kAggregateOutput,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kOrderByInput,
-             Spiller::Type::kOrderByOutput}}
+             Spiller::Type::kOrderByOutput,
+             Spiller::Type::kNestedLoopJoinBuild,
+             Spiller::Type::kNestedLoopJoinProbe}}
         .getTestParams();
   }
 };
@@ -1364,7 +1381,10 @@ class AggregationOutputOnly : public SpillerTest,
              Spiller::Type::kRowNumber,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kOrderByInput,
-             Spiller::Type::kOrderByOutput}}
+             Spiller::Type::kOrderByOutput,
+             Spiller::Type::kNestedLoopJoinBuild,
+             Spiller::Type::kNestedLoopJoinProbe,
+             Spiller::Type::kMarkDistinct}}
         .getTestParams();
   }
 };
@@ -1483,7 +1503,10 @@ class OrderByOutputOnly : public SpillerTest,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kRowNumber,
-             Spiller::Type::kOrderByInput}}
+             Spiller::Type::kOrderByInput,
+             Spiller::Type::kNestedLoopJoinBuild,
+             Spiller::Type::kNestedLoopJoinProbe,
+             Spiller::Type::kMarkDistinct}}
         .getTestParams();
   }
 };
@@ -1585,7 +1608,10 @@ class MaxSpillRunTest : public SpillerTest,
   static std::vector<TestParam> getTestParams() {
     return TestParamsBuilder{
         .typesToExclude =
-            {Spiller::Type::kHashJoinProbe, Spiller::Type::kOrderByOutput}}
+            {Spiller::Type::kHashJoinProbe,
+             Spiller::Type::kOrderByOutput,
+             Spiller::Type::kNestedLoopJoinBuild,
+             Spiller::Type::kNestedLoopJoinProbe}}
         .getTestParams();
   }
 };
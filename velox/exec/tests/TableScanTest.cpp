@@ -4020,6 +4020,33 @@ TEST_F(TableScanTest, parallelPrepare) {
       .copyResults(pool_.get());
 }
 
+TEST_F(TableScanTest, parallelDecoding) {
+  resetHiveConnector(std::make_shared<config::ConfigBase>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kParallelDecodingThreads, "4"}}));
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder().tableScan(rowType_, {}, "c0 % 3 = 0").planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .split(makeHiveSplit(filePath->getPath()))
+                  .assertResults("SELECT * FROM tmp WHERE c0 % 3 = 0");
+  ASSERT_GT(getTableScanRuntimeStats(task)["parallelDecodingCpuNanos"].sum, 0);
+
+  // A session factor of 1 turns parallel decoding off.
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .connectorSessionProperty(
+                 kHiveConnectorId,
+                 connector::hive::HiveConfig::kParallelDecodingFactorSession,
+                 "1")
+             .split(makeHiveSplit(filePath->getPath()))
+             .assertResults("SELECT * FROM tmp WHERE c0 % 3 = 0");
+  ASSERT_EQ(
+      getTableScanRuntimeStats(task).count("parallelDecodingCpuNanos"), 0);
+}
+
 TEST_F(TableScanTest, dictionaryMemo) {
   constexpr int kSize = 100;
   const char* baseStrings[] = {
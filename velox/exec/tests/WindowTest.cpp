@@ -81,6 +81,88 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, spillAfterNoMoreInput) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 11; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  // A single input batch doesn't trigger spilling before noMoreInput(), so
+  // the rows are spilled while the first partition is being output.
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .window({"row_number() over (partition by p order by s)"})
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kWindowSpillEnabled, "true")
+          .spillDirectory(spillDirectory->getPath())
+          .assertResults(
+              "SELECT *, row_number() over (partition by p order by s) FROM tmp");
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(windowId);
+
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledRows, 0);
+  // The rows of the first partition are not spilled.
+  ASSERT_LT(stats.spilledRows, size);
+  ASSERT_GT(stats.spilledFiles, 0);
+}
+
+TEST_F(WindowTest, spillMultipleBatches) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 7; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return size - row; }),
+      });
+
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 7))
+                  .window(
+                      {"row_number() over (partition by p order by s)",
+                       "sum(d) over (partition by p order by s)"})
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto expected = AssertQueryBuilder(plan).copyResults(pool_.get());
+
+  // The rows added after the last input spill are spilled at noMoreInput().
+  // They must end up in the output too.
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  std::shared_ptr<Task> task;
+  auto results = AssertQueryBuilder(plan)
+                     .config(core::QueryConfig::kSpillEnabled, "true")
+                     .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                     .spillDirectory(spillDirectory->getPath())
+                     .copyResults(pool_.get(), task);
+  assertEqualResults({expected}, {results});
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(taskStats.at(windowId).spilledRows, size);
+}
+
 TEST_F(WindowTest, rowBasedStreamingWindowOOM) {
   const vector_size_t size = 1'000'000;
   auto data = makeRowVector(
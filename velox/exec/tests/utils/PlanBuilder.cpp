@@ -1353,7 +1353,8 @@ PlanBuilder& PlanBuilder::hashJoin(
     const std::string& filter,
     const std::vector<std::string>& outputLayout,
     core::JoinType joinType,
-    bool nullAware) {
+    bool nullAware,
+    const std::string& hashTableCacheKey) {
   VELOX_CHECK_NOT_NULL(planNode_, "HashJoin cannot be the source node");
   VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
 
@@ -1394,7 +1395,8 @@ PlanBuilder& PlanBuilder::hashJoin(
       std::move(filterExpr),
       std::move(planNode_),
       build,
-      outputType);
+      outputType,
+      hashTableCacheKey);
   return *this;
 }
 
@@ -1462,6 +1464,92 @@ PlanBuilder& PlanBuilder::nestedLoopJoin(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::ieJoin(
+    const std::vector<std::string>& leftKeys,
+    const std::vector<std::string>& rightKeys,
+    const core::PlanNodePtr& right,
+    const std::vector<std::string>& conditions,
+    const std::vector<std::string>& outputLayout,
+    core::JoinType joinType) {
+  VELOX_CHECK_NOT_NULL(planNode_, "IEJoin cannot be the source node");
+  VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
+
+  auto leftType = planNode_->outputType();
+  auto rightType = right->outputType();
+  auto outputType = extract(concat(leftType, rightType), outputLayout);
+
+  std::vector<core::IEJoinNode::Condition> joinConditions;
+  for (const auto& condition : conditions) {
+    joinConditions.push_back(
+        parseIEJoinCondition(leftType, rightType, condition));
+  }
+
+  planNode_ = std::make_shared<core::IEJoinNode>(
+      nextPlanNodeId(),
+      joinType,
+      fields(leftType, leftKeys),
+      fields(rightType, rightKeys),
+      std::move(joinConditions),
+      std::move(planNode_),
+      right,
+      outputType);
+  return *this;
+}
+
+PlanBuilder& PlanBuilder::asOfJoin(
+    const std::vector<std::string>& leftKeys,
+    const std::vector<std::string>& rightKeys,
+    const core::PlanNodePtr& right,
+    const std::string& matchCondition,
+    const std::vector<std::string>& outputLayout,
+    core::JoinType joinType) {
+  VELOX_CHECK_NOT_NULL(planNode_, "AsOfJoin cannot be the source node");
+  VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
+
+  auto leftType = planNode_->outputType();
+  auto rightType = right->outputType();
+  auto outputType = extract(concat(leftType, rightType), outputLayout);
+
+  planNode_ = std::make_shared<core::AsOfJoinNode>(
+      nextPlanNodeId(),
+      joinType,
+      fields(leftType, leftKeys),
+      fields(rightType, rightKeys),
+      parseIEJoinCondition(leftType, rightType, matchCondition),
+      std::move(planNode_),
+      right,
+      outputType);
+  return *this;
+}
+
+// static
+core::IEJoinNode::Condition PlanBuilder::parseIEJoinCondition(
+    const RowTypePtr& leftType,
+    const RowTypePtr& rightType,
+    const std::string& condition) {
+  // Longer operators first, so that "<=" is not parsed as "<".
+  std::optional<std::string_view> op;
+  size_t pos = std::string::npos;
+  for (const std::string_view candidate : {"<=", ">=", "<", ">"}) {
+    pos = condition.find(candidate);
+    if (pos != std::string::npos) {
+      op = candidate;
+      break;
+    }
+  }
+  VELOX_CHECK(op.has_value(), "Invalid join condition: {}", condition);
+  auto trim = [](std::string_view name) {
+    const auto begin = name.find_first_not_of(' ');
+    const auto end = name.find_last_not_of(' ');
+    return std::string(name.substr(begin, end - begin + 1));
+  };
+  const std::string_view text(condition);
+  return {
+      field(leftType, trim(text.substr(0, pos))),
+      core::IEJoinNode::opFromName(op.value()),
+      field(rightType, trim(text.substr(pos + op->size())))};
+}
+
 PlanBuilder& PlanBuilder::unnest(
     const std::vector<std::string>& replicateColumns,
     const std::vector<std::string>& unnestColumns,
@@ -850,6 +850,9 @@ class PlanBuilder {
   /// @param joinType Type of the join: inner, left, right, full, semi, or anti.
   /// @param nullAware Applies to semi and anti joins. Indicates whether the
   /// join follows IN (null-aware) or EXISTS (regular) semantic.
+  /// @param hashTableCacheKey If not empty, the hash table is shared with the
+  /// concurrent tasks with the same key. See
+  /// core::HashJoinNode::hashTableCacheKey().
   PlanBuilder& hashJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
@@ -857,7 +860,8 @@ class PlanBuilder {
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner,
-      bool nullAware = false);
+      bool nullAware = false,
+      const std::string& hashTableCacheKey = "");
 
   /// Add a MergeJoinNode to join two inputs using one or more join keys and an
   /// optional filter. The caller is responsible to ensure that inputs are
@@ -903,6 +907,49 @@ class PlanBuilder {
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner);
 
+  /// Add an IEJoinNode to join two inputs on one or two inequality conditions
+  /// and optional equality keys. Only supports inner and left joins.
+  ///
+  /// @param leftKeys Left-side equality keys. May be empty.
+  /// @param rightKeys Right-side equality keys. Must be the same number as
+  /// 'leftKeys'.
+  /// @param right Right-side input. It is collected in memory (or spilled).
+  /// @param conditions One or two conditions in the form of "<left column>
+  /// <op> <right column>", where op is one of <, <=, > and >=, e.g. "t0 <
+  /// u0".
+  /// @param outputLayout Output layout consisting of columns from left and
+  /// right sides.
+  /// @param joinType Type of the join: inner or left.
+  PlanBuilder& ieJoin(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const core::PlanNodePtr& right,
+      const std::vector<std::string>& conditions,
+      const std::vector<std::string>& outputLayout,
+      core::JoinType joinType = core::JoinType::kInner);
+
+  /// Add an AsOfJoinNode to join each left row with its nearest right row with
+  /// the same keys. Both inputs must be sorted on the keys followed by the
+  /// column of the match condition. Only supports inner and left joins.
+  ///
+  /// @param leftKeys Left-side equality keys. May be empty.
+  /// @param rightKeys Right-side equality keys. Must be the same number as
+  /// 'leftKeys'.
+  /// @param right Right-side input.
+  /// @param matchCondition Condition in the form of "<left column> <op> <right
+  /// column>", where op is one of <, <=, > and >=, e.g. "t1 >= u1" to match
+  /// the right row with the largest u1 not greater than t1.
+  /// @param outputLayout Output layout consisting of columns from left and
+  /// right sides.
+  /// @param joinType Type of the join: inner or left.
+  PlanBuilder& asOfJoin(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const core::PlanNodePtr& right,
+      const std::string& matchCondition,
+      const std::vector<std::string>& outputLayout,
+      core::JoinType joinType = core::JoinType::kInner);
+
   /// Add an UnnestNode to unnest one or more columns of type array or map.
   ///
   /// The output will contain 'replicatedColumns' followed by unnested columns,
@@ -1060,6 +1107,12 @@ class PlanBuilder {
       const RowTypePtr& inputType,
       const std::string& name);
 
+  // Parses a condition in the form of "<left column> <op> <right column>".
+  static core::IEJoinNode::Condition parseIEJoinCondition(
+      const RowTypePtr& leftType,
+      const RowTypePtr& rightType,
+      const std::string& condition);
+
   core::PlanNodePtr createIntermediateOrFinalAggregation(
       core::AggregationNode::Step step,
       const core::AggregationNode* partialAggNode);
@@ -131,6 +131,26 @@ class MaxAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseInput() const override {
+    return true;
+  }
+
+  void addRawInputDense(
+      char** groups,
+      int32_t numGroups,
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::updateDenseGroups(
+        groups,
+        numGroups,
+        groupIndices,
+        rows,
+        args[0],
+        updateGroup,
+        kInitialValue_);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -228,6 +248,26 @@ class MinAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseInput() const override {
+    return true;
+  }
+
+  void addRawInputDense(
+      char** groups,
+      int32_t numGroups,
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::updateDenseGroups(
+        groups,
+        numGroups,
+        groupIndices,
+        rows,
+        args[0],
+        updateGroup,
+        kInitialValue_);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/RawVector.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
 #include "velox/vector/DecodedVector.h"
@@ -146,6 +147,66 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Implements addRawInputDense(). Row 'i' of 'rows' goes to
+  // groups[groupIndices[i]]. The values of each group are first combined into
+  // a dense array of TData starting from 'initialValue', which must be the
+  // identity of 'updateSingleValue'. Each group that received a non-null value
+  // is then updated once. TData and TValue are as in updateGroups().
+  template <
+      typename TData = TResult,
+      typename TValue = TInput,
+      typename UpdateSingleValue>
+  void updateDenseGroups(
+      char** groups,
+      int32_t numGroups,
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      UpdateSingleValue updateSingleValue,
+      TData initialValue) {
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping() && decoded.isNullAt(0)) {
+      return;
+    }
+    denseValues_.resize(numGroups * sizeof(TData));
+    denseHasValue_.resize(numGroups);
+    auto* values = reinterpret_cast<TData*>(denseValues_.data());
+    auto* hasValue = denseHasValue_.data();
+    std::fill(values, values + numGroups, initialValue);
+    std::fill(hasValue, hasValue + numGroups, 0);
+
+    if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (decoded.isNullAt(i)) {
+          return;
+        }
+        const auto group = groupIndices[i];
+        updateSingleValue(values[group], TData(decoded.valueAt<TValue>(i)));
+        hasValue[group] = 1;
+      });
+    } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+      auto data = decoded.data<TValue>();
+      rows.applyToSelected([&](vector_size_t i) {
+        const auto group = groupIndices[i];
+        updateSingleValue(values[group], TData(data[i]));
+        hasValue[group] = 1;
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        const auto group = groupIndices[i];
+        updateSingleValue(values[group], TData(decoded.valueAt<TValue>(i)));
+        hasValue[group] = 1;
+      });
+    }
+
+    for (auto group = 0; group < numGroups; ++group) {
+      if (hasValue[group]) {
+        updateNonNullValue<true, TData>(
+            groups[group], values[group], updateSingleValue);
+      }
+    }
+  }
+
   // TData is used to store the updated group state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
@@ -231,6 +292,11 @@ class SimpleNumericAggregate : public exec::Aggregate {
   }
 
  private:
+  // Scratch space of updateDenseGroups(). The values are of the TData of the
+  // call.
+  raw_vector<char> denseValues_;
+  raw_vector<uint8_t> denseHasValue_;
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <
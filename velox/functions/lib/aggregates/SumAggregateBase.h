@@ -80,6 +80,26 @@ class SumAggregateBase
     updateInternal<TAccumulator, TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseInput() const override {
+    return true;
+  }
+
+  void addRawInputDense(
+      char** groups,
+      int32_t numGroups,
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::template updateDenseGroups<TAccumulator>(
+        groups,
+        numGroups,
+        groupIndices,
+        rows,
+        args[0],
+        &updateSingleValue<TAccumulator>,
+        TAccumulator(0));
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -69,6 +69,38 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     }
   }
 
+  bool supportsDenseInput() const override {
+    return true;
+  }
+
+  void addRawInputDense(
+      char** groups,
+      int32_t numGroups,
+      const vector_size_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    denseCounts_.resize(numGroups);
+    auto* counts = denseCounts_.data();
+    std::fill(counts, counts + numGroups, 0);
+    DecodedVector decoded;
+    if (!args.empty()) {
+      decoded.decode(*args[0], rows);
+    }
+    if (!args.empty() && decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        counts[groupIndices[i]] += !decoded.isNullAt(i);
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) { ++counts[groupIndices[i]]; });
+    }
+
+    for (auto group = 0; group < numGroups; ++group) {
+      if (counts[group] > 0) {
+        addToGroup(groups[group], counts[group]);
+      }
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -147,6 +179,9 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
   }
 
   DecodedVector decodedIntermediate_;
+
+  // Per group counts of addRawInputDense().
+  raw_vector<int64_t> denseCounts_;
 };
 
 } // namespace
@@ -17,11 +17,13 @@
 
 #include <optional>
 
+#include <folly/io/Cursor.h>
 #include <folly/lang/Bits.h>
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/CpuWallTimer.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DictionaryVector.h"
@@ -36,6 +38,11 @@ namespace {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Velox extension: the columns are compressed separately, see
+// PrestoOptions::columnCompression. The page is not compressed as a whole.
+// Readers other than Velox may ignore this bit and misread the page, so such
+// pages must never reach them.
+constexpr int8_t kColumnCompressedBitMask = 8;
 // uncompressed size comes after the number of rows and the codec
 constexpr int32_t kSizeInBytesOffset{4 + 1};
 // There header for a page is:
@@ -130,6 +137,10 @@ bool isEncryptedBitSet(int8_t codec) {
   return (codec & kEncryptedBitMask) == kEncryptedBitMask;
 }
 
+bool isColumnCompressedBitSet(int8_t codec) {
+  return (codec & kColumnCompressedBitMask) == kColumnCompressedBitMask;
+}
+
 bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
@@ -3917,6 +3928,176 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
   SerdeOpts opts_;
 };
 
+// Writes pages with PrestoOptions::columnCompression. After the page header
+// comes the number of columns followed by, for each column, the
+// CompressionKind (1 byte), the uncompressed size (4 bytes), the size (4 bytes)
+// and the column data. Keeps per column statistics across pages.
+class ColumnCompressor {
+ public:
+  ColumnCompressor(const RowTypePtr& rowType, const SerdeOpts& opts)
+      : names_(rowType->names()),
+        minCompressionRatio_(opts.minCompressionRatio),
+        lz4_(common::compressionKindToCodec(common::CompressionKind_LZ4)),
+        zstd_(folly::io::getCodec(
+            folly::io::CodecType::ZSTD,
+            opts.columnCompressionZstdLevel)),
+        columns_(names_.size()) {}
+
+  void flush(
+      const std::vector<std::unique_ptr<VectorStream>>& streams,
+      int32_t numRows,
+      const StreamArena& arena,
+      OutputStream* output) {
+    auto listener =
+        dynamic_cast<PrestoOutputStreamListener*>(output->listener());
+    char codecMask = kColumnCompressedBitMask;
+    if (listener) {
+      codecMask |= kCheckSumBitMask;
+      // Reset and pause CRC computation.
+      listener->reset();
+      listener->pause();
+    }
+
+    writeInt32(output, numRows);
+
+    IOBufOutputStream body(*arena.pool(), nullptr, arena.size());
+    writeInt32(&body, streams.size());
+    for (auto i = 0; i < streams.size(); ++i) {
+      IOBufOutputStream column(
+          *arena.pool(), nullptr, streams[i]->serializedSize());
+      streams[i]->flush(&column);
+      const auto data = column.getIOBuf();
+      const int32_t uncompressedSize = data->computeChainDataLength();
+
+      auto& state = columns_[i];
+      auto kind = common::CompressionKind_NONE;
+      std::unique_ptr<folly::IOBuf> compressed;
+      {
+        CpuWallTimer timer(state.timing);
+        kind = chooseKind(*data, state);
+        if (kind != common::CompressionKind_NONE) {
+          compressed = codec(kind).compress(data.get());
+          if (compressed->computeChainDataLength() >
+              uncompressedSize * minCompressionRatio_) {
+            kind = common::CompressionKind_NONE;
+            compressed.reset();
+          }
+        }
+      }
+      const auto& payload = compressed != nullptr ? compressed : data;
+      const int32_t size = payload->computeChainDataLength();
+      state.inputBytes += uncompressedSize;
+      state.outputBytes += size;
+      if (kind == common::CompressionKind_LZ4) {
+        ++state.numLz4;
+      } else if (kind == common::CompressionKind_ZSTD) {
+        ++state.numZstd;
+      }
+
+      const char marker = static_cast<char>(kind);
+      body.write(&marker, 1);
+      writeInt32(&body, uncompressedSize);
+      writeInt32(&body, size);
+      for (auto range : *payload) {
+        body.write(reinterpret_cast<const char*>(range.data()), range.size());
+      }
+    }
+
+    const int32_t bodySize = body.tellp();
+    flushSerialization(
+        numRows,
+        bodySize,
+        bodySize,
+        codecMask,
+        body.getIOBuf(),
+        output,
+        listener);
+  }
+
+  void addRuntimeStats(
+      std::unordered_map<std::string, RuntimeCounter>& map) const {
+    for (auto i = 0; i < columns_.size(); ++i) {
+      const auto& state = columns_[i];
+      const auto prefix = fmt::format("columnCompression.{}.", names_[i]);
+      map.insert(
+          {{prefix + "inputBytes",
+            RuntimeCounter(state.inputBytes, RuntimeCounter::Unit::kBytes)},
+           {prefix + "outputBytes",
+            RuntimeCounter(state.outputBytes, RuntimeCounter::Unit::kBytes)},
+           {prefix + "cpuNanos",
+            RuntimeCounter(
+                state.timing.cpuNanos, RuntimeCounter::Unit::kNanos)},
+           {prefix + "numLz4", RuntimeCounter(state.numLz4)},
+           {prefix + "numZstd", RuntimeCounter(state.numZstd)}});
+    }
+  }
+
+ private:
+  // Columns smaller than this are not compressed.
+  static constexpr int32_t kMinCompressionBytes = 512;
+  // Number of bytes from the start of a column that are compressed to choose
+  // its compression.
+  static constexpr int32_t kSampleBytes = 64 << 10;
+  // ZSTD is chosen over LZ4 if its sample is at most this fraction of the
+  // LZ4 sample.
+  static constexpr double kMinZstdGain = 0.8;
+  static constexpr int32_t kMaxPagesToSkip = 30;
+
+  struct ColumnState {
+    // Pages left for which the column is written uncompressed without
+    // sampling because its sample did not compress.
+    int32_t numPagesToSkip{0};
+    int32_t numIncompressible{0};
+    int64_t inputBytes{0};
+    int64_t outputBytes{0};
+    int64_t numLz4{0};
+    int64_t numZstd{0};
+    // Time spent sampling and compressing.
+    CpuWallTiming timing;
+  };
+
+  common::CompressionKind chooseKind(
+      const folly::IOBuf& data,
+      ColumnState& state) {
+    const auto size = data.computeChainDataLength();
+    if (size < kMinCompressionBytes) {
+      return common::CompressionKind_NONE;
+    }
+    if (state.numPagesToSkip > 0) {
+      --state.numPagesToSkip;
+      return common::CompressionKind_NONE;
+    }
+
+    const auto sampleSize = std::min<size_t>(size, kSampleBytes);
+    auto sample = folly::IOBuf::create(sampleSize);
+    folly::io::Cursor(&data).pull(sample->writableData(), sampleSize);
+    sample->append(sampleSize);
+
+    const auto lz4Size = lz4_->compress(sample.get())->computeChainDataLength();
+    if (lz4Size > sampleSize * minCompressionRatio_) {
+      ++state.numIncompressible;
+      state.numPagesToSkip =
+          std::min(kMaxPagesToSkip, state.numIncompressible);
+      return common::CompressionKind_NONE;
+    }
+    const auto zstdSize =
+        zstd_->compress(sample.get())->computeChainDataLength();
+    // ZSTD takes more CPU, use it when it is clearly smaller.
+    return zstdSize < lz4Size * kMinZstdGain ? common::CompressionKind_ZSTD
+                                             : common::CompressionKind_LZ4;
+  }
+
+  folly::io::Codec& codec(common::CompressionKind kind) {
+    return kind == common::CompressionKind_ZSTD ? *zstd_ : *lz4_;
+  }
+
+  const std::vector<std::string> names_;
+  const float minCompressionRatio_;
+  const std::unique_ptr<folly::io::Codec> lz4_;
+  const std::unique_ptr<folly::io::Codec> zstd_;
+  std::vector<ColumnState> columns_;
+};
+
 class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
  public:
   PrestoIterativeVectorSerializer(
@@ -3930,6 +4111,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     const auto types = rowType->children();
     const auto numTypes = types.size();
     streams_.resize(numTypes);
+    if (opts.columnCompression) {
+      columnCompressor_ = std::make_unique<ColumnCompressor>(rowType, opts);
+    }
 
     for (int i = 0; i < numTypes; ++i) {
       streams_[i] = std::make_unique<VectorStream>(
@@ -3971,6 +4155,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       dataSize += stream->serializedSize();
     }
 
+    if (columnCompressor_ != nullptr) {
+      // Per column headers. Columns that do not compress are stored as is.
+      return kHeaderSize + dataSize + streams_.size() * (1 + 4 + 4);
+    }
     auto compressedSize = needCompression(*codec_)
         ? codec_->maxCompressedLength(dataSize)
         : dataSize;
@@ -3982,7 +4170,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // checksum(8) | data
   void flush(OutputStream* out) override {
     constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
-    if (!needCompression(*codec_)) {
+    if (columnCompressor_ != nullptr) {
+      columnCompressor_->flush(streams_, numRows_, *streamArena_, out);
+    } else if (!needCompression(*codec_)) {
       flushStreams(
           streams_,
           numRows_,
@@ -4028,6 +4218,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
          {"compressionSkippedBytes",
           RuntimeCounter(
               stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+    if (columnCompressor_ != nullptr) {
+      columnCompressor_->addRuntimeStats(map);
+    }
     return map;
   }
 
@@ -4064,6 +4257,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
   CompressionStats stats_;
+
+  // Set if 'opts_.columnCompression' is true.
+  std::unique_ptr<ColumnCompressor> columnCompressor_;
 };
 } // namespace
 
@@ -4098,6 +4294,9 @@ std::unique_ptr<BatchVectorSerializer> PrestoVectorSerde::createBatchSerializer(
     memory::MemoryPool* pool,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
+  VELOX_USER_CHECK(
+      !prestoOptions.columnCompression,
+      "PrestoOptions::columnCompression is only supported by the iterative serializer");
   return std::make_unique<PrestoBatchVectorSerializer>(pool, prestoOptions);
 }
 
@@ -4168,6 +4367,48 @@ void readTopColumns(
   readColumns(
       &source, childTypes, resultOffset, nullptr, 0, pool, opts, children);
 }
+
+// Reads a page written with PrestoOptions::columnCompression.
+void readColumnCompressedPage(
+    ByteInputStream& source,
+    const RowTypePtr& type,
+    velox::memory::MemoryPool* pool,
+    const RowVectorPtr& result,
+    int32_t resultOffset,
+    const SerdeOpts& opts) {
+  int32_t numColumns = source.read<int32_t>();
+  VELOX_CHECK_GE(numColumns, 0);
+  // The uncompressed columns preceded by their number, as expected by
+  // readTopColumns().
+  std::vector<ByteRange> ranges;
+  ranges.reserve(numColumns + 1);
+  ranges.push_back(
+      {reinterpret_cast<uint8_t*>(&numColumns), sizeof(numColumns), 0});
+  std::vector<std::unique_ptr<folly::IOBuf>> buffers;
+  buffers.reserve(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto kind =
+        static_cast<common::CompressionKind>(source.read<int8_t>());
+    const auto uncompressedSize = source.read<int32_t>();
+    const auto size = source.read<int32_t>();
+    VELOX_CHECK_GE(uncompressedSize, 0);
+    VELOX_CHECK_GE(size, 0);
+    auto buffer = folly::IOBuf::create(size);
+    source.readBytes(buffer->writableData(), size);
+    buffer->append(size);
+    if (kind != common::CompressionKind_NONE) {
+      buffer = common::compressionKindToCodec(kind)->uncompress(
+          buffer.get(), uncompressedSize);
+      buffer->coalesce();
+    }
+    VELOX_CHECK_EQ(buffer->length(), uncompressedSize);
+    ranges.push_back(
+        {buffer->writableData(), static_cast<int32_t>(buffer->length()), 0});
+    buffers.push_back(std::move(buffer));
+  }
+  BufferInputStream input(std::move(ranges));
+  readTopColumns(input, type, pool, result, resultOffset, opts);
+}
 } // namespace
 
 void PrestoVectorSerde::deserialize(
@@ -4214,7 +4455,10 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       header.checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  if (!isCompressedBitSet(header.pageCodecMarker)) {
+  if (isColumnCompressedBitSet(header.pageCodecMarker)) {
+    readColumnCompressedPage(
+        *source, type, pool, *result, resultOffset, prestoOptions);
+  } else if (!isCompressedBitSet(header.pageCodecMarker)) {
     readTopColumns(*source, type, pool, *result, resultOffset, prestoOptions);
   } else {
     auto compressBuf = folly::IOBuf::create(header.compressedSize);
@@ -4310,6 +4554,9 @@ class PrestoVectorLexer {
     VELOX_RETURN_IF(
         isCompressedBitSet(header->pageCodecMarker),
         Status::Invalid("Compression is not supported"));
+    VELOX_RETURN_IF(
+        isColumnCompressedBitSet(header->pageCodecMarker),
+        Status::Invalid("Column compression is not supported"));
     VELOX_RETURN_IF(
         isEncryptedBitSet(header->pageCodecMarker),
         Status::Invalid("Encryption is not supported"));
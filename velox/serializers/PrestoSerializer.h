@@ -72,6 +72,24 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Compresses each top level column separately instead of the whole page.
+    /// A sample of each column is compressed to choose between no compression,
+    /// LZ4 and ZSTD for the column, and the choice is recorded per column in
+    /// the page. Columns that compress worse than 'minCompressionRatio' are
+    /// not sampled again for a number of pages. Overrides 'compressionKind'.
+    /// Only supported by the iterative serializer, createBatchSerializer()
+    /// throws if set.
+    ///
+    /// The pages are marked with a codec bit that is not part of the Presto
+    /// wire format. Presto (Java) and other non-Velox readers do not check
+    /// for this bit and may silently misread such pages. These pages must
+    /// never reach non-Velox readers, i.e. use only where both ends are
+    /// Velox, e.g. for exchanges between Velox workers.
+    bool columnCompression{false};
+
+    /// ZSTD compression level used by 'columnCompression'.
+    int32_t columnCompressionZstdLevel{1};
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
@@ -1550,6 +1550,74 @@ TEST_F(PrestoSerializerTest, deserializeSingleColumn) {
   }
 }
 
+TEST_F(PrestoSerializerTest, columnCompression) {
+  constexpr vector_size_t kSize = 10'000;
+  folly::Random::DefaultGenerator rng(1);
+  auto data = makeRowVector(
+      {"repeated", "random"},
+      {
+          makeFlatVector<std::string>(
+              kSize,
+              [](auto row) {
+                return fmt::format("category_{}_with_a_long_suffix", row % 7);
+              }),
+          makeFlatVector<int64_t>(
+              kSize, [&](auto /*row*/) { return folly::Random::rand64(rng); }),
+      });
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions opts;
+  opts.columnCompression = true;
+  auto rowType = asRowType(data->type());
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto serializer =
+      serde_->createIterativeSerializer(rowType, kSize, arena.get(), &opts);
+
+  auto flush = [&](const RowVectorPtr& page) {
+    serializer->clear();
+    serializer->append(page);
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    std::ostringstream output;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    EXPECT_GE(serializer->maxSerializedSize(), output.str().size());
+    return output.str();
+  };
+
+  // The columns of the second page are too small to be compressed.
+  for (const auto& page :
+       {data, std::dynamic_pointer_cast<RowVector>(data->slice(0, 3))}) {
+    auto byteStream = toByteStream(flush(page));
+    RowVectorPtr result;
+    serde_->deserialize(byteStream.get(), pool(), rowType, &result, 0, &opts);
+    assertEqualVectors(page, result);
+  }
+
+  const auto stats = serializer->runtimeStats();
+  const auto stat = [&](const std::string& column, const std::string& name) {
+    return stats.at(fmt::format("columnCompression.{}.{}", column, name)).value;
+  };
+  ASSERT_LT(
+      stat("repeated", "outputBytes") * 10, stat("repeated", "inputBytes"));
+  ASSERT_EQ(stat("repeated", "numLz4") + stat("repeated", "numZstd"), 1);
+  // Random bits are sent as is.
+  ASSERT_EQ(stat("random", "outputBytes"), stat("random", "inputBytes"));
+  ASSERT_EQ(stat("random", "numLz4") + stat("random", "numZstd"), 0);
+
+  // A corrupted page fails the checksum.
+  auto serialized = flush(data);
+  serialized.back() ^= 1;
+  auto byteStream = toByteStream(serialized);
+  RowVectorPtr result;
+  VELOX_ASSERT_THROW(
+      serde_->deserialize(byteStream.get(), pool(), rowType, &result, 0, &opts),
+      "Received corrupted serialized page.");
+
+  // The batch serializer does not compress per column.
+  VELOX_ASSERT_USER_THROW(
+      serde_->createBatchSerializer(pool(), &opts),
+      "PrestoOptions::columnCompression is only supported by the iterative serializer");
+}
+
 class PrestoSerializerBatchEstimateSizeTest : public testing::Test,
                                               public VectorTestBase {
  protected:
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/hash/Hash.h>
 #include <folly/init/Init.h>
 
 #include <vector>
@@ -146,6 +147,76 @@ class SerializerBenchmark : public VectorTestBase {
     }
   }
 
+  void timeCompression() {
+    // Serializes a page of UUID-like strings, low cardinality strings and
+    // small integers with whole page compression and with column compression.
+    // Prints the serialized size and the time to serialize each way.
+    constexpr int32_t kVectorSize = 10000;
+    constexpr int32_t kNumRepeats = 20;
+    VectorMaker vm(pool_.get());
+    auto data = vm.rowVector(
+        {"uuid", "status", "quantity"},
+        {vm.flatVector<std::string>(
+             kVectorSize,
+             [](auto row) {
+               return fmt::format(
+                   "{:016x}{:016x}",
+                   folly::hash::twang_mix64(row),
+                   folly::hash::twang_mix64(row + kVectorSize));
+             }),
+         vm.flatVector<std::string>(
+             kVectorSize,
+             [](auto row) {
+               static const std::vector<std::string> kStatus = {
+                   "PENDING", "SHIPPED", "DELIVERED", "RETURNED"};
+               return kStatus[row % 13 % kStatus.size()];
+             }),
+         vm.flatVector<int64_t>(
+             kVectorSize, [](auto row) { return row % 100; })});
+    auto rowType = asRowType(data->type());
+
+    struct Case {
+      std::string name;
+      serializer::presto::PrestoVectorSerde::PrestoOptions opts;
+    };
+    std::vector<Case> cases(5);
+    cases[0].name = "none";
+    cases[1].name = "page LZ4";
+    cases[1].opts.compressionKind = common::CompressionKind_LZ4;
+    cases[2].name = "page ZSTD";
+    cases[2].opts.compressionKind = common::CompressionKind_ZSTD;
+    cases[3].name = "column";
+    cases[3].opts.columnCompression = true;
+    cases[4].name = "column, ZSTD level 3";
+    cases[4].opts.columnCompression = true;
+    cases[4].opts.columnCompressionZstdLevel = 3;
+
+    for (auto& item : cases) {
+      StreamArena arena(pool_.get());
+      auto serializer = serde_->createIterativeSerializer(
+          rowType, kVectorSize, &arena, &item.opts);
+      uint64_t micros = 0;
+      int64_t bytes = 0;
+      for (auto repeat = 0; repeat < kNumRepeats; ++repeat) {
+        MicrosecondTimer t(&micros);
+        serializer->clear();
+        serializer->append(data);
+        IOBufOutputStream out(*pool_, nullptr, serializer->maxSerializedSize());
+        serializer->flush(&out);
+        bytes = out.tellp();
+      }
+      std::cout << fmt::format(
+                       "{}: {} bytes, {} us/page",
+                       item.name,
+                       bytes,
+                       micros / kNumRepeats)
+                << std::endl;
+      for (const auto& [name, counter] : serializer->runtimeStats()) {
+        std::cout << "  " << name << ": " << counter.value << std::endl;
+      }
+    }
+  }
+
   std::unique_ptr<serializer::presto::PrestoVectorSerde> serde_;
 };
 
@@ -155,4 +226,5 @@ int main(int argc, char** argv) {
   SerializerBenchmark bm;
   bm.setup();
   bm.timeFlat();
+  bm.timeCompression();
 }
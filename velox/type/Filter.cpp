@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilterValues:
+      strKind = "BloomFilterValues";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilterValues, "kBloomFilterValues"},
   };
 }
 
@@ -199,6 +204,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -754,6 +760,52 @@ bool MultiRange::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  std::string serialized;
+  serialized.resize(bloomFilter_->serializedSize());
+  bloomFilter_->serialize(serialized.data());
+  obj["bloomFilter"] = encoding::Base64::encode(serialized);
+  if (base_ != nullptr) {
+    obj["base"] = base_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto serialized =
+      encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+  std::shared_ptr<const Filter> base;
+  if (obj.count("base")) {
+    base = ISerializable::deserialize<Filter>(obj["base"]);
+  }
+  return std::make_unique<BloomFilterValues>(
+      std::move(bloomFilter), nullAllowed, std::move(base));
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilter = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other)) {
+    return false;
+  }
+  if ((base_ == nullptr) != (otherBloomFilter->base_ == nullptr) ||
+      (base_ != nullptr && !base_->testingEquals(*otherBloomFilter->base_))) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloomFilter->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string serialized(size, '\0');
+  std::string otherSerialized(size, '\0');
+  bloomFilter_->serialize(serialized.data());
+  otherBloomFilter->bloomFilter_->serialize(otherSerialized.data());
+  return serialized == otherSerialized;
+}
+
 BigintValuesUsingBitmask::BigintValuesUsingBitmask(
     int64_t min,
     int64_t max,
@@ -2630,4 +2682,69 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (base_ != nullptr && !base_->testInt64Range(min, max, false)) {
+    return false;
+  }
+  if (min == max) {
+    return bloomFilter_->mayContain(hashInt64(min));
+  }
+  return true;
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (base_ != nullptr && !base_->testBytesRange(min, max, false)) {
+    return false;
+  }
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return bloomFilter_->mayContain(
+        hashBytes(min.value().data(), min.value().size()));
+  }
+  return true;
+}
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+      return clone();
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return clone(false);
+    case FilterKind::kBloomFilterValues: {
+      // Keep 'other' as the conjunct. 'other' merges with our own conjunct, if
+      // any, by wrapping it as well.
+      std::shared_ptr<const Filter> base = base_ == nullptr
+          ? std::shared_ptr<const Filter>(other->clone())
+          : std::shared_ptr<const Filter>(other->mergeWith(base_.get()));
+      return std::make_unique<BloomFilterValues>(
+          bloomFilter_, bothNullAllowed, std::move(base));
+    }
+    default: {
+      std::shared_ptr<const Filter> base = base_ == nullptr
+          ? std::shared_ptr<const Filter>(other->clone())
+          : std::shared_ptr<const Filter>(base_->mergeWith(other));
+      if (base->kind() == FilterKind::kAlwaysFalse ||
+          base->kind() == FilterKind::kIsNull) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BloomFilterValues>(
+          bloomFilter_, bothNullAllowed, std::move(base));
+    }
+  }
+}
+
 } // namespace facebook::velox::common
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilterValues,
 };
 
 class Filter;
@@ -2087,6 +2090,107 @@ class MultiRange final : public Filter {
   const std::vector<std::unique_ptr<Filter>> filters_;
 };
 
+/// Probabilistic IN-list filter for integer and string data types backed by a
+/// blocked Bloom filter. Produced as a dynamic filter by hash join build sides
+/// whose keys are too many to be represented as an exact IN-list. May pass
+/// values that are not in the set but never fails a value that is. The Bloom
+/// filter is immutable and shared between copies of the filter.
+///
+/// Since the exact filters do not know how to merge with a Bloom filter, the
+/// result of merging other filters with 'this' is kept as a conjunct in
+/// 'base_' which is evaluated before the Bloom filter.
+class BloomFilterValues final : public Filter {
+ public:
+  /// @param bloomFilter Bloom filter of the hashes of the values that pass,
+  /// computed with hashInt64() or hashBytes().
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param base Optional filter that must also pass.
+  BloomFilterValues(
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> base = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilter_(std::move(bloomFilter)),
+        base_(std::move(base)) {
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+    VELOX_CHECK(bloomFilter_->isSet());
+  }
+
+  BloomFilterValues(const BloomFilterValues& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilter_(other.bloomFilter_),
+        base_(other.base_) {}
+
+  /// Hash functions used for inserting values into and testing values against
+  /// the Bloom filter. Integer values of all widths are hashed as int64_t.
+  static uint64_t hashInt64(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return folly::hasher<std::string_view>()(std::string_view(value, length));
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BloomFilterValues>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  bool testInt64(int64_t value) const final {
+    return (base_ == nullptr || base_->testInt64(value)) &&
+        bloomFilter_->mayContain(hashInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (base_ == nullptr || base_->testBytes(value, length)) &&
+        bloomFilter_->mayContain(hashBytes(value, length));
+  }
+
+  bool hasTestLength() const final {
+    return base_ != nullptr && base_->hasTestLength();
+  }
+
+  bool testLength(int32_t length) const final {
+    return base_ == nullptr || base_->testLength(length);
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const std::shared_ptr<const BloomFilter<>>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  const std::shared_ptr<const Filter>& base() const {
+    return base_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BloomFilterValues: {} bytes{}, {}",
+        bloomFilter_->serializedSize(),
+        base_ ? " AND " + base_->toString() : "",
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+  const std::shared_ptr<const Filter> base_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
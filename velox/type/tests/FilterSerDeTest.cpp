@@ -156,6 +156,18 @@ TEST_F(FilterSerDeTest, multiFilter) {
   testSerde(multiRange);
 }
 
+TEST_F(FilterSerDeTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i * 7));
+  }
+  testSerde(BloomFilterValues(bloomFilter, false));
+  testSerde(BloomFilterValues(bloomFilter, true));
+  testSerde(BloomFilterValues(
+      bloomFilter, false, std::make_shared<BigintRange>(10, 500, false)));
+}
+
 TEST_F(FilterSerDeTest, timestampFilter) {
   Timestamp hi(100000, 2000);
   Timestamp lo(-123, 99999);
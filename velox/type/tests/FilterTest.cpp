@@ -965,6 +965,74 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i * 3));
+    const auto value = fmt::format("key{}", i * 3);
+    bloomFilter->insert(
+        BloomFilterValues::hashBytes(value.data(), value.size()));
+  }
+  auto filter = std::make_unique<BloomFilterValues>(bloomFilter, false);
+  EXPECT_EQ(filter->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(filter->testNull());
+
+  // No false negatives. False positives are rare.
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 3'000; ++i) {
+    const auto value = fmt::format("key{}", i);
+    if (i % 3 == 0) {
+      EXPECT_TRUE(filter->testInt64(i));
+      EXPECT_TRUE(filter->testBytes(value.data(), value.size()));
+    } else {
+      numFalsePositives += filter->testInt64(i);
+      numFalsePositives += filter->testBytes(value.data(), value.size());
+    }
+  }
+  EXPECT_LT(numFalsePositives, 4'000 / 20);
+
+  EXPECT_FALSE(filter->hasTestLength());
+  EXPECT_TRUE(filter->testInt64Range(0, 100, false));
+  EXPECT_TRUE(filter->testInt64Range(300, 300, false));
+  EXPECT_TRUE(filter->testBytesRange("key3", "key3", false));
+  EXPECT_TRUE(filter->testBytesRange("a", "z", false));
+  EXPECT_TRUE(filter->testBytesRange(std::nullopt, "z", false));
+
+  auto nullAllowed = filter->clone(true);
+  EXPECT_TRUE(nullAllowed->testNull());
+  EXPECT_TRUE(nullAllowed->testInt64(3));
+
+  // Merging keeps the other filter as a conjunct.
+  auto merged = filter->mergeWith(between(10, 20).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_TRUE(merged->testInt64(12));
+  EXPECT_FALSE(merged->testInt64(9));
+  EXPECT_FALSE(merged->testInt64(21));
+  EXPECT_FALSE(merged->testInt64Range(0, 9, false));
+  EXPECT_TRUE(merged->testInt64Range(12, 12, false));
+
+  merged = filter->mergeWith(
+      in(std::vector<std::string>{"key3", "key4"}).get());
+  EXPECT_TRUE(merged->hasTestLength());
+  EXPECT_TRUE(merged->testLength(4));
+  EXPECT_FALSE(merged->testLength(5));
+  EXPECT_TRUE(merged->testBytes("key3", 4));
+  EXPECT_FALSE(merged->testBytes("key6", 4));
+
+  merged = filter->mergeWith(filter.get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_TRUE(merged->testInt64(3));
+
+  merged = filter->mergeWith(isNull().get());
+  EXPECT_EQ(merged->kind(), FilterKind::kAlwaysFalse);
+  merged = nullAllowed->mergeWith(isNull().get());
+  EXPECT_EQ(merged->kind(), FilterKind::kIsNull);
+  merged = nullAllowed->mergeWith(isNotNull().get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(merged->testNull());
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(